@@ -0,0 +1,178 @@
+/*
+ * Copyright 2026 The Elisa developers
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "audiowrapper.h"
+
+#include <QObject>
+#include <QString>
+#include <QFile>
+#include <QDataStream>
+#include <QTemporaryDir>
+#include <QElapsedTimer>
+
+#include <QDebug>
+
+#include <QtTest>
+
+#include <cmath>
+
+/**
+ * Play two generated PCM files one after the other and measure the time
+ * between the expected end of the first one and the first position reported
+ * in the second one, with and without prepareNext.
+ *
+ * An audio output is needed: the benchmark is skipped without one.
+ */
+class AudioWrapperGaplessBenchmark: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit AudioWrapperGaplessBenchmark(QObject *aParent = nullptr) : QObject(aParent)
+    {
+    }
+
+private:
+
+    static const int SampleRate = 44100;
+
+    static const int ChannelsCount = 2;
+
+    static const qint64 TrackDuration = 2000;
+
+    static bool writeWaveFile(const QString &fileName, double frequency)
+    {
+        QFile waveFile(fileName);
+        if (!waveFile.open(QIODevice::WriteOnly)) {
+            return false;
+        }
+
+        const quint32 samplesCount = SampleRate * TrackDuration / 1000;
+        const quint32 dataSize = samplesCount * ChannelsCount * sizeof(qint16);
+
+        QDataStream waveStream(&waveFile);
+        waveStream.setByteOrder(QDataStream::LittleEndian);
+
+        waveStream.writeRawData("RIFF", 4);
+        waveStream << quint32(36 + dataSize);
+        waveStream.writeRawData("WAVE", 4);
+        waveStream.writeRawData("fmt ", 4);
+        waveStream << quint32(16) << quint16(1) << quint16(ChannelsCount) << quint32(SampleRate)
+                   << quint32(SampleRate * ChannelsCount * sizeof(qint16)) << quint16(ChannelsCount * sizeof(qint16))
+                   << quint16(16);
+        waveStream.writeRawData("data", 4);
+        waveStream << dataSize;
+
+        const auto pi = std::acos(-1.0);
+
+        for (quint32 sampleIndex = 0; sampleIndex < samplesCount; ++sampleIndex) {
+            const auto value = static_cast<qint16>(8000 * std::sin(2 * pi * frequency * sampleIndex / SampleRate));
+            for (int channel = 0; channel < ChannelsCount; ++channel) {
+                waveStream << value;
+            }
+        }
+
+        return waveStream.status() == QDataStream::Ok;
+    }
+
+    static qint64 measureGap(const QUrl &firstTrack, const QUrl &secondTrack, bool prepareNext)
+    {
+        AudioWrapper player;
+
+        QElapsedTimer playTimer;
+        auto firstTrackStart = qint64(-1);
+        auto secondTrackStart = qint64(-1);
+        auto isSecondTrack = false;
+
+        connect(&player, &AudioWrapper::positionChanged, &player, [&](qint64 position) {
+            if (position <= 0) {
+                return;
+            }
+
+            if (!isSecondTrack && firstTrackStart == -1) {
+                firstTrackStart = playTimer.elapsed();
+            } else if (isSecondTrack && secondTrackStart == -1) {
+                secondTrackStart = playTimer.elapsed();
+            }
+        });
+
+        connect(&player, &AudioWrapper::preparedSourceStarted, &player, [&]() {
+            isSecondTrack = true;
+        });
+
+        connect(&player, &AudioWrapper::statusChanged, &player, [&](QMediaPlayer::MediaStatus status) {
+            if (prepareNext || isSecondTrack || status != QMediaPlayer::EndOfMedia) {
+                return;
+            }
+
+            isSecondTrack = true;
+            player.setSource(secondTrack);
+            player.play();
+        });
+
+        player.setSource(firstTrack);
+        if (prepareNext) {
+            player.prepareNext(secondTrack);
+        }
+
+        playTimer.start();
+        player.play();
+
+        QElapsedTimer waitTimer;
+        waitTimer.start();
+        while (secondTrackStart == -1 && player.error() == QMediaPlayer::NoError && waitTimer.elapsed() < 5 * TrackDuration) {
+            QTest::qWait(10);
+        }
+
+        if (firstTrackStart == -1 || secondTrackStart == -1) {
+            return -1;
+        }
+
+        return secondTrackStart - firstTrackStart - TrackDuration;
+    }
+
+private Q_SLOTS:
+
+    void benchmarkInterTrackGap()
+    {
+        QTemporaryDir workingDirectory;
+        QVERIFY(workingDirectory.isValid());
+
+        const auto firstTrack = workingDirectory.filePath(QStringLiteral("first.wav"));
+        const auto secondTrack = workingDirectory.filePath(QStringLiteral("second.wav"));
+
+        QVERIFY(writeWaveFile(firstTrack, 440));
+        QVERIFY(writeWaveFile(secondTrack, 660));
+
+        const auto stoppedGap = measureGap(QUrl::fromLocalFile(firstTrack), QUrl::fromLocalFile(secondTrack), false);
+        if (stoppedGap == -1) {
+            QSKIP("no usable audio output");
+        }
+
+        const auto preparedGap = measureGap(QUrl::fromLocalFile(firstTrack), QUrl::fromLocalFile(secondTrack), true);
+        QVERIFY(preparedGap != -1);
+
+        qInfo() << "AudioWrapperGaplessBenchmark" << "gap between tracks:" << stoppedGap << "ms when starting the next track after the end,"
+                << preparedGap << "ms with the next track prepared";
+    }
+};
+
+QTEST_GUILESS_MAIN(AudioWrapperGaplessBenchmark)
+
+
+#include "audiowrappergaplessbenchmark.moc"
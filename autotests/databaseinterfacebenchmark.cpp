@@ -0,0 +1,142 @@
+/*
+ * Copyright 2026 The Elisa developers
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "databaseinterface.h"
+#include "datatypes.h"
+
+#include <QObject>
+#include <QUrl>
+#include <QString>
+#include <QHash>
+#include <QTime>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QTemporaryFile>
+
+#include <QDebug>
+
+#include <QtTest>
+
+#include <algorithm>
+
+class DatabaseInterfaceBenchmark: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit DatabaseInterfaceBenchmark(QObject *aParent = nullptr) : QObject(aParent)
+    {
+    }
+
+private:
+
+    static DataTypes::ListTrackDataType generateTracks(int tracksCount)
+    {
+        auto result = DataTypes::ListTrackDataType{};
+        result.reserve(tracksCount);
+
+        for (int trackIndex = 0; trackIndex < tracksCount; ++trackIndex) {
+            const auto albumIndex = trackIndex / 12;
+            const auto artistIndex = albumIndex / 4;
+
+            const auto artistName = QStringLiteral("artist%1").arg(artistIndex);
+            const auto albumName = QStringLiteral("album%1").arg(albumIndex);
+            const auto fileName = QStringLiteral("/benchmark/%1/%2/track%3.ogg").arg(artistName, albumName).arg(trackIndex);
+
+            result.push_back({true, QString::number(trackIndex), QStringLiteral("0"), QStringLiteral("track%1").arg(trackIndex),
+                              artistName, albumName, artistName,
+                              trackIndex % 12 + 1, 1, QTime::fromMSecsSinceStartOfDay(180000 + trackIndex), QUrl::fromLocalFile(fileName),
+                              QDateTime::fromMSecsSinceEpoch(trackIndex),
+                              {}, 0, true,
+                              QStringLiteral("genre%1").arg(artistIndex % 25), QStringLiteral("composer%1").arg(artistIndex % 60),
+                              QStringLiteral("lyricist%1").arg(artistIndex % 40), false});
+        }
+
+        return result;
+    }
+
+private Q_SLOTS:
+
+    void initTestCase()
+    {
+        qRegisterMetaType<QHash<QString,QUrl>>("QHash<QString,QUrl>");
+        qRegisterMetaType<QHash<QUrl,QDateTime>>("QHash<QUrl,QDateTime>");
+        qRegisterMetaType<DataTypes::ListTrackDataType>("ListTrackDataType");
+        qRegisterMetaType<DataTypes::ListAlbumDataType>("ListAlbumDataType");
+        qRegisterMetaType<DataTypes::ListArtistDataType>("ListArtistDataType");
+        qRegisterMetaType<DataTypes::ListGenreDataType>("ListGenreDataType");
+        qRegisterMetaType<DataTypes::TrackDataType>("TrackDataType");
+        qRegisterMetaType<DataTypes::AlbumDataType>("AlbumDataType");
+        qRegisterMetaType<DataTypes::ArtistDataType>("ArtistDataType");
+        qRegisterMetaType<DataTypes::GenreDataType>("GenreDataType");
+    }
+
+    void benchmarkInsertTracksList_data()
+    {
+        QTest::addColumn<int>("tracksCount");
+        QTest::addColumn<int>("batchSize");
+
+        // one track per call cannot be batched: reference for the rows below
+        QTest::newRow("1000 tracks by 1") << 1000 << 1;
+        QTest::newRow("1000 tracks by 100") << 1000 << 100;
+        QTest::newRow("10000 tracks by 1") << 10000 << 1;
+        QTest::newRow("10000 tracks by 100") << 10000 << 100;
+        QTest::newRow("10000 tracks by 1000") << 10000 << 1000;
+    }
+
+    void benchmarkInsertTracksList()
+    {
+        QFETCH(int, tracksCount);
+        QFETCH(int, batchSize);
+
+        const auto allTracks = generateTracks(tracksCount);
+
+        QBENCHMARK_ONCE {
+            QTemporaryFile databaseFile;
+            databaseFile.open();
+
+            DatabaseInterface musicDb;
+
+            musicDb.init(QStringLiteral("benchmarkDb%1-%2").arg(tracksCount).arg(batchSize), databaseFile.fileName());
+
+            QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+            QElapsedTimer insertTimer;
+            insertTimer.start();
+
+            for (int batchBegin = 0; batchBegin < tracksCount; batchBegin += batchSize) {
+                musicDb.insertTracksList(allTracks.mid(batchBegin, batchSize), {});
+            }
+
+            const auto elapsedMilliseconds = std::max<qint64>(insertTimer.elapsed(), 1);
+
+            QTest::setBenchmarkResult(elapsedMilliseconds, QTest::WalltimeMilliseconds);
+
+            qInfo() << "DatabaseInterfaceBenchmark::benchmarkInsertTracksList" << tracksCount << "tracks by" << batchSize
+                    << "inserted in" << elapsedMilliseconds << "ms" << (tracksCount * 1000. / elapsedMilliseconds) << "tracks per second";
+
+            QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+            QCOMPARE(musicDb.allTracksData().count(), tracksCount);
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(DatabaseInterfaceBenchmark)
+
+
+#include "databaseinterfacebenchmark.moc"
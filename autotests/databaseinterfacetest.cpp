@@ -2449,6 +2449,53 @@ private Q_SLOTS:
         QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
     }
 
+    void removeOneArtistAndAddItBack()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        QSignalSpy musicDbArtistAddedSpy(&musicDb, &DatabaseInterface::artistsAdded);
+        QSignalSpy musicDbArtistRemovedSpy(&musicDb, &DatabaseInterface::artistRemoved);
+        QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+        musicDbTrackAddedSpy.wait(300);
+
+        QCOMPARE(musicDb.allArtistsData().count(), 7);
+        QCOMPARE(musicDb.allTracksData().count(), 22);
+        QCOMPARE(musicDbArtistAddedSpy.count(), 1);
+
+        auto removedTrack = std::find_if(mNewTracks.begin(), mNewTracks.end(), [](const auto &oneTrack) {
+            return oneTrack.title() == QStringLiteral("track3") && oneTrack.artist() == QStringLiteral("artist3") &&
+                    oneTrack.album() == QStringLiteral("album1");
+        });
+
+        QVERIFY(removedTrack != mNewTracks.end());
+
+        musicDb.removeTracksList({removedTrack->resourceURI()});
+
+        QCOMPARE(musicDb.allArtistsData().count(), 6);
+        QCOMPARE(musicDb.allTracksData().count(), 21);
+        QCOMPARE(musicDbArtistRemovedSpy.count(), 1);
+
+        musicDb.insertTracksList({*removedTrack}, mNewCovers);
+
+        QCOMPARE(musicDb.allArtistsData().count(), 7);
+        QCOMPARE(musicDb.allTracksData().count(), 22);
+        QCOMPARE(musicDbArtistAddedSpy.count(), 2);
+        QCOMPARE(musicDbTrackAddedSpy.count(), 2);
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+
+        auto trackId = musicDb.trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track3"), QStringLiteral("artist3"),
+                                                                    QStringLiteral("album1"), 3, 3);
+
+        QVERIFY(trackId != 0);
+        QCOMPARE(musicDb.trackDataFromDatabaseId(trackId).artist(), QStringLiteral("artist3"));
+    }
+
     void addOneTrack()
     {
         DatabaseInterface musicDb;
@@ -4634,6 +4681,128 @@ private Q_SLOTS:
         QCOMPARE(recentlyPlayedTracksData[9].resourceURI(), QUrl::fromLocalFile(QStringLiteral("/$9")));
     }
 
+    void renameTrackKeepsStatistics()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        QSignalSpy musicDbAlbumAddedSpy(&musicDb, &DatabaseInterface::albumsAdded);
+        QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+        QSignalSpy musicDbAlbumRemovedSpy(&musicDb, &DatabaseInterface::albumRemoved);
+        QSignalSpy musicDbTrackRemovedSpy(&musicDb, &DatabaseInterface::trackRemoved);
+        QSignalSpy musicDbTracksChangedSpy(&musicDb, &DatabaseInterface::tracksChanged);
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+        musicDbTrackAddedSpy.wait(300);
+
+        QCOMPARE(musicDb.allAlbumsData().count(), 5);
+        QCOMPARE(musicDb.allTracksData().count(), 22);
+
+        const auto oldFileName = QUrl::fromLocalFile(QStringLiteral("/$9"));
+        const auto newFileName = QUrl::fromLocalFile(QStringLiteral("/$9 renamed"));
+
+        const auto trackId = musicDb.trackIdFromFileName(oldFileName);
+        QVERIFY(trackId != 0);
+
+        musicDb.trackHasStartedPlaying(oldFileName, QDateTime::fromSecsSinceEpoch(1534689));
+
+        musicDb.renameTracksList({{oldFileName, newFileName, QDateTime::fromSecsSinceEpoch(1534700), {}}});
+
+        QCOMPARE(musicDb.allAlbumsData().count(), 5);
+        QCOMPARE(musicDb.allTracksData().count(), 22);
+        QCOMPARE(musicDbAlbumAddedSpy.count(), 1);
+        QCOMPARE(musicDbTrackAddedSpy.count(), 1);
+        QCOMPARE(musicDbAlbumRemovedSpy.count(), 0);
+        QCOMPARE(musicDbTrackRemovedSpy.count(), 0);
+        QCOMPARE(musicDbTracksChangedSpy.count(), 1);
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+
+        QCOMPARE(musicDb.trackIdFromFileName(oldFileName), qulonglong(0));
+        QCOMPARE(musicDb.trackIdFromFileName(newFileName), trackId);
+
+        const auto track = musicDb.trackDataFromDatabaseId(trackId);
+        QCOMPARE(track.resourceURI(), newFileName);
+        QCOMPARE(track.title(), QStringLiteral("track5"));
+        QCOMPARE(track.album(), QStringLiteral("album2"));
+
+        auto recentlyPlayedTracksData = musicDb.recentlyPlayedTracksData(1);
+
+        QCOMPARE(recentlyPlayedTracksData.count(), 1);
+        QCOMPARE(recentlyPlayedTracksData[0].resourceURI(), newFileName);
+    }
+
+    void insertTracksAndScannedDirectories()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+        QSignalSpy restoredScannedDirectoriesSpy(&musicDb, &DatabaseInterface::restoredScannedDirectories);
+
+        const auto scannedDirectory = DataTypes::DirectoryScanData{QUrl::fromLocalFile(QStringLiteral("/music")),
+                QDateTime::fromSecsSinceEpoch(1534689), 22, QByteArrayLiteral("hash"), {}};
+
+        musicDb.insertTracksAndScannedDirectoriesList(mNewTracks, mNewCovers, {scannedDirectory}, 0);
+
+        musicDbTrackAddedSpy.wait(300);
+
+        QCOMPARE(musicDb.allTracksData().count(), 22);
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+
+        musicDb.askRestoredTracks();
+
+        QCOMPARE(restoredScannedDirectoriesSpy.count(), 1);
+
+        const auto restoredDirectories = restoredScannedDirectoriesSpy.at(0).at(0).value<DataTypes::ListDirectoryScanData>();
+
+        QCOMPARE(restoredDirectories.count(), 1);
+        QCOMPARE(restoredDirectories.at(0).mDirectory, scannedDirectory.mDirectory);
+        QCOMPARE(restoredDirectories.at(0).mModificationTime, scannedDirectory.mModificationTime);
+        QCOMPARE(restoredDirectories.at(0).mEntriesCount, 22);
+        QCOMPARE(restoredDirectories.at(0).mContentHash, scannedDirectory.mContentHash);
+    }
+
+    void tracksDataFromDatabaseIds()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+        musicDbTrackAddedSpy.wait(300);
+
+        QCOMPARE(musicDb.allTracksData().count(), 22);
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+
+        auto firstTrackId = musicDb.trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track6"), QStringLiteral("artist1 and artist2"),
+                                                                         QStringLiteral("album2"), 6, 1);
+        auto secondTrackId = musicDb.trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track1"), QStringLiteral("artist1"),
+                                                                          QStringLiteral("album1"), 1, 1);
+
+        QVERIFY(firstTrackId != 0);
+        QVERIFY(secondTrackId != 0);
+
+        auto tracksData = musicDb.tracksDataFromDatabaseIds({firstTrackId, 999999, secondTrackId});
+
+        QCOMPARE(tracksData.count(), 2);
+        QCOMPARE(tracksData.at(0), musicDb.trackDataFromDatabaseId(firstTrackId));
+        QCOMPARE(tracksData.at(1), musicDb.trackDataFromDatabaseId(secondTrackId));
+        QCOMPARE(tracksData.at(0).title(), QStringLiteral("track6"));
+        QCOMPARE(tracksData.at(1).title(), QStringLiteral("track1"));
+
+        QCOMPARE(musicDb.tracksDataFromDatabaseIds({}).count(), 0);
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+    }
+
     void readFrequentlyPlayedTracksData()
     {
         DatabaseInterface musicDb;
@@ -5248,6 +5417,246 @@ private Q_SLOTS:
 
         QCOMPARE(albumFromGenreAndArtist.size(), 1);
     }
+
+    void albumStatsFollowTracksChanges()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        auto firstTrack = DataTypes::TrackDataType{true, QStringLiteral("$1"), QStringLiteral("0"), QStringLiteral("statsTrack1"),
+                QStringLiteral("statsArtist1"), QStringLiteral("statsAlbum"), QStringLiteral("statsAlbumArtist"),
+                1, 1, QTime::fromMSecsSinceStartOfDay(1), {QUrl::fromLocalFile(QStringLiteral("/stats/$1"))},
+                QDateTime::fromMSecsSinceEpoch(1), {}, 3, true,
+                QStringLiteral("genre1"), QStringLiteral("composer1"), QStringLiteral("lyricist1"), false};
+        auto secondTrack = DataTypes::TrackDataType{true, QStringLiteral("$2"), QStringLiteral("0"), QStringLiteral("statsTrack2"),
+                QStringLiteral("statsArtist2"), QStringLiteral("statsAlbum"), QStringLiteral("statsAlbumArtist"),
+                2, 1, QTime::fromMSecsSinceStartOfDay(2), {QUrl::fromLocalFile(QStringLiteral("/stats/$2"))},
+                QDateTime::fromMSecsSinceEpoch(2), {}, 5, true,
+                QStringLiteral("genre2"), QStringLiteral("composer1"), QStringLiteral("lyricist1"), false};
+
+        musicDb.insertTracksList({firstTrack, secondTrack}, mNewCovers);
+
+        auto allAlbums = musicDb.allAlbumsData();
+
+        QCOMPARE(allAlbums.count(), 1);
+        QCOMPARE(allAlbums.first().isSingleDiscAlbum(), true);
+        QCOMPARE(allAlbums.first()[DataTypes::HighestTrackRating].toInt(), 5);
+        QCOMPARE(allAlbums.first()[DataTypes::AllArtistsRole].toStringList().count(), 2);
+        QCOMPARE(allAlbums.first().genres().count(), 2);
+
+        secondTrack[DataTypes::DiscNumberRole] = 2;
+        secondTrack[DataTypes::RatingRole] = 7;
+
+        musicDb.insertTracksList({secondTrack}, mNewCovers);
+
+        allAlbums = musicDb.allAlbumsData();
+
+        QCOMPARE(allAlbums.count(), 1);
+        QCOMPARE(allAlbums.first().isSingleDiscAlbum(), false);
+        QCOMPARE(allAlbums.first()[DataTypes::HighestTrackRating].toInt(), 7);
+
+        auto oneAlbum = musicDb.albumDataFromDatabaseId(allAlbums.first().databaseId());
+
+        QCOMPARE(oneAlbum.isSingleDiscAlbum(), false);
+        QCOMPARE(oneAlbum[DataTypes::HighestTrackRating].toInt(), 7);
+
+        musicDb.removeTracksList({secondTrack.resourceURI()});
+
+        allAlbums = musicDb.allAlbumsData();
+
+        QCOMPARE(allAlbums.count(), 1);
+        QCOMPARE(allAlbums.first().isSingleDiscAlbum(), true);
+        QCOMPARE(allAlbums.first()[DataTypes::HighestTrackRating].toInt(), 3);
+        QCOMPARE(allAlbums.first()[DataTypes::AllArtistsRole].toStringList(), QStringList{QStringLiteral("statsArtist1")});
+        QCOMPARE(allAlbums.first().genres(), QStringList{QStringLiteral("genre1")});
+
+        musicDb.removeTracksList({firstTrack.resourceURI()});
+
+        QCOMPARE(musicDb.allAlbumsData().count(), 0);
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+    }
+
+    void searchFollowsTracksChanges()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        if (!musicDb.isSearchIndexAvailable()) {
+            QSKIP("SQLite is built without FTS5");
+        }
+
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        auto firstTrack = DataTypes::TrackDataType{true, QStringLiteral("$1"), QStringLiteral("0"), QStringLiteral("Moonlight Sonata"),
+                QStringLiteral("Ludwig van Beethoven"), QStringLiteral("Piano Sonatas"), QStringLiteral("Ludwig van Beethoven"),
+                1, 1, QTime::fromMSecsSinceStartOfDay(1), {QUrl::fromLocalFile(QStringLiteral("/search/$1"))},
+                QDateTime::fromMSecsSinceEpoch(1), {}, 3, true,
+                QStringLiteral("Classical"), QStringLiteral("composer1"), QStringLiteral("lyricist1"), false};
+        auto secondTrack = DataTypes::TrackDataType{true, QStringLiteral("$2"), QStringLiteral("0"), QStringLiteral("Blue Moon"),
+                QStringLiteral("Ella Fitzgerald"), QStringLiteral("Songbook"), QStringLiteral("Ella Fitzgerald"),
+                1, 1, QTime::fromMSecsSinceStartOfDay(2), {QUrl::fromLocalFile(QStringLiteral("/search/$2"))},
+                QDateTime::fromMSecsSinceEpoch(2), {}, 5, true,
+                QStringLiteral("Jazz"), QStringLiteral("composer2"), QStringLiteral("lyricist2"), false};
+
+        musicDb.insertTracksList({firstTrack, secondTrack}, mNewCovers);
+
+        QCOMPARE(musicDb.searchTracks(QStringLiteral("moon"), -1, 0).count(), 2);
+        QCOMPARE(musicDb.searchTracks(QStringLiteral("moo bee"), -1, 0).count(), 1);
+        QCOMPARE(musicDb.searchTracks(QStringLiteral("jaz"), -1, 0).count(), 1);
+        QCOMPARE(musicDb.searchTracks(QStringLiteral("oon"), -1, 0).count(), 0);
+        QCOMPARE(musicDb.searchTracks(QStringLiteral("moon"), 1, 0).count(), 1);
+        QCOMPARE(musicDb.searchTracks(QStringLiteral("\"moon"), -1, 0).count(), 2);
+        QCOMPARE(musicDb.searchTracks(QStringLiteral("  "), -1, 0).count(), 0);
+
+        auto searchedAlbums = musicDb.searchAlbums(QStringLiteral("song"), -1, 0);
+
+        QCOMPARE(searchedAlbums.count(), 1);
+        QCOMPARE(searchedAlbums.first().title(), QStringLiteral("Songbook"));
+        QCOMPARE(musicDb.searchAlbums(QStringLiteral("moon"), -1, 0).count(), 0);
+
+        auto searchedArtists = musicDb.searchArtists(QStringLiteral("ell"), -1, 0);
+
+        QCOMPARE(searchedArtists.count(), 1);
+        QCOMPARE(searchedArtists.first()[DataTypes::TitleRole].toString(), QStringLiteral("Ella Fitzgerald"));
+
+        QCOMPARE(musicDb.searchIds(ElisaUtils::Track, QStringLiteral("moon"), 10).count(), 2);
+        QCOMPARE(musicDb.searchIds(ElisaUtils::Track, QStringLiteral("moon"), 1).count(), 1);
+        QCOMPARE(musicDb.searchIds(ElisaUtils::Album, QStringLiteral("song"), 10),
+                 QVector<qulonglong>{searchedAlbums.first().databaseId()});
+        QCOMPARE(musicDb.searchIds(ElisaUtils::Artist, QStringLiteral("ell"), 10),
+                 QVector<qulonglong>{searchedArtists.first().databaseId()});
+
+        secondTrack[DataTypes::TitleRole] = QStringLiteral("Summertime");
+
+        musicDb.insertTracksList({secondTrack}, mNewCovers);
+
+        QCOMPARE(musicDb.searchTracks(QStringLiteral("moon"), -1, 0).count(), 1);
+        QCOMPARE(musicDb.searchTracks(QStringLiteral("summer"), -1, 0).count(), 1);
+
+        musicDb.removeTracksList({firstTrack.resourceURI()});
+
+        QCOMPARE(musicDb.searchTracks(QStringLiteral("moon"), -1, 0).count(), 0);
+        QCOMPARE(musicDb.searchArtists(QStringLiteral("beeth"), -1, 0).count(), 0);
+
+        musicDb.clearData();
+
+        QCOMPARE(musicDb.searchTracks(QStringLiteral("summer"), -1, 0).count(), 0);
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+    }
+
+    void readWhileImportingWithWriteAheadLog()
+    {
+        QTemporaryFile databaseFile;
+        databaseFile.open();
+
+        QThread writerThread;
+        QThread readerThread;
+
+        DatabaseInterface musicDb;
+        DatabaseInterface musicDbReader;
+
+        musicDb.moveToThread(&writerThread);
+        musicDbReader.moveToThread(&readerThread);
+
+        writerThread.start();
+        readerThread.start();
+
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+        QSignalSpy musicDbReaderDatabaseErrorSpy(&musicDbReader, &DatabaseInterface::databaseError);
+
+        QMetaObject::invokeMethod(&musicDb, [&]() {
+            musicDb.init(QStringLiteral("testDbWriter"), databaseFile.fileName(), true);
+            musicDb.insertTracksList(mNewTracks, mNewCovers);
+        }, Qt::BlockingQueuedConnection);
+
+        QMetaObject::invokeMethod(&musicDbReader, [&]() {
+            musicDbReader.initReadOnly(QStringLiteral("testDbReader"), databaseFile.fileName());
+        }, Qt::BlockingQueuedConnection);
+
+        auto committedAlbums = DataTypes::ListAlbumDataType{};
+        auto committedTracks = DataTypes::ListTrackDataType{};
+
+        QMetaObject::invokeMethod(&musicDbReader, [&]() {
+            committedAlbums = musicDbReader.allAlbumsData();
+            committedTracks = musicDbReader.allTracksData();
+        }, Qt::BlockingQueuedConnection);
+
+        QVERIFY(!committedAlbums.isEmpty());
+        QVERIFY(!committedTracks.isEmpty());
+
+        auto importTracks = DataTypes::ListTrackDataType{};
+        for (int trackIndex = 0; trackIndex < 5000; ++trackIndex) {
+            const auto artistName = QStringLiteral("importArtist%1").arg(trackIndex / 48);
+            const auto albumName = QStringLiteral("importAlbum%1").arg(trackIndex / 12);
+
+            importTracks.push_back({true, QStringLiteral("import%1").arg(trackIndex), QStringLiteral("0"), QStringLiteral("importTrack%1").arg(trackIndex),
+                                    artistName, albumName, artistName,
+                                    trackIndex % 12 + 1, 1, QTime::fromMSecsSinceStartOfDay(180000), QUrl::fromLocalFile(QStringLiteral("/import/%1.ogg").arg(trackIndex)),
+                                    QDateTime::fromMSecsSinceEpoch(trackIndex),
+                                    {}, 0, true,
+                                    QStringLiteral("importGenre%1").arg(trackIndex % 10), QStringLiteral("importComposer1"),
+                                    QStringLiteral("importLyricist1"), false});
+        }
+
+        // listeners are told about the new genres once the import is committed:
+        // a read-only connection already sees all the imported tracks
+        QAtomicInt tracksCountOnGenresAdded = 0;
+        QAtomicInt importFinished = 0;
+
+        connect(&musicDb, &DatabaseInterface::genresAdded, &musicDb, [&]() {
+            QMetaObject::invokeMethod(&musicDbReader, [&]() {
+                tracksCountOnGenresAdded = musicDbReader.allTracksData().count();
+            }, Qt::BlockingQueuedConnection);
+        }, Qt::DirectConnection);
+        connect(&musicDb, &DatabaseInterface::finishInsertingTracksList, &musicDb, [&]() {
+            importFinished = 1;
+        }, Qt::DirectConnection);
+
+        QMetaObject::invokeMethod(&musicDb, [&]() {
+            musicDb.insertTracksList(importTracks, {});
+        }, Qt::QueuedConnection);
+
+        // the reads during the import see either the committed data or the whole import
+        while (int(importFinished) == 0) {
+            auto albumsDuringImport = DataTypes::ListAlbumDataType{};
+            auto tracksDuringImport = DataTypes::ListTrackDataType{};
+            auto oneTrackDuringImport = DataTypes::TrackDataType{};
+
+            QMetaObject::invokeMethod(&musicDbReader, [&]() {
+                albumsDuringImport = musicDbReader.allAlbumsData();
+                tracksDuringImport = musicDbReader.allTracksData();
+                oneTrackDuringImport = musicDbReader.trackDataFromDatabaseId(committedTracks.first().databaseId());
+            }, Qt::BlockingQueuedConnection);
+
+            QVERIFY(tracksDuringImport.count() == committedTracks.count() ||
+                    tracksDuringImport.count() == committedTracks.count() + importTracks.count());
+            QVERIFY(albumsDuringImport.count() >= committedAlbums.count());
+            QCOMPARE(oneTrackDuringImport.databaseId(), committedTracks.first().databaseId());
+            QCOMPARE(oneTrackDuringImport.title(), committedTracks.first().title());
+        }
+
+        QCOMPARE(int(tracksCountOnGenresAdded), committedTracks.count() + importTracks.count());
+
+        auto tracksAfterImport = DataTypes::ListTrackDataType{};
+
+        QMetaObject::invokeMethod(&musicDbReader, [&]() {
+            tracksAfterImport = musicDbReader.allTracksData();
+        }, Qt::BlockingQueuedConnection);
+
+        QCOMPARE(tracksAfterImport.count(), committedTracks.count() + importTracks.count());
+
+        writerThread.quit();
+        writerThread.wait();
+        readerThread.quit();
+        readerThread.wait();
+
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+        QCOMPARE(musicDbReaderDatabaseErrorSpy.count(), 0);
+    }
 };
 
 QTEST_GUILESS_MAIN(DatabaseInterfaceTests)
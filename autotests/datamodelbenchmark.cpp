@@ -0,0 +1,295 @@
+/*
+ * Copyright 2026 The Elisa developers
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "datatypes.h"
+#include "models/datamodel.h"
+
+#include <QObject>
+#include <QUrl>
+#include <QString>
+#include <QList>
+#include <QMap>
+#include <QTime>
+#include <QDateTime>
+#include <QElapsedTimer>
+
+#include <QDebug>
+
+#include <QtTest>
+
+#include <algorithm>
+#include <cstdlib>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+class DataModelBenchmark: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit DataModelBenchmark(QObject *aParent = nullptr) : QObject(aParent)
+    {
+    }
+
+private:
+
+    /**
+     * Storage used by DataModel before the compact track record.
+     */
+    using MapTrackDataType = QMap<DataTypes::ColumnsRoles, QVariant>;
+
+    static const int TracksCount = 100000;
+
+    static const int ModifiedTracksCount = 10000;
+
+    static qint64 allocatedBytes()
+    {
+#if defined(__GLIBC__)
+#if __GLIBC_PREREQ(2, 33)
+        return static_cast<qint64>(mallinfo2().uordblks);
+#else
+        return static_cast<qint64>(mallinfo().uordblks);
+#endif
+#else
+        return 0;
+#endif
+    }
+
+    static QList<int> displayedRoles()
+    {
+        return {DataTypes::TitleRole, DataTypes::ArtistRole, DataTypes::AlbumRole, DataTypes::AlbumArtistRole,
+                DataTypes::TrackNumberRole, DataTypes::DiscNumberRole, DataTypes::ImageUrlRole,
+                DataTypes::ResourceRole, DataTypes::DatabaseIdRole, DataTypes::RatingRole};
+    }
+
+    static DataTypes::TrackDataType generateTrack(int trackIndex)
+    {
+        const auto albumIndex = trackIndex / 12;
+        const auto artistIndex = albumIndex / 4;
+
+        const auto artistName = QStringLiteral("artist%1").arg(artistIndex);
+        const auto albumName = QStringLiteral("album%1").arg(albumIndex);
+        const auto fileName = QStringLiteral("/benchmark/%1/%2/track%3.ogg").arg(artistName, albumName).arg(trackIndex);
+
+        auto result = DataTypes::TrackDataType{true, QString::number(trackIndex), QStringLiteral("0"), QStringLiteral("track%1").arg(trackIndex),
+                artistName, albumName, artistName,
+                trackIndex % 12 + 1, 1, QTime::fromMSecsSinceStartOfDay(180000 + trackIndex), QUrl::fromLocalFile(fileName),
+                QDateTime::fromMSecsSinceEpoch(trackIndex),
+                {}, 0, true,
+                QStringLiteral("genre%1").arg(artistIndex % 25), QStringLiteral("composer%1").arg(artistIndex % 60),
+                QStringLiteral("lyricist%1").arg(artistIndex % 40), false};
+
+        result[DataTypes::DatabaseIdRole] = static_cast<qulonglong>(trackIndex + 1);
+        result[DataTypes::AlbumIdRole] = static_cast<qulonglong>(albumIndex + 1);
+
+        return result;
+    }
+
+    static MapTrackDataType generateMapTrack(int trackIndex)
+    {
+        auto result = MapTrackDataType{};
+
+        const auto oneTrack = generateTrack(trackIndex);
+        for (auto itData = oneTrack.begin(); itData != oneTrack.end(); ++itData) {
+            result[itData.key()] = itData.value();
+        }
+
+        return result;
+    }
+
+    static void report(const char *representation, qint64 loadMilliseconds, qint64 readMilliseconds, qint64 usedBytes)
+    {
+        qInfo() << "DataModelBenchmark" << representation << TracksCount << "tracks loaded in" << loadMilliseconds << "ms,"
+                << "all rows read in" << readMilliseconds << "ms," << (usedBytes / 1024) << "KiB"
+                << (usedBytes / TracksCount) << "bytes per track";
+    }
+
+    static void loadTracks(DataModel &tracksModel)
+    {
+        tracksModel.initialize(nullptr, nullptr, ElisaUtils::Track, ElisaUtils::NoFilter, {}, {}, 0);
+
+        auto newTracks = DataTypes::ListTrackDataType{};
+        newTracks.reserve(TracksCount);
+        for (int trackIndex = 0; trackIndex < TracksCount; ++trackIndex) {
+            newTracks.push_back(generateTrack(trackIndex));
+        }
+
+        tracksModel.tracksAdded(newTracks);
+    }
+
+    // modified tracks are spread over the whole model
+    static int modifiedTrackIndex(int modificationIndex)
+    {
+        return (modificationIndex * (TracksCount / ModifiedTracksCount) + modificationIndex % 7) % TracksCount;
+    }
+
+private Q_SLOTS:
+
+    void initTestCase()
+    {
+        qRegisterMetaType<DataTypes::ListTrackDataType>("ListTrackDataType");
+        qRegisterMetaType<DataTypes::TrackDataType>("TrackDataType");
+    }
+
+    void benchmarkLoadTracksInDataModel()
+    {
+        QBENCHMARK_ONCE {
+            const auto bytesBefore = allocatedBytes();
+
+            QElapsedTimer loadTimer;
+            loadTimer.start();
+
+            DataModel tracksModel;
+            tracksModel.initialize(nullptr, nullptr, ElisaUtils::Track, ElisaUtils::NoFilter, {}, {}, 0);
+
+            {
+                auto newTracks = DataTypes::ListTrackDataType{};
+                newTracks.reserve(TracksCount);
+                for (int trackIndex = 0; trackIndex < TracksCount; ++trackIndex) {
+                    newTracks.push_back(generateTrack(trackIndex));
+                }
+
+                tracksModel.tracksAdded(newTracks);
+            }
+
+            const auto loadMilliseconds = loadTimer.elapsed();
+            const auto usedBytes = allocatedBytes() - bytesBefore;
+
+            QCOMPARE(tracksModel.rowCount(), TracksCount);
+
+            QElapsedTimer readTimer;
+            readTimer.start();
+
+            const auto allRoles = displayedRoles();
+            auto validValues = 0;
+            for (int row = 0; row < TracksCount; ++row) {
+                const auto currentIndex = tracksModel.index(row, 0);
+                for (auto role : allRoles) {
+                    validValues += tracksModel.data(currentIndex, role).isValid() ? 1 : 0;
+                }
+            }
+
+            report("compact TrackDataType", loadMilliseconds, readTimer.elapsed(), usedBytes);
+
+            QVERIFY(validValues > 0);
+        }
+    }
+
+    void benchmarkModifyTracksInDataModel()
+    {
+        DataModel tracksModel;
+        loadTracks(tracksModel);
+
+        QSignalSpy dataChangedSpy(&tracksModel, &DataModel::dataChanged);
+
+        auto modifiedTracks = DataTypes::ListTrackDataType{};
+        modifiedTracks.reserve(ModifiedTracksCount);
+        for (int modificationIndex = 0; modificationIndex < ModifiedTracksCount; ++modificationIndex) {
+            auto oneTrack = generateTrack(modifiedTrackIndex(modificationIndex));
+            oneTrack[DataTypes::RatingRole] = 8;
+            modifiedTracks.push_back(oneTrack);
+        }
+
+        QBENCHMARK_ONCE {
+            QElapsedTimer modifyTimer;
+            modifyTimer.start();
+
+            for (const auto &oneTrack : qAsConst(modifiedTracks)) {
+                tracksModel.trackModified(oneTrack);
+            }
+
+            qInfo() << "DataModelBenchmark" << ModifiedTracksCount << "tracks modified one by one in a model of"
+                    << TracksCount << "tracks in" << modifyTimer.elapsed() << "ms";
+        }
+
+        QCOMPARE(dataChangedSpy.count(), ModifiedTracksCount);
+        QCOMPARE(tracksModel.data(tracksModel.index(modifiedTrackIndex(42), 0), DataTypes::RatingRole).toInt(), 8);
+    }
+
+    void benchmarkApplyTracksChangeSetInDataModel()
+    {
+        DataModel tracksModel;
+        loadTracks(tracksModel);
+
+        QSignalSpy dataChangedSpy(&tracksModel, &DataModel::dataChanged);
+
+        auto changes = DataTypes::TracksChangeSet{};
+        changes.mTracksChanges.reserve(ModifiedTracksCount);
+        for (int modificationIndex = 0; modificationIndex < ModifiedTracksCount; ++modificationIndex) {
+            changes.mTracksChanges.push_back({{DataTypes::DatabaseIdRole, static_cast<qulonglong>(modifiedTrackIndex(modificationIndex) + 1)},
+                                              {DataTypes::RatingRole, 8}});
+        }
+
+        QBENCHMARK_ONCE {
+            QElapsedTimer modifyTimer;
+            modifyTimer.start();
+
+            tracksModel.tracksChanged(changes);
+
+            qInfo() << "DataModelBenchmark" << ModifiedTracksCount << "tracks modified by one change set in a model of"
+                    << TracksCount << "tracks in" << modifyTimer.elapsed() << "ms";
+        }
+
+        QVERIFY(dataChangedSpy.count() <= ModifiedTracksCount);
+        QCOMPARE(tracksModel.data(tracksModel.index(modifiedTrackIndex(42), 0), DataTypes::RatingRole).toInt(), 8);
+    }
+
+    void benchmarkLoadTracksInMap()
+    {
+        QBENCHMARK_ONCE {
+            const auto bytesBefore = allocatedBytes();
+
+            QElapsedTimer loadTimer;
+            loadTimer.start();
+
+            auto allTracks = QList<MapTrackDataType>{};
+            allTracks.reserve(TracksCount);
+            for (int trackIndex = 0; trackIndex < TracksCount; ++trackIndex) {
+                allTracks.push_back(generateMapTrack(trackIndex));
+            }
+
+            const auto loadMilliseconds = loadTimer.elapsed();
+            const auto usedBytes = allocatedBytes() - bytesBefore;
+
+            QCOMPARE(allTracks.count(), TracksCount);
+
+            QElapsedTimer readTimer;
+            readTimer.start();
+
+            const auto allRoles = displayedRoles();
+            auto validValues = 0;
+            for (int row = 0; row < TracksCount; ++row) {
+                const auto &oneTrack = allTracks.at(row);
+                for (auto role : allRoles) {
+                    validValues += oneTrack.value(static_cast<DataTypes::ColumnsRoles>(role)).isValid() ? 1 : 0;
+                }
+            }
+
+            report("QMap", loadMilliseconds, readTimer.elapsed(), usedBytes);
+
+            QVERIFY(validValues > 0);
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(DataModelBenchmark)
+
+
+#include "datamodelbenchmark.moc"
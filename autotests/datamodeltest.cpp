@@ -25,6 +25,7 @@
 #include <QUrl>
 #include <QString>
 #include <QHash>
+#include <QSet>
 #include <QVector>
 #include <QThread>
 #include <QMetaObject>
@@ -37,6 +38,8 @@
 
 #include <QtTest>
 
+#include <algorithm>
+
 class DataModelTests: public QObject, public DatabaseTestData
 {
     Q_OBJECT
@@ -55,6 +58,7 @@ private Q_SLOTS:
         qRegisterMetaType<QHash<QString,QUrl>>("QHash<QString,QUrl>");
         qRegisterMetaType<QVector<qlonglong>>("QVector<qlonglong>");
         qRegisterMetaType<QHash<qlonglong,int>>("QHash<qlonglong,int>");
+        qRegisterMetaType<DataTypes::TracksChangeSet>("TracksChangeSet");
     }
 
     void removeOneTrack()
@@ -746,6 +750,73 @@ private Q_SLOTS:
         QCOMPARE(tracksModel.data(changedIndex, DataTypes::ColumnsRoles::RatingRole).toInt(), 5);
     }
 
+    void applyTracksChangeSetAllTracks()
+    {
+        DatabaseInterface musicDb;
+        DataModel tracksModel;
+        QAbstractItemModelTester testModel(&tracksModel);
+
+        connect(&musicDb, &DatabaseInterface::tracksAdded,
+                &tracksModel, &DataModel::tracksAdded);
+        connect(&musicDb, &DatabaseInterface::tracksChanged,
+                &tracksModel, &DataModel::tracksChanged);
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        QSignalSpy beginRemoveRowsSpy(&tracksModel, &DataModel::rowsAboutToBeRemoved);
+        QSignalSpy dataChangedSpy(&tracksModel, &DataModel::dataChanged);
+        QSignalSpy musicDbTracksChangedSpy(&musicDb, &DatabaseInterface::tracksChanged);
+
+        tracksModel.initialize(nullptr, nullptr, ElisaUtils::Track, ElisaUtils::NoFilter, {}, {}, 0);
+
+        musicDb.insertTracksList(mNewTracks, mNewCovers);
+
+        QCOMPARE(tracksModel.rowCount(), 23);
+        QCOMPARE(musicDbTracksChangedSpy.count(), 1);
+        QCOMPARE(dataChangedSpy.count(), 0);
+
+        auto firstTrack = mNewTracks[0];
+        auto secondTrack = mNewTracks[1];
+        firstTrack[DataTypes::RatingRole] = 9;
+        secondTrack[DataTypes::RatingRole] = 7;
+
+        musicDb.insertTracksList({firstTrack, secondTrack}, mNewCovers);
+
+        QCOMPARE(musicDbTracksChangedSpy.count(), 2);
+
+        const auto changes = musicDbTracksChangedSpy.constLast().constFirst().value<DataTypes::TracksChangeSet>();
+
+        QCOMPARE(changes.mInsertedTrackIds.count(), 0);
+        QCOMPARE(changes.mModifiedTracks.count() + changes.mTracksChanges.count(), 2);
+        QCOMPARE(changes.mRemovedTrackIds.count(), 0);
+
+        QCOMPARE(tracksModel.rowCount(), 23);
+        QCOMPARE(beginRemoveRowsSpy.count(), 0);
+        QVERIFY(dataChangedSpy.count() >= 1);
+        QVERIFY(dataChangedSpy.count() <= 2);
+
+        auto modifiedRatings = QList<int>{};
+        for (int row = 0; row < tracksModel.rowCount(); ++row) {
+            const auto currentIndex = tracksModel.index(row, 0);
+            const auto fileName = tracksModel.data(currentIndex, DataTypes::ResourceRole).toUrl();
+            if (fileName == firstTrack.resourceURI() || fileName == secondTrack.resourceURI()) {
+                modifiedRatings.push_back(tracksModel.data(currentIndex, DataTypes::RatingRole).toInt());
+            }
+        }
+        std::sort(modifiedRatings.begin(), modifiedRatings.end());
+
+        QCOMPARE(modifiedRatings, (QList<int>{7, 9}));
+
+        musicDb.removeTracksList({firstTrack.resourceURI(), secondTrack.resourceURI()});
+
+        QCOMPARE(musicDbTracksChangedSpy.count(), 3);
+        QCOMPARE(musicDbTracksChangedSpy.constLast().constFirst().value<DataTypes::TracksChangeSet>().mRemovedTrackIds.count(), 2);
+
+        QCOMPARE(tracksModel.rowCount(), 21);
+        QVERIFY(beginRemoveRowsSpy.count() >= 1);
+        QVERIFY(beginRemoveRowsSpy.count() <= 2);
+    }
+
     void addEmptyTracksListAllTracks()
     {
         DataModel tracksModel;
@@ -1583,6 +1654,122 @@ private Q_SLOTS:
         QCOMPARE(beginInsertRowsSpy.at(1).at(1).toInt(), 2);
         QCOMPARE(beginInsertRowsSpy.at(1).at(2).toInt(), 2);
     }
+
+    void loadAllTracksByPages()
+    {
+        DatabaseInterface musicDb;
+        DataModel tracksModel;
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        auto manyTracks = DataTypes::ListTrackDataType{};
+        for (int trackIndex = 0; trackIndex < 450; ++trackIndex) {
+            manyTracks.push_back({true, QStringLiteral("$%1").arg(trackIndex), QStringLiteral("0"), QStringLiteral("track%1").arg(trackIndex),
+                                  QStringLiteral("artist1"), QStringLiteral("album%1").arg(trackIndex / 10), QStringLiteral("artist1"),
+                                  trackIndex % 10 + 1, 1, QTime::fromMSecsSinceStartOfDay(trackIndex + 1),
+                                  {QUrl::fromLocalFile(QStringLiteral("/pages/$%1").arg(trackIndex))},
+                                  QDateTime::fromMSecsSinceEpoch(trackIndex), {}, 1, true,
+                                  {}, QStringLiteral("composer1"), QStringLiteral("lyricist1"), false});
+        }
+
+        musicDb.insertTracksList(manyTracks, mNewCovers);
+
+        QSignalSpy beginInsertRowsSpy(&tracksModel, &DataModel::rowsAboutToBeInserted);
+
+        tracksModel.initialize(nullptr, &musicDb, ElisaUtils::Track, ElisaUtils::NoFilter, {}, {}, 0);
+
+        QCOMPARE(tracksModel.rowCount(), 200);
+        QCOMPARE(beginInsertRowsSpy.count(), 1);
+        QVERIFY(tracksModel.canFetchMore({}));
+
+        tracksModel.fetchMore({});
+
+        QCOMPARE(tracksModel.rowCount(), 400);
+        QCOMPARE(beginInsertRowsSpy.count(), 2);
+        QVERIFY(tracksModel.canFetchMore({}));
+
+        tracksModel.fetchMore({});
+
+        QCOMPARE(tracksModel.rowCount(), 450);
+        QCOMPARE(beginInsertRowsSpy.count(), 3);
+        QVERIFY(!tracksModel.canFetchMore({}));
+
+        auto allIds = QSet<qulonglong>{};
+        for (int rowIndex = 0; rowIndex < tracksModel.rowCount(); ++rowIndex) {
+            allIds.insert(tracksModel.data(tracksModel.index(rowIndex, 0), DataTypes::DatabaseIdRole).toULongLong());
+        }
+        QCOMPARE(allIds.count(), 450);
+
+        auto newTrack = DataTypes::TrackDataType{true, QStringLiteral("$450"), QStringLiteral("0"), QStringLiteral("track450"),
+                QStringLiteral("artist1"), QStringLiteral("album45"), QStringLiteral("artist1"),
+                1, 1, QTime::fromMSecsSinceStartOfDay(451), {QUrl::fromLocalFile(QStringLiteral("/pages/$450"))},
+                QDateTime::fromMSecsSinceEpoch(450), {}, 1, true,
+                {}, QStringLiteral("composer1"), QStringLiteral("lyricist1"), false};
+
+        musicDb.insertTracksList({newTrack}, mNewCovers);
+
+        QCOMPARE(tracksModel.rowCount(), 451);
+        QVERIFY(!tracksModel.canFetchMore({}));
+    }
+
+    void trackDataPackedRoles()
+    {
+        auto track = DataTypes::TrackDataType{};
+
+        track[DataTypes::DatabaseIdRole] = qulonglong(12);
+        track[DataTypes::TrackNumberRole] = 3;
+        track[DataTypes::IsSingleDiscAlbumRole] = true;
+        track[DataTypes::DurationRole] = QTime::fromMSecsSinceStartOfDay(123456);
+        track[DataTypes::YearRole] = QStringLiteral("2019");
+        track[DataTypes::TitleRole] = QStringLiteral("title");
+
+        QCOMPARE(track.count(), 6);
+        QCOMPARE(track.databaseId(), qulonglong(12));
+        QCOMPARE(track[DataTypes::DatabaseIdRole].userType(), static_cast<int>(QMetaType::ULongLong));
+        QCOMPARE(track.trackNumber(), 3);
+        QCOMPARE(track[DataTypes::TrackNumberRole].userType(), static_cast<int>(QMetaType::Int));
+        QCOMPARE(track.isSingleDiscAlbum(), true);
+        QCOMPARE(track.duration(), QTime::fromMSecsSinceStartOfDay(123456));
+        QCOMPARE(track[DataTypes::YearRole].userType(), static_cast<int>(QMetaType::QString));
+        QCOMPARE(track.year(), 2019);
+        QCOMPARE(track.title(), QStringLiteral("title"));
+
+        track[DataTypes::YearRole] = 2020;
+        QCOMPARE(track[DataTypes::YearRole].userType(), static_cast<int>(QMetaType::Int));
+        QCOMPARE(track.year(), 2020);
+
+        track[DataTypes::DurationRole] = QTime{};
+        QVERIFY(track.contains(DataTypes::DurationRole));
+        QVERIFY(!track.duration().isValid());
+
+        QVERIFY(!track[DataTypes::AlbumRole].isValid());
+        QVERIFY(!track.contains(DataTypes::AlbumRole));
+
+        QCOMPARE(track.remove(DataTypes::TitleRole), 1);
+        QVERIFY(!track.contains(DataTypes::TitleRole));
+        QCOMPARE(track.count(), 5);
+
+        auto copy = track;
+        copy[DataTypes::TrackNumberRole] = 4;
+        QCOMPARE(track.trackNumber(), 3);
+        QVERIFY(copy != track);
+        copy[DataTypes::TrackNumberRole] = 3;
+        QVERIFY(copy == track);
+    }
+
+    void trackDataInternedRoles()
+    {
+        auto firstTrack = DataTypes::TrackDataType{};
+        auto secondTrack = DataTypes::TrackDataType{};
+
+        firstTrack[DataTypes::ArtistRole] = QStringLiteral("artist%1").arg(1);
+        secondTrack[DataTypes::ArtistRole] = QStringLiteral("artist%1").arg(1);
+        firstTrack[DataTypes::CommentRole] = QStringLiteral("comment%1").arg(1);
+        secondTrack[DataTypes::CommentRole] = QStringLiteral("comment%1").arg(1);
+
+        QCOMPARE(firstTrack.artist().constData(), secondTrack.artist().constData());
+        QVERIFY(firstTrack.comment().constData() != secondTrack.comment().constData());
+    }
 };
 
 QTEST_GUILESS_MAIN(DataModelTests)
@@ -0,0 +1,93 @@
+/*
+ * Copyright 2026 The Elisa developers
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "abstractfile/directorylister.h"
+
+#include "config-upnp-qt.h"
+
+#include <QObject>
+#include <QString>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+#include <QDebug>
+
+#include <QtTest>
+
+class DirectoryListerTest: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit DirectoryListerTest(QObject *aParent = nullptr) : QObject(aParent)
+    {
+    }
+
+private Q_SLOTS:
+
+    void listLikeQDir()
+    {
+        QTemporaryDir rootDirectory;
+        QVERIFY(rootDirectory.isValid());
+
+        const auto musicDirectory = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music");
+        QVERIFY(QDir().mkpath(rootDirectory.filePath(QStringLiteral("Album"))));
+        QVERIFY(QFile::copy(musicDirectory + QStringLiteral("/test.ogg"), rootDirectory.filePath(QStringLiteral("b.ogg"))));
+        QVERIFY(QFile::copy(musicDirectory + QStringLiteral("/cover.jpg"), rootDirectory.filePath(QStringLiteral("A.jpg"))));
+        QVERIFY(QFile::copy(musicDirectory + QStringLiteral("/test.mp3"), rootDirectory.filePath(QStringLiteral(".hidden.mp3"))));
+        QVERIFY(QFile::link(rootDirectory.filePath(QStringLiteral("b.ogg")), rootDirectory.filePath(QStringLiteral("c.ogg"))));
+
+        const auto lister = DirectoryLister::create(DirectoryLister::Backend::Automatic);
+        const auto entries = lister->entries(rootDirectory.path());
+
+        QDirDirectoryLister qDirLister;
+        const auto qDirEntries = qDirLister.entries(rootDirectory.path());
+
+        QCOMPARE(entries.size(), 4);
+        QCOMPARE(qDirEntries.size(), 4);
+
+        for (int i = 0; i < entries.size(); ++i) {
+            QCOMPARE(entries[i].mFileName, qDirEntries[i].mFileName);
+            QCOMPARE(entries[i].mCanonicalFilePath, qDirEntries[i].mCanonicalFilePath);
+            QCOMPARE(entries[i].isDir(), qDirEntries[i].isDir());
+            QCOMPARE(entries[i].mMetadataChangeTime, qDirEntries[i].mMetadataChangeTime);
+            QCOMPARE(entries[i].mModificationTime, qDirEntries[i].mModificationTime);
+
+            if (entries[i].isFile()) {
+                QCOMPARE(entries[i].mSize, qDirEntries[i].mSize);
+                QCOMPARE(entries[i].mInode, qDirEntries[i].mInode);
+            }
+        }
+
+        QCOMPARE(entries[0].mFileName, QStringLiteral("A.jpg"));
+        QCOMPARE(entries[1].mFileName, QStringLiteral("Album"));
+        QVERIFY(entries[1].isDir());
+        QCOMPARE(entries[2].mFileName, QStringLiteral("b.ogg"));
+        QCOMPARE(entries[3].mFileName, QStringLiteral("c.ogg"));
+
+        // symbolic links are resolved
+        QCOMPARE(entries[3].mCanonicalFilePath, QFileInfo(rootDirectory.filePath(QStringLiteral("b.ogg"))).canonicalFilePath());
+    }
+};
+
+QTEST_GUILESS_MAIN(DirectoryListerTest)
+
+
+#include "directorylistertest.moc"
@@ -0,0 +1,160 @@
+/*
+ * Copyright 2026 The Elisa developers
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "config-upnp-qt.h"
+
+#include <QObject>
+#include <QString>
+#include <QDir>
+#include <QFile>
+#include <QProcess>
+#include <QProcessEnvironment>
+#include <QTemporaryDir>
+#include <QElapsedTimer>
+
+#include <QDebug>
+
+#include <QtTest>
+
+/**
+ * Import a synthetic collection with elisaImport, then start it again on the
+ * same unchanged collection.
+ *
+ * The number of artists can be raised with ELISA_IMPORT_BENCHMARK_ARTISTS:
+ * each artist has 10 albums of 10 tracks.
+ */
+class ElisaImportBenchmark: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit ElisaImportBenchmark(QObject *aParent = nullptr) : QObject(aParent)
+    {
+    }
+
+private:
+
+    static const int AlbumsPerArtist = 10;
+
+    static const int TracksPerAlbum = 10;
+
+    static int createCollection(const QString &rootPath, int artistsCount)
+    {
+        const auto sampleFile = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music/test.ogg");
+
+        auto filesCount = 0;
+        for (int artistIndex = 0; artistIndex < artistsCount; ++artistIndex) {
+            for (int albumIndex = 0; albumIndex < AlbumsPerArtist; ++albumIndex) {
+                const auto albumPath = QStringLiteral("%1/artist%2/album%3").arg(rootPath).arg(artistIndex).arg(albumIndex);
+                if (!QDir().mkpath(albumPath)) {
+                    return -1;
+                }
+
+                for (int trackIndex = 0; trackIndex < TracksPerAlbum; ++trackIndex) {
+                    if (!QFile::copy(sampleFile, QStringLiteral("%1/track%2.ogg").arg(albumPath).arg(trackIndex))) {
+                        return -1;
+                    }
+                    ++filesCount;
+                }
+            }
+        }
+
+        return filesCount;
+    }
+
+    static qint64 runImport(const QProcessEnvironment &environment)
+    {
+        QProcess importProcess;
+        importProcess.setProcessEnvironment(environment);
+        importProcess.setProcessChannelMode(QProcess::ForwardedErrorChannel);
+
+        QElapsedTimer importTimer;
+        importTimer.start();
+
+        importProcess.start(QStringLiteral(ELISA_IMPORT_EXECUTABLE), QStringList{});
+        if (!importProcess.waitForFinished(30 * 60 * 1000) || importProcess.exitStatus() != QProcess::NormalExit ||
+                importProcess.exitCode() != 0) {
+            return -1;
+        }
+
+        return importTimer.elapsed();
+    }
+
+    QTemporaryDir mWorkingDirectory;
+
+    QProcessEnvironment mEnvironment;
+
+    int mFilesCount = 0;
+
+private Q_SLOTS:
+
+    void initTestCase()
+    {
+        auto artistsCount = qEnvironmentVariableIntValue("ELISA_IMPORT_BENCHMARK_ARTISTS");
+        if (artistsCount <= 0) {
+            artistsCount = 20;
+        }
+
+        QVERIFY(mWorkingDirectory.isValid());
+
+        const auto musicPath = mWorkingDirectory.filePath(QStringLiteral("music"));
+        const auto configPath = mWorkingDirectory.filePath(QStringLiteral("config"));
+        const auto dataPath = mWorkingDirectory.filePath(QStringLiteral("data"));
+
+        QVERIFY(QDir().mkpath(configPath));
+        QVERIFY(QDir().mkpath(dataPath));
+
+        mFilesCount = createCollection(musicPath, artistsCount);
+        QVERIFY(mFilesCount > 0);
+
+        QFile configurationFile(configPath + QStringLiteral("/elisarc"));
+        QVERIFY(configurationFile.open(QIODevice::WriteOnly));
+        configurationFile.write(QStringLiteral("[ElisaFileIndexer]\nRootPath=%1/\n").arg(musicPath).toUtf8());
+        configurationFile.close();
+
+        mEnvironment = QProcessEnvironment::systemEnvironment();
+        mEnvironment.insert(QStringLiteral("XDG_CONFIG_HOME"), configPath);
+        mEnvironment.insert(QStringLiteral("XDG_DATA_HOME"), dataPath);
+    }
+
+    void benchmarkFirstImport()
+    {
+        const auto firstImportMilliseconds = runImport(mEnvironment);
+        QVERIFY(firstImportMilliseconds >= 0);
+
+        QTest::setBenchmarkResult(firstImportMilliseconds, QTest::WalltimeMilliseconds);
+
+        qInfo() << "ElisaImportBenchmark" << mFilesCount << "files imported in" << firstImportMilliseconds << "ms";
+    }
+
+    // needs the database written by benchmarkFirstImport
+    void benchmarkRestartWithoutChange()
+    {
+        const auto restartMilliseconds = runImport(mEnvironment);
+        QVERIFY(restartMilliseconds >= 0);
+
+        QTest::setBenchmarkResult(restartMilliseconds, QTest::WalltimeMilliseconds);
+
+        qInfo() << "ElisaImportBenchmark" << mFilesCount << "files unchanged, restart in" << restartMilliseconds << "ms";
+    }
+};
+
+QTEST_GUILESS_MAIN(ElisaImportBenchmark)
+
+
+#include "elisaimportbenchmark.moc"
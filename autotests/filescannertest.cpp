@@ -16,6 +16,7 @@
  */
 
 #include "filescanner.h"
+#include "filescannerpool.h"
 #include "config-upnp-qt.h"
 
 #include <QObject>
@@ -23,6 +24,9 @@
 #include <QUrl>
 #include <QDateTime>
 #include <QTime>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
 
 #include <QDebug>
 
@@ -93,6 +97,59 @@ private Q_SLOTS:
         QVERIFY(!fileScanner.searchForCoverFile(mTestTracksForDirectory.at(8)).isEmpty());
     }
 
+    void findCoverFromDirectoryListing()
+    {
+        QTemporaryDir rootDirectory;
+        QVERIFY(rootDirectory.isValid());
+
+        const auto albumDirectory = rootDirectory.filePath(QStringLiteral("album"));
+        QVERIFY(QDir().mkpath(albumDirectory));
+
+        const auto trackFile = albumDirectory + QStringLiteral("/track.ogg");
+        const auto coverFile = albumDirectory + QStringLiteral("/Cover.jpg");
+
+        FileScanner fileScanner;
+
+        // the listing is reused until the directory cover is invalidated
+        fileScanner.addDirectoryEntries(albumDirectory, QDir(albumDirectory).entryList(QDir::Files));
+        QVERIFY(fileScanner.searchForCoverFile(trackFile).isEmpty());
+
+        QFile newCover(coverFile);
+        QVERIFY(newCover.open(QIODevice::WriteOnly));
+        newCover.close();
+
+        QVERIFY(fileScanner.searchForCoverFile(trackFile).isEmpty());
+
+        fileScanner.invalidateDirectoryCover(albumDirectory);
+        QCOMPARE(fileScanner.searchForCoverFile(trackFile), QUrl::fromLocalFile(coverFile));
+
+        QVERIFY(QFile::remove(coverFile));
+        fileScanner.addDirectoryEntries(albumDirectory, QDir(albumDirectory).entryList(QDir::Files));
+        QVERIFY(fileScanner.searchForCoverFile(trackFile).isEmpty());
+    }
+
+    void skipSniffingForKnownExtensions()
+    {
+        FileScanner fileScanner;
+
+        QVERIFY(fileScanner.shouldScanFile(QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music/test.mp3")));
+        QVERIFY(!fileScanner.shouldScanFile(QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music/cover.jpg")));
+
+        QCOMPARE(fileScanner.sniffedFilesCount(), qulonglong(0));
+        QCOMPARE(fileScanner.skippedSniffingFilesCount(), qulonglong(2));
+
+        QTemporaryDir rootDirectory;
+        QVERIFY(rootDirectory.isValid());
+
+        const auto fileWithoutExtension = rootDirectory.filePath(QStringLiteral("test"));
+        QVERIFY(QFile::copy(QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music/test.mp3"), fileWithoutExtension));
+
+        QVERIFY(fileScanner.shouldScanFile(fileWithoutExtension));
+
+        QCOMPARE(fileScanner.sniffedFilesCount(), qulonglong(1));
+        QCOMPARE(fileScanner.skippedSniffingFilesCount(), qulonglong(2));
+    }
+
     void loadCoverFromMetaData()
     {
         FileScanner fileScanner;
@@ -101,6 +158,64 @@ private Q_SLOTS:
         QVERIFY(fileScanner.checkEmbeddedCoverImage(mTestTracksForMetaData.at(2)));
     }
 
+    void detectCoverWhileScanningMetaData()
+    {
+        FileScanner fileScanner;
+
+        for (const auto &oneTrack : qAsConst(mTestTracksForMetaData)) {
+            const auto scannedTrack = fileScanner.scanOneFile(QUrl::fromLocalFile(oneTrack));
+
+            QVERIFY(scannedTrack.isValid());
+            if (scannedTrack.contains(DataTypes::HasEmbeddedCover)) {
+                QVERIFY(scannedTrack.hasEmbeddedCover());
+            }
+        }
+    }
+
+    void scanFilesWithPoolInOrder()
+    {
+        FileScannerPool scannerPool(4);
+
+        const auto directory = QUrl::fromLocalFile(QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music"));
+        const QList<QUrl> allFiles = {
+            QUrl::fromLocalFile(QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music/test.ogg")),
+            QUrl::fromLocalFile(QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music/testMultiple.ogg")),
+            QUrl::fromLocalFile(QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music/testMany.ogg")),
+        };
+        const auto modificationTime = QDateTime::fromMSecsSinceEpoch(1000);
+
+        auto scheduledFiles = QList<QUrl>{};
+        auto scannedFiles = QList<QUrl>{};
+        for (int i = 0; i < 30; ++i) {
+            while (scannerPool.isFull()) {
+                const auto result = scannerPool.takeNextResult();
+                QVERIFY(result.mTrack.isValid());
+                QCOMPARE(result.mTrack.resourceURI(), result.mFileName);
+                QCOMPARE(result.mTrack.fileModificationTime(), modificationTime);
+                QCOMPARE(result.mDirectory, directory);
+                scannedFiles.push_back(result.mFileName);
+            }
+
+            scheduledFiles.push_back(allFiles.at(i % allFiles.size()));
+            scannerPool.scheduleFile(scheduledFiles.last(), directory, modificationTime);
+        }
+
+        while (scannerPool.hasPendingResults()) {
+            scannedFiles.push_back(scannerPool.takeNextResult().mFileName);
+        }
+
+        QCOMPARE(scannedFiles, scheduledFiles);
+
+        scannerPool.scheduleFile(allFiles.at(0), directory, modificationTime);
+        scannerPool.scheduleFile(allFiles.at(1), directory, modificationTime);
+        scannerPool.cancel();
+
+        QVERIFY(!scannerPool.hasPendingResults());
+
+        scannerPool.scheduleFile(allFiles.at(2), directory, modificationTime);
+        QCOMPARE(scannerPool.takeNextResult().mFileName, allFiles.at(2));
+    }
+
     void benchmarkFileScan()
     {
         FileScanner fileScanner;
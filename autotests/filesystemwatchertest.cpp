@@ -0,0 +1,166 @@
+/*
+ * Copyright 2026 The Elisa developers
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "abstractfile/inotifyfilesystemwatcher.h"
+
+#include <QObject>
+#include <QString>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <QDebug>
+
+#include <QtTest>
+
+class FileSystemWatcherTest: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit FileSystemWatcherTest(QObject *aParent = nullptr) : QObject(aParent)
+    {
+    }
+
+private:
+
+    static bool writeFile(const QString &fileName, const QByteArray &content)
+    {
+        QFile newFile(fileName);
+        if (!newFile.open(QIODevice::WriteOnly)) {
+            return false;
+        }
+
+        return newFile.write(content) == content.size();
+    }
+
+private Q_SLOTS:
+
+    void coalesceDirectoryChanges()
+    {
+        QTemporaryDir rootDirectory;
+        QVERIFY(rootDirectory.isValid());
+
+        InotifyFileSystemWatcher watcher;
+        QVERIFY(watcher.isValid());
+
+        QSignalSpy directoryChangedSpy(&watcher, &FileSystemWatcher::directoryChanged);
+        QSignalSpy fileChangedSpy(&watcher, &FileSystemWatcher::fileChanged);
+
+        QVERIFY(watcher.addDirectory(rootDirectory.path()));
+
+        for (int i = 0; i < 20; ++i) {
+            QVERIFY(writeFile(rootDirectory.filePath(QStringLiteral("track%1.ogg").arg(i)), QByteArrayLiteral("data")));
+        }
+
+        QVERIFY(directoryChangedSpy.wait());
+        QTest::qWait(500);
+
+        QCOMPARE(directoryChangedSpy.count(), 1);
+        QCOMPARE(directoryChangedSpy.at(0).at(0).toString(), rootDirectory.path());
+
+        // new files are reported by their directory
+        QCOMPARE(fileChangedSpy.count(), 0);
+    }
+
+    void reportModifiedWatchedFiles()
+    {
+        QTemporaryDir rootDirectory;
+        QVERIFY(rootDirectory.isValid());
+
+        const auto watchedFile = rootDirectory.filePath(QStringLiteral("watched.ogg"));
+        const auto otherFile = rootDirectory.filePath(QStringLiteral("other.ogg"));
+        QVERIFY(writeFile(watchedFile, QByteArrayLiteral("data")));
+        QVERIFY(writeFile(otherFile, QByteArrayLiteral("data")));
+
+        InotifyFileSystemWatcher watcher;
+        QVERIFY(watcher.isValid());
+
+        QSignalSpy directoryChangedSpy(&watcher, &FileSystemWatcher::directoryChanged);
+        QSignalSpy fileChangedSpy(&watcher, &FileSystemWatcher::fileChanged);
+
+        QVERIFY(watcher.addDirectory(rootDirectory.path()));
+        QVERIFY(watcher.addFile(watchedFile));
+
+        QVERIFY(writeFile(otherFile, QByteArrayLiteral("new data")));
+        QVERIFY(writeFile(watchedFile, QByteArrayLiteral("new data")));
+
+        QVERIFY(fileChangedSpy.wait());
+
+        QCOMPARE(fileChangedSpy.count(), 1);
+        QCOMPARE(fileChangedSpy.at(0).at(0).toString(), watchedFile);
+        QCOMPARE(directoryChangedSpy.count(), 0);
+    }
+
+    void renameFileAndDirectory()
+    {
+        QTemporaryDir rootDirectory;
+        QVERIFY(rootDirectory.isValid());
+
+        const auto albumDirectory = rootDirectory.filePath(QStringLiteral("album"));
+        const auto renamedAlbumDirectory = rootDirectory.filePath(QStringLiteral("renamed album"));
+        const auto trackFile = albumDirectory + QStringLiteral("/track.ogg");
+        const auto renamedTrackFile = albumDirectory + QStringLiteral("/renamed track.ogg");
+
+        QVERIFY(QDir().mkpath(albumDirectory));
+        QVERIFY(writeFile(trackFile, QByteArrayLiteral("data")));
+
+        InotifyFileSystemWatcher watcher;
+        QVERIFY(watcher.isValid());
+
+        QSignalSpy directoryChangedSpy(&watcher, &FileSystemWatcher::directoryChanged);
+        QSignalSpy fileChangedSpy(&watcher, &FileSystemWatcher::fileChanged);
+        QSignalSpy pathRenamedSpy(&watcher, &FileSystemWatcher::pathRenamed);
+
+        QVERIFY(watcher.addDirectory(rootDirectory.path()));
+        QVERIFY(watcher.addDirectory(albumDirectory));
+        QVERIFY(watcher.addFile(trackFile));
+
+        QVERIFY(QFile::rename(trackFile, renamedTrackFile));
+
+        QVERIFY(pathRenamedSpy.wait());
+
+        QCOMPARE(pathRenamedSpy.count(), 1);
+        QCOMPARE(pathRenamedSpy.at(0).at(0).toString(), trackFile);
+        QCOMPARE(pathRenamedSpy.at(0).at(1).toString(), renamedTrackFile);
+        QCOMPARE(directoryChangedSpy.count(), 0);
+
+        QVERIFY(QDir().rename(albumDirectory, renamedAlbumDirectory));
+
+        QVERIFY(pathRenamedSpy.wait());
+
+        QCOMPARE(pathRenamedSpy.count(), 2);
+        QCOMPARE(pathRenamedSpy.at(1).at(0).toString(), albumDirectory);
+        QCOMPARE(pathRenamedSpy.at(1).at(1).toString(), renamedAlbumDirectory);
+        QCOMPARE(directoryChangedSpy.count(), 0);
+
+        // the watch of the directory follows the rename
+        const auto movedTrackFile = renamedAlbumDirectory + QStringLiteral("/renamed track.ogg");
+        QVERIFY(writeFile(movedTrackFile, QByteArrayLiteral("new data")));
+
+        QVERIFY(fileChangedSpy.wait());
+
+        QCOMPARE(fileChangedSpy.count(), 1);
+        QCOMPARE(fileChangedSpy.at(0).at(0).toString(), movedTrackFile);
+    }
+};
+
+QTEST_GUILESS_MAIN(FileSystemWatcherTest)
+
+
+#include "filesystemwatchertest.moc"
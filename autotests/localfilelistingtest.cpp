@@ -59,6 +59,8 @@ private Q_SLOTS:
         qRegisterMetaType<QVector<qlonglong>>("QVector<qlonglong>");
         qRegisterMetaType<QHash<qlonglong,int>>("QHash<qlonglong,int>");
         qRegisterMetaType<QList<QUrl>>("QList<QUrl>");
+        qRegisterMetaType<DataTypes::ListDirectoryScanData>("ListDirectoryScanData");
+        qRegisterMetaType<DataTypes::ListRenamedFileData>("DataTypes::ListRenamedFileData");
     }
 
     void initialTestWithNoTrack()
@@ -128,6 +130,62 @@ private Q_SLOTS:
         QCOMPARE(newCovers.count(), 5);
     }
 
+    void skipUnchangedDirectories()
+    {
+        QString musicPath = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music");
+
+        auto scannedDirectories = DataTypes::ListDirectoryScanData{};
+        auto allFiles = QHash<QUrl, QDateTime>{};
+
+        {
+            LocalFileListing myListing;
+
+            QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+            QSignalSpy scannedDirectoriesListSpy(&myListing, &LocalFileListing::scannedDirectoriesList);
+
+            myListing.init();
+            myListing.setAllRootPaths({musicPath});
+            myListing.refreshContent();
+
+            // the directory is recorded with its last tracks
+            QCOMPARE(scannedDirectoriesListSpy.count(), 0);
+
+            for (const auto &oneSignal : tracksListSpy) {
+                scannedDirectories += oneSignal.at(2).value<DataTypes::ListDirectoryScanData>();
+            }
+
+            QCOMPARE(scannedDirectories.count(), 1);
+            QCOMPARE(scannedDirectories.at(0).mDirectory, QUrl::fromLocalFile(musicPath));
+            QVERIFY(scannedDirectories.at(0).mModificationTime.isValid());
+            QVERIFY(scannedDirectories.at(0).mEntriesCount > 0);
+            QVERIFY(!scannedDirectories.at(0).mContentHash.isEmpty());
+
+            for (const auto &oneSignal : tracksListSpy) {
+                const auto newTracks = oneSignal.at(0).value<DataTypes::ListTrackDataType>();
+                for (const auto &oneTrack : newTracks) {
+                    allFiles[oneTrack.resourceURI()] = oneTrack.fileModificationTime();
+                }
+            }
+
+            QCOMPARE(allFiles.count(), 5);
+        }
+
+        LocalFileListing myListing;
+
+        QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+        QSignalSpy removedTracksListSpy(&myListing, &LocalFileListing::removedTracksList);
+        QSignalSpy scannedDirectoriesListSpy(&myListing, &LocalFileListing::scannedDirectoriesList);
+
+        myListing.init();
+        myListing.setAllRootPaths({musicPath});
+        myListing.restoredScannedDirectories(scannedDirectories);
+        myListing.restoredTracks(allFiles);
+
+        QCOMPARE(tracksListSpy.count(), 0);
+        QCOMPARE(removedTracksListSpy.count(), 0);
+        QCOMPARE(scannedDirectoriesListSpy.count(), 0);
+    }
+
     void addAndRemoveTracks()
     {
         LocalFileListing myListing;
@@ -420,6 +478,87 @@ private Q_SLOTS:
         QCOMPARE(newCoversLast.count(), 1);
     }
 
+    void renameDirectoryAfterRestart()
+    {
+        QString musicOriginPath = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music");
+
+        QString musicParentPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + QStringLiteral("/music4");
+        QDir musicParentDirectory(musicParentPath);
+
+        QString musicPath = musicParentPath + QStringLiteral("/album");
+        QString musicRenamedPath = musicParentPath + QStringLiteral("/renamedAlbum");
+
+        QCOMPARE(musicParentDirectory.removeRecursively(), true);
+        QCOMPARE(QDir().mkpath(musicPath), true);
+
+        QFile myTrack(musicOriginPath + QStringLiteral("/test.ogg"));
+        QCOMPARE(myTrack.copy(musicPath + QStringLiteral("/test.ogg")), true);
+
+        auto scannedDirectories = DataTypes::ListDirectoryScanData{};
+        auto allFiles = QHash<QUrl, QDateTime>{};
+
+        {
+            LocalFileListing myListing;
+
+            QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+            QSignalSpy scannedDirectoriesListSpy(&myListing, &LocalFileListing::scannedDirectoriesList);
+
+            myListing.init();
+            myListing.setAllRootPaths({musicParentPath});
+            myListing.refreshContent();
+
+            for (const auto &oneSignal : tracksListSpy) {
+                scannedDirectories += oneSignal.at(2).value<DataTypes::ListDirectoryScanData>();
+
+                const auto newTracks = oneSignal.at(0).value<DataTypes::ListTrackDataType>();
+                for (const auto &oneTrack : newTracks) {
+                    allFiles[oneTrack.resourceURI()] = oneTrack.fileModificationTime();
+                }
+            }
+            for (const auto &oneSignal : scannedDirectoriesListSpy) {
+                scannedDirectories += oneSignal.at(0).value<DataTypes::ListDirectoryScanData>();
+            }
+
+            QCOMPARE(allFiles.count(), 1);
+            QCOMPARE(scannedDirectories.count(), 2);
+        }
+
+        LocalFileListing myListing;
+
+        QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+        QSignalSpy removedTracksListSpy(&myListing, &LocalFileListing::removedTracksList);
+        QSignalSpy renamedTracksListSpy(&myListing, &LocalFileListing::renamedTracksList);
+        QSignalSpy errorWatchingFileSystemChangesSpy(&myListing, &LocalFileListing::errorWatchingFileSystemChanges);
+
+        myListing.init();
+        myListing.setAllRootPaths({musicParentPath});
+        myListing.restoredScannedDirectories(scannedDirectories);
+        myListing.restoredTracks(allFiles);
+
+        QCOMPARE(tracksListSpy.count(), 0);
+        QCOMPARE(removedTracksListSpy.count(), 0);
+        QCOMPARE(renamedTracksListSpy.count(), 0);
+
+        QCOMPARE(QDir().rename(musicPath, musicRenamedPath), true);
+
+        auto renamedFilesWorking = renamedTracksListSpy.wait();
+
+        if (!renamedFilesWorking && errorWatchingFileSystemChangesSpy.count()) {
+            QEXPECT_FAIL("", "Impossible watching file system for changes", Abort);
+        }
+        QCOMPARE(renamedFilesWorking, true);
+
+        QCOMPARE(tracksListSpy.count(), 0);
+        QCOMPARE(removedTracksListSpy.count(), 0);
+        QCOMPARE(renamedTracksListSpy.count(), 1);
+
+        const auto renamedFiles = renamedTracksListSpy.at(0).at(0).value<DataTypes::ListRenamedFileData>();
+
+        QCOMPARE(renamedFiles.count(), 1);
+        QCOMPARE(renamedFiles.at(0).mOldFileName, QUrl::fromLocalFile(musicPath + QStringLiteral("/test.ogg")));
+        QCOMPARE(renamedFiles.at(0).mNewFileName, QUrl::fromLocalFile(musicRenamedPath + QStringLiteral("/test.ogg")));
+    }
+
     void restoreRemovedTracks()
     {
         LocalFileListing myListing;
@@ -8932,6 +8932,67 @@ void ManageAudioPlayerTest::testRestorePlayListAndSettingsAutomaticPlay()
     QCOMPARE(skipNextTrackSpy.wait(300), true);
 }
 
+void ManageAudioPlayerTest::playPreparedNextTrack()
+{
+    ManageAudioPlayer myPlayer;
+    QStandardItemModel myPlayList;
+
+    QSignalSpy currentTrackChangedSpy(&myPlayer, &ManageAudioPlayer::currentTrackChanged);
+    QSignalSpy playerSourceChangedSpy(&myPlayer, &ManageAudioPlayer::playerSourceChanged);
+    QSignalSpy playerNextSourceChangedSpy(&myPlayer, &ManageAudioPlayer::playerNextSourceChanged);
+    QSignalSpy playerPlaySpy(&myPlayer, &ManageAudioPlayer::playerPlay);
+    QSignalSpy playerStopSpy(&myPlayer, &ManageAudioPlayer::playerStop);
+    QSignalSpy skipNextTrackSpy(&myPlayer, &ManageAudioPlayer::skipNextTrack);
+    QSignalSpy startedPlayingTrackSpy(&myPlayer, &ManageAudioPlayer::startedPlayingTrack);
+
+    myPlayList.appendRow(new QStandardItem);
+    myPlayList.appendRow(new QStandardItem);
+
+    myPlayList.item(0, 0)->setData(QUrl::fromUserInput(QStringLiteral("file:///1.mp3")), ManageAudioPlayerTest::ResourceRole);
+    myPlayList.item(1, 0)->setData(QUrl::fromUserInput(QStringLiteral("file:///2.mp3")), ManageAudioPlayerTest::ResourceRole);
+
+    myPlayer.setPlayListModel(&myPlayList);
+    myPlayer.setUrlRole(ManageAudioPlayerTest::ResourceRole);
+    myPlayer.setIsPlayingRole(ManageAudioPlayerTest::IsPlayingRole);
+
+    connect(&myPlayer, &ManageAudioPlayer::skipNextTrack, this, [&myPlayer, &myPlayList]() {
+        myPlayer.setCurrentTrack(myPlayList.index(1, 0));
+    });
+
+    myPlayer.setCurrentTrack(myPlayList.index(0, 0));
+    myPlayer.setNextTrack(myPlayList.index(1, 0));
+
+    QCOMPARE(playerSourceChangedSpy.count(), 1);
+    QCOMPARE(playerNextSourceChangedSpy.count(), 1);
+    QCOMPARE(playerNextSourceChangedSpy.at(0).at(0).toUrl(), QUrl::fromUserInput(QStringLiteral("file:///2.mp3")));
+
+    myPlayer.ensurePlay();
+
+    QCOMPARE(playerPlaySpy.wait(), true);
+
+    myPlayer.setPlayerStatus(QMediaPlayer::LoadedMedia);
+    myPlayer.setPlayerStatus(QMediaPlayer::BufferedMedia);
+    myPlayer.setPlayerPlaybackState(QMediaPlayer::PlayingState);
+
+    QCOMPARE(startedPlayingTrackSpy.count(), 1);
+    QCOMPARE(myPlayList.data(myPlayList.index(0, 0), ManageAudioPlayerTest::IsPlayingRole).toBool(), true);
+
+    // the player went on with the next track by itself
+    myPlayer.preparedSourceStarted(QUrl::fromUserInput(QStringLiteral("file:///2.mp3")));
+
+    QCOMPARE(skipNextTrackSpy.count(), 1);
+    QCOMPARE(currentTrackChangedSpy.count(), 2);
+    QCOMPARE(myPlayer.currentTrack(), QPersistentModelIndex(myPlayList.index(1, 0)));
+    QCOMPARE(playerSourceChangedSpy.count(), 1);
+    QCOMPARE(startedPlayingTrackSpy.count(), 2);
+    QCOMPARE(startedPlayingTrackSpy.at(1).at(0).toUrl(), QUrl::fromUserInput(QStringLiteral("file:///2.mp3")));
+    QCOMPARE(myPlayList.data(myPlayList.index(0, 0), ManageAudioPlayerTest::IsPlayingRole).toBool(), false);
+    QCOMPARE(myPlayList.data(myPlayList.index(1, 0), ManageAudioPlayerTest::IsPlayingRole).toBool(), true);
+
+    QCOMPARE(playerStopSpy.wait(300), false);
+    QCOMPARE(playerStopSpy.count(), 0);
+}
+
 QTEST_GUILESS_MAIN(ManageAudioPlayerTest)
 
 
@@ -90,6 +90,8 @@ private Q_SLOTS:
 
     void playSingleAndClearPlayListTrack();
 
+    void playPreparedNextTrack();
+
 };
 
 #endif // MANAGEAUDIOPLAYERTEST_H
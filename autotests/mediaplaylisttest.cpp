@@ -30,6 +30,7 @@
 #include <QUrl>
 #include <QTime>
 #include <QTemporaryFile>
+#include <QDataStream>
 #include <QAbstractItemModelTester>
 
 MediaPlayListTest::MediaPlayListTest(QObject *parent) : QObject(parent)
@@ -42,6 +43,8 @@ void MediaPlayListTest::initTestCase()
     qRegisterMetaType<QVector<qlonglong>>("QVector<qlonglong>");
     qRegisterMetaType<QHash<qlonglong,int>>("QHash<qlonglong,int>");
     qRegisterMetaType<ElisaUtils::PlayListEntryType>("PlayListEntryType");
+    qRegisterMetaType<QVector<qulonglong>>("QVector<qulonglong>");
+    qRegisterMetaType<TracksListener::TracksChangeSet>("TracksListener::TracksChangeSet");
 }
 
 void MediaPlayListTest::simpleInitialCase()
@@ -3128,6 +3131,80 @@ void MediaPlayListTest::restoreTrackWithoutAlbum()
     QCOMPARE(myPlayList.data(myPlayList.index(0, 0), MediaPlayList::DurationRole).toTime().msecsSinceStartOfDay(), 29);
 }
 
+void MediaPlayListTest::restoreTrackWithUnknownId()
+{
+    MediaPlayList myPlayList;
+    QAbstractItemModelTester testModel(&myPlayList);
+    DatabaseInterface myDatabaseContent;
+    TracksListener myListener(&myDatabaseContent);
+
+    QSignalSpy rowsInsertedSpy(&myPlayList, &MediaPlayList::rowsInserted);
+    QSignalSpy dataChangedSpy(&myPlayList, &MediaPlayList::dataChanged);
+    QSignalSpy newTrackByNameInListSpy(&myPlayList, &MediaPlayList::newTrackByNameInList);
+    QSignalSpy newTracksByIdInListSpy(&myPlayList, &MediaPlayList::newTracksByIdInList);
+    QSignalSpy newUrlInListSpy(&myPlayList, &MediaPlayList::newUrlInList);
+
+    myDatabaseContent.init(QStringLiteral("testDbDirectContent"));
+
+    connect(&myListener, &TracksListener::trackHasChanged,
+            &myPlayList, &MediaPlayList::trackChanged,
+            Qt::QueuedConnection);
+    connect(&myListener, &TracksListener::tracksHaveChanged,
+            &myPlayList, &MediaPlayList::tracksChanged,
+            Qt::QueuedConnection);
+    connect(&myPlayList, &MediaPlayList::newTracksByIdInList,
+            &myListener, &TracksListener::newTracksByIdInList,
+            Qt::QueuedConnection);
+    connect(&myPlayList, &MediaPlayList::newUrlInList,
+            &myListener, &TracksListener::newUrlInList,
+            Qt::QueuedConnection);
+    connect(&myDatabaseContent, &DatabaseInterface::tracksAdded,
+            &myListener, &TracksListener::tracksAdded);
+
+    myDatabaseContent.insertTracksList(mNewTracks, mNewCovers);
+
+    auto secondTrackId = myDatabaseContent.trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track2"), QStringLiteral("artist2"),
+                                                                                QStringLiteral("album3"), 2, 1);
+
+    // the first track is saved with an id the database does not know
+    QByteArray playListData;
+    QDataStream playListStream(&playListData, QIODevice::WriteOnly);
+    playListStream.setVersion(QDataStream::Qt_5_11);
+    playListStream << quint32(0x454c504c) << quint32(1);
+    playListStream << qint32(ElisaUtils::Track) << quint64(999999) << QUrl::fromUserInput(QStringLiteral("/$1"));
+    playListStream << qint32(ElisaUtils::Track) << quint64(secondTrackId) << QUrl::fromUserInput(QStringLiteral("/$12"));
+
+    auto playListState = QVariantMap{};
+    playListState[QStringLiteral("playListData")] = playListData;
+
+    myPlayList.setPersistentState(playListState);
+
+    QCOMPARE(myPlayList.tracksCount(), 2);
+    QCOMPARE(rowsInsertedSpy.count(), 1);
+    QCOMPARE(newTracksByIdInListSpy.count(), 1);
+    QCOMPARE(newTracksByIdInListSpy.at(0).at(0).value<QVector<qulonglong>>(), (QVector<qulonglong>{999999, secondTrackId}));
+
+    QCOMPARE(newUrlInListSpy.wait(), true);
+
+    QCOMPARE(newUrlInListSpy.count(), 1);
+    QCOMPARE(newUrlInListSpy.at(0).at(0).toUrl(), QUrl::fromUserInput(QStringLiteral("/$1")));
+
+    while (dataChangedSpy.count() < 2) {
+        QCOMPARE(dataChangedSpy.wait(), true);
+    }
+
+    QCOMPARE(newTrackByNameInListSpy.count(), 0);
+
+    QCOMPARE(myPlayList.data(myPlayList.index(0, 0), MediaPlayList::ColumnsRoles::IsValidRole).toBool(), true);
+    QCOMPARE(myPlayList.data(myPlayList.index(0, 0), MediaPlayList::ColumnsRoles::TitleRole).toString(), QStringLiteral("track1"));
+    QCOMPARE(myPlayList.data(myPlayList.index(0, 0), MediaPlayList::ColumnsRoles::AlbumRole).toString(), QStringLiteral("album1"));
+    QCOMPARE(myPlayList.data(myPlayList.index(0, 0), MediaPlayList::ColumnsRoles::ResourceRole).toUrl(), QUrl::fromUserInput(QStringLiteral("/$1")));
+    QCOMPARE(myPlayList.data(myPlayList.index(1, 0), MediaPlayList::ColumnsRoles::IsValidRole).toBool(), true);
+    QCOMPARE(myPlayList.data(myPlayList.index(1, 0), MediaPlayList::ColumnsRoles::TitleRole).toString(), QStringLiteral("track2"));
+    QCOMPARE(myPlayList.data(myPlayList.index(1, 0), MediaPlayList::ColumnsRoles::AlbumRole).toString(), QStringLiteral("album3"));
+    QCOMPARE(myPlayList.data(myPlayList.index(1, 0), MediaPlayList::ColumnsRoles::ResourceRole).toUrl(), QUrl::fromUserInput(QStringLiteral("/$12")));
+}
+
 void MediaPlayListTest::testHasHeaderAlbumWithSameTitle()
 {
     MediaPlayList myPlayList;
@@ -3440,6 +3517,12 @@ void MediaPlayListTest::testSavePersistentState()
     connect(&myPlayListRead, &MediaPlayList::newEntryInList,
             &myListenerRead, &TracksListener::newEntryInList,
             Qt::QueuedConnection);
+    connect(&myPlayListRead, &MediaPlayList::newTracksByIdInList,
+            &myListenerRead, &TracksListener::newTracksByIdInList,
+            Qt::QueuedConnection);
+    connect(&myListenerRead, &TracksListener::tracksHaveChanged,
+            &myPlayListRead, &MediaPlayList::tracksChanged,
+            Qt::QueuedConnection);
     connect(&myDatabaseContent, &DatabaseInterface::tracksAdded,
             &myListenerRead, &TracksListener::tracksAdded);
 
@@ -3663,13 +3746,13 @@ void MediaPlayListTest::testSavePersistentState()
     QCOMPARE(newEntryInListSpySave.count(), 3);
     QCOMPARE(rowsAboutToBeRemovedSpyRead.count(), 0);
     QCOMPARE(rowsAboutToBeMovedSpyRead.count(), 0);
-    QCOMPARE(rowsAboutToBeInsertedSpyRead.count(), 3);
+    QCOMPARE(rowsAboutToBeInsertedSpyRead.count(), 1);
     QCOMPARE(rowsRemovedSpyRead.count(), 0);
     QCOMPARE(rowsMovedSpyRead.count(), 0);
-    QCOMPARE(rowsInsertedSpyRead.count(), 3);
-    QCOMPARE(persistentStateChangedSpyRead.count(), 4);
-    QCOMPARE(dataChangedSpyRead.count(), 6);
-    QCOMPARE(newTrackByNameInListSpyRead.count(), 3);
+    QCOMPARE(rowsInsertedSpyRead.count(), 1);
+    QCOMPARE(persistentStateChangedSpyRead.count(), 2);
+    QCOMPARE(dataChangedSpyRead.count(), 1);
+    QCOMPARE(newTrackByNameInListSpyRead.count(), 0);
     QCOMPARE(newEntryInListSpyRead.count(), 0);
 
     QCOMPARE(myPlayListRead.tracksCount(), 3);
@@ -5605,8 +5688,12 @@ void MediaPlayListTest::randomPlayList()
 
     QCOMPARE(myPlayList.randomPlay(), true);
 
+    auto playedRows = QSet<int>{myPlayList.currentTrack().row()};
+
     myPlayList.skipNextTrack();
 
+    playedRows.insert(myPlayList.currentTrack().row());
+
     QCOMPARE(currentTrackChangedSpy.count(), 2);
     QCOMPARE(randomPlayChangedSpy.count(), 1);
     QCOMPARE(repeatPlayChangedSpy.count(), 0);
@@ -5614,6 +5701,8 @@ void MediaPlayListTest::randomPlayList()
 
     myPlayList.skipNextTrack();
 
+    playedRows.insert(myPlayList.currentTrack().row());
+
     QCOMPARE(currentTrackChangedSpy.count(), 3);
     QCOMPARE(randomPlayChangedSpy.count(), 1);
     QCOMPARE(repeatPlayChangedSpy.count(), 0);
@@ -5621,6 +5710,8 @@ void MediaPlayListTest::randomPlayList()
 
     myPlayList.skipNextTrack();
 
+    playedRows.insert(myPlayList.currentTrack().row());
+
     QCOMPARE(currentTrackChangedSpy.count(), 4);
     QCOMPARE(randomPlayChangedSpy.count(), 1);
     QCOMPARE(repeatPlayChangedSpy.count(), 0);
@@ -5631,7 +5722,10 @@ void MediaPlayListTest::randomPlayList()
     QCOMPARE(currentTrackChangedSpy.count(), 5);
     QCOMPARE(randomPlayChangedSpy.count(), 1);
     QCOMPARE(repeatPlayChangedSpy.count(), 0);
-    QCOMPARE(playListFinishedSpy.count(), 0);
+    QCOMPARE(playListFinishedSpy.count(), 1);
+
+    // each track is played once before the playlist is finished
+    QCOMPARE(playedRows.size(), 4);
 }
 
 void MediaPlayListTest::randomAndContinuePlayList()
@@ -6587,7 +6681,8 @@ void MediaPlayListTest::remainingTracksTest()
     QCOMPARE(repeatPlayChangedSpy.count(), 0);
     QCOMPARE(remainingTracksChangedSpy.count(), 8);
 
-    QCOMPARE(myPlayList.remainingTracks(), -1);
+    // the tracks not played yet in the random order
+    QCOMPARE(myPlayList.remainingTracks(), 4);
 
     myPlayList.setRandomPlay(false);
     myPlayList.setRepeatPlay(true);
@@ -7602,6 +7697,68 @@ void MediaPlayListTest::enqueueTracksByUrl()
     QCOMPARE(newUrlInListSpy.count(), 2);
 }
 
+void MediaPlayListTest::enqueueTracksById()
+{
+    MediaPlayList myPlayList;
+    QAbstractItemModelTester testModel(&myPlayList);
+    DatabaseInterface myDatabaseContent;
+    TracksListener myListener(&myDatabaseContent);
+
+    QSignalSpy rowsAboutToBeInsertedSpy(&myPlayList, &MediaPlayList::rowsAboutToBeInserted);
+    QSignalSpy rowsInsertedSpy(&myPlayList, &MediaPlayList::rowsInserted);
+    QSignalSpy persistentStateChangedSpy(&myPlayList, &MediaPlayList::persistentStateChanged);
+    QSignalSpy dataChangedSpy(&myPlayList, &MediaPlayList::dataChanged);
+    QSignalSpy newEntryInListSpy(&myPlayList, &MediaPlayList::newEntryInList);
+    QSignalSpy newTracksByIdInListSpy(&myPlayList, &MediaPlayList::newTracksByIdInList);
+    QSignalSpy tracksHaveChangedSpy(&myListener, &TracksListener::tracksHaveChanged);
+
+    myDatabaseContent.init(QStringLiteral("testDbDirectContent"));
+
+    connect(&myListener, &TracksListener::tracksHaveChanged,
+            &myPlayList, &MediaPlayList::tracksChanged,
+            Qt::QueuedConnection);
+    connect(&myPlayList, &MediaPlayList::newEntryInList,
+            &myListener, &TracksListener::newEntryInList,
+            Qt::QueuedConnection);
+    connect(&myPlayList, &MediaPlayList::newTracksByIdInList,
+            &myListener, &TracksListener::newTracksByIdInList,
+            Qt::QueuedConnection);
+    connect(&myDatabaseContent, &DatabaseInterface::tracksAdded,
+            &myListener, &TracksListener::tracksAdded);
+
+    myDatabaseContent.insertTracksList(mNewTracks, mNewCovers);
+
+    auto firstNewTrackID = myDatabaseContent.trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track6"), QStringLiteral("artist1 and artist2"), QStringLiteral("album2"), 6, 1);
+    auto secondNewTrackID = myDatabaseContent.trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track1"), QStringLiteral("artist1"), QStringLiteral("album1"), 1, 1);
+    auto thirdNewTrackID = myDatabaseContent.trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track2"), QStringLiteral("artist1"), QStringLiteral("album2"), 2, 1);
+
+    myPlayList.enqueue({{firstNewTrackID, QStringLiteral("track6"), {}},
+                        {secondNewTrackID, QStringLiteral("track1"), {}},
+                        {thirdNewTrackID, QStringLiteral("track2"), {}},
+                        {firstNewTrackID, QStringLiteral("track6"), {}}}, ElisaUtils::Track);
+
+    QCOMPARE(rowsAboutToBeInsertedSpy.count(), 1);
+    QCOMPARE(rowsInsertedSpy.count(), 1);
+    QCOMPARE(persistentStateChangedSpy.count(), 1);
+    QCOMPARE(dataChangedSpy.count(), 0);
+    QCOMPARE(newEntryInListSpy.count(), 0);
+    QCOMPARE(newTracksByIdInListSpy.count(), 1);
+    QCOMPARE(newTracksByIdInListSpy.at(0).at(0).value<QVector<qulonglong>>().count(), 4);
+
+    QCOMPARE(dataChangedSpy.wait(), true);
+
+    QCOMPARE(tracksHaveChangedSpy.count(), 1);
+    QCOMPARE(dataChangedSpy.count(), 1);
+    QCOMPARE(dataChangedSpy.at(0).at(0).toModelIndex(), myPlayList.index(0, 0));
+    QCOMPARE(dataChangedSpy.at(0).at(1).toModelIndex(), myPlayList.index(3, 0));
+
+    QCOMPARE(myPlayList.rowCount(), 4);
+    QCOMPARE(myPlayList.data(myPlayList.index(0, 0), MediaPlayList::TitleRole).toString(), QStringLiteral("track6"));
+    QCOMPARE(myPlayList.data(myPlayList.index(1, 0), MediaPlayList::TitleRole).toString(), QStringLiteral("track1"));
+    QCOMPARE(myPlayList.data(myPlayList.index(2, 0), MediaPlayList::TitleRole).toString(), QStringLiteral("track2"));
+    QCOMPARE(myPlayList.data(myPlayList.index(3, 0), MediaPlayList::TitleRole).toString(), QStringLiteral("track6"));
+}
+
 QTEST_GUILESS_MAIN(MediaPlayListTest)
 
 
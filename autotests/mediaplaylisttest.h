@@ -73,6 +73,8 @@ private Q_SLOTS:
 
     void restoreTrackWithoutAlbum();
 
+    void restoreTrackWithUnknownId();
+
     void testHasHeaderAlbumWithSameTitle();
 
     void testSavePersistentState();
@@ -151,6 +153,8 @@ private Q_SLOTS:
 
     void enqueueTracksByUrl();
 
+    void enqueueTracksById();
+
 };
 
 class MediaPlayList;
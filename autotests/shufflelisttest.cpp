@@ -0,0 +1,291 @@
+/*
+ * Copyright 2026 The Elisa developers
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "shufflelist.h"
+
+#include <QObject>
+#include <QSet>
+#include <QVector>
+
+#include <QtTest>
+
+class ShuffleListTests: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit ShuffleListTests(QObject *parent = nullptr) : QObject(parent)
+    {
+    }
+
+private:
+
+    static QVector<int> playToEnd(ShuffleList &shuffle)
+    {
+        auto result = QVector<int>{};
+
+        for (auto row = shuffle.moveToNext(false); row != -1; row = shuffle.moveToNext(false)) {
+            result.push_back(row);
+        }
+
+        return result;
+    }
+
+    static int uniqueRowsCount(const QVector<int> &rows)
+    {
+        auto result = QSet<int>{};
+
+        for (auto row : rows) {
+            result.insert(row);
+        }
+
+        return result.size();
+    }
+
+private Q_SLOTS:
+
+    void playEachRowOnce()
+    {
+        ShuffleList shuffle;
+        shuffle.reset(1000);
+
+        QCOMPARE(shuffle.currentRow(), -1);
+        QCOMPARE(shuffle.remainingRowsCount(), 1000);
+
+        const auto playedRows = playToEnd(shuffle);
+
+        QCOMPARE(playedRows.size(), 1000);
+        QCOMPARE(uniqueRowsCount(playedRows), 1000);
+        QCOMPARE(shuffle.remainingRowsCount(), 0);
+        QCOMPARE(shuffle.nextRow(false), -1);
+        QCOMPARE(shuffle.currentRow(), playedRows.last());
+    }
+
+    void previousAndNextRows()
+    {
+        ShuffleList shuffle;
+        shuffle.reset(100);
+
+        auto playedRows = QVector<int>{};
+        for (int i = 0; i < 10; ++i) {
+            const auto expectedRow = shuffle.nextRow(false);
+            playedRows.push_back(shuffle.moveToNext(false));
+            QCOMPARE(playedRows.last(), expectedRow);
+        }
+
+        QCOMPARE(shuffle.remainingRowsCount(), 90);
+
+        for (int i = 8; i >= 0; --i) {
+            QCOMPARE(shuffle.previousRow(false), playedRows[i]);
+            QCOMPARE(shuffle.moveToPrevious(false), playedRows[i]);
+        }
+
+        QCOMPARE(shuffle.previousRow(false), -1);
+        QCOMPARE(shuffle.moveToPrevious(false), -1);
+
+        for (int i = 1; i < 10; ++i) {
+            QCOMPARE(shuffle.moveToNext(false), playedRows[i]);
+        }
+    }
+
+    void wrapAround()
+    {
+        ShuffleList shuffle;
+        shuffle.reset(5);
+
+        const auto firstRow = shuffle.moveToNext(true);
+        const auto lastRow = shuffle.previousRow(true);
+
+        QVERIFY(lastRow != -1);
+        QVERIFY(lastRow != firstRow);
+
+        auto playedRows = QVector<int>{firstRow};
+        for (int i = 1; i < 5; ++i) {
+            playedRows.push_back(shuffle.moveToNext(true));
+        }
+
+        QCOMPARE(uniqueRowsCount(playedRows), 5);
+        QCOMPARE(playedRows.last(), lastRow);
+
+        // a new order starts with the row announced as the next one
+        const auto nextRow = shuffle.nextRow(true);
+        QCOMPARE(nextRow, firstRow);
+        QCOMPARE(shuffle.moveToNext(true), nextRow);
+        QCOMPARE(shuffle.remainingRowsCount(), 4);
+        QCOMPARE(shuffle.moveToPrevious(false), -1);
+
+        auto newPlayedRows = QVector<int>{nextRow};
+        for (int i = 1; i < 5; ++i) {
+            newPlayedRows.push_back(shuffle.moveToNext(true));
+        }
+
+        QCOMPARE(uniqueRowsCount(newPlayedRows), 5);
+    }
+
+    void stateWithoutSkippedRows()
+    {
+        ShuffleList shuffle;
+        shuffle.reset(10);
+
+        auto playedRows = QVector<int>{};
+        for (int i = 0; i < 4; ++i) {
+            playedRows.push_back(shuffle.moveToNext(false));
+        }
+
+        const auto currentRow = shuffle.currentRow();
+        const auto skippedRow = (currentRow == 0 ? 1 : 0);
+
+        ShuffleList restoredShuffle;
+        restoredShuffle.reset(9);
+
+        QVERIFY(restoredShuffle.restoreState(shuffle.state({skippedRow})));
+        QCOMPARE(restoredShuffle.currentRow(), currentRow > skippedRow ? currentRow - 1 : currentRow);
+        QCOMPARE(restoredShuffle.remainingRowsCount(), playedRows.contains(skippedRow) ? 6 : 5);
+    }
+
+    void chooseCurrentRow()
+    {
+        ShuffleList shuffle;
+        shuffle.reset(20);
+
+        shuffle.setCurrentRow(7);
+        QCOMPARE(shuffle.currentRow(), 7);
+        QCOMPARE(shuffle.remainingRowsCount(), 19);
+
+        const auto secondRow = shuffle.moveToNext(false);
+        const auto thirdRow = shuffle.moveToNext(false);
+
+        // a row already played becomes the last one played
+        shuffle.setCurrentRow(7);
+        QCOMPARE(shuffle.currentRow(), 7);
+        QCOMPARE(shuffle.previousRow(false), thirdRow);
+        QCOMPARE(shuffle.remainingRowsCount(), 17);
+
+        shuffle.setCurrentRow(secondRow);
+        QCOMPARE(shuffle.previousRow(false), 7);
+
+        auto playedRows = QVector<int>{thirdRow, 7, secondRow};
+        playedRows.append(playToEnd(shuffle));
+
+        QCOMPARE(playedRows.size(), 20);
+        QCOMPARE(uniqueRowsCount(playedRows), 20);
+    }
+
+    void insertRemoveAndMoveRows()
+    {
+        ShuffleList shuffle;
+        shuffle.reset(10);
+
+        auto playedRows = QVector<int>{};
+        for (int i = 0; i < 3; ++i) {
+            playedRows.push_back(shuffle.moveToNext(false));
+        }
+
+        shuffle.insertRows(0, 5);
+
+        for (auto &row : playedRows) {
+            row += 5;
+        }
+
+        QCOMPARE(shuffle.currentRow(), playedRows[2]);
+        QCOMPARE(shuffle.previousRow(false), playedRows[1]);
+        QCOMPARE(shuffle.remainingRowsCount(), 12);
+
+        // removing the current row makes the following one current
+        const auto followingRow = shuffle.nextRow(false);
+        const auto removedRow = playedRows.takeLast();
+        shuffle.removeRows(removedRow, 1);
+
+        for (auto &row : playedRows) {
+            if (row > removedRow) {
+                --row;
+            }
+        }
+
+        QCOMPARE(shuffle.rowsCount(), 14);
+        QCOMPARE(shuffle.currentRow(), followingRow > removedRow ? followingRow - 1 : followingRow);
+        QCOMPARE(shuffle.previousRow(false), playedRows[1]);
+
+        // moving rows keeps the order of the tracks
+        const auto currentRow = shuffle.currentRow();
+        shuffle.moveRows(currentRow, 1, 0);
+        QCOMPARE(shuffle.currentRow(), 0);
+
+        auto allRows = QVector<int>{shuffle.currentRow()};
+        allRows.append(playToEnd(shuffle));
+
+        QCOMPARE(allRows.size(), shuffle.rowsCount() - 2);
+        QCOMPARE(uniqueRowsCount(allRows), allRows.size());
+    }
+
+    void keepGroupsTogether()
+    {
+        ShuffleList shuffle;
+        shuffle.setSameGroupFunction([](int firstRow, int secondRow) {
+            return firstRow / 4 == secondRow / 4;
+        });
+        shuffle.reset(40);
+
+        const auto playedRows = playToEnd(shuffle);
+
+        QCOMPARE(playedRows.size(), 40);
+
+        for (int i = 0; i < playedRows.size(); i += 4) {
+            QCOMPARE(playedRows[i] % 4, 0);
+            for (int j = 1; j < 4; ++j) {
+                QCOMPARE(playedRows[i + j], playedRows[i] + j);
+            }
+        }
+    }
+
+    void saveAndRestoreState()
+    {
+        ShuffleList shuffle;
+        shuffle.reset(50);
+
+        auto playedRows = QVector<int>{};
+        for (int i = 0; i < 5; ++i) {
+            playedRows.push_back(shuffle.moveToNext(false));
+        }
+        const auto nextRow = shuffle.nextRow(false);
+
+        ShuffleList restoredShuffle;
+        restoredShuffle.reset(50);
+
+        QVERIFY(restoredShuffle.restoreState(shuffle.state()));
+        QCOMPARE(restoredShuffle.currentRow(), playedRows.last());
+        QCOMPARE(restoredShuffle.remainingRowsCount(), 45);
+        QCOMPARE(restoredShuffle.nextRow(false), nextRow);
+
+        for (int i = 3; i >= 0; --i) {
+            QCOMPARE(restoredShuffle.moveToPrevious(false), playedRows[i]);
+        }
+
+        ShuffleList otherShuffle;
+        otherShuffle.reset(49);
+
+        QVERIFY(!otherShuffle.restoreState(shuffle.state()));
+        QVERIFY(!otherShuffle.restoreState(QByteArray{}));
+        QCOMPARE(otherShuffle.currentRow(), -1);
+    }
+};
+
+QTEST_GUILESS_MAIN(ShuffleListTests)
+
+
+#include "shufflelisttest.moc"
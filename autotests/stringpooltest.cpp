@@ -0,0 +1,120 @@
+/*
+ * Copyright 2026 The Elisa developers
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "stringpool.h"
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+
+#include <QtTest>
+
+#include <thread>
+#include <vector>
+
+class StringPoolTests: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit StringPoolTests(QObject *parent = nullptr) : QObject(parent)
+    {
+    }
+
+private Q_SLOTS:
+
+    void internEqualStrings()
+    {
+        auto &stringPool = StringPool::instance();
+
+        const auto savedBytesBefore = stringPool.savedBytes();
+
+        const auto firstArtist = stringPool.intern(QStringLiteral("artist") + QString::number(1));
+        const auto secondArtist = stringPool.intern(QStringLiteral("artist") + QString::number(1));
+        const auto otherArtist = stringPool.intern(QStringLiteral("artist") + QString::number(2));
+
+        QCOMPARE(firstArtist, secondArtist);
+        QCOMPARE(firstArtist.constData(), secondArtist.constData());
+        QVERIFY(firstArtist.constData() != otherArtist.constData());
+        QVERIFY(StringPool::isSame(firstArtist, secondArtist));
+        QVERIFY(!StringPool::isSame(firstArtist, otherArtist));
+        QCOMPARE(stringPool.savedBytes() - savedBytesBefore, static_cast<qint64>(firstArtist.size() * sizeof(QChar)));
+    }
+
+    void internVariants()
+    {
+        auto &stringPool = StringPool::instance();
+
+        const auto genre = stringPool.intern(QStringLiteral("genre1"));
+        const auto genres = stringPool.intern(QVariant{QStringList{QStringLiteral("genre") + QString::number(1)}});
+
+        QCOMPARE(genres.userType(), static_cast<int>(QMetaType::QStringList));
+        QCOMPARE(genres.toStringList().first().constData(), genre.constData());
+
+        const auto number = stringPool.intern(QVariant{3});
+        QCOMPARE(number, QVariant{3});
+    }
+
+    void purgeUnusedStrings()
+    {
+        auto &stringPool = StringPool::instance();
+
+        {
+            auto unusedString = stringPool.intern(QStringLiteral("unused") + QString::number(1));
+            Q_UNUSED(unusedString)
+        }
+        const auto usedString = stringPool.intern(QStringLiteral("used") + QString::number(1));
+
+        const auto stringsCount = stringPool.stringsCount();
+
+        stringPool.purgeUnusedStrings();
+
+        QVERIFY(stringPool.stringsCount() < stringsCount);
+        QCOMPARE(stringPool.intern(QStringLiteral("used") + QString::number(1)).constData(), usedString.constData());
+    }
+
+    void internFromSeveralThreads()
+    {
+        auto internedNames = std::vector<QStringList>(4);
+        auto allThreads = std::vector<std::thread>{};
+
+        for (auto &threadNames : internedNames) {
+            allThreads.emplace_back([&threadNames]() {
+                for (int i = 0; i < 1000; ++i) {
+                    threadNames.push_back(StringPool::instance().intern(QStringLiteral("album") + QString::number(i % 10)));
+                }
+            });
+        }
+
+        for (auto &oneThread : allThreads) {
+            oneThread.join();
+        }
+
+        for (const auto &threadNames : internedNames) {
+            for (int i = 0; i < threadNames.size(); ++i) {
+                QCOMPARE(threadNames[i].constData(), internedNames.front()[i].constData());
+            }
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(StringPoolTests)
+
+
+#include "stringpooltest.moc"
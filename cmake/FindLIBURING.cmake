@@ -0,0 +1,28 @@
+# CMake module to search for liburing, the io_uring helper library of Linux
+#
+# Redistribution and use is allowed according to the terms of the BSD license.
+# For details see the accompanying COPYING-CMAKE-SCRIPTS file.
+#
+# If it's found it sets LIBURING_FOUND to TRUE
+# and following variables are set:
+#    LIBURING_INCLUDE_DIR
+#    LIBURING_LIBRARY
+#    LIBURING_VERSION
+
+find_package(PkgConfig QUIET)
+pkg_check_modules(PC_LIBURING QUIET liburing)
+
+find_path(LIBURING_INCLUDE_DIR liburing.h
+    HINTS ${PC_LIBURING_INCLUDEDIR} ${PC_LIBURING_INCLUDE_DIRS})
+
+find_library(LIBURING_LIBRARY NAMES uring liburing
+    HINTS ${PC_LIBURING_LIBDIR} ${PC_LIBURING_LIBRARY_DIRS})
+
+set(LIBURING_VERSION ${PC_LIBURING_VERSION})
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(LIBURING
+    REQUIRED_VARS LIBURING_LIBRARY LIBURING_INCLUDE_DIR
+    VERSION_VAR LIBURING_VERSION)
+
+mark_as_advanced(LIBURING_INCLUDE_DIR LIBURING_LIBRARY)
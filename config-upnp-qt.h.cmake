@@ -22,6 +22,10 @@
 
 #cmakedefine01 KF5FileMetaData_FOUND
 
+#cmakedefine01 HAVE_INOTIFY
+
+#cmakedefine01 LIBURING_FOUND
+
 #define LOCAL_FILE_TESTS_SAMPLE_FILES_PATH "@CMAKE_CURRENT_SOURCE_DIR@/autotests/data"
 
 #define LOCAL_FILE_TESTS_WORKING_PATH "@CMAKE_CURRENT_BINARY_DIR@/autotests/data"
@@ -52,19 +52,25 @@ void AbstractFileListener::setDatabaseInterface(DatabaseInterface *model)
 {
     if (model) {
         connect(this, &AbstractFileListener::newTrackFile, d->mFileListing, &AbstractFileListing::newTrackFile);
-        connect(d->mFileListing, &AbstractFileListing::tracksList, model, &DatabaseInterface::insertTracksList);
+        connect(d->mFileListing, &AbstractFileListing::tracksList, model, &DatabaseInterface::insertTracksAndScannedDirectoriesList);
         connect(d->mFileListing, &AbstractFileListing::removedTracksList, model, &DatabaseInterface::removeTracksList);
         connect(d->mFileListing, &AbstractFileListing::modifyTracksList, model, &DatabaseInterface::insertTracksList);
+        connect(d->mFileListing, &AbstractFileListing::renamedTracksList, model, &DatabaseInterface::renameTracksList);
         connect(d->mFileListing, &AbstractFileListing::askRestoredTracks,
                 model, &DatabaseInterface::askRestoredTracks);
+        connect(model, &DatabaseInterface::restoredScannedDirectories,
+                d->mFileListing, &AbstractFileListing::restoredScannedDirectories);
         connect(model, &DatabaseInterface::restoredTracks,
                 d->mFileListing, &AbstractFileListing::restoredTracks);
+        connect(d->mFileListing, &AbstractFileListing::scannedDirectoriesList,
+                model, &DatabaseInterface::insertScannedDirectoriesList);
         connect(model, &DatabaseInterface::cleanedDatabase,
-                d->mFileListing, &AbstractFileListing::refreshContent);
+                d->mFileListing, &AbstractFileListing::databaseCleaned);
         connect(model, &DatabaseInterface::finishRemovingTracksList,
                 d->mFileListing, &AbstractFileListing::databaseFinishedRemovingTracksList);
         connect(model, &DatabaseInterface::finishInsertingTracksList,
-                d->mFileListing, &AbstractFileListing::databaseFinishedInsertingTracksList);
+                d->mFileListing, &AbstractFileListing::databaseFinishedInsertingTracksList, Qt::DirectConnection);
+        d->mFileListing->setDatabaseFlowControl(true);
     }
 
     Q_EMIT databaseInterfaceChanged();
@@ -22,29 +22,182 @@
 #include "abstractfile/indexercommon.h"
 
 #include "filescanner.h"
+#include "filescannerpool.h"
+#include "filesystemwatcher.h"
+#include "directorylister.h"
 
 #include <QThread>
 #include <QHash>
 #include <QFileInfo>
 #include <QFile>
 #include <QDir>
-#include <QFileSystemWatcher>
 #include <QSet>
 #include <QPair>
 #include <QAtomicInt>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+#include <QElapsedTimer>
+#include <QQueue>
 
 #include <QtGlobal>
 
 #include <algorithm>
 #include <utility>
 
+namespace {
+
+QUrl directoryKey(const QUrl &directory)
+{
+    return directory.adjusted(QUrl::StripTrailingSlash);
+}
+
+QUrl parentDirectoryKey(const QUrl &fileName)
+{
+    return fileName.adjusted(QUrl::RemoveFilename | QUrl::StripTrailingSlash);
+}
+
+QByteArray directoryContentHash(const DirectoryEntries &entries)
+{
+    QCryptographicHash contentHash(QCryptographicHash::Sha1);
+
+    for (const auto &oneEntry : entries) {
+        contentHash.addData(oneEntry.mFileName.toUtf8());
+        contentHash.addData(oneEntry.isDir() ? QByteArrayLiteral("/\n") : QByteArrayLiteral("\n"));
+    }
+
+    return contentHash.result();
+}
+
+// names and types of the entries of a directory, in the order of the directory listers
+DirectoryEntries directoryEntryNames(const QString &directoryName)
+{
+    auto result = DirectoryEntries{};
+
+    // the type of the entries usually comes with their names: no canonical path, size or inode is read
+    const auto entryList = QDir(directoryName).entryInfoList(QDir::NoDotAndDotDot | QDir::Files | QDir::Dirs);
+
+    result.reserve(entryList.size());
+
+    for (const auto &oneEntry : entryList) {
+        auto newEntry = DirectoryEntry{};
+
+        if (oneEntry.isDir()) {
+            newEntry.mType = DirectoryEntry::Type::Directory;
+        } else if (!oneEntry.isFile()) {
+            continue;
+        }
+
+        newEntry.mFileName = oneEntry.fileName();
+
+        result.push_back(newEntry);
+    }
+
+    return result;
+}
+
+// the database commits a batch of new tracks in about this time
+const qint64 constTargetBatchCommitTime = 250;
+
+const int constMaximumBatchSize = 1000;
+
+// one batch committed while the next one is waiting in the database thread
+const int constMaximumPendingBatches = 2;
+
+// unique among all the listings sharing the database, 0 is kept for untagged insertions
+QAtomicInteger<qulonglong> lastTracksBatchId = 0;
+
+class PendingTracksBatch
+{
+public:
+
+    qulonglong mBatchId = 0;
+
+    QElapsedTimer mEmitTime;
+
+    int mTracksCount = 0;
+
+};
+
+class PendingScannedDirectory
+{
+public:
+
+    DataTypes::DirectoryScanData mDirectory;
+
+    // files given to the scanner pool until the end of the scan of this directory
+    qulonglong mScheduledFilesCount = 0;
+
+};
+
+class FileIdentity
+{
+public:
+
+    quint64 mInode = 0;
+
+    qint64 mSize = -1;
+
+    qint64 mModificationTime = 0;
+
+};
+
+bool operator==(const FileIdentity &first, const FileIdentity &second)
+{
+    return first.mInode == second.mInode && first.mSize == second.mSize &&
+            first.mModificationTime == second.mModificationTime;
+}
+
+uint qHash(const FileIdentity &identity, uint seed = 0)
+{
+    return ::qHash(identity.mInode, seed) ^ ::qHash(identity.mSize, seed) ^ ::qHash(identity.mModificationTime, seed);
+}
+
+FileIdentity fileIdentity(const DirectoryEntry &entry)
+{
+    auto result = FileIdentity{};
+
+    result.mInode = entry.mInode;
+    result.mSize = entry.mSize;
+    result.mModificationTime = entry.mModificationTime.toSecsSinceEpoch();
+
+    return result;
+}
+
+// a file moved while Elisa was not running is recognized by its inode, size and modification time
+QByteArray directoryFilesIdentity(const DirectoryEntries &entries)
+{
+    QByteArray result;
+    QDataStream identityStream(&result, QIODevice::WriteOnly);
+    identityStream.setVersion(QDataStream::Qt_5_11);
+
+    for (const auto &oneEntry : entries) {
+        if (!oneEntry.isFile()) {
+            continue;
+        }
+
+        const auto identity = fileIdentity(oneEntry);
+        if (identity.mSize < 0) {
+            continue;
+        }
+
+        identityStream << oneEntry.mFileName << identity.mInode << identity.mSize << identity.mModificationTime;
+    }
+
+    return result;
+}
+
+}
+
 class AbstractFileListingPrivate
 {
 public:
 
     QStringList mAllRootPaths;
 
-    QFileSystemWatcher mFileSystemWatcher;
+    FileSystemWatcher *mFileSystemWatcher = nullptr;
 
     QHash<QString, QUrl> mAllAlbumCover;
 
@@ -52,13 +205,53 @@ public:
 
     FileScanner mFileScanner;
 
+    std::unique_ptr<DirectoryLister> mDirectoryLister;
+
+    std::unique_ptr<FileScannerPool> mScannerPool;
+
     QHash<QUrl, QDateTime> mAllFiles;
 
+    QHash<QUrl, DataTypes::DirectoryScanData> mScannedDirectories;
+
+    QHash<QUrl, QVector<QUrl>> mScannedChildDirectories;
+
+    QHash<QUrl, QVector<QUrl>> mKnownFilesByDirectory;
+
+    DataTypes::ListDirectoryScanData mNewScannedDirectories;
+
+    QList<QUrl> mRemovedScannedDirectories;
+
+    // completed directories waiting to be sent to the database with their last tracks
+    QQueue<PendingScannedDirectory> mPendingScannedDirectories;
+
+    qulonglong mScheduledFilesCount = 0;
+
+    qulonglong mTakenFilesCount = 0;
+
+    DataTypes::ListRenamedFileData mRenamedFiles;
+
+    QHash<FileIdentity, QUrl> mFilesByIdentity;
+
+    bool mHasFilesIdentityIndex = false;
+
     QAtomicInt mStopRequest = 0;
 
     int mImportedTracksCount = 0;
 
-    int mNewFilesEmitInterval = 1;
+    QAtomicInt mNewFilesBatchSize = 1;
+
+    QAtomicInt mHasDatabaseFlowControl = 0;
+
+    // shared with the database thread calling databaseFinishedInsertingTracksList
+    QMutex mPendingBatchesMutex;
+
+    QWaitCondition mPendingBatchesCondition;
+
+    QQueue<PendingTracksBatch> mPendingBatches;
+
+    QElapsedTimer mLastCommitTime;
+
+    int mMetadataExtractionWorkersCount = 1;
 
     bool mHandleNewFiles = true;
 
@@ -72,10 +265,15 @@ public:
 
 AbstractFileListing::AbstractFileListing(QObject *parent) : QObject(parent), d(std::make_unique<AbstractFileListingPrivate>())
 {
-    connect(&d->mFileSystemWatcher, &QFileSystemWatcher::directoryChanged,
+    d->mFileSystemWatcher = FileSystemWatcher::create(FileSystemWatcher::Backend::Automatic, this);
+    d->mDirectoryLister = DirectoryLister::create(DirectoryLister::Backend::Automatic);
+
+    connect(d->mFileSystemWatcher, &FileSystemWatcher::directoryChanged,
             this, &AbstractFileListing::directoryChanged);
-    connect(&d->mFileSystemWatcher, &QFileSystemWatcher::fileChanged,
+    connect(d->mFileSystemWatcher, &FileSystemWatcher::fileChanged,
             this, &AbstractFileListing::fileChanged);
+    connect(d->mFileSystemWatcher, &FileSystemWatcher::pathRenamed,
+            this, &AbstractFileListing::pathRenamed);
 }
 
 AbstractFileListing::~AbstractFileListing()
@@ -107,6 +305,19 @@ void AbstractFileListing::newTrackFile(const DataTypes::TrackDataType &partialTr
     }
 }
 
+void AbstractFileListing::restoredScannedDirectories(const DataTypes::ListDirectoryScanData &scannedDirectories)
+{
+    d->mScannedDirectories.clear();
+
+    for (const auto &oneDirectory : scannedDirectories) {
+        d->mScannedDirectories[directoryKey(oneDirectory.mDirectory)] = oneDirectory;
+    }
+
+    indexScannedChildDirectories();
+
+    qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::restoredScannedDirectories" << d->mScannedDirectories.size() << "directories";
+}
+
 void AbstractFileListing::restoredTracks(QHash<QUrl, QDateTime> allFiles)
 {
     executeInit(std::move(allFiles));
@@ -119,8 +330,64 @@ void AbstractFileListing::setAllRootPaths(const QStringList &allRootPaths)
     d->mAllRootPaths = allRootPaths;
 }
 
-void AbstractFileListing::databaseFinishedInsertingTracksList()
+void AbstractFileListing::setMetadataExtractionWorkersCount(int workersCount)
+{
+    workersCount = std::max(1, workersCount);
+
+    if (d->mMetadataExtractionWorkersCount == workersCount) {
+        return;
+    }
+
+    qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::setMetadataExtractionWorkersCount" << workersCount;
+
+    d->mMetadataExtractionWorkersCount = workersCount;
+    d->mScannerPool.reset();
+}
+
+void AbstractFileListing::setDatabaseFlowControl(bool enabled)
+{
+    d->mHasDatabaseFlowControl = (enabled ? 1 : 0);
+
+    QMutexLocker locker(&d->mPendingBatchesMutex);
+    d->mPendingBatches.clear();
+    d->mPendingBatchesCondition.wakeAll();
+}
+
+void AbstractFileListing::databaseFinishedInsertingTracksList(qulonglong batchId)
 {
+    if (d->mHasDatabaseFlowControl == 0 || batchId == 0) {
+        return;
+    }
+
+    QMutexLocker locker(&d->mPendingBatchesMutex);
+
+    // modified tracks and the batches of another listing sharing the database are not ours to account
+    auto itBatch = std::find_if(d->mPendingBatches.begin(), d->mPendingBatches.end(),
+                                [batchId](const auto &oneBatch) {return oneBatch.mBatchId == batchId;});
+    if (itBatch == d->mPendingBatches.end()) {
+        return;
+    }
+
+    const auto batch = *itBatch;
+    d->mPendingBatches.erase(itBatch);
+
+    // time spent committing this batch, not waiting behind the previous one
+    auto commitTime = batch.mEmitTime.elapsed();
+    if (d->mLastCommitTime.isValid()) {
+        commitTime = std::min(commitTime, d->mLastCommitTime.elapsed());
+    }
+    d->mLastCommitTime.start();
+
+    const auto estimatedBatchSize = batch.mTracksCount * constTargetBatchCommitTime / std::max(qint64(1), commitTime);
+    const auto newBatchSize = std::max(qint64(1), std::min(qint64(constMaximumBatchSize),
+                                                           (d->mNewFilesBatchSize + estimatedBatchSize) / 2));
+
+    d->mNewFilesBatchSize = static_cast<int>(newBatchSize);
+
+    qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::databaseFinishedInsertingTracksList" << batch.mTracksCount
+                                  << "tracks committed in" << commitTime << "ms" << "next batch size" << newBatchSize;
+
+    d->mPendingBatchesCondition.wakeAll();
 }
 
 void AbstractFileListing::databaseFinishedRemovingTracksList()
@@ -131,9 +398,21 @@ void AbstractFileListing::databaseFinishedRemovingTracksList()
     }
 }
 
+void AbstractFileListing::databaseCleaned()
+{
+    d->mScannedDirectories.clear();
+    d->mScannedChildDirectories.clear();
+    d->mKnownFilesByDirectory.clear();
+
+    refreshContent();
+}
+
 void AbstractFileListing::applicationAboutToQuit()
 {
     d->mStopRequest = 1;
+
+    QMutexLocker locker(&d->mPendingBatchesMutex);
+    d->mPendingBatchesCondition.wakeAll();
 }
 
 const QStringList &AbstractFileListing::allRootPaths() const
@@ -152,6 +431,13 @@ void AbstractFileListing::scanDirectory(DataTypes::ListTrackDataType &newFiles,
         return;
     }
 
+    if (d->mHandleNewFiles && scanUnchangedDirectory(newFiles, path)) {
+        return;
+    }
+
+    // read before listing: an entry added meanwhile will change it again
+    const auto directoryModificationTime = QFileInfo(path.toLocalFile()).lastModified();
+
     QDir rootDirectory(path.toLocalFile());
     rootDirectory.refresh();
 
@@ -161,23 +447,30 @@ void AbstractFileListing::scanDirectory(DataTypes::ListTrackDataType &newFiles,
 
     auto &currentDirectoryListingFiles = d->mDiscoveredFiles[path];
 
-    auto currentFilesList = QSet<QUrl>();
+    // each entry is read once: the new entries below reuse what the listing found
+    const auto entryList = d->mDirectoryLister->entries(path.toLocalFile());
 
-    rootDirectory.refresh();
-    const auto entryList = rootDirectory.entryInfoList(QDir::NoDotAndDotDot | QDir::Files | QDir::Dirs);
-    for (const auto &oneEntry : entryList) {
-        auto newFilePath = QUrl::fromLocalFile(oneEntry.canonicalFilePath());
+    auto currentFilesList = QHash<QUrl, int>();
+    auto allFileNames = QStringList();
+
+    for (int entryIndex = 0; entryIndex < entryList.size(); ++entryIndex) {
+        const auto &oneEntry = entryList[entryIndex];
+
+        if (!oneEntry.mCanonicalFilePath.isEmpty()) {
+            currentFilesList.insert(QUrl::fromLocalFile(oneEntry.mCanonicalFilePath), entryIndex);
+        }
 
-        if (oneEntry.isDir() || oneEntry.isFile()) {
-            currentFilesList.insert(newFilePath);
+        if (oneEntry.isFile()) {
+            allFileNames.push_back(oneEntry.mFileName);
         }
     }
 
+    // tracks are known by their canonical path: so is the cover of their directory
+    d->mFileScanner.addDirectoryEntries(rootDirectory.canonicalPath(), allFileNames);
+
     auto removedTracks = QVector<QPair<QUrl, bool>>();
     for (const auto &removedFilePath : currentDirectoryListingFiles) {
-        auto itFilePath = std::find(currentFilesList.begin(), currentFilesList.end(), removedFilePath.first);
-
-        if (itFilePath != currentFilesList.end()) {
+        if (currentFilesList.contains(removedFilePath.first)) {
             continue;
         }
 
@@ -205,12 +498,25 @@ void AbstractFileListing::scanDirectory(DataTypes::ListTrackDataType &newFiles,
         return;
     }
 
-    for (const auto &newFilePath : currentFilesList) {
-        QFileInfo oneEntry(newFilePath.toLocalFile());
+    const auto currentKey = directoryKey(path);
+    const auto scannedDirectory = DataTypes::DirectoryScanData{currentKey, directoryModificationTime, entryList.size(),
+            directoryContentHash(entryList), directoryFilesIdentity(entryList)};
+    if (!rootDirectory.exists()) {
+        d->mRemovedScannedDirectories.push_back(currentKey);
+    }
+
+    const auto &scannedChildDirectories = d->mScannedChildDirectories.value(currentKey);
+    for (const auto &oneChildDirectory : scannedChildDirectories) {
+        if (!currentFilesList.contains(oneChildDirectory)) {
+            d->mRemovedScannedDirectories.push_back(oneChildDirectory);
+        }
+    }
 
-        auto itFilePath = std::find(currentDirectoryListingFiles.begin(), currentDirectoryListingFiles.end(), QPair<QUrl, bool>{newFilePath, oneEntry.isFile()});
+    for (auto itNewFile = currentFilesList.cbegin(); itNewFile != currentFilesList.cend(); ++itNewFile) {
+        const auto &newFilePath = itNewFile.key();
+        const auto &oneEntry = entryList[itNewFile.value()];
 
-        if (itFilePath != currentDirectoryListingFiles.end()) {
+        if (currentDirectoryListingFiles.contains({newFilePath, oneEntry.isFile()})) {
             continue;
         }
 
@@ -230,36 +536,254 @@ void AbstractFileListing::scanDirectory(DataTypes::ListTrackDataType &newFiles,
 
         auto itExistingFile = allFiles().find(newFilePath);
         if (itExistingFile != allFiles().end()) {
-            if (*itExistingFile >= oneEntry.metadataChangeTime()) {
+            if (*itExistingFile >= oneEntry.mMetadataChangeTime) {
                 allFiles().erase(itExistingFile);
+                // a known track has to be found again by a later rename or removal
+                currentDirectoryListingFiles.insert({newFilePath, true});
                 qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::scanDirectory" << newFilePath << "file not modified since last scan";
                 continue;
             }
+        } else if (renameMovedFile(newFilePath, oneEntry, path)) {
+            continue;
         }
 
-        auto newTrack = scanOneFile(newFilePath, oneEntry);
+        scanNewFile(newFiles, newFilePath, QFileInfo(newFilePath.toLocalFile()), path);
+
+        if (d->mStopRequest == 1) {
+            break;
+        }
+    }
 
-        if (newTrack.isValid() && d->mStopRequest == 0) {
-            addCover(newTrack);
+    // an interrupted directory has no record: the next scan will list it again
+    if (rootDirectory.exists() && d->mStopRequest == 0) {
+        d->mNewScannedDirectories.push_back(scannedDirectory);
+        d->mPendingScannedDirectories.enqueue({scannedDirectory, d->mScheduledFilesCount});
+    }
+}
 
-            addFileInDirectory(newTrack.resourceURI(), path);
-            newFiles.push_back(newTrack);
+bool AbstractFileListing::scanUnchangedDirectory(DataTypes::ListTrackDataType &newFiles, const QUrl &path)
+{
+    if (d->mDiscoveredFiles.contains(path)) {
+        return false;
+    }
 
-            ++d->mImportedTracksCount;
+    const auto currentKey = directoryKey(path);
+    const auto itScannedDirectory = d->mScannedDirectories.constFind(currentKey);
+    if (itScannedDirectory == d->mScannedDirectories.constEnd()) {
+        return false;
+    }
 
-            if (newFiles.size() > d->mNewFilesEmitInterval && d->mStopRequest == 0) {
-                d->mNewFilesEmitInterval = std::min(50, 1 + d->mNewFilesEmitInterval * d->mNewFilesEmitInterval);
-                emitNewFiles(newFiles);
-                newFiles.clear();
-            }
-        } else {
-            qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::scanDirectory" << newFilePath << "is not a valid track";
+    const auto directoryModificationTime = QFileInfo(path.toLocalFile()).lastModified();
+    if (!directoryModificationTime.isValid() || directoryModificationTime != itScannedDirectory->mModificationTime) {
+        return false;
+    }
+
+    // the modification time may be too coarse to see an entry added or removed just after the last listing:
+    // only the names and types of the entries are read to check the directory still has the same content
+    const auto directoryNames = directoryEntryNames(path.toLocalFile());
+    if (directoryNames.size() != itScannedDirectory->mEntriesCount ||
+            directoryContentHash(directoryNames) != itScannedDirectory->mContentHash) {
+        qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::scanUnchangedDirectory" << path << "entries modified without a new modification time";
+        return false;
+    }
+
+    qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::scanUnchangedDirectory" << path << "not modified since last scan";
+
+    watchPath(path.toLocalFile());
+    auto &currentDirectoryListingFiles = d->mDiscoveredFiles[path];
+
+    // no entry was added or removed but the content of known tracks may have been modified
+    const auto &knownFiles = d->mKnownFilesByDirectory.value(currentKey);
+    for (const auto &oneFile : knownFiles) {
+        auto itExistingFile = allFiles().find(oneFile);
+        if (itExistingFile == allFiles().end()) {
+            continue;
+        }
+
+        QFileInfo oneFileInfo(oneFile.toLocalFile());
+        if (!oneFileInfo.isFile()) {
+            continue;
+        }
+
+        if (*itExistingFile >= oneFileInfo.metadataChangeTime()) {
+            allFiles().erase(itExistingFile);
+            currentDirectoryListingFiles.insert({oneFile, true});
+            continue;
+        }
+
+        scanNewFile(newFiles, oneFile, oneFileInfo, path);
+
+        if (d->mStopRequest == 1) {
+            return true;
+        }
+    }
+
+    const auto &childDirectories = d->mScannedChildDirectories.value(currentKey);
+    for (const auto &oneChildDirectory : childDirectories) {
+        if (!QFileInfo(oneChildDirectory.toLocalFile()).isDir()) {
+            continue;
         }
 
+        addFileInDirectory(oneChildDirectory, path);
+        scanDirectory(newFiles, oneChildDirectory);
+
         if (d->mStopRequest == 1) {
             break;
         }
     }
+
+    return true;
+}
+
+void AbstractFileListing::scanNewFile(DataTypes::ListTrackDataType &newFiles, const QUrl &newFilePath,
+                                      const QFileInfo &newFileInfo, const QUrl &directory)
+{
+    if (d->mScannerPool) {
+        if (!d->mFileScanner.shouldScanFile(newFilePath.toLocalFile())) {
+            qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::scanNewFile" << newFilePath << "invalid mime type";
+            return;
+        }
+
+        while (d->mScannerPool->isFull() && d->mStopRequest == 0) {
+            takeScannedFile(newFiles);
+        }
+
+        if (d->mStopRequest == 1) {
+            return;
+        }
+
+        d->mScannerPool->scheduleFile(newFilePath, directory, newFileInfo.metadataChangeTime());
+        ++d->mScheduledFilesCount;
+
+        return;
+    }
+
+    auto newTrack = scanOneFile(newFilePath, newFileInfo);
+
+    if (newTrack.isValid() && d->mStopRequest == 0) {
+        addNewTrack(newFiles, newTrack, directory);
+    } else {
+        qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::scanNewFile" << newFilePath << "is not a valid track";
+    }
+}
+
+void AbstractFileListing::takeScannedFile(DataTypes::ListTrackDataType &newFiles)
+{
+    // counted before adding the track: a batch emitted by addNewTrack contains it
+    ++d->mTakenFilesCount;
+
+    addScannedFile(newFiles, d->mScannerPool->takeNextResult());
+}
+
+void AbstractFileListing::addScannedFile(DataTypes::ListTrackDataType &newFiles, const FileScannerPool::ScanResult &scannedFile)
+{
+    if (!scannedFile.mTrack.isValid() || d->mStopRequest == 1) {
+        qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::addScannedFile" << scannedFile.mFileName << "is not a valid track";
+        return;
+    }
+
+    watchFile(scannedFile.mFileName.toLocalFile());
+
+    addNewTrack(newFiles, scannedFile.mTrack, scannedFile.mDirectory);
+}
+
+bool AbstractFileListing::renameMovedFile(const QUrl &newFilePath, const DirectoryEntry &newFileEntry, const QUrl &directory)
+{
+    if (allFiles().isEmpty()) {
+        return false;
+    }
+
+    if (!d->mHasFilesIdentityIndex) {
+        buildFilesIdentityIndex();
+    }
+
+    const auto itMovedFile = d->mFilesByIdentity.find(fileIdentity(newFileEntry));
+    if (itMovedFile == d->mFilesByIdentity.end()) {
+        return false;
+    }
+
+    const auto oldFilePath = *itMovedFile;
+    d->mFilesByIdentity.erase(itMovedFile);
+
+    // a hard link or a copy keeping the modification time is a new track
+    if (!allFiles().contains(oldFilePath) || QFileInfo::exists(oldFilePath.toLocalFile())) {
+        return false;
+    }
+
+    qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::renameMovedFile" << oldFilePath << "moved to" << newFilePath;
+
+    allFiles().remove(oldFilePath);
+
+    d->mRenamedFiles.push_back({oldFilePath, newFilePath, newFileEntry.mMetadataChangeTime,
+                                d->mFileScanner.searchForCoverFile(newFilePath.toLocalFile())});
+
+    watchFile(newFilePath.toLocalFile());
+    addFileInDirectory(newFilePath, directory);
+
+    return true;
+}
+
+void AbstractFileListing::buildFilesIdentityIndex()
+{
+    d->mFilesByIdentity.clear();
+    d->mHasFilesIdentityIndex = true;
+
+    for (const auto &oneDirectory : qAsConst(d->mScannedDirectories)) {
+        if (oneDirectory.mFilesIdentity.isEmpty()) {
+            continue;
+        }
+
+        const auto directoryName = QDir(oneDirectory.mDirectory.toLocalFile());
+
+        QDataStream identityStream(oneDirectory.mFilesIdentity);
+        identityStream.setVersion(QDataStream::Qt_5_11);
+
+        while (!identityStream.atEnd()) {
+            auto fileName = QString{};
+            auto identity = FileIdentity{};
+
+            identityStream >> fileName >> identity.mInode >> identity.mSize >> identity.mModificationTime;
+
+            if (identityStream.status() != QDataStream::Ok) {
+                break;
+            }
+
+            // only the known tracks not yet found by this scan may have moved
+            const auto oneFile = QUrl::fromLocalFile(directoryName.filePath(fileName));
+            if (allFiles().contains(oneFile)) {
+                d->mFilesByIdentity.insert(identity, oneFile);
+            }
+        }
+    }
+
+    qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::buildFilesIdentityIndex" << d->mFilesByIdentity.size() << "files";
+}
+
+void AbstractFileListing::indexScannedChildDirectories()
+{
+    d->mScannedChildDirectories.clear();
+
+    for (auto itDirectory = d->mScannedDirectories.cbegin(); itDirectory != d->mScannedDirectories.cend(); ++itDirectory) {
+        const auto parentKey = parentDirectoryKey(itDirectory.key());
+        if (parentKey != itDirectory.key()) {
+            d->mScannedChildDirectories[parentKey].push_back(itDirectory.key());
+        }
+    }
+}
+
+void AbstractFileListing::addNewTrack(DataTypes::ListTrackDataType &newFiles, const DataTypes::TrackDataType &newTrack, const QUrl &directory)
+{
+    addCover(newTrack);
+
+    addFileInDirectory(newTrack.resourceURI(), directory);
+    newFiles.push_back(newTrack);
+
+    ++d->mImportedTracksCount;
+
+    if (isNewFilesBatchReady(newFiles) && d->mStopRequest == 0) {
+        emitNewFiles(newFiles);
+        newFiles.clear();
+    }
 }
 
 void AbstractFileListing::directoryChanged(const QString &path)
@@ -269,6 +793,8 @@ void AbstractFileListing::directoryChanged(const QString &path)
         return;
     }
 
+    d->mFileScanner.invalidateDirectoryCover(QFileInfo(path).canonicalFilePath());
+
     Q_EMIT indexingStarted();
 
     scanDirectoryTree(path);
@@ -276,6 +802,149 @@ void AbstractFileListing::directoryChanged(const QString &path)
     Q_EMIT indexingFinished();
 }
 
+void AbstractFileListing::pathRenamed(const QString &from, const QString &to)
+{
+    qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::pathRenamed" << from << to;
+
+    const auto oldPath = QUrl::fromLocalFile(from);
+    const auto newPath = QUrl::fromLocalFile(to);
+    const auto oldDirectory = discoveredDirectory(QFileInfo(from).absolutePath());
+    const auto newDirectory = discoveredDirectory(QFileInfo(to).absolutePath());
+
+    const auto &oldDirectoryEntries = d->mDiscoveredFiles.value(oldDirectory);
+    const auto isKnownTrack = oldDirectoryEntries.contains({oldPath, true}) && d->mFileScanner.shouldScanFile(to);
+    const auto isKnownDirectory = oldDirectoryEntries.contains({oldPath, false}) && d->mDiscoveredFiles.contains(oldPath);
+
+    if (!isKnownTrack && !isKnownDirectory) {
+        directoryChanged(oldDirectory.toLocalFile());
+        if (newDirectory != oldDirectory) {
+            directoryChanged(newDirectory.toLocalFile());
+        }
+
+        return;
+    }
+
+    auto renamedFiles = DataTypes::ListRenamedFileData{};
+
+    if (isKnownTrack) {
+        renamedFiles.push_back({oldPath, newPath, QFileInfo(to).metadataChangeTime(), d->mFileScanner.searchForCoverFile(to)});
+        allFiles().remove(oldPath);
+        watchFile(to);
+    } else {
+        renameDiscoveredDirectory(oldPath, newPath, renamedFiles);
+    }
+
+    d->mDiscoveredFiles[oldDirectory].remove({oldPath, isKnownTrack});
+    addFileInDirectory(newPath, newDirectory);
+
+    if (!renamedFiles.isEmpty()) {
+        Q_EMIT renamedTracksList(renamedFiles);
+    }
+}
+
+QUrl AbstractFileListing::discoveredDirectory(const QString &directoryName) const
+{
+    // root paths are discovered with their trailing slash
+    const auto withTrailingSlash = QUrl::fromLocalFile(directoryName + QLatin1Char('/'));
+    if (d->mDiscoveredFiles.contains(withTrailingSlash)) {
+        return withTrailingSlash;
+    }
+
+    return QUrl::fromLocalFile(directoryName);
+}
+
+void AbstractFileListing::renameDiscoveredDirectory(const QUrl &oldDirectory, const QUrl &newDirectory,
+                                                    DataTypes::ListRenamedFileData &renamedFiles)
+{
+    const auto oldDirectoryName = oldDirectory.toLocalFile();
+    const auto newDirectoryName = newDirectory.toLocalFile();
+
+    auto isInside = [&oldDirectoryName](const QUrl &path) {
+        const auto pathName = path.toLocalFile();
+        return pathName == oldDirectoryName || pathName.startsWith(oldDirectoryName + QLatin1Char('/'));
+    };
+    auto renamedPath = [&oldDirectoryName, &newDirectoryName](const QUrl &path) {
+        return QUrl::fromLocalFile(newDirectoryName + path.toLocalFile().mid(oldDirectoryName.size()));
+    };
+
+    auto movedDirectories = QList<QUrl>{};
+    for (auto itDirectory = d->mDiscoveredFiles.cbegin(); itDirectory != d->mDiscoveredFiles.cend(); ++itDirectory) {
+        if (isInside(itDirectory.key())) {
+            movedDirectories.push_back(itDirectory.key());
+        }
+    }
+
+    for (const auto &oneDirectory : movedDirectories) {
+        const auto oldEntries = d->mDiscoveredFiles.take(oneDirectory);
+        d->mFileScanner.invalidateDirectoryCover(oneDirectory.toLocalFile());
+        const auto newDirectoryPath = renamedPath(oneDirectory);
+
+        auto &newEntries = d->mDiscoveredFiles[newDirectoryPath];
+
+        for (const auto &oneEntry : oldEntries) {
+            const auto newEntryPath = renamedPath(oneEntry.first);
+            newEntries.insert({newEntryPath, oneEntry.second});
+
+            if (!oneEntry.second) {
+                continue;
+            }
+
+            renamedFiles.push_back({oneEntry.first, newEntryPath, QFileInfo(newEntryPath.toLocalFile()).metadataChangeTime(),
+                                    d->mFileScanner.searchForCoverFile(newEntryPath.toLocalFile())});
+            allFiles().remove(oneEntry.first);
+        }
+    }
+
+    auto renamedDirectories = DataTypes::ListDirectoryScanData{};
+    auto removedDirectories = QList<QUrl>{};
+    for (auto itDirectory = d->mScannedDirectories.begin(); itDirectory != d->mScannedDirectories.end(); ) {
+        if (!isInside(itDirectory.key())) {
+            ++itDirectory;
+            continue;
+        }
+
+        auto oneDirectory = itDirectory.value();
+        oneDirectory.mDirectory = renamedPath(itDirectory.key());
+
+        renamedDirectories.push_back(oneDirectory);
+        removedDirectories.push_back(itDirectory.key());
+
+        itDirectory = d->mScannedDirectories.erase(itDirectory);
+    }
+
+    // an unchanged directory is not listed again: its known files have to follow it
+    auto renamedKnownFiles = QHash<QUrl, QVector<QUrl>>{};
+    for (auto itKnownFiles = d->mKnownFilesByDirectory.begin(); itKnownFiles != d->mKnownFilesByDirectory.end(); ) {
+        if (!isInside(itKnownFiles.key())) {
+            ++itKnownFiles;
+            continue;
+        }
+
+        auto &newKnownFiles = renamedKnownFiles[renamedPath(itKnownFiles.key())];
+        for (const auto &oneFile : qAsConst(itKnownFiles.value())) {
+            newKnownFiles.push_back(renamedPath(oneFile));
+        }
+
+        itKnownFiles = d->mKnownFilesByDirectory.erase(itKnownFiles);
+    }
+    for (auto itKnownFiles = renamedKnownFiles.cbegin(); itKnownFiles != renamedKnownFiles.cend(); ++itKnownFiles) {
+        d->mKnownFilesByDirectory[itKnownFiles.key()] += itKnownFiles.value();
+    }
+
+    if (renamedDirectories.isEmpty()) {
+        return;
+    }
+
+    for (const auto &oneDirectory : qAsConst(renamedDirectories)) {
+        d->mScannedDirectories[oneDirectory.mDirectory] = oneDirectory;
+    }
+
+    indexScannedChildDirectories();
+
+    // the renamed directories do not need to be listed again next time
+    Q_EMIT scannedDirectoriesList(renamedDirectories, removedDirectories);
+}
+
 void AbstractFileListing::fileChanged(const QString &modifiedFileName)
 {
     QFileInfo modifiedFileInfo(modifiedFileName);
@@ -291,6 +960,11 @@ void AbstractFileListing::fileChanged(const QString &modifiedFileName)
 void AbstractFileListing::executeInit(QHash<QUrl, QDateTime> allFiles)
 {
     d->mAllFiles = std::move(allFiles);
+
+    d->mKnownFilesByDirectory.clear();
+    for (auto itFile = d->mAllFiles.cbegin(); itFile != d->mAllFiles.cend(); ++itFile) {
+        d->mKnownFilesByDirectory[parentDirectoryKey(itFile.key())].push_back(itFile.key());
+    }
 }
 
 void AbstractFileListing::triggerStop()
@@ -334,11 +1008,13 @@ DataTypes::TrackDataType AbstractFileListing::scanOneFile(const QUrl &scanFile,
     newTrack = d->mFileScanner.scanOneFile(scanFile);
 
     if (newTrack.isValid()) {
-        newTrack[DataTypes::HasEmbeddedCover] = checkEmbeddedCoverImage(localFileName);
+        if (!newTrack.contains(DataTypes::HasEmbeddedCover)) {
+            newTrack[DataTypes::HasEmbeddedCover] = checkEmbeddedCoverImage(localFileName);
+        }
         newTrack[DataTypes::FileModificationTime] = scanFileInfo.metadataChangeTime();
 
         if (scanFileInfo.exists()) {
-            watchPath(scanFile.toLocalFile());
+            watchFile(scanFile.toLocalFile());
         }
     }
 
@@ -347,7 +1023,7 @@ DataTypes::TrackDataType AbstractFileListing::scanOneFile(const QUrl &scanFile,
 
 void AbstractFileListing::watchPath(const QString &pathName)
 {
-    if (!d->mFileSystemWatcher.addPath(pathName)) {
+    if (!d->mFileSystemWatcher->addDirectory(pathName)) {
         qCDebug(orgKdeElisaIndexer) << "AbstractFileListing::watchPath" << "fail for" << pathName;
 
         if (!d->mErrorWatchingFileSystemChanges) {
@@ -357,6 +1033,18 @@ void AbstractFileListing::watchPath(const QString &pathName)
     }
 }
 
+void AbstractFileListing::watchFile(const QString &fileName)
+{
+    if (!d->mFileSystemWatcher->addFile(fileName)) {
+        qCDebug(orgKdeElisaIndexer) << "AbstractFileListing::watchFile" << "fail for" << fileName;
+
+        if (!d->mErrorWatchingFileSystemChanges) {
+            d->mErrorWatchingFileSystemChanges = true;
+            Q_EMIT errorWatchingFileSystemChanges();
+        }
+    }
+}
+
 void AbstractFileListing::addFileInDirectory(const QUrl &newFile, const QUrl &directoryName)
 {
     const auto directoryEntry = d->mDiscoveredFiles.find(directoryName);
@@ -389,11 +1077,61 @@ void AbstractFileListing::scanDirectoryTree(const QString &path)
 
     qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::scanDirectoryTree" << path;
 
+    if (!d->mScannerPool && d->mMetadataExtractionWorkersCount > 1) {
+        d->mScannerPool = std::make_unique<FileScannerPool>(d->mMetadataExtractionWorkersCount);
+    }
+
     scanDirectory(newFiles, QUrl::fromLocalFile(path));
 
+    if (d->mScannerPool) {
+        while (d->mScannerPool->hasPendingResults() && d->mStopRequest == 0) {
+            takeScannedFile(newFiles);
+        }
+
+        d->mScannerPool->cancel();
+    }
+
+    if (!d->mRenamedFiles.isEmpty() && d->mStopRequest == 0) {
+        Q_EMIT renamedTracksList(d->mRenamedFiles);
+    }
+
+    d->mRenamedFiles.clear();
+    d->mFilesByIdentity.clear();
+    d->mHasFilesIdentityIndex = false;
+
     if (!newFiles.isEmpty() && d->mStopRequest == 0) {
         emitNewFiles(newFiles);
     }
+
+    // most directories went to the database with their tracks: send the ones without new tracks
+    // an interrupted scan drops them as their tracks may not all be in the database
+    if (d->mStopRequest == 0 && (!d->mNewScannedDirectories.isEmpty() || !d->mRemovedScannedDirectories.isEmpty())) {
+        for (const auto &oneDirectory : qAsConst(d->mNewScannedDirectories)) {
+            d->mScannedDirectories[oneDirectory.mDirectory] = oneDirectory;
+        }
+        for (const auto &oneDirectory : qAsConst(d->mRemovedScannedDirectories)) {
+            d->mScannedDirectories.remove(oneDirectory);
+        }
+
+        auto remainingScannedDirectories = DataTypes::ListDirectoryScanData{};
+        for (const auto &oneDirectory : qAsConst(d->mPendingScannedDirectories)) {
+            remainingScannedDirectories.push_back(oneDirectory.mDirectory);
+        }
+
+        if (!remainingScannedDirectories.isEmpty() || !d->mRemovedScannedDirectories.isEmpty()) {
+            Q_EMIT scannedDirectoriesList(remainingScannedDirectories, d->mRemovedScannedDirectories);
+        }
+    }
+
+    d->mNewScannedDirectories.clear();
+    d->mRemovedScannedDirectories.clear();
+    d->mPendingScannedDirectories.clear();
+    d->mScheduledFilesCount = 0;
+    d->mTakenFilesCount = 0;
+
+    qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::scanDirectoryTree" << path
+                                  << d->mFileScanner.sniffedFilesCount() << "files sniffed"
+                                  << d->mFileScanner.skippedSniffingFilesCount() << "files known from their extension";
 }
 
 void AbstractFileListing::setHandleNewFiles(bool handleThem)
@@ -403,19 +1141,77 @@ void AbstractFileListing::setHandleNewFiles(bool handleThem)
 
 void AbstractFileListing::emitNewFiles(const DataTypes::ListTrackDataType &tracks)
 {
-    Q_EMIT tracksList(tracks, d->mAllAlbumCover);
+    const auto batchId = registerTracksBatch(tracks.size());
+
+    // a directory is complete once all the files scheduled for it were taken from the pool
+    auto scannedDirectories = DataTypes::ListDirectoryScanData{};
+    while (!d->mPendingScannedDirectories.isEmpty() &&
+           d->mPendingScannedDirectories.head().mScheduledFilesCount <= d->mTakenFilesCount) {
+        scannedDirectories.push_back(d->mPendingScannedDirectories.dequeue().mDirectory);
+    }
+
+    // a recorded directory is skipped by the next scan: the tracks moved into it
+    // have to be renamed before, even if this scan is interrupted
+    if (!scannedDirectories.isEmpty() && !d->mRenamedFiles.isEmpty()) {
+        Q_EMIT renamedTracksList(d->mRenamedFiles);
+        d->mRenamedFiles.clear();
+    }
+
+    Q_EMIT tracksList(tracks, d->mAllAlbumCover, scannedDirectories, batchId);
+}
+
+bool AbstractFileListing::isNewFilesBatchReady(const DataTypes::ListTrackDataType &newFiles)
+{
+    if (newFiles.size() < d->mNewFilesBatchSize) {
+        return false;
+    }
+
+    if (d->mHasDatabaseFlowControl == 0) {
+        return true;
+    }
+
+    QMutexLocker locker(&d->mPendingBatchesMutex);
+
+    // while the database is busy, the batch grows up to its maximum size: then the scan
+    // takes no more directories or scanned files until a batch is committed
+    // the database may never answer once stopped: keep checking for a stop request
+    while (newFiles.size() >= constMaximumBatchSize && d->mPendingBatches.size() >= constMaximumPendingBatches &&
+           d->mStopRequest == 0 && d->mHasDatabaseFlowControl == 1) {
+        d->mPendingBatchesCondition.wait(&d->mPendingBatchesMutex, 100);
+    }
+
+    return d->mPendingBatches.size() < constMaximumPendingBatches;
+}
+
+qulonglong AbstractFileListing::registerTracksBatch(int tracksCount)
+{
+    const auto batchId = ++lastTracksBatchId;
+
+    if (d->mHasDatabaseFlowControl == 0) {
+        return batchId;
+    }
+
+    auto newBatch = PendingTracksBatch{};
+    newBatch.mBatchId = batchId;
+    newBatch.mEmitTime.start();
+    newBatch.mTracksCount = tracksCount;
+
+    QMutexLocker locker(&d->mPendingBatchesMutex);
+    d->mPendingBatches.enqueue(newBatch);
+
+    return batchId;
 }
 
 void AbstractFileListing::addCover(const DataTypes::TrackDataType &newTrack)
 {
-    auto itCover = d->mAllAlbumCover.find(newTrack.album());
-    if (itCover != d->mAllAlbumCover.end()) {
+    const auto trackKey = newTrack.resourceURI().toString();
+    if (d->mAllAlbumCover.contains(trackKey)) {
         return;
     }
 
     auto coverUrl = d->mFileScanner.searchForCoverFile(newTrack.resourceURI().toLocalFile());
     if (!coverUrl.isEmpty()) {
-        d->mAllAlbumCover[newTrack.resourceURI().toString()] = coverUrl;
+        d->mAllAlbumCover[trackKey] = coverUrl;
     }
 }
 
@@ -438,6 +1234,8 @@ void AbstractFileListing::removeDirectory(const QUrl &removedDirectory, QList<QU
     }
 
     d->mDiscoveredFiles.erase(itRemovedDirectory);
+
+    d->mFileScanner.invalidateDirectoryCover(removedDirectory.toLocalFile());
 }
 
 void AbstractFileListing::removeFile(const QUrl &oneRemovedTrack, QList<QUrl> &allRemovedFiles)
@@ -489,6 +1287,11 @@ void AbstractFileListing::setWaitEndTrackRemoval(bool wait)
     d->mWaitEndTrackRemoval = wait;
 }
 
+bool AbstractFileListing::isStopRequested() const
+{
+    return d->mStopRequest == 1;
+}
+
 bool AbstractFileListing::isActive() const
 {
     return d->mIsActive;
@@ -20,6 +20,8 @@
 
 #include "elisaLib_export.h"
 #include "datatypes.h"
+#include "filescannerpool.h"
+#include "directorylister.h"
 
 #include <QObject>
 #include <QString>
@@ -53,10 +55,27 @@ public:
 
 Q_SIGNALS:
 
-    void tracksList(const DataTypes::ListTrackDataType &tracks, const QHash<QString, QUrl> &covers);
+    /**
+     * scannedDirectories were completely scanned: they are recorded with these
+     * tracks so that an interrupted scan does not list them again.
+     * batchId is given back to databaseFinishedInsertingTracksList.
+     */
+    void tracksList(const DataTypes::ListTrackDataType &tracks, const QHash<QString, QUrl> &covers,
+                    const DataTypes::ListDirectoryScanData &scannedDirectories, qulonglong batchId);
 
     void removedTracksList(const QList<QUrl> &removedTracks);
 
+    /**
+     * Known tracks found under another file name: they are not scanned again.
+     */
+    void renamedTracksList(const DataTypes::ListRenamedFileData &renamedFiles);
+
+    /**
+     * Emitted at the end of scanDirectoryTree, after the tracks of the scanned directories.
+     */
+    void scannedDirectoriesList(const DataTypes::ListDirectoryScanData &scannedDirectories,
+                                const QList<QUrl> &removedDirectories);
+
     void modifyTracksList(const DataTypes::ListTrackDataType &modifiedTracks, const QHash<QString, QUrl> &covers);
 
     void indexingStarted();
@@ -77,20 +96,52 @@ public Q_SLOTS:
 
     void newTrackFile(const DataTypes::TrackDataType &partialTrack);
 
+    void restoredScannedDirectories(const DataTypes::ListDirectoryScanData &scannedDirectories);
+
     void restoredTracks(QHash<QUrl, QDateTime> allFiles);
 
     void setAllRootPaths(const QStringList &allRootPaths);
 
-    void databaseFinishedInsertingTracksList();
+    /**
+     * Set the number of threads extracting metadata while scanning directories.
+     * With one worker, files are scanned one after the other by scanOneFile.
+     */
+    void setMetadataExtractionWorkersCount(int workersCount);
+
+    /**
+     * Bound the number of batches of tracks waiting to be inserted by the database.
+     * databaseFinishedInsertingTracksList must then be connected with a direct
+     * connection: it is called in the database thread and returns a credit to
+     * the scan, that lets its new tracks accumulate while no credit is left,
+     * up to a maximum batch size.
+     */
+    void setDatabaseFlowControl(bool enabled);
+
+    /**
+     * Thread safe: may be called from the database thread.
+     * Only the batches emitted by this listing with tracksList return a credit.
+     * The batch size of the following new tracks is adapted to the time
+     * needed by the database to commit this one.
+     */
+    void databaseFinishedInsertingTracksList(qulonglong batchId);
 
     void databaseFinishedRemovingTracksList();
 
+    void databaseCleaned();
+
 protected Q_SLOTS:
 
     void directoryChanged(const QString &path);
 
     void fileChanged(const QString &modifiedFileName);
 
+    /**
+     * A track or a directory was moved inside the watched directories.
+     * Known tracks are renamed in the database, anything else is handled by
+     * scanning again the directories on both sides.
+     */
+    void pathRenamed(const QString &from, const QString &to);
+
 protected:
 
     virtual void executeInit(QHash<QUrl, QDateTime> allFiles);
@@ -105,14 +156,26 @@ protected:
 
     void watchPath(const QString &pathName);
 
+    void watchFile(const QString &fileName);
+
     void addFileInDirectory(const QUrl &newFile, const QUrl &directoryName);
 
     void scanDirectoryTree(const QString &path);
 
     void setHandleNewFiles(bool handleThem);
 
+    /**
+     * Send new tracks to the database, without waiting for it.
+     */
     void emitNewFiles(const DataTypes::ListTrackDataType &tracks);
 
+    /**
+     * Enough new tracks are accumulated to call emitNewFiles and, with flow
+     * control, the database is not already busy with the previous batches.
+     * Only for the scans: a batch of the maximum size waits for the database.
+     */
+    bool isNewFilesBatchReady(const DataTypes::ListTrackDataType &newFiles);
+
     void addCover(const DataTypes::TrackDataType &newTrack);
 
     void removeDirectory(const QUrl &removedDirectory, QList<QUrl> &allRemovedFiles);
@@ -131,10 +194,36 @@ protected:
 
     void setWaitEndTrackRemoval(bool wait);
 
+    bool isStopRequested() const;
+
     bool isActive() const;
 
 private:
 
+    qulonglong registerTracksBatch(int tracksCount);
+
+    bool scanUnchangedDirectory(DataTypes::ListTrackDataType &newFiles, const QUrl &path);
+
+    void scanNewFile(DataTypes::ListTrackDataType &newFiles, const QUrl &newFilePath,
+                     const QFileInfo &newFileInfo, const QUrl &directory);
+
+    void takeScannedFile(DataTypes::ListTrackDataType &newFiles);
+
+    void addScannedFile(DataTypes::ListTrackDataType &newFiles, const FileScannerPool::ScanResult &scannedFile);
+
+    void addNewTrack(DataTypes::ListTrackDataType &newFiles, const DataTypes::TrackDataType &newTrack, const QUrl &directory);
+
+    bool renameMovedFile(const QUrl &newFilePath, const DirectoryEntry &newFileEntry, const QUrl &directory);
+
+    void buildFilesIdentityIndex();
+
+    void indexScannedChildDirectories();
+
+    QUrl discoveredDirectory(const QString &directoryName) const;
+
+    void renameDiscoveredDirectory(const QUrl &oldDirectory, const QUrl &newDirectory,
+                                   DataTypes::ListRenamedFileData &renamedFiles);
+
     std::unique_ptr<AbstractFileListingPrivate> d;
 
 };
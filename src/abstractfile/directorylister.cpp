@@ -0,0 +1,112 @@
+/*
+ * Copyright 2026 The Elisa developers
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "directorylister.h"
+
+#include "config-upnp-qt.h"
+
+#include "abstractfile/indexercommon.h"
+
+#if LIBURING_FOUND
+#include "abstractfile/iouringdirectorylister.h"
+#endif
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+
+#if defined Q_OS_UNIX
+#include <sys/stat.h>
+#endif
+
+#include <algorithm>
+
+std::unique_ptr<DirectoryLister> DirectoryLister::create(Backend backend)
+{
+#if LIBURING_FOUND
+    if (backend == Backend::Automatic || backend == Backend::IoUring) {
+        auto ioUringLister = std::make_unique<IoUringDirectoryLister>();
+
+        if (ioUringLister->isValid()) {
+            return ioUringLister;
+        }
+
+        qCDebug(orgKdeElisaIndexer) << "DirectoryLister::create" << "io_uring is not usable, fall back to QDir";
+    }
+#else
+    Q_UNUSED(backend)
+#endif
+
+    return std::make_unique<QDirDirectoryLister>();
+}
+
+DirectoryLister::DirectoryLister()
+= default;
+
+DirectoryLister::~DirectoryLister()
+= default;
+
+void DirectoryLister::sortEntries(DirectoryEntries &entries)
+{
+    // same order as QDir::Name | QDir::IgnoreCase
+    std::sort(entries.begin(), entries.end(), [](const DirectoryEntry &first, const DirectoryEntry &second) {
+        const auto result = first.mFileName.compare(second.mFileName, Qt::CaseInsensitive);
+        if (result != 0) {
+            return result < 0;
+        }
+
+        return first.mFileName < second.mFileName;
+    });
+}
+
+DirectoryEntries QDirDirectoryLister::entries(const QString &directoryName)
+{
+    auto result = DirectoryEntries{};
+
+    QDir directory(directoryName);
+    const auto entryList = directory.entryInfoList(QDir::NoDotAndDotDot | QDir::Files | QDir::Dirs);
+
+    result.reserve(entryList.size());
+
+    for (const auto &oneEntry : entryList) {
+        auto newEntry = DirectoryEntry{};
+
+        if (oneEntry.isDir()) {
+            newEntry.mType = DirectoryEntry::Type::Directory;
+        } else if (!oneEntry.isFile()) {
+            continue;
+        }
+
+        newEntry.mFileName = oneEntry.fileName();
+        newEntry.mCanonicalFilePath = oneEntry.canonicalFilePath();
+        newEntry.mModificationTime = oneEntry.lastModified();
+        newEntry.mMetadataChangeTime = oneEntry.metadataChangeTime();
+        newEntry.mSize = oneEntry.size();
+
+#if defined Q_OS_UNIX
+        // only files are recognized by their inode when moved
+        struct stat fileStatus;
+        if (newEntry.isFile() && ::stat(QFile::encodeName(oneEntry.absoluteFilePath()).constData(), &fileStatus) == 0) {
+            newEntry.mInode = static_cast<quint64>(fileStatus.st_ino);
+        }
+#endif
+
+        result.push_back(newEntry);
+    }
+
+    return result;
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright 2026 The Elisa developers
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef DIRECTORYLISTER_H
+#define DIRECTORYLISTER_H
+
+#include "elisaLib_export.h"
+
+#include <QString>
+#include <QDateTime>
+#include <QVector>
+
+#include <memory>
+
+/**
+ * What the indexer needs to know about one entry of a directory,
+ * read with a single stat of the entry.
+ */
+class DirectoryEntry
+{
+public:
+
+    enum class Type {
+        File,
+        Directory,
+    };
+
+    bool isFile() const
+    {
+        return mType == Type::File;
+    }
+
+    bool isDir() const
+    {
+        return mType == Type::Directory;
+    }
+
+    QString mFileName;
+
+    // symbolic links are resolved
+    QString mCanonicalFilePath;
+
+    Type mType = Type::File;
+
+    QDateTime mModificationTime;
+
+    QDateTime mMetadataChangeTime;
+
+    qint64 mSize = -1;
+
+    quint64 mInode = 0;
+
+};
+
+using DirectoryEntries = QVector<DirectoryEntry>;
+
+/**
+ * List the files and directories of a directory, like QDir::entryInfoList
+ * with QDir::NoDotAndDotDot | QDir::Files | QDir::Dirs sorted by name.
+ */
+class ELISALIB_EXPORT DirectoryLister
+{
+public:
+
+    enum class Backend {
+        Automatic,
+        QDir,
+        IoUring,
+    };
+
+    /**
+     * Automatic selects io_uring when available and usable and falls back to QDir.
+     */
+    static std::unique_ptr<DirectoryLister> create(Backend backend);
+
+    DirectoryLister();
+
+    virtual ~DirectoryLister();
+
+    virtual DirectoryEntries entries(const QString &directoryName) = 0;
+
+protected:
+
+    static void sortEntries(DirectoryEntries &entries);
+
+};
+
+/**
+ * List a directory with QDir: entries are read one after the other.
+ */
+class ELISALIB_EXPORT QDirDirectoryLister : public DirectoryLister
+{
+public:
+
+    DirectoryEntries entries(const QString &directoryName) override;
+
+};
+
+#endif // DIRECTORYLISTER_H
@@ -0,0 +1,77 @@
+/*
+ * Copyright 2026 The Elisa developers
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "filesystemwatcher.h"
+
+#include "config-upnp-qt.h"
+
+#include "abstractfile/indexercommon.h"
+
+#if HAVE_INOTIFY
+#include "abstractfile/inotifyfilesystemwatcher.h"
+#endif
+
+FileSystemWatcher *FileSystemWatcher::create(Backend backend, QObject *parent)
+{
+#if HAVE_INOTIFY
+    if (backend == Backend::Automatic || backend == Backend::Inotify) {
+        auto inotifyWatcher = new InotifyFileSystemWatcher(parent);
+
+        if (inotifyWatcher->isValid()) {
+            return inotifyWatcher;
+        }
+
+        qCDebug(orgKdeElisaIndexer) << "FileSystemWatcher::create" << "inotify is not usable, fall back to QFileSystemWatcher";
+        delete inotifyWatcher;
+    }
+#else
+    Q_UNUSED(backend)
+#endif
+
+    return new QtFileSystemWatcher(parent);
+}
+
+FileSystemWatcher::FileSystemWatcher(QObject *parent) : QObject(parent)
+{
+}
+
+FileSystemWatcher::~FileSystemWatcher()
+= default;
+
+QtFileSystemWatcher::QtFileSystemWatcher(QObject *parent) : FileSystemWatcher(parent), mWatcher(this)
+{
+    connect(&mWatcher, &QFileSystemWatcher::directoryChanged,
+            this, &QtFileSystemWatcher::directoryChanged);
+    connect(&mWatcher, &QFileSystemWatcher::fileChanged,
+            this, &QtFileSystemWatcher::fileChanged);
+}
+
+QtFileSystemWatcher::~QtFileSystemWatcher()
+= default;
+
+bool QtFileSystemWatcher::addDirectory(const QString &directoryName)
+{
+    return mWatcher.addPath(directoryName);
+}
+
+bool QtFileSystemWatcher::addFile(const QString &fileName)
+{
+    return mWatcher.addPath(fileName);
+}
+
+
+#include "moc_filesystemwatcher.cpp"
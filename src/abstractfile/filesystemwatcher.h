@@ -0,0 +1,97 @@
+/*
+ * Copyright 2026 The Elisa developers
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef FILESYSTEMWATCHER_H
+#define FILESYSTEMWATCHER_H
+
+#include "elisaLib_export.h"
+
+#include <QObject>
+#include <QString>
+#include <QFileSystemWatcher>
+
+/**
+ * Watch the music directories for changes.
+ *
+ * Depending on the backend, files may be covered by the watch of their
+ * directory: addFile then does nothing and still succeeds.
+ */
+class ELISALIB_EXPORT FileSystemWatcher : public QObject
+{
+
+    Q_OBJECT
+
+public:
+
+    enum class Backend {
+        Automatic,
+        QtFileSystemWatcher,
+        Inotify,
+    };
+
+    /**
+     * Create a watcher using the requested backend, owned by parent.
+     * Automatic selects inotify when available and falls back to QFileSystemWatcher.
+     */
+    static FileSystemWatcher *create(Backend backend, QObject *parent);
+
+    explicit FileSystemWatcher(QObject *parent = nullptr);
+
+    ~FileSystemWatcher() override;
+
+    virtual bool addDirectory(const QString &directoryName) = 0;
+
+    virtual bool addFile(const QString &fileName) = 0;
+
+Q_SIGNALS:
+
+    void directoryChanged(const QString &path);
+
+    void fileChanged(const QString &path);
+
+    /**
+     * A file or a directory was renamed or moved between two watched directories.
+     */
+    void pathRenamed(const QString &from, const QString &to);
+
+};
+
+/**
+ * Watch each directory and each file with QFileSystemWatcher.
+ */
+class ELISALIB_EXPORT QtFileSystemWatcher : public FileSystemWatcher
+{
+
+    Q_OBJECT
+
+public:
+
+    explicit QtFileSystemWatcher(QObject *parent = nullptr);
+
+    ~QtFileSystemWatcher() override;
+
+    bool addDirectory(const QString &directoryName) override;
+
+    bool addFile(const QString &fileName) override;
+
+private:
+
+    QFileSystemWatcher mWatcher;
+
+};
+
+#endif // FILESYSTEMWATCHER_H
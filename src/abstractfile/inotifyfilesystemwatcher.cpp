@@ -0,0 +1,385 @@
+/*
+ * Copyright 2026 The Elisa developers
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "inotifyfilesystemwatcher.h"
+
+#include "abstractfile/indexercommon.h"
+
+#include <QSocketNotifier>
+#include <QTimer>
+#include <QHash>
+#include <QSet>
+#include <QVector>
+#include <QPair>
+#include <QDir>
+#include <QFile>
+
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+
+namespace {
+
+const int DebounceInterval = 300;
+
+const uint32_t WatchedEvents = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_CLOSE_WRITE |
+        IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+
+QString childPath(const QString &directoryName, const QString &entryName)
+{
+    if (directoryName.endsWith(QLatin1Char('/'))) {
+        return directoryName + entryName;
+    }
+
+    return directoryName + QLatin1Char('/') + entryName;
+}
+
+bool isSameOrInside(const QString &path, const QString &directoryName)
+{
+    return path == directoryName ||
+            (path.startsWith(directoryName) && path.at(directoryName.size()) == QLatin1Char('/'));
+}
+
+}
+
+class InotifyFileSystemWatcherPrivate
+{
+public:
+
+    struct PendingMove
+    {
+        QString mFrom;
+
+        QString mDirectory;
+
+        bool mIsDirectory = false;
+    };
+
+    void handleEvent(const struct inotify_event &event);
+
+    void handleMove(const PendingMove &move, const QString &to, const QString &toDirectory);
+
+    void renameWatches(const QString &from, const QString &to);
+
+    void removeWatches(const QString &directoryName);
+
+    int mInotifyDescriptor = -1;
+
+    QSocketNotifier *mNotifier = nullptr;
+
+    QTimer *mDebounceTimer = nullptr;
+
+    // watched directories are reported with the name used to add them
+    QHash<int, QString> mWatchedDirectories;
+
+    QHash<QString, int> mWatchDescriptors;
+
+    QSet<QString> mWatchedFiles;
+
+    QSet<QString> mChangedDirectories;
+
+    QSet<QString> mChangedFiles;
+
+    QSet<QString> mCreatedFiles;
+
+    QHash<uint32_t, PendingMove> mPendingMoves;
+
+    QVector<QPair<QString, QString>> mRenamedPaths;
+
+    QSet<int> mRenamedWatches;
+
+};
+
+void InotifyFileSystemWatcherPrivate::handleEvent(const struct inotify_event &event)
+{
+    if (event.mask & IN_Q_OVERFLOW) {
+        qCDebug(orgKdeElisaIndexer) << "InotifyFileSystemWatcher::readEvents" << "events queue overflow";
+        for (const auto &oneDirectory : qAsConst(mWatchedDirectories)) {
+            mChangedDirectories.insert(oneDirectory);
+        }
+        return;
+    }
+
+    const auto itDirectory = mWatchedDirectories.constFind(event.wd);
+    if (itDirectory == mWatchedDirectories.constEnd()) {
+        return;
+    }
+
+    const auto directoryName = *itDirectory;
+
+    if (event.mask & IN_IGNORED) {
+        mWatchDescriptors.remove(QDir::cleanPath(directoryName));
+        mWatchedDirectories.remove(event.wd);
+        return;
+    }
+
+    if (event.mask & IN_DELETE_SELF) {
+        mChangedDirectories.insert(directoryName);
+        return;
+    }
+
+    if (event.mask & IN_MOVE_SELF) {
+        if (!mRenamedWatches.contains(event.wd)) {
+            mChangedDirectories.insert(directoryName);
+        }
+        return;
+    }
+
+    if (event.len == 0) {
+        return;
+    }
+
+    const auto entryName = childPath(directoryName, QFile::decodeName(event.name));
+    const auto isDirectory = (event.mask & IN_ISDIR) != 0;
+
+    if (event.mask & IN_CREATE) {
+        mChangedDirectories.insert(directoryName);
+        if (!isDirectory) {
+            mCreatedFiles.insert(entryName);
+        }
+    } else if (event.mask & IN_DELETE) {
+        mChangedDirectories.insert(directoryName);
+        mChangedFiles.remove(entryName);
+        mWatchedFiles.remove(QDir::cleanPath(entryName));
+    } else if (event.mask & IN_CLOSE_WRITE) {
+        if (mWatchedFiles.contains(QDir::cleanPath(entryName))) {
+            mChangedFiles.insert(entryName);
+        }
+    } else if (event.mask & IN_MOVED_FROM) {
+        mPendingMoves.insert(event.cookie, {entryName, directoryName, isDirectory});
+    } else if (event.mask & IN_MOVED_TO) {
+        const auto itMove = mPendingMoves.find(event.cookie);
+        if (itMove == mPendingMoves.end()) {
+            // moved in from a directory that is not watched
+            mChangedDirectories.insert(directoryName);
+            return;
+        }
+
+        const auto move = *itMove;
+        mPendingMoves.erase(itMove);
+
+        handleMove(move, entryName, directoryName);
+    }
+}
+
+void InotifyFileSystemWatcherPrivate::handleMove(const PendingMove &move, const QString &to, const QString &toDirectory)
+{
+    const auto cleanFrom = QDir::cleanPath(move.mFrom);
+    const auto cleanTo = QDir::cleanPath(to);
+
+    if (move.mIsDirectory) {
+        if (!mWatchDescriptors.contains(cleanFrom)) {
+            mChangedDirectories.insert(move.mDirectory);
+            mChangedDirectories.insert(toDirectory);
+            return;
+        }
+
+        renameWatches(cleanFrom, cleanTo);
+        mRenamedPaths.push_back({move.mFrom, to});
+        return;
+    }
+
+    if (mWatchedFiles.contains(cleanTo)) {
+        // a file saved by writing a temporary file then moving it over the original one
+        mChangedDirectories.insert(move.mDirectory);
+        mChangedFiles.insert(to);
+        mWatchedFiles.remove(cleanFrom);
+        return;
+    }
+
+    if (!mWatchedFiles.contains(cleanFrom)) {
+        // not a known track: the destination may be a new one
+        mChangedDirectories.insert(move.mDirectory);
+        mChangedDirectories.insert(toDirectory);
+        return;
+    }
+
+    mWatchedFiles.remove(cleanFrom);
+    mWatchedFiles.insert(cleanTo);
+    mChangedFiles.remove(move.mFrom);
+    mRenamedPaths.push_back({move.mFrom, to});
+}
+
+void InotifyFileSystemWatcherPrivate::renameWatches(const QString &from, const QString &to)
+{
+    for (auto itDirectory = mWatchedDirectories.begin(); itDirectory != mWatchedDirectories.end(); ++itDirectory) {
+        const auto cleanDirectory = QDir::cleanPath(*itDirectory);
+        if (!isSameOrInside(cleanDirectory, from)) {
+            continue;
+        }
+
+        const auto newDirectory = to + cleanDirectory.mid(from.size());
+
+        mWatchDescriptors.remove(cleanDirectory);
+        mWatchDescriptors.insert(newDirectory, itDirectory.key());
+        mRenamedWatches.insert(itDirectory.key());
+        *itDirectory = newDirectory;
+    }
+
+    auto renamedFiles = QSet<QString>();
+    for (auto itFile = mWatchedFiles.begin(); itFile != mWatchedFiles.end(); ) {
+        if (isSameOrInside(*itFile, from)) {
+            renamedFiles.insert(to + itFile->mid(from.size()));
+            itFile = mWatchedFiles.erase(itFile);
+        } else {
+            ++itFile;
+        }
+    }
+    mWatchedFiles.unite(renamedFiles);
+}
+
+void InotifyFileSystemWatcherPrivate::removeWatches(const QString &directoryName)
+{
+    for (auto itDirectory = mWatchDescriptors.begin(); itDirectory != mWatchDescriptors.end(); ) {
+        if (isSameOrInside(itDirectory.key(), directoryName)) {
+            inotify_rm_watch(mInotifyDescriptor, itDirectory.value());
+            mWatchedDirectories.remove(itDirectory.value());
+            itDirectory = mWatchDescriptors.erase(itDirectory);
+        } else {
+            ++itDirectory;
+        }
+    }
+}
+
+InotifyFileSystemWatcher::InotifyFileSystemWatcher(QObject *parent)
+    : FileSystemWatcher(parent), d(std::make_unique<InotifyFileSystemWatcherPrivate>())
+{
+    d->mInotifyDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (d->mInotifyDescriptor == -1) {
+        qCDebug(orgKdeElisaIndexer) << "InotifyFileSystemWatcher::InotifyFileSystemWatcher" << "inotify_init1 failed" << errno;
+        return;
+    }
+
+    d->mNotifier = new QSocketNotifier(d->mInotifyDescriptor, QSocketNotifier::Read, this);
+    connect(d->mNotifier, &QSocketNotifier::activated,
+            this, &InotifyFileSystemWatcher::readEvents);
+
+    d->mDebounceTimer = new QTimer(this);
+    d->mDebounceTimer->setSingleShot(true);
+    d->mDebounceTimer->setInterval(DebounceInterval);
+    connect(d->mDebounceTimer, &QTimer::timeout,
+            this, &InotifyFileSystemWatcher::flushEvents);
+}
+
+InotifyFileSystemWatcher::~InotifyFileSystemWatcher()
+{
+    if (d->mInotifyDescriptor != -1) {
+        delete d->mNotifier;
+        ::close(d->mInotifyDescriptor);
+    }
+}
+
+bool InotifyFileSystemWatcher::isValid() const
+{
+    return d->mInotifyDescriptor != -1;
+}
+
+bool InotifyFileSystemWatcher::addDirectory(const QString &directoryName)
+{
+    const auto cleanDirectory = QDir::cleanPath(directoryName);
+
+    const auto watchDescriptor = inotify_add_watch(d->mInotifyDescriptor, QFile::encodeName(cleanDirectory).constData(), WatchedEvents);
+    if (watchDescriptor == -1) {
+        qCDebug(orgKdeElisaIndexer) << "InotifyFileSystemWatcher::addDirectory" << directoryName << "inotify_add_watch failed" << errno;
+        return false;
+    }
+
+    // the same directory may be added again under another name after a rename
+    const auto itOldName = d->mWatchedDirectories.constFind(watchDescriptor);
+    if (itOldName != d->mWatchedDirectories.constEnd()) {
+        d->mWatchDescriptors.remove(QDir::cleanPath(*itOldName));
+    }
+
+    d->mWatchedDirectories.insert(watchDescriptor, directoryName);
+    d->mWatchDescriptors.insert(cleanDirectory, watchDescriptor);
+
+    return true;
+}
+
+bool InotifyFileSystemWatcher::addFile(const QString &fileName)
+{
+    d->mWatchedFiles.insert(QDir::cleanPath(fileName));
+
+    return true;
+}
+
+void InotifyFileSystemWatcher::readEvents()
+{
+    alignas(struct inotify_event) char buffer[4096];
+
+    while (true) {
+        const auto readBytes = ::read(d->mInotifyDescriptor, buffer, sizeof(buffer));
+        if (readBytes <= 0) {
+            if (readBytes == -1 && errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+
+        for (auto currentEvent = buffer; currentEvent < buffer + readBytes; ) {
+            const auto &event = *reinterpret_cast<const struct inotify_event*>(currentEvent);
+
+            d->handleEvent(event);
+
+            currentEvent += sizeof(struct inotify_event) + event.len;
+        }
+    }
+
+    if (!d->mDebounceTimer->isActive()) {
+        d->mDebounceTimer->start();
+    }
+}
+
+void InotifyFileSystemWatcher::flushEvents()
+{
+    for (const auto &oneMove : qAsConst(d->mPendingMoves)) {
+        // moved out of the watched directories
+        d->mChangedDirectories.insert(oneMove.mDirectory);
+        if (oneMove.mIsDirectory) {
+            d->removeWatches(QDir::cleanPath(oneMove.mFrom));
+        } else {
+            d->mWatchedFiles.remove(QDir::cleanPath(oneMove.mFrom));
+        }
+    }
+    d->mPendingMoves.clear();
+
+    const auto renamedPaths = std::move(d->mRenamedPaths);
+    const auto changedDirectories = std::move(d->mChangedDirectories);
+    auto changedFiles = std::move(d->mChangedFiles);
+    changedFiles.subtract(d->mCreatedFiles);
+
+    d->mRenamedPaths.clear();
+    d->mChangedDirectories.clear();
+    d->mChangedFiles.clear();
+    d->mCreatedFiles.clear();
+    d->mRenamedWatches.clear();
+
+    for (const auto &oneRename : renamedPaths) {
+        Q_EMIT pathRenamed(oneRename.first, oneRename.second);
+    }
+
+    for (const auto &oneDirectory : changedDirectories) {
+        Q_EMIT directoryChanged(oneDirectory);
+    }
+
+    for (const auto &oneFile : qAsConst(changedFiles)) {
+        Q_EMIT fileChanged(oneFile);
+    }
+}
+
+
+#include "moc_inotifyfilesystemwatcher.cpp"
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2026 The Elisa developers
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef INOTIFYFILESYSTEMWATCHER_H
+#define INOTIFYFILESYSTEMWATCHER_H
+
+#include "elisaLib_export.h"
+
+#include "filesystemwatcher.h"
+
+#include <memory>
+
+class InotifyFileSystemWatcherPrivate;
+
+/**
+ * Watch directories with one inotify watch each.
+ *
+ * Files are not watched on their own: a modification is reported by the watch
+ * of their directory, so only the directories count against the inotify
+ * watches limit. Events are coalesced during a short debounce window and a
+ * file or directory moved between two watched directories is reported by
+ * pathRenamed instead of two directory changes.
+ */
+class ELISALIB_EXPORT InotifyFileSystemWatcher : public FileSystemWatcher
+{
+
+    Q_OBJECT
+
+public:
+
+    explicit InotifyFileSystemWatcher(QObject *parent = nullptr);
+
+    ~InotifyFileSystemWatcher() override;
+
+    bool isValid() const;
+
+    bool addDirectory(const QString &directoryName) override;
+
+    bool addFile(const QString &fileName) override;
+
+private Q_SLOTS:
+
+    void readEvents();
+
+    void flushEvents();
+
+private:
+
+    std::unique_ptr<InotifyFileSystemWatcherPrivate> d;
+
+};
+
+#endif // INOTIFYFILESYSTEMWATCHER_H
@@ -0,0 +1,307 @@
+/*
+ * Copyright 2026 The Elisa developers
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "iouringdirectorylister.h"
+
+#include "abstractfile/indexercommon.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QByteArray>
+
+#include <liburing.h>
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include <cerrno>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace {
+
+const unsigned constQueueDepth = 64;
+
+QDateTime fromTimestamp(qint64 seconds, qint64 nanoseconds)
+{
+    return QDateTime::fromMSecsSinceEpoch(seconds * 1000 + nanoseconds / 1000000);
+}
+
+bool fillEntry(DirectoryEntry &entry, const struct statx &fileStatus)
+{
+    if (S_ISDIR(fileStatus.stx_mode)) {
+        entry.mType = DirectoryEntry::Type::Directory;
+    } else if (S_ISREG(fileStatus.stx_mode)) {
+        entry.mType = DirectoryEntry::Type::File;
+    } else {
+        return false;
+    }
+
+    entry.mModificationTime = fromTimestamp(fileStatus.stx_mtime.tv_sec, fileStatus.stx_mtime.tv_nsec);
+    entry.mMetadataChangeTime = fromTimestamp(fileStatus.stx_ctime.tv_sec, fileStatus.stx_ctime.tv_nsec);
+    entry.mSize = static_cast<qint64>(fileStatus.stx_size);
+    entry.mInode = static_cast<quint64>(fileStatus.stx_ino);
+
+    return true;
+}
+
+bool fillEntry(DirectoryEntry &entry, const QByteArray &filePath)
+{
+    struct stat fileStatus;
+    if (::stat(filePath.constData(), &fileStatus) != 0) {
+        return false;
+    }
+
+    if (S_ISDIR(fileStatus.st_mode)) {
+        entry.mType = DirectoryEntry::Type::Directory;
+    } else if (S_ISREG(fileStatus.st_mode)) {
+        entry.mType = DirectoryEntry::Type::File;
+    } else {
+        return false;
+    }
+
+    entry.mModificationTime = fromTimestamp(fileStatus.st_mtim.tv_sec, fileStatus.st_mtim.tv_nsec);
+    entry.mMetadataChangeTime = fromTimestamp(fileStatus.st_ctim.tv_sec, fileStatus.st_ctim.tv_nsec);
+    entry.mSize = static_cast<qint64>(fileStatus.st_size);
+    entry.mInode = static_cast<quint64>(fileStatus.st_ino);
+
+    return true;
+}
+
+}
+
+class IoUringDirectoryListerPrivate
+{
+public:
+
+    struct io_uring mRing;
+
+    bool mIsValid = false;
+
+    // the kernel may know io_uring but not its statx request
+    bool mHasStatxRequest = true;
+
+    // what the kernel could still use for requests that never completed
+    std::vector<std::vector<struct statx>> mAbandonedStatus;
+
+    std::vector<std::vector<QByteArray>> mAbandonedFileNames;
+
+    std::vector<DIR*> mAbandonedDirectories;
+
+    /**
+     * Stop using the ring after an error. The requests in flight write to the buffers
+     * of the listing: their completions are waited for before the ring is closed and
+     * the buffers are kept as long as the lister when they cannot be.
+     */
+    void closeRing(int inFlightRequests, std::vector<struct statx> &allStatus,
+                   const std::vector<QByteArray> &fileNames, DIR *&directoryStream)
+    {
+        while (inFlightRequests > 0) {
+            struct io_uring_cqe *completion = nullptr;
+            const auto waitResult = io_uring_wait_cqe(&mRing, &completion);
+            if (waitResult == -EINTR) {
+                continue;
+            }
+            if (waitResult < 0) {
+                break;
+            }
+
+            io_uring_cqe_seen(&mRing, completion);
+            --inFlightRequests;
+        }
+
+        if (inFlightRequests > 0) {
+            qCDebug(orgKdeElisaIndexer) << "IoUringDirectoryListerPrivate::closeRing" << inFlightRequests << "requests abandoned";
+
+            // the completed entries are read from a copy, the other ones are read again synchronously
+            mAbandonedStatus.push_back(std::move(allStatus));
+            allStatus = mAbandonedStatus.back();
+            // the names are shared with the copy kept here
+            mAbandonedFileNames.push_back(fileNames);
+            mAbandonedDirectories.push_back(std::exchange(directoryStream, nullptr));
+        }
+
+        io_uring_queue_exit(&mRing);
+        mIsValid = false;
+    }
+
+};
+
+IoUringDirectoryLister::IoUringDirectoryLister() : d(std::make_unique<IoUringDirectoryListerPrivate>())
+{
+    const auto result = io_uring_queue_init(constQueueDepth, &d->mRing, 0);
+
+    d->mIsValid = (result == 0);
+
+    if (!d->mIsValid) {
+        qCDebug(orgKdeElisaIndexer) << "IoUringDirectoryLister::IoUringDirectoryLister" << "io_uring_queue_init failed" << std::strerror(-result);
+    }
+}
+
+IoUringDirectoryLister::~IoUringDirectoryLister()
+{
+    if (d->mIsValid) {
+        io_uring_queue_exit(&d->mRing);
+    }
+
+    for (auto oneDirectory : d->mAbandonedDirectories) {
+        ::closedir(oneDirectory);
+    }
+}
+
+bool IoUringDirectoryLister::isValid() const
+{
+    return d->mIsValid;
+}
+
+DirectoryEntries IoUringDirectoryLister::entries(const QString &directoryName)
+{
+    auto result = DirectoryEntries{};
+
+    const auto canonicalDirectory = QFileInfo(directoryName).canonicalFilePath();
+    if (canonicalDirectory.isEmpty()) {
+        return result;
+    }
+
+    const auto directoryPrefix = (canonicalDirectory.endsWith(QLatin1Char('/')) ? canonicalDirectory : canonicalDirectory + QLatin1Char('/'));
+
+    auto directoryStream = ::opendir(QFile::encodeName(canonicalDirectory).constData());
+    if (!directoryStream) {
+        return result;
+    }
+
+    auto fileNames = std::vector<QByteArray>{};
+    auto fileTypes = std::vector<unsigned char>{};
+
+    while (auto oneEntry = ::readdir(directoryStream)) {
+        // hidden entries, . and .. are not listed by QDir either
+        if (oneEntry->d_name[0] == '.') {
+            continue;
+        }
+
+        if (oneEntry->d_type != DT_REG && oneEntry->d_type != DT_DIR &&
+                oneEntry->d_type != DT_LNK && oneEntry->d_type != DT_UNKNOWN) {
+            continue;
+        }
+
+        fileNames.emplace_back(oneEntry->d_name);
+        fileTypes.push_back(oneEntry->d_type);
+    }
+
+    const auto entriesCount = static_cast<int>(fileNames.size());
+    auto allStatus = std::vector<struct statx>(fileNames.size());
+    auto allResults = std::vector<int>(fileNames.size(), -ENOSYS);
+
+    const auto directoryDescriptor = ::dirfd(directoryStream);
+    auto nextRequest = 0;
+    auto pendingRequests = 0;
+    // submitted to the kernel and not completed
+    auto inFlightRequests = 0;
+
+    while (d->mIsValid && (pendingRequests > 0 || (d->mHasStatxRequest && nextRequest < entriesCount))) {
+        while (d->mHasStatxRequest && nextRequest < entriesCount) {
+            auto submission = io_uring_get_sqe(&d->mRing);
+            if (!submission) {
+                break;
+            }
+
+            io_uring_prep_statx(submission, directoryDescriptor, fileNames[nextRequest].constData(), 0,
+                                STATX_BASIC_STATS, &allStatus[nextRequest]);
+            io_uring_sqe_set_data(submission, reinterpret_cast<void*>(static_cast<quintptr>(nextRequest)));
+
+            ++nextRequest;
+            ++pendingRequests;
+        }
+
+        const auto submitResult = io_uring_submit(&d->mRing);
+        if (submitResult > 0) {
+            inFlightRequests += submitResult;
+        }
+        if (submitResult < 0 && submitResult != -EINTR && submitResult != -EAGAIN && submitResult != -EBUSY) {
+            // requests still queued would point to this listing: the ring is not used anymore
+            qCDebug(orgKdeElisaIndexer) << "IoUringDirectoryLister::entries" << "io_uring_submit failed" << std::strerror(-submitResult);
+
+            d->closeRing(inFlightRequests, allStatus, fileNames, directoryStream);
+
+            break;
+        }
+
+        struct io_uring_cqe *completion = nullptr;
+        const auto waitResult = io_uring_wait_cqe(&d->mRing, &completion);
+        if (waitResult < 0) {
+            if (waitResult == -EINTR) {
+                continue;
+            }
+
+            qCDebug(orgKdeElisaIndexer) << "IoUringDirectoryLister::entries" << "io_uring_wait_cqe failed" << std::strerror(-waitResult);
+
+            d->closeRing(inFlightRequests, allStatus, fileNames, directoryStream);
+
+            break;
+        }
+
+        while (completion) {
+            const auto requestIndex = static_cast<int>(reinterpret_cast<quintptr>(io_uring_cqe_get_data(completion)));
+            allResults[requestIndex] = completion->res;
+
+            if (completion->res == -EINVAL) {
+                d->mHasStatxRequest = false;
+            }
+
+            io_uring_cqe_seen(&d->mRing, completion);
+            --pendingRequests;
+            --inFlightRequests;
+
+            completion = nullptr;
+            if (io_uring_peek_cqe(&d->mRing, &completion) != 0) {
+                completion = nullptr;
+            }
+        }
+    }
+
+    result.reserve(entriesCount);
+
+    for (int i = 0; i < entriesCount; ++i) {
+        auto newEntry = DirectoryEntry{};
+        const auto filePath = QFile::encodeName(directoryPrefix) + fileNames[i];
+
+        // entries without an answer are read synchronously
+        const auto isValidEntry = (allResults[i] == 0 ? fillEntry(newEntry, allStatus[i]) : fillEntry(newEntry, filePath));
+        if (!isValidEntry) {
+            continue;
+        }
+
+        newEntry.mFileName = QFile::decodeName(fileNames[i]);
+
+        if (fileTypes[i] == DT_LNK || fileTypes[i] == DT_UNKNOWN) {
+            newEntry.mCanonicalFilePath = QFileInfo(QFile::decodeName(filePath)).canonicalFilePath();
+        } else {
+            newEntry.mCanonicalFilePath = directoryPrefix + newEntry.mFileName;
+        }
+
+        result.push_back(newEntry);
+    }
+
+    if (directoryStream) {
+        ::closedir(directoryStream);
+    }
+
+    sortEntries(result);
+
+    return result;
+}
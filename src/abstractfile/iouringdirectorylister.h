@@ -0,0 +1,54 @@
+/*
+ * Copyright 2026 The Elisa developers
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef IOURINGDIRECTORYLISTER_H
+#define IOURINGDIRECTORYLISTER_H
+
+#include "elisaLib_export.h"
+
+#include "directorylister.h"
+
+#include <memory>
+
+class IoUringDirectoryListerPrivate;
+
+/**
+ * List a directory with one io_uring statx request in flight per entry.
+ *
+ * The names are read with readdir, io_uring has no request to read a
+ * directory. On a network file system or a spinning disk, the metadata of
+ * all the entries are then requested at once instead of one after the other.
+ */
+class ELISALIB_EXPORT IoUringDirectoryLister : public DirectoryLister
+{
+public:
+
+    IoUringDirectoryLister();
+
+    ~IoUringDirectoryLister() override;
+
+    bool isValid() const;
+
+    DirectoryEntries entries(const QString &directoryName) override;
+
+private:
+
+    std::unique_ptr<IoUringDirectoryListerPrivate> d;
+
+};
+
+#endif // IOURINGDIRECTORYLISTER_H
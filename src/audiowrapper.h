@@ -73,6 +73,15 @@ class ELISALIB_EXPORT AudioWrapper : public QObject
                READ seekable
                NOTIFY seekableChanged)
 
+    /**
+     * Minimum time in milliseconds between two positionChanged signals while
+     * playing: the position is pulled from the player at this rate.
+     */
+    Q_PROPERTY(int positionUpdateInterval
+               READ positionUpdateInterval
+               WRITE setPositionUpdateInterval
+               NOTIFY positionUpdateIntervalChanged)
+
 public:
 
     explicit AudioWrapper(QObject *parent = nullptr);
@@ -97,6 +106,8 @@ public:
 
     bool seekable() const;
 
+    int positionUpdateInterval() const;
+
 Q_SIGNALS:
 
     void mutedChanged(bool muted);
@@ -119,12 +130,20 @@ Q_SIGNALS:
 
     void seekableChanged(bool seekable);
 
+    void positionUpdateIntervalChanged();
+
     void playing();
 
     void paused();
 
     void stopped();
 
+    /**
+     * The player went on with the source given to prepareNext at the end of
+     * the previous one, without stopping.
+     */
+    void preparedSourceStarted(const QUrl &source);
+
 public Q_SLOTS:
 
     void setMuted(bool muted);
@@ -133,8 +152,19 @@ public Q_SLOTS:
 
     void setSource(const QUrl &source);
 
+    /**
+     * Open the source to play after the current one, so that the player can go
+     * on with it as soon as the current one ends. An empty url cancels it.
+     * With QtMultimedia the source is queued in the player and played without gap.
+     * With libvlc the same player is restarted on the opened source at the end of
+     * the current one: only the time to open it is saved, a short gap remains.
+     */
+    void prepareNext(const QUrl &nextSource);
+
     void setPosition(qint64 position);
 
+    void setPositionUpdateInterval(int interval);
+
     void saveUndoPosition(qint64 position);
 
     void restoreUndoPosition();
@@ -168,8 +198,6 @@ private:
 
     void playerDurationSignalChanges(qint64 newDuration);
 
-    void playerPositionSignalChanges(qint64 newPosition);
-
     void playerVolumeSignalChanges();
 
     void playerMutedSignalChanges(bool isMuted);
@@ -25,6 +25,10 @@
 #include <QTimer>
 #include <QAudio>
 #include <QDir>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <utility>
 
 #if defined Q_OS_WIN
 
@@ -54,6 +58,16 @@ public:
 
     libvlc_media_t *mMedia = nullptr;
 
+    // written in the main thread, taken in the libvlc thread at the end of the current media
+    QMutex mPreparedMediaMutex;
+
+    libvlc_media_t *mPreparedMedia = nullptr;
+
+    QUrl mPreparedSource;
+
+    // the player is stopped by the switch to the prepared media: no one should know
+    QAtomicInt mIsStartingPreparedMedia = 0;
+
     qint64 mMediaDuration = 0;
 
     QMediaPlayer::State mPreviousPlayerState = QMediaPlayer::StoppedState;
@@ -68,6 +82,26 @@ public:
 
     qint64 mPreviousPosition = 0;
 
+    // written for each position event of libvlc, published by mPositionTimer while playing
+    QAtomicInteger<qint64> mCurrentPosition = 0;
+
+    QAtomicInt mHasQueuedPosition = 0;
+
+    QAtomicInt mIsPlaying = 0;
+
+    QTimer mPositionTimer;
+
+    // read from mMedia in the libvlc thread that releases it, published with the position
+    QMutex mRadioMetadataMutex;
+
+    QString mCurrentRadioTitle;
+
+    QString mCurrentRadioNowPlaying;
+
+    QString mRadioTitle;
+
+    QString mRadioNowPlaying;
+
     QMediaPlayer::Error mError = QMediaPlayer::NoError;
 
     bool mIsMuted = false;
@@ -80,6 +114,10 @@ public:
 
     void mediaIsEnded();
 
+    libvlc_media_t *createMedia(const QUrl &source) const;
+
+    bool startPreparedMedia();
+
     bool signalPlaybackChange(QMediaPlayer::State newPlayerState);
 
     void signalMediaStatusChange(QMediaPlayer::MediaStatus newMediaStatus);
@@ -92,6 +130,8 @@ public:
 
     void signalPositionChange(float newPosition);
 
+    void publishPosition();
+
     void signalSeekableChange(bool isSeekable);
 
     void signalErrorChange(QMediaPlayer::Error errorCode);
@@ -106,6 +146,9 @@ static void vlc_callback(const struct libvlc_event_t *p_event, void *p_data)
 AudioWrapper::AudioWrapper(QObject *parent) : QObject(parent), d(std::make_unique<AudioWrapperPrivate>())
 {
     d->mParent = this;
+
+    d->mPositionTimer.setInterval(100);
+    connect(&d->mPositionTimer, &QTimer::timeout, this, [this]() {d->publishPosition();});
     d->mInstance = libvlc_new(0, nullptr);
     libvlc_set_user_agent(d->mInstance, "elisa", "Elisa Music Player");
     libvlc_set_app_id(d->mInstance, "org.kde.elisa", ELISA_VERSION_STRING, "elisa");
@@ -137,6 +180,10 @@ AudioWrapper::AudioWrapper(QObject *parent) : QObject(parent), d(std::make_uniqu
 
 AudioWrapper::~AudioWrapper()
 {
+    if (d->mPreparedMedia) {
+        libvlc_media_release(d->mPreparedMedia);
+    }
+
     if (d->mInstance) {
         libvlc_release(d->mInstance);
     }
@@ -196,6 +243,11 @@ bool AudioWrapper::seekable() const
     return d->mIsSeekable;
 }
 
+int AudioWrapper::positionUpdateInterval() const
+{
+    return d->mPositionTimer.interval();
+}
+
 QMediaPlayer::State AudioWrapper::playbackState() const
 {
     return d->mPreviousPlayerState;
@@ -227,28 +279,21 @@ void AudioWrapper::setVolume(qreal volume)
 
 void AudioWrapper::setSource(const QUrl &source)
 {
-    if (source.isLocalFile()) {
-        qCDebug(orgKdeElisaPlayerVlc) << "AudioWrapper::setSource reading local resource";
-        d->mMedia = libvlc_media_new_path(d->mInstance, QDir::toNativeSeparators(source.toLocalFile()).toUtf8().constData());
-    } else {
-        qCDebug(orgKdeElisaPlayerVlc) << "AudioWrapper::setSource reading remote resource";
-        d->mMedia = libvlc_media_new_location(d->mInstance, source.url().toUtf8().constData());
+    {
+        QMutexLocker locker(&d->mPreparedMediaMutex);
+
+        // skipping to the next track: it is already opened
+        if (d->mPreparedMedia && d->mPreparedSource == source) {
+            qCDebug(orgKdeElisaPlayerVlc) << "AudioWrapper::setSource reading prepared resource";
+            d->mMedia = std::exchange(d->mPreparedMedia, nullptr);
+            d->mPreparedSource.clear();
+        } else {
+            d->mMedia = d->createMedia(source);
+        }
     }
 
     if (!d->mMedia) {
-        qCDebug(orgKdeElisaPlayerVlc) << "AudioWrapper::setSource"
-                 << "failed creating media"
-                 << libvlc_errmsg()
-                 << QDir::toNativeSeparators(source.toLocalFile()).toUtf8().constData();
-
-        d->mMedia = libvlc_media_new_path(d->mInstance, QDir::toNativeSeparators(source.toLocalFile()).toLatin1().constData());
-        if (!d->mMedia) {
-            qCDebug(orgKdeElisaPlayerVlc) << "AudioWrapper::setSource"
-                     << "failed creating media"
-                     << libvlc_errmsg()
-                     << QDir::toNativeSeparators(source.toLocalFile()).toLatin1().constData();
-            return;
-        }
+        return;
     }
 
     libvlc_media_player_set_media(d->mPlayer, d->mMedia);
@@ -262,6 +307,43 @@ void AudioWrapper::setSource(const QUrl &source)
     d->signalMediaStatusChange(QMediaPlayer::BufferedMedia);
 }
 
+void AudioWrapper::prepareNext(const QUrl &nextSource)
+{
+    if (!d->mPlayer) {
+        return;
+    }
+
+    QMutexLocker locker(&d->mPreparedMediaMutex);
+
+    if (d->mPreparedSource == nextSource) {
+        return;
+    }
+
+    if (d->mPreparedMedia) {
+        libvlc_media_release(d->mPreparedMedia);
+        d->mPreparedMedia = nullptr;
+    }
+    d->mPreparedSource.clear();
+
+    if (nextSource.isEmpty()) {
+        return;
+    }
+
+    d->mPreparedMedia = d->createMedia(nextSource);
+    if (!d->mPreparedMedia) {
+        return;
+    }
+
+    d->mPreparedSource = nextSource;
+
+    // read the headers now instead of at the end of the current track
+    if (nextSource.isLocalFile()) {
+        libvlc_media_parse_with_options(d->mPreparedMedia, libvlc_media_parse_local, -1);
+    }
+
+    qCDebug(orgKdeElisaPlayerVlc) << "AudioWrapper::prepareNext" << nextSource;
+}
+
 void AudioWrapper::setPosition(qint64 position)
 {
     if (!d->mPlayer) {
@@ -276,6 +358,16 @@ void AudioWrapper::setPosition(qint64 position)
     libvlc_media_player_set_position(d->mPlayer, static_cast<float>(position) / d->mMediaDuration);
 }
 
+void AudioWrapper::setPositionUpdateInterval(int interval)
+{
+    if (d->mPositionTimer.interval() == interval) {
+        return;
+    }
+
+    d->mPositionTimer.setInterval(interval);
+    Q_EMIT positionUpdateIntervalChanged();
+}
+
 void AudioWrapper::savePosition(qint64 position)
 {
     if (!d->mHasSavedPosition) {
@@ -353,14 +445,19 @@ void AudioWrapper::playerStateSignalChanges(QMediaPlayer::State newState)
         case QMediaPlayer::StoppedState:
             Q_EMIT stopped();
             d->mPowerInterface.setPreventSleep(false);
+            d->mPositionTimer.stop();
+            d->publishPosition();
             break;
         case QMediaPlayer::PlayingState:
             Q_EMIT playing();
             d->mPowerInterface.setPreventSleep(true);
+            d->mPositionTimer.start();
             break;
         case QMediaPlayer::PausedState:
             Q_EMIT paused();
             d->mPowerInterface.setPreventSleep(false);
+            d->mPositionTimer.stop();
+            d->publishPosition();
             break;
         }
     }, Qt::QueuedConnection);
@@ -381,11 +478,6 @@ void AudioWrapper::playerDurationSignalChanges(qint64 newDuration)
     QMetaObject::invokeMethod(this, [this, newDuration]() {Q_EMIT durationChanged(newDuration);}, Qt::QueuedConnection);
 }
 
-void AudioWrapper::playerPositionSignalChanges(qint64 newPosition)
-{
-    QMetaObject::invokeMethod(this, [this, newPosition]() {Q_EMIT positionChanged(newPosition);}, Qt::QueuedConnection);
-}
-
 void AudioWrapper::playerVolumeSignalChanges()
 {
     QMetaObject::invokeMethod(this, [this]() {Q_EMIT volumeChanged();}, Qt::QueuedConnection);
@@ -417,6 +509,7 @@ void AudioWrapperPrivate::vlcEventCallback(const struct libvlc_event_t *p_event)
         break;
     case libvlc_MediaPlayerPlaying:
         qCDebug(orgKdeElisaPlayerVlc) << "AudioWrapperPrivate::vlcEventCallback" << "libvlc_MediaPlayerPlaying";
+        mIsStartingPreparedMedia = 0;
         signalPlaybackChange(QMediaPlayer::PlayingState);
         break;
     case libvlc_MediaPlayerPaused:
@@ -425,10 +518,16 @@ void AudioWrapperPrivate::vlcEventCallback(const struct libvlc_event_t *p_event)
         break;
     case libvlc_MediaPlayerStopped:
         qCDebug(orgKdeElisaPlayerVlc) << "AudioWrapperPrivate::vlcEventCallback" << "libvlc_MediaPlayerStopped";
+        if (mIsStartingPreparedMedia == 1) {
+            break;
+        }
         signalPlaybackChange(QMediaPlayer::StoppedState);
         break;
     case libvlc_MediaPlayerEndReached:
         qCDebug(orgKdeElisaPlayerVlc) << "AudioWrapperPrivate::vlcEventCallback" << "libvlc_MediaPlayerEndReached";
+        if (startPreparedMedia()) {
+            break;
+        }
         signalMediaStatusChange(QMediaPlayer::BufferedMedia);
         signalMediaStatusChange(QMediaPlayer::NoMedia);
         signalMediaStatusChange(QMediaPlayer::EndOfMedia);
@@ -436,6 +535,7 @@ void AudioWrapperPrivate::vlcEventCallback(const struct libvlc_event_t *p_event)
         break;
     case libvlc_MediaPlayerEncounteredError:
         qCDebug(orgKdeElisaPlayerVlc) << "AudioWrapperPrivate::vlcEventCallback" << "libvlc_MediaPlayerEncounteredError";
+        mIsStartingPreparedMedia = 0;
         signalErrorChange(QMediaPlayer::ResourceError);
         mediaIsEnded();
         signalMediaStatusChange(QMediaPlayer::InvalidMedia);
@@ -483,10 +583,72 @@ void AudioWrapperPrivate::mediaIsEnded()
     mMedia = nullptr;
 }
 
+libvlc_media_t *AudioWrapperPrivate::createMedia(const QUrl &source) const
+{
+    libvlc_media_t *newMedia = nullptr;
+
+    if (source.isLocalFile()) {
+        qCDebug(orgKdeElisaPlayerVlc) << "AudioWrapperPrivate::createMedia reading local resource";
+        newMedia = libvlc_media_new_path(mInstance, QDir::toNativeSeparators(source.toLocalFile()).toUtf8().constData());
+    } else {
+        qCDebug(orgKdeElisaPlayerVlc) << "AudioWrapperPrivate::createMedia reading remote resource";
+        newMedia = libvlc_media_new_location(mInstance, source.url().toUtf8().constData());
+    }
+
+    if (!newMedia) {
+        qCDebug(orgKdeElisaPlayerVlc) << "AudioWrapperPrivate::createMedia"
+                 << "failed creating media"
+                 << libvlc_errmsg()
+                 << QDir::toNativeSeparators(source.toLocalFile()).toUtf8().constData();
+
+        newMedia = libvlc_media_new_path(mInstance, QDir::toNativeSeparators(source.toLocalFile()).toLatin1().constData());
+        if (!newMedia) {
+            qCDebug(orgKdeElisaPlayerVlc) << "AudioWrapperPrivate::createMedia"
+                     << "failed creating media"
+                     << libvlc_errmsg()
+                     << QDir::toNativeSeparators(source.toLocalFile()).toLatin1().constData();
+        }
+    }
+
+    return newMedia;
+}
+
+bool AudioWrapperPrivate::startPreparedMedia()
+{
+    QMutexLocker locker(&mPreparedMediaMutex);
+
+    if (!mPreparedMedia) {
+        return false;
+    }
+
+    auto preparedMedia = std::exchange(mPreparedMedia, nullptr);
+    auto preparedSource = std::exchange(mPreparedSource, {});
+
+    mIsStartingPreparedMedia = 1;
+
+    // the player cannot be controlled from its own event callback
+    // it has stopped when it is restarted on the prepared media: this is not gapless,
+    // that would need a second player pre-rolled and paused on the prepared media
+    QMetaObject::invokeMethod(mParent, [this, preparedMedia, preparedSource]() {
+        if (mMedia) {
+            mediaIsEnded();
+        }
+        mMedia = preparedMedia;
+
+        libvlc_media_player_set_media(mPlayer, mMedia);
+        libvlc_media_player_play(mPlayer);
+
+        Q_EMIT mParent->preparedSourceStarted(preparedSource);
+    }, Qt::QueuedConnection);
+
+    return true;
+}
+
 bool AudioWrapperPrivate::signalPlaybackChange(QMediaPlayer::State newPlayerState)
 {
     if (mPreviousPlayerState != newPlayerState) {
         mPreviousPlayerState = newPlayerState;
+        mIsPlaying = (newPlayerState == QMediaPlayer::PlayingState ? 1 : 0);
 
         mParent->playerStateSignalChanges(mPreviousPlayerState);
 
@@ -546,19 +708,55 @@ void AudioWrapperPrivate::signalPositionChange(float newPosition)
         return;
     }
 
-    auto computedPosition = qRound64(newPosition * mMediaDuration);
+    mCurrentPosition = qRound64(newPosition * mMediaDuration);
+
+    if (mMedia) {
+        const auto metaValue = [this](libvlc_meta_t metaType) {
+            auto value = libvlc_media_get_meta(mMedia, metaType);
+            auto result = QString(QLatin1String(value));
+            libvlc_free(value);
+            return result;
+        };
+
+        const auto title = metaValue(libvlc_meta_Title);
+        const auto nowPlaying = metaValue(libvlc_meta_NowPlaying);
+
+        QMutexLocker locker(&mRadioMetadataMutex);
+        mCurrentRadioTitle = title;
+        mCurrentRadioNowPlaying = nowPlaying;
+    }
+
+    // while playing, the position timer reads it: one queued call at most otherwise, after a seek
+    if (mIsPlaying == 0 && mHasQueuedPosition.testAndSetOrdered(0, 1)) {
+        QMetaObject::invokeMethod(mParent, [this]() {publishPosition();}, Qt::QueuedConnection);
+    }
+}
+
+void AudioWrapperPrivate::publishPosition()
+{
+    mHasQueuedPosition = 0;
+
+    const qint64 currentPosition = mCurrentPosition;
 
-    if (mPreviousPosition != computedPosition) {
-        mPreviousPosition = computedPosition;
+    if (mPreviousPosition != currentPosition) {
+        mPreviousPosition = currentPosition;
 
-        mParent->playerPositionSignalChanges(mPreviousPosition);
+        Q_EMIT mParent->positionChanged(mPreviousPosition);
+    }
+
+    QString title;
+    QString nowPlaying;
+    {
+        QMutexLocker locker(&mRadioMetadataMutex);
+        title = mCurrentRadioTitle;
+        nowPlaying = mCurrentRadioNowPlaying;
     }
 
-    if (this->mMedia) {
-        QString title = QLatin1String(libvlc_media_get_meta(this->mMedia, libvlc_meta_Title));
-        QString nowPlaying = QLatin1String(libvlc_media_get_meta(this->mMedia, libvlc_meta_NowPlaying));
+    if (title != mRadioTitle || nowPlaying != mRadioNowPlaying) {
+        mRadioTitle = title;
+        mRadioNowPlaying = nowPlaying;
 
-        Q_EMIT mParent->currentPlayingForRadiosChanged(title, nowPlaying);
+        Q_EMIT mParent->currentPlayingForRadiosChanged(mRadioTitle, mRadioNowPlaying);
     }
 }
 
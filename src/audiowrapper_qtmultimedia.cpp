@@ -22,6 +22,7 @@
 
 #include <QTimer>
 #include <QAudio>
+#include <QMediaPlaylist>
 
 #include "config-upnp-qt.h"
 
@@ -34,6 +35,15 @@ public:
 
     QMediaPlayer mPlayer;
 
+    // the current source and the prepared one: the player goes on with it by itself
+    QMediaPlaylist mPlayList;
+
+    QUrl mPreparedSource;
+
+    int mPreparedIndex = -1;
+
+    void appendPreparedSource();
+
     qint64 mSavedPosition = 0.0;
 
     qint64 mUndoSavedPosition = 0.0;
@@ -44,9 +54,11 @@ public:
 
 AudioWrapper::AudioWrapper(QObject *parent) : QObject(parent), d(std::make_unique<AudioWrapperPrivate>())
 {
+    d->mPlayer.setPlaylist(&d->mPlayList);
+
     connect(&d->mPlayer, &QMediaPlayer::mutedChanged, this, &AudioWrapper::playerMutedChanged);
     connect(&d->mPlayer, &QMediaPlayer::volumeChanged, this, &AudioWrapper::playerVolumeChanged);
-    connect(&d->mPlayer, &QMediaPlayer::mediaChanged, this, &AudioWrapper::sourceChanged);
+    connect(&d->mPlayer, &QMediaPlayer::currentMediaChanged, this, &AudioWrapper::sourceChanged);
     connect(&d->mPlayer, &QMediaPlayer::mediaStatusChanged, this, &AudioWrapper::statusChanged);
     connect(&d->mPlayer, &QMediaPlayer::mediaStatusChanged, this, &AudioWrapper::mediaStatusChanged);
     connect(&d->mPlayer, &QMediaPlayer::stateChanged, this, &AudioWrapper::playbackStateChanged);
@@ -55,6 +67,20 @@ AudioWrapper::AudioWrapper(QObject *parent) : QObject(parent), d(std::make_uniqu
     connect(&d->mPlayer, &QMediaPlayer::durationChanged, this, &AudioWrapper::durationChanged);
     connect(&d->mPlayer, &QMediaPlayer::positionChanged, this, &AudioWrapper::positionChanged);
     connect(&d->mPlayer, &QMediaPlayer::seekableChanged, this, &AudioWrapper::seekableChanged);
+    connect(&d->mPlayer, &QMediaPlayer::notifyIntervalChanged, this, &AudioWrapper::positionUpdateIntervalChanged);
+    connect(&d->mPlayList, &QMediaPlaylist::currentIndexChanged, this, [this](int position) {
+        if (position == -1 || position != d->mPreparedIndex) {
+            return;
+        }
+
+        qCDebug(orgKdeElisaPlayerQtMultimedia) << "AudioWrapper::preparedSourceStarted" << d->mPreparedSource;
+
+        const auto preparedSource = d->mPreparedSource;
+        d->mPreparedSource.clear();
+        d->mPreparedIndex = -1;
+
+        Q_EMIT preparedSourceStarted(preparedSource);
+    });
 }
 
 AudioWrapper::~AudioWrapper()
@@ -75,7 +101,7 @@ qreal AudioWrapper::volume() const
 
 QUrl AudioWrapper::source() const
 {
-    return d->mPlayer.media().canonicalUrl();
+    return d->mPlayer.currentMedia().canonicalUrl();
 }
 
 QMediaPlayer::Error AudioWrapper::error() const
@@ -102,6 +128,11 @@ bool AudioWrapper::seekable() const
     return d->mPlayer.isSeekable();
 }
 
+int AudioWrapper::positionUpdateInterval() const
+{
+    return d->mPlayer.notifyInterval();
+}
+
 QMediaPlayer::State AudioWrapper::playbackState() const
 {
     return d->mPlayer.state();
@@ -129,7 +160,41 @@ void AudioWrapper::setSource(const QUrl &source)
 {
     qCDebug(orgKdeElisaPlayerQtMultimedia) << "AudioWrapper::setSource" << source;
 
-    d->mPlayer.setMedia({source});
+    d->mPreparedIndex = -1;
+    d->mPlayList.clear();
+
+    if (source.isEmpty()) {
+        return;
+    }
+
+    d->mPlayList.addMedia(source);
+    d->mPlayList.setCurrentIndex(0);
+
+    if (source == d->mPreparedSource) {
+        d->mPreparedSource.clear();
+    } else {
+        d->appendPreparedSource();
+    }
+}
+
+void AudioWrapper::prepareNext(const QUrl &nextSource)
+{
+    qCDebug(orgKdeElisaPlayerQtMultimedia) << "AudioWrapper::prepareNext" << nextSource;
+
+    if (d->mPreparedSource == nextSource) {
+        return;
+    }
+
+    // only the current source is kept before the new prepared one
+    const auto currentIndex = d->mPlayList.currentIndex();
+    if (d->mPlayList.mediaCount() > currentIndex + 1) {
+        d->mPlayList.removeMedia(currentIndex + 1, d->mPlayList.mediaCount() - 1);
+    }
+
+    d->mPreparedIndex = -1;
+    d->mPreparedSource = nextSource;
+
+    d->appendPreparedSource();
 }
 
 void AudioWrapper::setPosition(qint64 position)
@@ -144,6 +209,11 @@ void AudioWrapper::setPosition(qint64 position)
     d->mPlayer.setPosition(position);
 }
 
+void AudioWrapper::setPositionUpdateInterval(int interval)
+{
+    d->mPlayer.setNotifyInterval(interval);
+}
+
 void AudioWrapper::play()
 {
     qCDebug(orgKdeElisaPlayerQtMultimedia) << "AudioWrapper::play";
@@ -240,11 +310,6 @@ void AudioWrapper::playerDurationSignalChanges(qint64 newDuration)
     QMetaObject::invokeMethod(this, [this, newDuration]() {Q_EMIT durationChanged(newDuration);}, Qt::QueuedConnection);
 }
 
-void AudioWrapper::playerPositionSignalChanges(qint64 newPosition)
-{
-    QMetaObject::invokeMethod(this, [this, newPosition]() {Q_EMIT positionChanged(newPosition);}, Qt::QueuedConnection);
-}
-
 void AudioWrapper::playerVolumeSignalChanges()
 {
     QMetaObject::invokeMethod(this, [this]() {Q_EMIT volumeChanged();}, Qt::QueuedConnection);
@@ -275,6 +340,18 @@ void AudioWrapper::restoreUndoPosition()
     d->mSavedPosition = d->mUndoSavedPosition;
 }
 
+void AudioWrapperPrivate::appendPreparedSource()
+{
+    const auto currentIndex = mPlayList.currentIndex();
+
+    if (mPreparedSource.isEmpty() || currentIndex == -1) {
+        return;
+    }
+
+    mPlayList.addMedia(mPreparedSource);
+    mPreparedIndex = currentIndex + 1;
+}
+
 void AudioWrapper::savePosition(qint64 position)
 {
     qCDebug(orgKdeElisaPlayerQtMultimedia) << "AudioWrapper::savePosition" << position;
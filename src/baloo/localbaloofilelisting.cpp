@@ -307,6 +307,8 @@ void LocalBalooFileListing::registerToBaloo()
 void LocalBalooFileListing::renamedFiles(const QString &from, const QString &to, const QStringList &listFiles)
 {
     qCDebug(orgKdeElisaBaloo) << "LocalBalooFileListing::renamedFiles" << from << to << listFiles;
+
+    pathRenamed(from, to);
 }
 
 void LocalBalooFileListing::serviceOwnerChanged(const QString &serviceName, const QString &oldOwner, const QString &newOwner)
@@ -421,7 +423,7 @@ void LocalBalooFileListing::triggerRefreshOfContent()
 
         if (newTrack.isValid()) {
             newFiles.push_back(newTrack);
-            if (newFiles.size() > 500 && d->mStopRequest == 0) {
+            if (isNewFilesBatchReady(newFiles) && d->mStopRequest == 0) {
                 qCDebug(orgKdeElisaBaloo()) << "LocalBalooFileListing::triggerRefreshOfContent" << "insert new tracks in database" << newFiles.count();
                 emitNewFiles(newFiles);
                 newFiles.clear();
@@ -470,7 +472,9 @@ DataTypes::TrackDataType LocalBalooFileListing::scanOneFile(const QUrl &scanFile
     }
 
     if (trackData.isValid()) {
-        trackData[DataTypes::HasEmbeddedCover] = checkEmbeddedCoverImage(localFileName);
+        if (!trackData.contains(DataTypes::HasEmbeddedCover)) {
+            trackData[DataTypes::HasEmbeddedCover] = checkEmbeddedCoverImage(localFileName);
+        }
         addCover(trackData);
     } else {
         qCDebug(orgKdeElisaBaloo) << "LocalBalooFileListing::scanOneFile" << scanFile << "invalid track";
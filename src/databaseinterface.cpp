@@ -17,6 +17,7 @@
 
 #include "databaseinterface.h"
 
+#include "stringpool.h"
 #include "databaseLogging.h"
 
 #include <KI18n/KLocalizedString>
@@ -30,18 +31,51 @@
 #include <QSqlError>
 
 #include <QDateTime>
+#include <QMetaMethod>
 #include <QMutex>
+#include <QRegularExpression>
 #include <QVariant>
 #include <QAtomicInt>
 #include <QElapsedTimer>
 #include <QDebug>
 
 #include <algorithm>
+#include <utility>
 
 class DatabaseInterfacePrivate
 {
 public:
 
+    struct AlbumCacheKey
+    {
+        QString mTitle;
+
+        QString mArtist;
+
+        QString mAlbumPath;
+
+        bool operator==(const AlbumCacheKey &other) const
+        {
+            return mTitle == other.mTitle && mArtist == other.mArtist && mAlbumPath == other.mAlbumPath;
+        }
+
+        friend uint qHash(const AlbumCacheKey &key, uint seed = 0)
+        {
+            return qHash(key.mTitle, seed) ^ qHash(key.mArtist, seed) ^ qHash(key.mAlbumPath, seed);
+        }
+    };
+
+    struct PendingAlbumUpdate
+    {
+        qulonglong mAlbumId = 0;
+
+        QUrl mAlbumCover;
+
+        DataTypes::TrackDataType mTrack;
+
+        QString mTrackPath;
+    };
+
     DatabaseInterfacePrivate(const QSqlDatabase &tracksDatabase)
         : mTracksDatabase(tracksDatabase), mSelectAlbumQuery(mTracksDatabase),
           mSelectTrackQuery(mTracksDatabase), mSelectAlbumIdFromTitleQuery(mTracksDatabase),
@@ -64,6 +98,7 @@ public:
           mUpdateAlbumArtUriFromAlbumIdQuery(mTracksDatabase), mSelectTracksMappingPriorityByTrackId(mTracksDatabase),
           mSelectAlbumIdsFromArtist(mTracksDatabase), mSelectAllTrackFilesQuery(mTracksDatabase),
           mRemoveTracksMappingFromSource(mTracksDatabase), mRemoveTracksMapping(mTracksDatabase),
+          mRenameTrackOriginQuery(mTracksDatabase),
           mSelectTracksWithoutMappingQuery(mTracksDatabase), mSelectAlbumIdFromTitleAndArtistQuery(mTracksDatabase),
           mSelectAlbumIdFromTitleWithoutArtistQuery(mTracksDatabase),
           mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery(mTracksDatabase), mSelectAlbumArtUriFromAlbumIdQuery(mTracksDatabase),
@@ -89,7 +124,15 @@ public:
           mArtistMatchGenreQuery(mTracksDatabase), mSelectTrackIdQuery(mTracksDatabase),
           mInsertRadioQuery(mTracksDatabase), mDeleteRadioQuery(mTracksDatabase),
           mSelectTrackFromIdAndUrlQuery(mTracksDatabase),
-          mUpdateDatabaseVersionQuery(mTracksDatabase), mSelectDatabaseVersionQuery(mTracksDatabase)
+          mUpdateDatabaseVersionQuery(mTracksDatabase), mSelectDatabaseVersionQuery(mTracksDatabase),
+          mRefreshAlbumStatsQuery(mTracksDatabase), mRemoveAlbumStatsQuery(mTracksDatabase),
+          mClearAlbumStatsTable(mTracksDatabase), mIndexTrackSearchQuery(mTracksDatabase),
+          mRemoveTrackSearchQuery(mTracksDatabase), mClearTracksSearchTable(mTracksDatabase),
+          mSearchTracksQuery(mTracksDatabase), mSearchAlbumsQuery(mTracksDatabase),
+          mSearchArtistsQuery(mTracksDatabase), mSearchTrackIdsQuery(mTracksDatabase),
+          mSearchAlbumIdsQuery(mTracksDatabase), mSearchArtistIdsQuery(mTracksDatabase),
+          mSelectAllScannedDirectoriesQuery(mTracksDatabase), mInsertScannedDirectoryQuery(mTracksDatabase),
+          mRemoveScannedDirectoryQuery(mTracksDatabase), mClearScannedDirectoriesTable(mTracksDatabase)
     {
     }
 
@@ -169,6 +212,8 @@ public:
 
     QSqlQuery mRemoveTracksMapping;
 
+    QSqlQuery mRenameTrackOriginQuery;
+
     QSqlQuery mSelectTracksWithoutMappingQuery;
 
     QSqlQuery mSelectAlbumIdFromTitleAndArtistQuery;
@@ -271,8 +316,51 @@ public:
 
     QSqlQuery mSelectDatabaseVersionQuery;
 
+    QSqlQuery mRefreshAlbumStatsQuery;
+
+    QSqlQuery mRemoveAlbumStatsQuery;
+
+    QSqlQuery mClearAlbumStatsTable;
+
+    QSqlQuery mIndexTrackSearchQuery;
+
+    QSqlQuery mRemoveTrackSearchQuery;
+
+    QSqlQuery mClearTracksSearchTable;
+
+    QSqlQuery mSearchTracksQuery;
+
+    QSqlQuery mSearchAlbumsQuery;
+
+    QSqlQuery mSearchArtistsQuery;
+
+    QSqlQuery mSearchTrackIdsQuery;
+
+    QSqlQuery mSearchAlbumIdsQuery;
+
+    QSqlQuery mSearchArtistIdsQuery;
+
+    // one query per type of data, sort order and use of the full text index, see pageQueryKey
+    QHash<int, QSqlQuery> mPageQueries;
+
+    QSqlQuery mSelectAllScannedDirectoriesQuery;
+
+    QSqlQuery mInsertScannedDirectoryQuery;
+
+    QSqlQuery mRemoveScannedDirectoryQuery;
+
+    QSqlQuery mClearScannedDirectoriesTable;
+
     QSet<qulonglong> mModifiedTrackIds;
 
+    QHash<qulonglong, DataTypes::TrackDataType> mTracksChanges;
+
+    QVector<qulonglong> mRemovedTrackIds;
+
+    QVector<qulonglong> mRemovedAlbumIds;
+
+    QVector<qulonglong> mRemovedArtistIds;
+
     QSet<qulonglong> mModifiedAlbumIds;
 
     QSet<qulonglong> mModifiedArtistIds;
@@ -283,6 +371,49 @@ public:
 
     QSet<qulonglong> mInsertedArtists;
 
+    QSet<qulonglong> mInsertedGenres;
+
+    bool mHasInsertedComposers = false;
+
+    bool mHasInsertedLyricists = false;
+
+    QHash<QString, qulonglong> mBatchTracksMapping;
+
+    QHash<QString, qulonglong> mArtistIdsCache;
+
+    QHash<QString, qulonglong> mGenreIdsCache;
+
+    QHash<QString, qulonglong> mComposerIdsCache;
+
+    QHash<QString, qulonglong> mLyricistIdsCache;
+
+    // last album found or inserted by insertAlbum for a title and a path with the artist used for the lookup
+    QHash<QPair<QString, QString>, QPair<QString, qulonglong>> mAlbumIdsCache;
+
+    QHash<AlbumCacheKey, qulonglong> mAlbumIdsFromTitleAndArtistCache;
+
+    qulonglong mNamesCacheHits = 0;
+
+    qulonglong mNamesCacheMisses = 0;
+
+    qulonglong mAlbumsCacheHits = 0;
+
+    qulonglong mAlbumsCacheMisses = 0;
+
+    QList<QVariantList> mPendingTracks;
+
+    // text of mSelectTrackFromIdQuery with a %1 for the placeholders of the ids
+    QString mSelectTracksFromIdsQueryText;
+
+    // album updates of the pending tracks, done after their rows are inserted to see all the tracks of the album
+    QList<PendingAlbumUpdate> mPendingAlbumUpdates;
+
+    // albums whose row in AlbumStats must be computed again before being read or committed
+    QSet<qulonglong> mAlbumsStatsToRefresh;
+
+    // tracks whose row in TracksSearch must be indexed again before being read or committed
+    QSet<qulonglong> mTracksSearchToRefresh;
+
     qulonglong mAlbumId = 1;
 
     qulonglong mArtistId = 1;
@@ -301,8 +432,276 @@ public:
 
     bool mIsInBadState = false;
 
+    bool mSearchIndexAvailable = false;
+
+    template <typename Key>
+    static void removeCachedId(QHash<Key, qulonglong> &cache, qulonglong id)
+    {
+        for (auto itCache = cache.begin(); itCache != cache.end(); ) {
+            if (itCache.value() == id) {
+                itCache = cache.erase(itCache);
+            } else {
+                ++itCache;
+            }
+        }
+    }
+
+    void removeCachedAlbumId(qulonglong albumId)
+    {
+        for (auto itCache = mAlbumIdsCache.begin(); itCache != mAlbumIdsCache.end(); ) {
+            if (itCache.value().second == albumId) {
+                itCache = mAlbumIdsCache.erase(itCache);
+            } else {
+                ++itCache;
+            }
+        }
+
+        removeCachedId(mAlbumIdsFromTitleAndArtistCache, albumId);
+    }
+
+    void clearIdsCaches()
+    {
+        mArtistIdsCache.clear();
+        mGenreIdsCache.clear();
+        mComposerIdsCache.clear();
+        mLyricistIdsCache.clear();
+        mAlbumIdsCache.clear();
+        mAlbumIdsFromTitleAndArtistCache.clear();
+    }
+
+    // ids and entries cached during a transaction that was not committed may name rows that do not exist
+    void discardTransactionCaches()
+    {
+        clearIdsCaches();
+        mBatchTracksMapping.clear();
+        mPendingTracks.clear();
+        mPendingAlbumUpdates.clear();
+        mAlbumsStatsToRefresh.clear();
+        mTracksSearchToRefresh.clear();
+    }
+
+    // keep the number of bound values below the default SQLITE_MAX_VARIABLE_NUMBER (999)
+    static constexpr int mSelectBatchSize = 400;
+
+    static constexpr int mInsertNamesBatchSize = 400;
+
+    static constexpr int mInsertTracksBatchSize = 40;
+
+    enum PendingTrackColumns {
+        PendingTrackId,
+        PendingTrackFileName,
+        PendingTrackPriority,
+        PendingTrackTitle,
+        PendingTrackArtistName,
+        PendingTrackAlbumTitle,
+        PendingTrackAlbumArtistName,
+        PendingTrackAlbumPath,
+        PendingTrackGenre,
+        PendingTrackComposer,
+        PendingTrackLyricist,
+        PendingTrackComment,
+        PendingTrackNumber,
+        PendingTrackDiscNumber,
+        PendingTrackChannels,
+        PendingTrackBitRate,
+        PendingTrackSampleRate,
+        PendingTrackYear,
+        PendingTrackDuration,
+        PendingTrackRating,
+        PendingTrackHasEmbeddedCover,
+        PendingTrackColumnsCount,
+    };
+
 };
 
+namespace {
+
+QString albumStatsQueryText()
+{
+    return QStringLiteral("SELECT "
+                          "album.`ID`, "
+                          "COUNT(tracks.`ID`), "
+                          "COUNT(DISTINCT tracks.`DiscNumber`) <= 1, "
+                          "COUNT(DISTINCT tracks.`ArtistName`), "
+                          "GROUP_CONCAT(tracks.`ArtistName`, ', '), "
+                          "MAX(tracks.`Rating`), "
+                          "GROUP_CONCAT(genres.`Name`, ', '), "
+                          "( "
+                          "SELECT tracksCover.`FileName` "
+                          "FROM "
+                          "`Tracks` tracksCover "
+                          "WHERE "
+                          "tracksCover.`HasEmbeddedCover` = 1 AND "
+                          "tracksCover.`AlbumTitle` = album.`Title` AND "
+                          "(tracksCover.`AlbumArtistName` = album.`ArtistName` OR "
+                          "(tracksCover.`AlbumArtistName` IS NULL AND "
+                          "album.`ArtistName` IS NULL "
+                          ") "
+                          ") AND "
+                          "tracksCover.`AlbumPath` = album.`AlbumPath` "
+                          ") "
+                          "FROM "
+                          "`Albums` album LEFT JOIN "
+                          "`Tracks` tracks ON "
+                          "tracks.`AlbumTitle` = album.`Title` AND "
+                          "("
+                          "tracks.`AlbumArtistName` = album.`ArtistName` OR "
+                          "("
+                          "tracks.`AlbumArtistName` IS NULL AND "
+                          "album.`ArtistName` IS NULL"
+                          ")"
+                          ") AND "
+                          "tracks.`AlbumPath` = album.`AlbumPath` "
+                          "LEFT JOIN "
+                          "`Genre` genres ON tracks.`Genre` = genres.`Name` ");
+}
+
+QString queryPlaceholders(int count)
+{
+    auto result = QStringList{};
+    result.reserve(count);
+
+    for (int i = 0; i < count; ++i) {
+        result.push_back(QStringLiteral("?"));
+    }
+
+    return result.join(QStringLiteral(", "));
+}
+
+QString multiRowQueryPlaceholders(int rowsCount, int columnsCount)
+{
+    const auto oneRow = QStringLiteral("(%1)").arg(queryPlaceholders(columnsCount));
+
+    auto result = QStringList{};
+    result.reserve(rowsCount);
+
+    for (int i = 0; i < rowsCount; ++i) {
+        result.push_back(oneRow);
+    }
+
+    return result.join(QStringLiteral(", "));
+}
+
+QString insertTracksQueryText(int tracksCount)
+{
+    return QStringLiteral("INSERT INTO `Tracks` "
+                          "("
+                          "`ID`, "
+                          "`FileName`, "
+                          "`Priority`, "
+                          "`Title`, "
+                          "`ArtistName`, "
+                          "`AlbumTitle`, "
+                          "`AlbumArtistName`, "
+                          "`AlbumPath`, "
+                          "`Genre`, "
+                          "`Composer`, "
+                          "`Lyricist`, "
+                          "`Comment`, "
+                          "`TrackNumber`, "
+                          "`DiscNumber`, "
+                          "`Channels`, "
+                          "`BitRate`, "
+                          "`SampleRate`, "
+                          "`Year`,  "
+                          "`Duration`, "
+                          "`Rating`, "
+                          "`HasEmbeddedCover`) "
+                          "VALUES %1").arg(multiRowQueryPlaceholders(tracksCount, DatabaseInterfacePrivate::PendingTrackColumnsCount));
+}
+
+QString indexTracksSearchQueryText()
+{
+    return QStringLiteral("INSERT INTO `TracksSearch` "
+                          "(`rowid`, `Title`, `ArtistName`, `AlbumTitle`, `Composer`, `Genre`, `Comment`) "
+                          "SELECT "
+                          "tracks.`ID`, "
+                          "tracks.`Title`, "
+                          "tracks.`ArtistName`, "
+                          "tracks.`AlbumTitle`, "
+                          "tracks.`Composer`, "
+                          "tracks.`Genre`, "
+                          "tracks.`Comment` "
+                          "FROM "
+                          "`Tracks` tracks ");
+}
+
+// roles that can change without touching the album of the track, only those are sent as partial changes
+DataTypes::TrackDataType trackChanges(const DataTypes::TrackDataType &oldTrack, const DataTypes::TrackDataType &newTrack)
+{
+    const auto trackOnlyRoles = {DataTypes::TitleRole, DataTypes::ArtistRole, DataTypes::TrackNumberRole,
+                                  DataTypes::DurationRole, DataTypes::GenreRole, DataTypes::ComposerRole,
+                                  DataTypes::LyricistRole, DataTypes::CommentRole, DataTypes::YearRole,
+                                  DataTypes::ChannelsRole, DataTypes::BitRateRole, DataTypes::SampleRateRole,
+                                  DataTypes::LyricsRole, DataTypes::FileModificationTime, DataTypes::HasEmbeddedCover};
+
+    auto result = DataTypes::TrackDataType{};
+    result[DataTypes::DatabaseIdRole] = oldTrack.databaseId();
+
+    for (auto oneRole : trackOnlyRoles) {
+        const auto newValue = newTrack.value(oneRole);
+        if (oldTrack.value(oneRole) != newValue) {
+            // an invalid value tells listeners to drop the role
+            result[oneRole] = newValue;
+        }
+    }
+
+    if (oldTrack.rating() != newTrack.rating()) {
+        result[DataTypes::RatingRole] = newTrack.rating();
+    }
+
+    return result;
+}
+
+int pageQueryKey(ElisaUtils::PlayListEntryType dataType, Qt::SortOrder sortOrder, bool withSearch)
+{
+    return dataType * 4 + (sortOrder == Qt::AscendingOrder ? 0 : 2) + (withSearch ? 1 : 0);
+}
+
+// entries after the last one of the previous page, titles are compared without case like the views do
+QString pagePositionText(const QString &titleColumn, const QString &idColumn, Qt::SortOrder sortOrder)
+{
+    const auto comparison = (sortOrder == Qt::AscendingOrder ? QStringLiteral(">") : QStringLiteral("<"));
+
+    return QStringLiteral("(:isFirstPage = 1 OR "
+                          "%1 COLLATE NOCASE %3 :afterSortKey OR "
+                          "(%1 COLLATE NOCASE = :afterSortKey AND %2 %3 :afterKey)) ").arg(titleColumn, idColumn, comparison);
+}
+
+QString pageOrderText(const QString &titleColumn, const QString &idColumn, Qt::SortOrder sortOrder)
+{
+    const auto direction = (sortOrder == Qt::AscendingOrder ? QStringLiteral("ASC") : QStringLiteral("DESC"));
+
+    return QStringLiteral("ORDER BY %1 COLLATE NOCASE %3, %2 %3 "
+                          "LIMIT :pageSize").arg(titleColumn, idColumn, direction);
+}
+
+// every word typed by the user is a quoted prefix query, all of them must match
+QString searchMatchExpression(const QString &searchText, const QString &columns)
+{
+#if QT_VERSION < QT_VERSION_CHECK(5, 14, 0)
+    auto terms = searchText.split(QRegularExpression(QStringLiteral("\\s+")), QString::SkipEmptyParts);
+#else
+    auto terms = searchText.split(QRegularExpression(QStringLiteral("\\s+")), Qt::SkipEmptyParts);
+#endif
+
+    if (terms.isEmpty()) {
+        return {};
+    }
+
+    for (auto &oneTerm : terms) {
+        oneTerm = QStringLiteral("\"%1\"*").arg(oneTerm.replace(QLatin1Char('"'), QStringLiteral("\"\"")));
+    }
+
+    if (columns.isEmpty()) {
+        return terms.join(QLatin1Char(' '));
+    }
+
+    return QStringLiteral("{%1} : (%2)").arg(columns, terms.join(QLatin1Char(' ')));
+}
+
+}
+
 DatabaseInterface::DatabaseInterface(QObject *parent) : QObject(parent), d(nullptr)
 {
 }
@@ -314,16 +713,22 @@ DatabaseInterface::~DatabaseInterface()
     }
 }
 
-void DatabaseInterface::init(const QString &dbName, const QString &databaseFileName)
+void DatabaseInterface::init(const QString &dbName, const QString &databaseFileName, bool useWriteAheadLog)
 {
     QSqlDatabase tracksDatabase = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), dbName);
 
+    const auto writeAheadLogEnabled = useWriteAheadLog && !databaseFileName.isEmpty();
+
     if (!databaseFileName.isEmpty()) {
         tracksDatabase.setDatabaseName(QStringLiteral("file:") + databaseFileName);
     } else {
         tracksDatabase.setDatabaseName(QStringLiteral("file:memdb1?mode=memory"));
     }
-    tracksDatabase.setConnectOptions(QStringLiteral("foreign_keys = ON;locking_mode = EXCLUSIVE;QSQLITE_OPEN_URI;QSQLITE_BUSY_TIMEOUT=500000"));
+    if (writeAheadLogEnabled) {
+        tracksDatabase.setConnectOptions(QStringLiteral("QSQLITE_OPEN_URI;QSQLITE_BUSY_TIMEOUT=500000"));
+    } else {
+        tracksDatabase.setConnectOptions(QStringLiteral("foreign_keys = ON;locking_mode = EXCLUSIVE;QSQLITE_OPEN_URI;QSQLITE_BUSY_TIMEOUT=500000"));
+    }
 
     auto result = tracksDatabase.open();
     if (result) {
@@ -335,6 +740,18 @@ void DatabaseInterface::init(const QString &dbName, const QString &databaseFileN
 
     tracksDatabase.exec(QStringLiteral("PRAGMA foreign_keys = ON;"));
 
+    if (writeAheadLogEnabled) {
+        // readers opened with initReadOnly will only see committed data and
+        // will not be blocked by the transactions of this connection
+        auto journalModeQuery = tracksDatabase.exec(QStringLiteral("PRAGMA journal_mode = WAL;"));
+        if (journalModeQuery.next()) {
+            qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::init" << "journal mode" << journalModeQuery.value(0).toString();
+        }
+        tracksDatabase.exec(QStringLiteral("PRAGMA synchronous = NORMAL;"));
+    } else if (!databaseFileName.isEmpty()) {
+        tracksDatabase.exec(QStringLiteral("PRAGMA journal_mode = DELETE;"));
+    }
+
     d = std::make_unique<DatabaseInterfacePrivate>(tracksDatabase);
 
     initDatabase();
@@ -345,6 +762,28 @@ void DatabaseInterface::init(const QString &dbName, const QString &databaseFileN
     }
 }
 
+void DatabaseInterface::initReadOnly(const QString &dbName, const QString &databaseFileName)
+{
+    QSqlDatabase tracksDatabase = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), dbName);
+
+    tracksDatabase.setDatabaseName(QStringLiteral("file:") + databaseFileName);
+    tracksDatabase.setConnectOptions(QStringLiteral("QSQLITE_OPEN_READONLY;QSQLITE_OPEN_URI;QSQLITE_BUSY_TIMEOUT=500000"));
+
+    auto result = tracksDatabase.open();
+    if (result) {
+        qCDebug(orgKdeElisaDatabase) << "read-only database open";
+    } else {
+        qCDebug(orgKdeElisaDatabase) << "read-only database not open";
+    }
+
+    tracksDatabase.exec(QStringLiteral("PRAGMA query_only = ON;"));
+
+    d = std::make_unique<DatabaseInterfacePrivate>(tracksDatabase);
+
+    // the schema is created and upgraded by the writer connection
+    initRequest();
+}
+
 qulonglong DatabaseInterface::albumIdFromTitleAndArtist(const QString &title, const QString &artist, const QString &albumPath)
 {
     auto result = qulonglong{0};
@@ -377,7 +816,7 @@ DataTypes::ListTrackDataType DatabaseInterface::allTracksData()
         return result;
     }
 
-    result = internalAllTracksPartialData();
+    result = internalAllTracksPartialData(d->mSelectAllTracksQuery);
 
     transactionResult = finishTransaction();
     if (!transactionResult) {
@@ -748,6 +1187,29 @@ DataTypes::TrackDataType DatabaseInterface::trackDataFromDatabaseId(qulonglong i
     return result;
 }
 
+DataTypes::ListTrackDataType DatabaseInterface::tracksDataFromDatabaseIds(const QVector<qulonglong> &ids)
+{
+    auto result = DataTypes::ListTrackDataType();
+
+    if (!d || ids.isEmpty()) {
+        return result;
+    }
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    result = internalTracksPartialData(ids);
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    return result;
+}
+
 DataTypes::TrackDataType DatabaseInterface::trackDataFromDatabaseIdAndUrl(qulonglong id, const QUrl &trackUrl)
 {
     auto result = DataTypes::TrackDataType();
@@ -864,85 +1326,494 @@ qulonglong DatabaseInterface::radioIdFromFileName(const QUrl &fileName)
     return result;
 }
 
-void DatabaseInterface::applicationAboutToQuit()
+DataTypes::ListTrackDataType DatabaseInterface::allTracksDataPage(const DataTypes::PageRequest &request)
 {
-    d->mStopRequest = 1;
-}
+    auto result = DataTypes::ListTrackDataType{};
+
+    if (!d) {
+        return result;
+    }
 
-void DatabaseInterface::askRestoredTracks()
-{
     auto transactionResult = startTransaction();
     if (!transactionResult) {
-        return;
+        return result;
     }
 
-    auto result = internalAllFileName();
-
-    Q_EMIT restoredTracks(result);
+    auto pageQuery = internalPageQuery(ElisaUtils::Track, request);
+    if (pageQuery) {
+        result = internalAllTracksPartialData(*pageQuery);
+    }
 
     transactionResult = finishTransaction();
     if (!transactionResult) {
-        return;
+        return result;
     }
+
+    return result;
 }
 
-void DatabaseInterface::trackHasStartedPlaying(const QUrl &fileName, const QDateTime &time)
+DataTypes::ListAlbumDataType DatabaseInterface::allAlbumsDataPage(const DataTypes::PageRequest &request)
 {
+    auto result = DataTypes::ListAlbumDataType{};
+
+    if (!d) {
+        return result;
+    }
+
     auto transactionResult = startTransaction();
     if (!transactionResult) {
-        return;
+        return result;
     }
 
-    updateTrackStatistics(fileName, time);
-    auto trackId = internalTrackIdFromFileName(fileName);
-    if (trackId != 0) {
-        Q_EMIT trackModified(internalOneTrackPartialData(trackId));
+    auto pageQuery = internalPageQuery(ElisaUtils::Album, request);
+    if (pageQuery) {
+        result = internalAllAlbumsPartialData(*pageQuery);
     }
 
     transactionResult = finishTransaction();
     if (!transactionResult) {
-        return;
+        return result;
     }
+
+    return result;
 }
 
-void DatabaseInterface::clearData()
+DataTypes::ListArtistDataType DatabaseInterface::allArtistsDataPage(const DataTypes::PageRequest &request)
 {
+    auto result = DataTypes::ListArtistDataType{};
+
+    if (!d) {
+        return result;
+    }
+
     auto transactionResult = startTransaction();
     if (!transactionResult) {
-        return;
+        return result;
     }
 
-    auto queryResult = execQuery(d->mClearTracksTable);
-
-    if (!queryResult || !d->mClearTracksTable.isActive()) {
-        Q_EMIT databaseError();
+    auto pageQuery = internalPageQuery(ElisaUtils::Artist, request);
+    if (pageQuery) {
+        result = internalAllArtistsPartialData(*pageQuery);
+    }
 
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearTracksTable.lastQuery();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearTracksTable.boundValues();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearTracksTable.lastError();
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
     }
 
-    d->mClearTracksTable.finish();
+    return result;
+}
 
-    queryResult = execQuery(d->mClearAlbumsTable);
+ElisaUtils::EntryDataList DatabaseInterface::allEntriesOfPages(ElisaUtils::PlayListEntryType dataType, const DataTypes::PageRequest &request)
+{
+    auto result = ElisaUtils::EntryDataList{};
 
-    if (!queryResult || !d->mClearAlbumsTable.isActive()) {
-        Q_EMIT databaseError();
+    if (!d) {
+        return result;
+    }
 
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearAlbumsTable.lastQuery();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearAlbumsTable.boundValues();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearAlbumsTable.lastError();
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
     }
 
-    d->mClearAlbumsTable.finish();
+    if (dataType == ElisaUtils::Album) {
+        internalRefreshAlbumsStats();
+    }
 
-    queryResult = execQuery(d->mClearComposerTable);
+    auto pageQuery = internalPageQuery(dataType, request);
+    if (pageQuery && internalGenericPartialData(*pageQuery)) {
+        while (pageQuery->next()) {
+            const auto &currentRecord = pageQuery->record();
 
-    if (!queryResult || !d->mClearComposerTable.isActive()) {
-        Q_EMIT databaseError();
+            result.push_back(ElisaUtils::EntryData{currentRecord.value(0).toULongLong(), currentRecord.value(1).toString(), {}});
+        }
 
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearComposerTable.lastQuery();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearComposerTable.boundValues();
+        pageQuery->finish();
+    }
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    return result;
+}
+
+DataTypes::ListTrackDataType DatabaseInterface::searchTracks(const QString &searchText, int limit, int offset)
+{
+    auto result = DataTypes::ListTrackDataType{};
+
+    if (!d || !d->mSearchIndexAvailable) {
+        return result;
+    }
+
+    const auto matchExpression = searchMatchExpression(searchText, {});
+    if (matchExpression.isEmpty()) {
+        return result;
+    }
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    internalRefreshTracksSearch();
+
+    d->mSearchTracksQuery.bindValue(QStringLiteral(":searchQuery"), matchExpression);
+    d->mSearchTracksQuery.bindValue(QStringLiteral(":limit"), limit);
+    d->mSearchTracksQuery.bindValue(QStringLiteral(":offset"), offset);
+
+    result = internalAllTracksPartialData(d->mSearchTracksQuery);
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    return result;
+}
+
+DataTypes::ListAlbumDataType DatabaseInterface::searchAlbums(const QString &searchText, int limit, int offset)
+{
+    auto result = DataTypes::ListAlbumDataType{};
+
+    if (!d || !d->mSearchIndexAvailable) {
+        return result;
+    }
+
+    const auto matchExpression = searchMatchExpression(searchText, QStringLiteral("AlbumTitle ArtistName"));
+    if (matchExpression.isEmpty()) {
+        return result;
+    }
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    internalRefreshTracksSearch();
+
+    d->mSearchAlbumsQuery.bindValue(QStringLiteral(":searchQuery"), matchExpression);
+    d->mSearchAlbumsQuery.bindValue(QStringLiteral(":limit"), limit);
+    d->mSearchAlbumsQuery.bindValue(QStringLiteral(":offset"), offset);
+
+    result = internalAllAlbumsPartialData(d->mSearchAlbumsQuery);
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    return result;
+}
+
+DataTypes::ListArtistDataType DatabaseInterface::searchArtists(const QString &searchText, int limit, int offset)
+{
+    auto result = DataTypes::ListArtistDataType{};
+
+    if (!d || !d->mSearchIndexAvailable) {
+        return result;
+    }
+
+    const auto matchExpression = searchMatchExpression(searchText, QStringLiteral("ArtistName"));
+    if (matchExpression.isEmpty()) {
+        return result;
+    }
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    internalRefreshTracksSearch();
+
+    d->mSearchArtistsQuery.bindValue(QStringLiteral(":searchQuery"), matchExpression);
+    d->mSearchArtistsQuery.bindValue(QStringLiteral(":limit"), limit);
+    d->mSearchArtistsQuery.bindValue(QStringLiteral(":offset"), offset);
+
+    result = internalAllArtistsPartialData(d->mSearchArtistsQuery);
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    return result;
+}
+
+QVector<qulonglong> DatabaseInterface::searchIds(ElisaUtils::PlayListEntryType dataType, const QString &searchText, int limit)
+{
+    auto result = QVector<qulonglong>{};
+
+    if (!d || !d->mSearchIndexAvailable) {
+        return result;
+    }
+
+    auto matchExpression = QString{};
+    QSqlQuery *searchQuery = nullptr;
+
+    switch (dataType)
+    {
+    case ElisaUtils::Track:
+        matchExpression = searchMatchExpression(searchText, {});
+        searchQuery = &d->mSearchTrackIdsQuery;
+        break;
+    case ElisaUtils::Album:
+        matchExpression = searchMatchExpression(searchText, QStringLiteral("AlbumTitle ArtistName"));
+        searchQuery = &d->mSearchAlbumIdsQuery;
+        break;
+    case ElisaUtils::Artist:
+        matchExpression = searchMatchExpression(searchText, QStringLiteral("ArtistName"));
+        searchQuery = &d->mSearchArtistIdsQuery;
+        break;
+    case ElisaUtils::Composer:
+    case ElisaUtils::Genre:
+    case ElisaUtils::Lyricist:
+    case ElisaUtils::FileName:
+    case ElisaUtils::Unknown:
+    case ElisaUtils::Radio:
+        break;
+    }
+
+    if (!searchQuery || matchExpression.isEmpty()) {
+        return result;
+    }
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    internalRefreshTracksSearch();
+
+    searchQuery->bindValue(QStringLiteral(":searchQuery"), matchExpression);
+    searchQuery->bindValue(QStringLiteral(":limit"), limit);
+
+    auto queryResult = execQuery(*searchQuery);
+
+    if (!queryResult || !searchQuery->isSelect() || !searchQuery->isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::searchIds" << searchQuery->lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::searchIds" << searchQuery->boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::searchIds" << searchQuery->lastError();
+    } else {
+        while (searchQuery->next()) {
+            result.push_back(searchQuery->value(0).toULongLong());
+        }
+    }
+
+    searchQuery->finish();
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    return result;
+}
+
+bool DatabaseInterface::isSearchIndexAvailable() const
+{
+    return d && d->mSearchIndexAvailable;
+}
+
+void DatabaseInterface::applicationAboutToQuit()
+{
+    d->mStopRequest = 1;
+}
+
+void DatabaseInterface::askRestoredTracks()
+{
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    Q_EMIT restoredScannedDirectories(internalAllScannedDirectories());
+
+    auto result = internalAllFileName();
+
+    Q_EMIT restoredTracks(result);
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return;
+    }
+}
+
+void DatabaseInterface::insertScannedDirectoriesList(const DataTypes::ListDirectoryScanData &scannedDirectories,
+                                                     const QList<QUrl> &removedDirectories)
+{
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    internalInsertScannedDirectoriesList(scannedDirectories, removedDirectories);
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return;
+    }
+}
+
+void DatabaseInterface::internalInsertScannedDirectoriesList(const DataTypes::ListDirectoryScanData &scannedDirectories,
+                                                             const QList<QUrl> &removedDirectories)
+{
+    for (const auto &oneDirectory : removedDirectories) {
+        auto directoryPrefix = oneDirectory.toString();
+        if (!directoryPrefix.endsWith(QLatin1Char('/'))) {
+            directoryPrefix.append(QLatin1Char('/'));
+        }
+
+        d->mRemoveScannedDirectoryQuery.bindValue(QStringLiteral(":directoryPath"), oneDirectory);
+        d->mRemoveScannedDirectoryQuery.bindValue(QStringLiteral(":directoryPrefix"), directoryPrefix);
+
+        auto queryResult = execQuery(d->mRemoveScannedDirectoryQuery);
+
+        if (!queryResult || !d->mRemoveScannedDirectoryQuery.isActive()) {
+            Q_EMIT databaseError();
+
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertScannedDirectoriesList" << d->mRemoveScannedDirectoryQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertScannedDirectoriesList" << d->mRemoveScannedDirectoryQuery.boundValues();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertScannedDirectoriesList" << d->mRemoveScannedDirectoryQuery.lastError();
+        }
+
+        d->mRemoveScannedDirectoryQuery.finish();
+    }
+
+    for (const auto &oneDirectory : scannedDirectories) {
+        d->mInsertScannedDirectoryQuery.bindValue(QStringLiteral(":directoryPath"), oneDirectory.mDirectory);
+        d->mInsertScannedDirectoryQuery.bindValue(QStringLiteral(":modificationTime"), oneDirectory.mModificationTime);
+        d->mInsertScannedDirectoryQuery.bindValue(QStringLiteral(":entriesCount"), oneDirectory.mEntriesCount);
+        d->mInsertScannedDirectoryQuery.bindValue(QStringLiteral(":contentHash"), oneDirectory.mContentHash);
+        d->mInsertScannedDirectoryQuery.bindValue(QStringLiteral(":filesIdentity"), oneDirectory.mFilesIdentity);
+
+        auto queryResult = execQuery(d->mInsertScannedDirectoryQuery);
+
+        if (!queryResult || !d->mInsertScannedDirectoryQuery.isActive()) {
+            Q_EMIT databaseError();
+
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertScannedDirectoriesList" << d->mInsertScannedDirectoryQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertScannedDirectoriesList" << d->mInsertScannedDirectoryQuery.boundValues();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertScannedDirectoriesList" << d->mInsertScannedDirectoryQuery.lastError();
+        }
+
+        d->mInsertScannedDirectoryQuery.finish();
+    }
+}
+
+void DatabaseInterface::trackHasStartedPlaying(const QUrl &fileName, const QDateTime &time)
+{
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    updateTrackStatistics(fileName, time);
+    auto trackId = internalTrackIdFromFileName(fileName);
+
+    DataTypes::TracksChangeSet changes;
+    if (trackId != 0) {
+        changes.mModifiedTracks.push_back(internalOneTrackPartialData(trackId));
+    }
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    if (!changes.isEmpty()) {
+        if (isSignalConnected(QMetaMethod::fromSignal(&DatabaseInterface::trackModified))) {
+            Q_EMIT trackModified(changes.mModifiedTracks.constFirst());
+        }
+
+        Q_EMIT tracksChanged(changes);
+    }
+}
+
+void DatabaseInterface::clearData()
+{
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    d->clearIdsCaches();
+    d->mAlbumsStatsToRefresh.clear();
+    d->mTracksSearchToRefresh.clear();
+
+    if (d->mSearchIndexAvailable) {
+        auto queryResult = execQuery(d->mClearTracksSearchTable);
+
+        if (!queryResult || !d->mClearTracksSearchTable.isActive()) {
+            Q_EMIT databaseError();
+
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearTracksSearchTable.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearTracksSearchTable.boundValues();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearTracksSearchTable.lastError();
+        }
+
+        d->mClearTracksSearchTable.finish();
+    }
+
+    auto queryResult = execQuery(d->mClearAlbumStatsTable);
+
+    if (!queryResult || !d->mClearAlbumStatsTable.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearAlbumStatsTable.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearAlbumStatsTable.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearAlbumStatsTable.lastError();
+    }
+
+    d->mClearAlbumStatsTable.finish();
+
+    queryResult = execQuery(d->mClearScannedDirectoriesTable);
+
+    if (!queryResult || !d->mClearScannedDirectoriesTable.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearScannedDirectoriesTable.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearScannedDirectoriesTable.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearScannedDirectoriesTable.lastError();
+    }
+
+    d->mClearScannedDirectoriesTable.finish();
+
+    queryResult = execQuery(d->mClearTracksTable);
+
+    if (!queryResult || !d->mClearTracksTable.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearTracksTable.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearTracksTable.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearTracksTable.lastError();
+    }
+
+    d->mClearTracksTable.finish();
+
+    queryResult = execQuery(d->mClearAlbumsTable);
+
+    if (!queryResult || !d->mClearAlbumsTable.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearAlbumsTable.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearAlbumsTable.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearAlbumsTable.lastError();
+    }
+
+    d->mClearAlbumsTable.finish();
+
+    queryResult = execQuery(d->mClearComposerTable);
+
+    if (!queryResult || !d->mClearComposerTable.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearComposerTable.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearComposerTable.boundValues();
         qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearComposerTable.lastError();
     }
 
@@ -989,22 +1860,32 @@ void DatabaseInterface::clearData()
         return;
     }
 
+    StringPool::instance().purgeUnusedStrings();
+
     Q_EMIT cleanedDatabase();
 }
 
 void DatabaseInterface::initChangesTrackers()
 {
     d->mModifiedTrackIds.clear();
+    d->mTracksChanges.clear();
+    d->mRemovedTrackIds.clear();
+    d->mRemovedAlbumIds.clear();
+    d->mRemovedArtistIds.clear();
     d->mModifiedAlbumIds.clear();
     d->mModifiedArtistIds.clear();
     d->mInsertedTracks.clear();
     d->mInsertedAlbums.clear();
     d->mInsertedArtists.clear();
+    d->mInsertedGenres.clear();
+    d->mHasInsertedComposers = false;
+    d->mHasInsertedLyricists = false;
 }
 
 void DatabaseInterface::recordModifiedTrack(qulonglong trackId)
 {
     d->mModifiedTrackIds.insert(trackId);
+    d->mTracksChanges.remove(trackId);
 }
 
 void DatabaseInterface::recordModifiedAlbum(qulonglong albumId)
@@ -1012,119 +1893,311 @@ void DatabaseInterface::recordModifiedAlbum(qulonglong albumId)
     d->mModifiedAlbumIds.insert(albumId);
 }
 
-void DatabaseInterface::insertTracksList(const DataTypes::ListTrackDataType &tracks, const QHash<QString, QUrl> &covers)
-{
-    qCDebug(orgKdeElisaDatabase()) << "DatabaseInterface::insertTracksList" << tracks.count();
-    if (d->mStopRequest == 1) {
-        Q_EMIT finishInsertingTracksList();
-        return;
+bool DatabaseInterface::internalRefreshAlbumsStats()
+{
+    auto result = true;
+
+    if (d->mAlbumsStatsToRefresh.isEmpty()) {
+        return result;
+    }
+
+    if (!d->mPendingTracks.isEmpty()) {
+        flushPendingTracks();
+    }
+
+    for (auto albumId : qAsConst(d->mAlbumsStatsToRefresh)) {
+        d->mRefreshAlbumStatsQuery.bindValue(QStringLiteral(":albumId"), albumId);
+
+        auto queryResult = execQuery(d->mRefreshAlbumStatsQuery);
+
+        if (!queryResult || !d->mRefreshAlbumStatsQuery.isActive()) {
+            Q_EMIT databaseError();
+
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalRefreshAlbumsStats" << d->mRefreshAlbumStatsQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalRefreshAlbumsStats" << d->mRefreshAlbumStatsQuery.boundValues();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalRefreshAlbumsStats" << d->mRefreshAlbumStatsQuery.lastError();
+
+            result = false;
+        }
+
+        d->mRefreshAlbumStatsQuery.finish();
+    }
+
+    d->mAlbumsStatsToRefresh.clear();
+
+    return result;
+}
+
+bool DatabaseInterface::internalRefreshTracksSearch()
+{
+    auto result = true;
+
+    if (!d->mSearchIndexAvailable) {
+        d->mTracksSearchToRefresh.clear();
+
+        return result;
+    }
+
+    if (d->mTracksSearchToRefresh.isEmpty()) {
+        return result;
+    }
+
+    if (!d->mPendingTracks.isEmpty()) {
+        flushPendingTracks();
+    }
+
+    for (auto trackId : qAsConst(d->mTracksSearchToRefresh)) {
+        d->mRemoveTrackSearchQuery.bindValue(QStringLiteral(":trackId"), trackId);
+
+        auto queryResult = execQuery(d->mRemoveTrackSearchQuery);
+
+        if (!queryResult || !d->mRemoveTrackSearchQuery.isActive()) {
+            Q_EMIT databaseError();
+
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalRefreshTracksSearch" << d->mRemoveTrackSearchQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalRefreshTracksSearch" << d->mRemoveTrackSearchQuery.boundValues();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalRefreshTracksSearch" << d->mRemoveTrackSearchQuery.lastError();
+
+            result = false;
+        }
+
+        d->mRemoveTrackSearchQuery.finish();
+
+        d->mIndexTrackSearchQuery.bindValue(QStringLiteral(":trackId"), trackId);
+
+        queryResult = execQuery(d->mIndexTrackSearchQuery);
+
+        if (!queryResult || !d->mIndexTrackSearchQuery.isActive()) {
+            Q_EMIT databaseError();
+
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalRefreshTracksSearch" << d->mIndexTrackSearchQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalRefreshTracksSearch" << d->mIndexTrackSearchQuery.boundValues();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalRefreshTracksSearch" << d->mIndexTrackSearchQuery.lastError();
+
+            result = false;
+        }
+
+        d->mIndexTrackSearchQuery.finish();
+    }
+
+    d->mTracksSearchToRefresh.clear();
+
+    return result;
+}
+
+void DatabaseInterface::insertTracksList(const DataTypes::ListTrackDataType &tracks, const QHash<QString, QUrl> &covers)
+{
+    insertTracksAndScannedDirectoriesList(tracks, covers, {}, 0);
+}
+
+void DatabaseInterface::insertTracksAndScannedDirectoriesList(const DataTypes::ListTrackDataType &tracks, const QHash<QString, QUrl> &covers,
+                                                              const DataTypes::ListDirectoryScanData &scannedDirectories,
+                                                              qulonglong batchId)
+{
+    qCDebug(orgKdeElisaDatabase()) << "DatabaseInterface::insertTracksAndScannedDirectoriesList" << tracks.count() << scannedDirectories.count();
+    if (d->mStopRequest == 1) {
+        Q_EMIT finishInsertingTracksList(batchId);
+        return;
+    }
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        Q_EMIT finishInsertingTracksList(batchId);
+        return;
+    }
+
+    initChangesTrackers();
+    clearTracksListBatch();
+
+    auto batchResult = internalPrefetchTracksMapping(tracks);
+
+    if (batchResult) {
+        auto newFileNames = QList<QUrl>{};
+        auto newFileModifiedTimes = QList<QDateTime>{};
+        auto seenFileNames = QSet<QString>{};
+
+        for (const auto &oneTrack : tracks) {
+            const auto &fileName = oneTrack.resourceURI().toString();
+
+            if (seenFileNames.contains(fileName)) {
+                continue;
+            }
+            seenFileNames.insert(fileName);
+
+            if (!d->mBatchTracksMapping.contains(fileName)) {
+                newFileNames.push_back(oneTrack.resourceURI());
+                newFileModifiedTimes.push_back(oneTrack.fileModificationTime());
+            } else {
+                updateTrackOrigin(oneTrack.resourceURI(), oneTrack.fileModificationTime());
+            }
+        }
+
+        batchResult = internalInsertTracksOriginList(newFileNames, newFileModifiedTimes, QDateTime::currentDateTime());
+    }
+
+    if (batchResult) {
+        batchResult = internalResolveTracksListNames(tracks);
+    }
+
+    if (!batchResult) {
+        clearTracksListBatch();
+        rollBackTransaction();
+        Q_EMIT finishInsertingTracksList(batchId);
+        return;
+    }
+
+    for(const auto &oneTrack : tracks) {
+        bool isInserted = false;
+
+        const auto insertedTrackId = internalInsertTrack(oneTrack, covers, isInserted);
+
+        if (isInserted && insertedTrackId != 0) {
+            d->mInsertedTracks.insert(insertedTrackId);
+        }
+
+        if (d->mStopRequest == 1) {
+            flushPendingTracks();
+            clearTracksListBatch();
+
+            transactionResult = finishTransaction();
+            if (!transactionResult) {
+                Q_EMIT finishInsertingTracksList(batchId);
+                return;
+            }
+            Q_EMIT finishInsertingTracksList(batchId);
+            return;
+        }
+    }
+
+    flushPendingTracks();
+    clearTracksListBatch();
+
+    // only recorded with all their tracks: an interrupted scan lists them again
+    internalInsertScannedDirectoriesList(scannedDirectories, {});
+
+    DataTypes::ListArtistDataType newArtists;
+
+    for (auto artistId : qAsConst(d->mInsertedArtists)) {
+        newArtists.push_back({{DataTypes::DatabaseIdRole, artistId}});
     }
 
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
-        Q_EMIT finishInsertingTracksList();
-        return;
+    DataTypes::ListGenreDataType newGenres;
+
+    for (auto genreId : qAsConst(d->mInsertedGenres)) {
+        newGenres.push_back({{DataTypes::DatabaseIdRole, genreId}});
     }
 
-    initChangesTrackers();
+    const auto allComposers = (d->mHasInsertedComposers ? internalAllComposersPartialData() : DataTypes::ListArtistDataType{});
+    const auto allLyricists = (d->mHasInsertedLyricists ? internalAllLyricistsPartialData() : DataTypes::ListArtistDataType{});
+    const auto removedAlbumIds = d->mRemovedAlbumIds;
 
-    for(const auto &oneTrack : tracks) {
-        d->mSelectTracksMapping.bindValue(QStringLiteral(":fileName"), oneTrack.resourceURI());
+    DataTypes::ListAlbumDataType newAlbums;
 
-        auto result = execQuery(d->mSelectTracksMapping);
+    for (auto albumId : qAsConst(d->mInsertedAlbums)) {
+        d->mModifiedAlbumIds.remove(albumId);
+        newAlbums.push_back(internalOneAlbumPartialData(albumId));
+    }
 
-        if (!result || !d->mSelectTracksMapping.isSelect() || !d->mSelectTracksMapping.isActive()) {
-            Q_EMIT databaseError();
+    const auto modifiedAlbumIds = d->mModifiedAlbumIds;
 
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertTracksList" << d->mSelectTracksMapping.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertTracksList" << d->mSelectTracksMapping.boundValues();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::insertTracksList" << d->mSelectTracksMapping.lastError();
+    DataTypes::ListTrackDataType newTracks;
+    DataTypes::TracksChangeSet changes;
 
-            d->mSelectTracksMapping.finish();
+    for (auto trackId : qAsConst(d->mInsertedTracks)) {
+        newTracks.push_back(internalOneTrackPartialData(trackId));
+        changes.mInsertedTrackIds.push_back(trackId);
+        d->mModifiedTrackIds.remove(trackId);
+        d->mTracksChanges.remove(trackId);
+    }
 
-            rollBackTransaction();
-            Q_EMIT finishInsertingTracksList();
-            return;
-        }
+    const auto sendModifiedTracks = isSignalConnected(QMetaMethod::fromSignal(&DatabaseInterface::trackModified));
+    DataTypes::ListTrackDataType modifiedTracks;
+
+    for (auto trackId : qAsConst(d->mModifiedTrackIds)) {
+        const auto itChanges = d->mTracksChanges.constFind(trackId);
+        const auto hasPartialChanges = itChanges != d->mTracksChanges.constEnd();
 
-        bool isNewTrack = !d->mSelectTracksMapping.next();
+        if (!hasPartialChanges || sendModifiedTracks) {
+            auto oneModifiedTrack = internalOneTrackPartialData(trackId);
 
-        if (isNewTrack) {
-            insertTrackOrigin(oneTrack.resourceURI(), oneTrack.fileModificationTime(),
-                              QDateTime::currentDateTime());
-        } else if (!d->mSelectTracksMapping.record().value(0).isNull() && d->mSelectTracksMapping.record().value(0).toULongLong() != 0) {
-            updateTrackOrigin(oneTrack.resourceURI(), oneTrack.fileModificationTime());
+            if (!hasPartialChanges) {
+                changes.mModifiedTracks.push_back(oneModifiedTrack);
+            }
+            if (sendModifiedTracks) {
+                modifiedTracks.push_back(oneModifiedTrack);
+            }
         }
 
-        d->mSelectTracksMapping.finish();
+        if (hasPartialChanges) {
+            changes.mTracksChanges.push_back(itChanges.value());
+        }
+    }
 
-        bool isInserted = false;
+    for (auto albumId : modifiedAlbumIds) {
+        changes.mModifiedAlbumIds.push_back(albumId);
+    }
 
-        const auto insertedTrackId = internalInsertTrack(oneTrack, covers, isInserted);
+    qCInfo(orgKdeElisaDatabase) << "names cache" << d->mNamesCacheHits << "hits" << d->mNamesCacheMisses << "misses"
+                                << "albums cache" << d->mAlbumsCacheHits << "hits" << d->mAlbumsCacheMisses << "misses";
 
-        if (isInserted && insertedTrackId != 0) {
-            d->mInsertedTracks.insert(insertedTrackId);
-        }
+    const auto &stringPool = StringPool::instance();
+    qCInfo(orgKdeElisaDatabase) << "string pool" << stringPool.stringsCount() << "strings" << stringPool.storedBytes() << "bytes"
+                                << stringPool.savedBytes() << "bytes saved" << stringPool.hitsCount() << "hits" << stringPool.lookupsCount() << "lookups";
 
-        if (d->mStopRequest == 1) {
-            transactionResult = finishTransaction();
-            if (!transactionResult) {
-                Q_EMIT finishInsertingTracksList();
-                return;
-            }
-            Q_EMIT finishInsertingTracksList();
-            return;
-        }
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        Q_EMIT finishInsertingTracksList(batchId);
+        return;
     }
 
-    if (!d->mInsertedArtists.isEmpty()) {
-        DataTypes::ListArtistDataType newArtists;
+    // signals are emitted once the data is committed so that listeners using
+    // a read-only connection can query it
+    for (auto albumId : removedAlbumIds) {
+        Q_EMIT albumRemoved(albumId);
+    }
 
-        for (auto artistId : qAsConst(d->mInsertedArtists)) {
-            newArtists.push_back({{DataTypes::DatabaseIdRole, artistId}});
-        }
+    if (!newArtists.isEmpty()) {
         qCInfo(orgKdeElisaDatabase) << "artistsAdded" << newArtists.size();
         Q_EMIT artistsAdded(newArtists);
     }
 
-    if (!d->mInsertedAlbums.isEmpty()) {
-        DataTypes::ListAlbumDataType newAlbums;
+    if (!newGenres.isEmpty()) {
+        Q_EMIT genresAdded(newGenres);
+    }
 
-        for (auto albumId : qAsConst(d->mInsertedAlbums)) {
-            d->mModifiedAlbumIds.remove(albumId);
-            newAlbums.push_back(internalOneAlbumPartialData(albumId));
-        }
+    if (!allComposers.isEmpty()) {
+        Q_EMIT composersAdded(allComposers);
+    }
+
+    if (!allLyricists.isEmpty()) {
+        Q_EMIT lyricistsAdded(allLyricists);
+    }
 
+    if (!newAlbums.isEmpty()) {
         qCInfo(orgKdeElisaDatabase) << "albumsAdded" << newAlbums.size();
         Q_EMIT albumsAdded(newAlbums);
     }
 
-    for (auto albumId : qAsConst(d->mModifiedAlbumIds)) {
+    for (auto albumId : modifiedAlbumIds) {
         Q_EMIT albumModified({{DataTypes::DatabaseIdRole, albumId}}, albumId);
     }
 
-    if (!d->mInsertedTracks.isEmpty()) {
-        DataTypes::ListTrackDataType newTracks;
-
-        for (auto trackId : qAsConst(d->mInsertedTracks)) {
-            newTracks.push_back(internalOneTrackPartialData(trackId));
-            d->mModifiedTrackIds.remove(trackId);
-        }
-
+    if (!newTracks.isEmpty()) {
         qCInfo(orgKdeElisaDatabase) << "tracksAdded" << newTracks.size();
         Q_EMIT tracksAdded(newTracks);
     }
 
-    for (auto trackId : qAsConst(d->mModifiedTrackIds)) {
-        Q_EMIT trackModified(internalOneTrackPartialData(trackId));
+    for (const auto &oneModifiedTrack : qAsConst(modifiedTracks)) {
+        Q_EMIT trackModified(oneModifiedTrack);
     }
 
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
-        Q_EMIT finishInsertingTracksList();
-        return;
+    if (!changes.isEmpty()) {
+        qCInfo(orgKdeElisaDatabase) << "tracksChanged" << changes.mInsertedTrackIds.size() << "inserted"
+                                    << (changes.mModifiedTracks.size() + changes.mTracksChanges.size()) << "modified";
+        Q_EMIT tracksChanged(changes);
     }
-    Q_EMIT finishInsertingTracksList();
+
+    Q_EMIT finishInsertingTracksList(batchId);
 }
 
 void DatabaseInterface::removeTracksList(const QList<QUrl> &removedTracks)
@@ -1139,12 +2212,20 @@ void DatabaseInterface::removeTracksList(const QList<QUrl> &removedTracks)
 
     internalRemoveTracksList(removedTracks);
 
-    if (!d->mInsertedArtists.isEmpty()) {
-        DataTypes::ListArtistDataType newArtists;
-        for (auto artistId : qAsConst(d->mInsertedArtists)) {
-            newArtists.push_back({{DataTypes::DatabaseIdRole, artistId}});
-        }
-        Q_EMIT artistsAdded(newArtists);
+    DataTypes::ListArtistDataType newArtists;
+    for (auto artistId : qAsConst(d->mInsertedArtists)) {
+        newArtists.push_back({{DataTypes::DatabaseIdRole, artistId}});
+    }
+
+    const auto removedTrackIds = d->mRemovedTrackIds;
+    const auto removedAlbumIds = d->mRemovedAlbumIds;
+    const auto removedArtistIds = d->mRemovedArtistIds;
+    const auto modifiedAlbumIds = d->mModifiedAlbumIds;
+
+    DataTypes::TracksChangeSet changes;
+    changes.mRemovedTrackIds = removedTrackIds;
+    for (auto albumId : modifiedAlbumIds) {
+        changes.mModifiedAlbumIds.push_back(albumId);
     }
 
     transactionResult = finishTransaction();
@@ -1153,9 +2234,93 @@ void DatabaseInterface::removeTracksList(const QList<QUrl> &removedTracks)
         return;
     }
 
+    for (auto trackId : removedTrackIds) {
+        Q_EMIT trackRemoved(trackId);
+    }
+
+    for (auto albumId : modifiedAlbumIds) {
+        Q_EMIT albumModified({{DataTypes::DatabaseIdRole, albumId}}, albumId);
+    }
+
+    for (auto albumId : removedAlbumIds) {
+        Q_EMIT albumRemoved(albumId);
+    }
+
+    for (auto artistId : removedArtistIds) {
+        Q_EMIT artistRemoved(artistId);
+    }
+
+    if (!newArtists.isEmpty()) {
+        Q_EMIT artistsAdded(newArtists);
+    }
+
+    if (!changes.isEmpty()) {
+        Q_EMIT tracksChanged(changes);
+    }
+
+    StringPool::instance().purgeUnusedStrings();
+
     Q_EMIT finishRemovingTracksList();
 }
 
+void DatabaseInterface::renameTracksList(const DataTypes::ListRenamedFileData &renamedFiles)
+{
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    initChangesTrackers();
+
+    internalRenameTracksList(renamedFiles);
+
+    DataTypes::ListAlbumDataType newAlbums;
+    for (auto albumId : qAsConst(d->mInsertedAlbums)) {
+        d->mModifiedAlbumIds.remove(albumId);
+        newAlbums.push_back(internalOneAlbumPartialData(albumId));
+    }
+
+    const auto modifiedAlbumIds = d->mModifiedAlbumIds;
+    const auto removedAlbumIds = d->mRemovedAlbumIds;
+
+    DataTypes::TracksChangeSet changes;
+    for (auto trackId : qAsConst(d->mModifiedTrackIds)) {
+        const auto itChanges = d->mTracksChanges.constFind(trackId);
+
+        if (itChanges != d->mTracksChanges.constEnd()) {
+            changes.mTracksChanges.push_back(itChanges.value());
+        } else {
+            changes.mModifiedTracks.push_back(internalOneTrackPartialData(trackId));
+        }
+    }
+    for (auto albumId : modifiedAlbumIds) {
+        changes.mModifiedAlbumIds.push_back(albumId);
+    }
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::renameTracksList" << d->mModifiedTrackIds.size() << "tracks renamed";
+
+    for (auto albumId : removedAlbumIds) {
+        Q_EMIT albumRemoved(albumId);
+    }
+
+    if (!newAlbums.isEmpty()) {
+        Q_EMIT albumsAdded(newAlbums);
+    }
+
+    for (auto albumId : modifiedAlbumIds) {
+        Q_EMIT albumModified({{DataTypes::DatabaseIdRole, albumId}}, albumId);
+    }
+
+    if (!changes.isEmpty()) {
+        Q_EMIT tracksChanged(changes);
+    }
+}
+
 bool DatabaseInterface::startTransaction() const
 {
     auto result = false;
@@ -1172,15 +2337,21 @@ bool DatabaseInterface::startTransaction() const
     return result;
 }
 
-bool DatabaseInterface::finishTransaction() const
+bool DatabaseInterface::finishTransaction()
 {
     auto result = false;
 
+    internalRefreshAlbumsStats();
+    internalRefreshTracksSearch();
+
     auto transactionResult = d->mTracksDatabase.commit();
 
     if (!transactionResult) {
         qCDebug(orgKdeElisaDatabase) << "commit failed" << d->mTracksDatabase.lastError() << d->mTracksDatabase.lastError().nativeErrorCode();
 
+        d->discardTransactionCaches();
+        d->mTracksDatabase.rollback();
+
         return result;
     }
 
@@ -1193,6 +2364,8 @@ bool DatabaseInterface::rollBackTransaction() const
 {
     auto result = false;
 
+    d->discardTransactionCaches();
+
     auto transactionResult = d->mTracksDatabase.rollback();
 
     if (!transactionResult) {
@@ -2827,6 +4000,136 @@ void DatabaseInterface::upgradeDatabaseV15()
 }
 
 void DatabaseInterface::upgradeDatabaseV16()
+{
+    qCInfo(orgKdeElisaDatabase) << "begin update to v16 of database schema";
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `AlbumStats` ("
+                                                                   "`AlbumId` INTEGER PRIMARY KEY NOT NULL, "
+                                                                   "`TracksCount` INTEGER NOT NULL, "
+                                                                   "`IsSingleDiscAlbum` BOOLEAN NOT NULL, "
+                                                                   "`ArtistsCount` INTEGER NOT NULL, "
+                                                                   "`AllArtists` TEXT, "
+                                                                   "`HighestRating` INTEGER, "
+                                                                   "`AllGenres` TEXT, "
+                                                                   "`EmbeddedCover` VARCHAR(255))"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV16" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV16" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery copyDataQuery(d->mTracksDatabase);
+
+        const auto &result = copyDataQuery.exec(QStringLiteral("INSERT INTO `AlbumStats` "
+                                                               "(`AlbumId`, `TracksCount`, `IsSingleDiscAlbum`, `ArtistsCount`, "
+                                                               "`AllArtists`, `HighestRating`, `AllGenres`, `EmbeddedCover`) ") +
+                                                albumStatsQueryText() +
+                                                QStringLiteral("GROUP BY album.`ID`"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV16" << copyDataQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV16" << copyDataQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    qCInfo(orgKdeElisaDatabase) << "finished update to v16 of database schema";
+}
+
+void DatabaseInterface::upgradeDatabaseV17()
+{
+    qCInfo(orgKdeElisaDatabase) << "begin update to v17 of database schema";
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE VIRTUAL TABLE `TracksSearch` USING fts5("
+                                                                   "`Title`, "
+                                                                   "`ArtistName`, "
+                                                                   "`AlbumTitle`, "
+                                                                   "`Composer`, "
+                                                                   "`Genre`, "
+                                                                   "`Comment`)"));
+
+        if (!result) {
+            // SQLite may have been built without FTS5: search is then disabled but everything else works
+            qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV17" << "full text search is not available" << createSchemaQuery.lastError();
+            qCInfo(orgKdeElisaDatabase) << "finished update to v17 of database schema";
+
+            return;
+        }
+    }
+
+    {
+        QSqlQuery copyDataQuery(d->mTracksDatabase);
+
+        const auto &result = copyDataQuery.exec(indexTracksSearchQueryText());
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV17" << copyDataQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV17" << copyDataQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    qCInfo(orgKdeElisaDatabase) << "finished update to v17 of database schema";
+}
+
+void DatabaseInterface::upgradeDatabaseV18()
+{
+    qCInfo(orgKdeElisaDatabase) << "begin update to v18 of database schema";
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = createSchemaQuery.exec(QStringLiteral("CREATE TABLE `ScannedDirectories` ("
+                                                                   "`DirectoryPath` VARCHAR(255) PRIMARY KEY NOT NULL, "
+                                                                   "`ModificationTime` DATETIME NOT NULL, "
+                                                                   "`EntriesCount` INTEGER NOT NULL, "
+                                                                   "`ContentHash` BLOB NOT NULL)"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV18" << createSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV18" << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    qCInfo(orgKdeElisaDatabase) << "finished update to v18 of database schema";
+}
+
+void DatabaseInterface::upgradeDatabaseV19()
+{
+    qCInfo(orgKdeElisaDatabase) << "begin update to v19 of database schema";
+
+    {
+        QSqlQuery updateSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = updateSchemaQuery.exec(QStringLiteral("ALTER TABLE `ScannedDirectories` "
+                                                                   "ADD COLUMN `FilesIdentity` BLOB"));
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV19" << updateSchemaQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseV19" << updateSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    qCInfo(orgKdeElisaDatabase) << "finished update to v19 of database schema";
+}
+
+void DatabaseInterface::upgradeDatabaseV20()
 {
 
 }
@@ -2982,6 +4285,39 @@ void DatabaseInterface::checkDatabaseSchema()
         resetDatabase();
         return;
     }
+
+    checkAlbumStatsTableSchema();
+    if (d->mIsInBadState)
+    {
+        resetDatabase();
+        return;
+    }
+
+    checkScannedDirectoriesTableSchema();
+    if (d->mIsInBadState)
+    {
+        resetDatabase();
+        return;
+    }
+}
+
+void DatabaseInterface::checkAlbumStatsTableSchema()
+{
+    auto fieldsList = QStringList{QStringLiteral("AlbumId"), QStringLiteral("TracksCount"),
+                                  QStringLiteral("IsSingleDiscAlbum"), QStringLiteral("ArtistsCount"),
+                                  QStringLiteral("AllArtists"), QStringLiteral("HighestRating"),
+                                  QStringLiteral("AllGenres"), QStringLiteral("EmbeddedCover")};
+
+    genericCheckTable(QStringLiteral("AlbumStats"), fieldsList);
+}
+
+void DatabaseInterface::checkScannedDirectoriesTableSchema()
+{
+    auto fieldsList = QStringList{QStringLiteral("DirectoryPath"), QStringLiteral("ModificationTime"),
+                                  QStringLiteral("EntriesCount"), QStringLiteral("ContentHash"),
+                                  QStringLiteral("FilesIdentity")};
+
+    genericCheckTable(QStringLiteral("ScannedDirectories"), fieldsList);
 }
 
 void DatabaseInterface::checkAlbumsTableSchema()
@@ -3138,7 +4474,7 @@ void DatabaseInterface::manageNewDatabaseVersion()
     }
 
     int version = versionBegin;
-    for (; version-1 != DatabaseInterface::V16; version++) {
+    for (; version-1 != DatabaseInterface::V20; version++) {
         callUpgradeFunctionForVersion(static_cast<DatabaseVersion>(version));
     }
 
@@ -3150,7 +4486,7 @@ void DatabaseInterface::manageNewDatabaseVersion()
         dropTable(QStringLiteral("DROP TABLE DatabaseVersionV14"));
     }
 
-    setDatabaseVersionInTable(DatabaseInterface::V16);
+    setDatabaseVersionInTable(DatabaseInterface::V20);
 
     checkDatabaseSchema();
 }
@@ -3260,6 +4596,18 @@ void DatabaseInterface::callUpgradeFunctionForVersion(DatabaseVersion databaseVe
     case DatabaseInterface::V16:
         upgradeDatabaseV16();
         break;
+    case DatabaseInterface::V17:
+        upgradeDatabaseV17();
+        break;
+    case DatabaseInterface::V18:
+        upgradeDatabaseV18();
+        break;
+    case DatabaseInterface::V19:
+        upgradeDatabaseV19();
+        break;
+    case DatabaseInterface::V20:
+        upgradeDatabaseV20();
+        break;
     }
 }
 
@@ -3270,6 +4618,10 @@ void DatabaseInterface::initRequest()
         return;
     }
 
+    d->mSearchIndexAvailable = d->mTracksDatabase.tables().contains(QLatin1String("TracksSearch"));
+
+    d->mPageQueries.clear();
+
     {
         auto selectAlbumQueryText = QStringLiteral("SELECT "
                                                    "album.`ID`, "
@@ -3277,69 +4629,18 @@ void DatabaseInterface::initRequest()
                                                    "album.`ArtistName`, "
                                                    "album.`AlbumPath`, "
                                                    "album.`CoverFileName`, "
-                                                   "("
-                                                   "SELECT "
-                                                   "COUNT(*) "
-                                                   "FROM "
-                                                   "`Tracks` tracks3 "
-                                                   "WHERE "
-                                                   "tracks3.`AlbumTitle` = album.`Title` AND "
-                                                   "(tracks3.`AlbumArtistName` = album.`ArtistName` OR "
-                                                   "(tracks3.`AlbumArtistName` IS NULL AND "
-                                                   "album.`ArtistName` IS NULL"
-                                                   ")"
-                                                   ") AND "
-                                                   "tracks3.`AlbumPath` = album.`AlbumPath` "
-                                                   ") as `TracksCount`, "
-                                                   "("
-                                                   "SELECT "
-                                                   "COUNT(DISTINCT tracks2.DiscNumber) <= 1 "
-                                                   "FROM "
-                                                   "`Tracks` tracks2 "
-                                                   "WHERE "
-                                                   "tracks2.`AlbumTitle` = album.`Title` AND "
-                                                   "(tracks2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                   "(tracks2.`AlbumArtistName` IS NULL AND "
-                                                   "album.`ArtistName` IS NULL"
-                                                   ")"
-                                                   ") AND "
-                                                   "tracks2.`AlbumPath` = album.`AlbumPath` "
-                                                   ") as `IsSingleDiscAlbum`, "
-                                                   "COUNT(DISTINCT tracks.`ArtistName`) as ArtistsCount, "
-                                                   "GROUP_CONCAT(tracks.`ArtistName`, ', ') as AllArtists, "
-                                                   "MAX(tracks.`Rating`) as HighestRating, "
-                                                   "GROUP_CONCAT(genres.`Name`, ', ') as AllGenres, "
-                                                   "( "
-                                                   "SELECT tracksCover.`FileName` "
-                                                   "FROM "
-                                                   "`Tracks` tracksCover "
-                                                   "WHERE "
-                                                   "tracksCover.`HasEmbeddedCover` = 1 AND "
-                                                   "tracksCover.`AlbumTitle` = album.`Title` AND "
-                                                   "(tracksCover.`AlbumArtistName` = album.`ArtistName` OR "
-                                                   "(tracksCover.`AlbumArtistName` IS NULL AND "
-                                                   "album.`ArtistName` IS NULL "
-                                                   ") "
-                                                   ") AND "
-                                                   "tracksCover.`AlbumPath` = album.`AlbumPath` "
-                                                   ") as EmbeddedCover "
+                                                   "stats.`TracksCount`, "
+                                                   "stats.`IsSingleDiscAlbum`, "
+                                                   "stats.`ArtistsCount`, "
+                                                   "stats.`AllArtists`, "
+                                                   "stats.`HighestRating`, "
+                                                   "stats.`AllGenres`, "
+                                                   "stats.`EmbeddedCover` "
                                                    "FROM "
                                                    "`Albums` album LEFT JOIN "
-                                                   "`Tracks` tracks ON "
-                                                   "tracks.`AlbumTitle` = album.`Title` AND "
-                                                   "("
-                                                   "tracks.`AlbumArtistName` = album.`ArtistName` OR "
-                                                   "("
-                                                   "tracks.`AlbumArtistName` IS NULL AND "
-                                                   "album.`ArtistName` IS NULL"
-                                                   ")"
-                                                   ") AND "
-                                                   "tracks.`AlbumPath` = album.`AlbumPath`"
-                                                   "LEFT JOIN "
-                                                   "`Genre` genres ON tracks.`Genre` = genres.`Name` "
+                                                   "`AlbumStats` stats ON stats.`AlbumId` = album.`ID` "
                                                    "WHERE "
-                                                   "album.`ID` = :albumId "
-                                                   "GROUP BY album.`ID`");
+                                                   "album.`ID` = :albumId");
 
         auto result = prepareQuery(d->mSelectAlbumQuery, selectAlbumQueryText);
 
@@ -3375,51 +4676,18 @@ void DatabaseInterface::initRequest()
                                                   "album.`ArtistName` as SecondaryText, "
                                                   "album.`CoverFileName`, "
                                                   "album.`ArtistName`, "
-                                                  "COUNT(DISTINCT tracks.`ArtistName`) as ArtistsCount, "
-                                                  "GROUP_CONCAT(tracks.`ArtistName`, ', ') as AllArtists, "
-                                                  "MAX(tracks.`Rating`) as HighestRating, "
-                                                  "GROUP_CONCAT(genres.`Name`, ', ') as AllGenres, "
-                                                  "("
-                                                  "SELECT "
-                                                  "COUNT(DISTINCT tracks2.DiscNumber) <= 1 "
-                                                  "FROM "
-                                                  "`Tracks` tracks2 "
-                                                  "WHERE "
-                                                  "tracks2.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracks2.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracks2.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL"
-                                                  ")"
-                                                  ") AND "
-                                                  "tracks2.`AlbumPath` = album.`AlbumPath` "
-                                                  ") as `IsSingleDiscAlbum`, "
-                                                  "( "
-                                                  "SELECT tracksCover.`FileName` "
-                                                  "FROM "
-                                                  "`Tracks` tracksCover "
-                                                  "WHERE "
-                                                  "tracksCover.`HasEmbeddedCover` = 1 AND "
-                                                  "tracksCover.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracksCover.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracksCover.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL "
-                                                  ") "
-                                                  ") AND "
-                                                  "tracksCover.`AlbumPath` = album.`AlbumPath` "
-                                                  ") as EmbeddedCover "
+                                                  "stats.`ArtistsCount`, "
+                                                  "stats.`AllArtists`, "
+                                                  "stats.`HighestRating`, "
+                                                  "stats.`AllGenres`, "
+                                                  "stats.`IsSingleDiscAlbum`, "
+                                                  "stats.`EmbeddedCover` "
                                                   "FROM "
                                                   "`Albums` album, "
-                                                  "`Tracks` tracks LEFT JOIN "
-                                                  "`Genre` genres ON tracks.`Genre` = genres.`Name` "
+                                                  "`AlbumStats` stats "
                                                   "WHERE "
-                                                  "tracks.`AlbumTitle` = album.`Title` AND "
-                                                  "(tracks.`AlbumArtistName` = album.`ArtistName` OR "
-                                                  "(tracks.`AlbumArtistName` IS NULL AND "
-                                                  "album.`ArtistName` IS NULL"
-                                                  ") "
-                                                  ") AND "
-                                                  "tracks.`AlbumPath` = album.`AlbumPath` "
-                                                  "GROUP BY album.`ID`, album.`Title`, album.`AlbumPath` "
+                                                  "stats.`AlbumId` = album.`ID` AND "
+                                                  "stats.`TracksCount` > 0 "
                                                   "ORDER BY album.`Title` COLLATE NOCASE");
 
         auto result = prepareQuery(d->mSelectAllAlbumsShortQuery, selectAllAlbumsText);
@@ -3432,6 +4700,67 @@ void DatabaseInterface::initRequest()
         }
     }
 
+    for (auto sortOrder : {Qt::AscendingOrder, Qt::DescendingOrder}) {
+        for (auto withSearch : {false, true}) {
+            if (withSearch && !d->mSearchIndexAvailable) {
+                continue;
+            }
+
+            auto selectAlbumsPageText = QStringLiteral("SELECT "
+                                                       "album.`ID`, "
+                                                       "album.`Title`, "
+                                                       "album.`ArtistName` as SecondaryText, "
+                                                       "album.`CoverFileName`, "
+                                                       "album.`ArtistName`, "
+                                                       "stats.`ArtistsCount`, "
+                                                       "stats.`AllArtists`, "
+                                                       "stats.`HighestRating`, "
+                                                       "stats.`AllGenres`, "
+                                                       "stats.`IsSingleDiscAlbum`, "
+                                                       "stats.`EmbeddedCover` "
+                                                       "FROM "
+                                                       "`Albums` album, "
+                                                       "`AlbumStats` stats "
+                                                       "WHERE "
+                                                       "stats.`AlbumId` = album.`ID` AND "
+                                                       "stats.`TracksCount` > 0 AND "
+                                                       "IFNULL(stats.`HighestRating`, 0) >= :minimumRating AND ");
+
+            if (withSearch) {
+                selectAlbumsPageText += QStringLiteral("album.`ID` IN ("
+                                                       "     SELECT "
+                                                       "     album2.`ID` "
+                                                       "     FROM "
+                                                       "     `TracksSearch`, "
+                                                       "     `Tracks` tracks, "
+                                                       "     `Albums` album2 "
+                                                       "     WHERE "
+                                                       "     `TracksSearch` MATCH :searchQuery AND "
+                                                       "     tracks.`ID` = `TracksSearch`.`rowid` AND "
+                                                       "     tracks.`AlbumTitle` = album2.`Title` AND "
+                                                       "     (tracks.`AlbumArtistName` = album2.`ArtistName` OR "
+                                                       "     (tracks.`AlbumArtistName` IS NULL AND album2.`ArtistName` IS NULL)) AND "
+                                                       "     tracks.`AlbumPath` = album2.`AlbumPath` "
+                                                       ") AND ");
+            }
+
+            selectAlbumsPageText += pagePositionText(QStringLiteral("album.`Title`"), QStringLiteral("album.`ID`"), sortOrder) +
+                    pageOrderText(QStringLiteral("album.`Title`"), QStringLiteral("album.`ID`"), sortOrder);
+
+            auto &selectAlbumsPageQuery = d->mPageQueries[pageQueryKey(ElisaUtils::Album, sortOrder, withSearch)];
+            selectAlbumsPageQuery = QSqlQuery{d->mTracksDatabase};
+
+            auto result = prepareQuery(selectAlbumsPageQuery, selectAlbumsPageText);
+
+            if (!result) {
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << selectAlbumsPageQuery.lastQuery();
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << selectAlbumsPageQuery.lastError();
+
+                Q_EMIT databaseError();
+            }
+        }
+    }
+
     {
         auto selectAllAlbumsText = QStringLiteral("SELECT "
                                                   "album.`ID`, "
@@ -3611,6 +4940,115 @@ void DatabaseInterface::initRequest()
         }
     }
 
+    for (auto sortOrder : {Qt::AscendingOrder, Qt::DescendingOrder}) {
+        for (auto withSearch : {false, true}) {
+            if (withSearch && !d->mSearchIndexAvailable) {
+                continue;
+            }
+
+            auto selectArtistsPageText = QStringLiteral("SELECT artists.`ID`, "
+                                                        "artists.`Name`, "
+                                                        "GROUP_CONCAT(genres.`Name`, ', ') as AllGenres "
+                                                        "FROM `Artists` artists  LEFT JOIN "
+                                                        "`Tracks` tracks ON artists.`Name` = tracks.`ArtistName` LEFT JOIN "
+                                                        "`Genre` genres ON tracks.`Genre` = genres.`Name` "
+                                                        "WHERE ");
+
+            if (withSearch) {
+                selectArtistsPageText += QStringLiteral("artists.`Name` IN ("
+                                                        "     SELECT "
+                                                        "     tracks2.`ArtistName` "
+                                                        "     FROM "
+                                                        "     `TracksSearch`, "
+                                                        "     `Tracks` tracks2 "
+                                                        "     WHERE "
+                                                        "     `TracksSearch` MATCH :searchQuery AND "
+                                                        "     tracks2.`ID` = `TracksSearch`.`rowid` "
+                                                        ") AND ");
+            }
+
+            selectArtistsPageText += pagePositionText(QStringLiteral("artists.`Name`"), QStringLiteral("artists.`ID`"), sortOrder) +
+                    QStringLiteral("GROUP BY artists.`ID` ") +
+                    pageOrderText(QStringLiteral("artists.`Name`"), QStringLiteral("artists.`ID`"), sortOrder);
+
+            auto &selectArtistsPageQuery = d->mPageQueries[pageQueryKey(ElisaUtils::Artist, sortOrder, withSearch)];
+            selectArtistsPageQuery = QSqlQuery{d->mTracksDatabase};
+
+            auto result = prepareQuery(selectArtistsPageQuery, selectArtistsPageText);
+
+            if (!result) {
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << selectArtistsPageQuery.lastQuery();
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << selectArtistsPageQuery.lastError();
+
+                Q_EMIT databaseError();
+            }
+        }
+    }
+
+    {
+        auto selectAllScannedDirectoriesText = QStringLiteral("SELECT "
+                                                              "directories.`DirectoryPath`, "
+                                                              "directories.`ModificationTime`, "
+                                                              "directories.`EntriesCount`, "
+                                                              "directories.`ContentHash`, "
+                                                              "directories.`FilesIdentity` "
+                                                              "FROM `ScannedDirectories` directories");
+
+        auto result = prepareQuery(d->mSelectAllScannedDirectoriesQuery, selectAllScannedDirectoriesText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllScannedDirectoriesQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSelectAllScannedDirectoriesQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto insertScannedDirectoryText = QStringLiteral("INSERT OR REPLACE INTO `ScannedDirectories` "
+                                                         "(`DirectoryPath`, `ModificationTime`, `EntriesCount`, `ContentHash`, `FilesIdentity`) "
+                                                         "VALUES (:directoryPath, :modificationTime, :entriesCount, :contentHash, :filesIdentity)");
+
+        auto result = prepareQuery(d->mInsertScannedDirectoryQuery, insertScannedDirectoryText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertScannedDirectoryQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mInsertScannedDirectoryQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        // a removed directory takes all its sub-directories with it
+        auto removeScannedDirectoryText = QStringLiteral("DELETE FROM `ScannedDirectories` "
+                                                         "WHERE "
+                                                         "`DirectoryPath` = :directoryPath OR "
+                                                         "substr(`DirectoryPath`, 1, length(:directoryPrefix)) = :directoryPrefix");
+
+        auto result = prepareQuery(d->mRemoveScannedDirectoryQuery, removeScannedDirectoryText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveScannedDirectoryQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveScannedDirectoryQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto clearScannedDirectoriesTableText = QStringLiteral("DELETE FROM `ScannedDirectories`");
+
+        auto result = prepareQuery(d->mClearScannedDirectoriesTable, clearScannedDirectoriesTableText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearScannedDirectoriesTable.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearScannedDirectoriesTable.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
     {
         auto selectAllArtistsWithGenreFilterText = QStringLiteral("SELECT artists.`ID`, "
                                                                   "artists.`Name`, "
@@ -3823,6 +5261,69 @@ void DatabaseInterface::initRequest()
 
             Q_EMIT databaseError();
         }
+
+        for (auto sortOrder : {Qt::AscendingOrder, Qt::DescendingOrder}) {
+            for (auto withSearch : {false, true}) {
+                if (withSearch && !d->mSearchIndexAvailable) {
+                    continue;
+                }
+
+                auto selectTracksPageText = selectAllTracksText +
+                        QStringLiteral(" AND "
+                                       "tracks.`Rating` >= :minimumRating AND ");
+
+                if (withSearch) {
+                    selectTracksPageText += QStringLiteral("tracks.`ID` IN ("
+                                                           "     SELECT "
+                                                           "     `rowid` "
+                                                           "     FROM "
+                                                           "     `TracksSearch` "
+                                                           "     WHERE "
+                                                           "     `TracksSearch` MATCH :searchQuery"
+                                                           ") AND ");
+                }
+
+                selectTracksPageText += pagePositionText(QStringLiteral("tracks.`Title`"), QStringLiteral("tracks.`ID`"), sortOrder) +
+                        pageOrderText(QStringLiteral("tracks.`Title`"), QStringLiteral("tracks.`ID`"), sortOrder);
+
+                auto &selectTracksPageQuery = d->mPageQueries[pageQueryKey(ElisaUtils::Track, sortOrder, withSearch)];
+                selectTracksPageQuery = QSqlQuery{d->mTracksDatabase};
+
+                result = prepareQuery(selectTracksPageQuery, selectTracksPageText);
+
+                if (!result) {
+                    qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << selectTracksPageQuery.lastQuery();
+                    qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << selectTracksPageQuery.lastError();
+
+                    Q_EMIT databaseError();
+                }
+            }
+        }
+
+        if (d->mSearchIndexAvailable) {
+            auto searchTracksText = selectAllTracksText +
+                    QStringLiteral(" AND "
+                                   "tracks.`ID` IN ("
+                                   "     SELECT "
+                                   "     `rowid` "
+                                   "     FROM "
+                                   "     `TracksSearch` "
+                                   "     WHERE "
+                                   "     `TracksSearch` MATCH :searchQuery "
+                                   "     ORDER BY `rank` "
+                                   "     LIMIT :limit OFFSET :offset"
+                                   ") "
+                                   "ORDER BY tracks.`Title` COLLATE NOCASE");
+
+            result = prepareQuery(d->mSearchTracksQuery, searchTracksText);
+
+            if (!result) {
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSearchTracksQuery.lastQuery();
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSearchTracksQuery.lastError();
+
+                Q_EMIT databaseError();
+            }
+        }
     }
 
     {
@@ -4176,6 +5677,245 @@ void DatabaseInterface::initRequest()
         }
     }
 
+    {
+        auto clearAlbumStatsTableText = QStringLiteral("DELETE FROM `AlbumStats`");
+
+        auto result = prepareQuery(d->mClearAlbumStatsTable, clearAlbumStatsTableText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearAlbumStatsTable.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearAlbumStatsTable.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto refreshAlbumStatsQueryText = QStringLiteral("INSERT OR REPLACE INTO `AlbumStats` "
+                                                         "(`AlbumId`, `TracksCount`, `IsSingleDiscAlbum`, `ArtistsCount`, "
+                                                         "`AllArtists`, `HighestRating`, `AllGenres`, `EmbeddedCover`) ") +
+                albumStatsQueryText() +
+                QStringLiteral("WHERE "
+                               "album.`ID` = :albumId "
+                               "GROUP BY album.`ID`");
+
+        auto result = prepareQuery(d->mRefreshAlbumStatsQuery, refreshAlbumStatsQueryText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRefreshAlbumStatsQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRefreshAlbumStatsQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto removeAlbumStatsQueryText = QStringLiteral("DELETE FROM `AlbumStats` "
+                                                        "WHERE "
+                                                        "`AlbumId` = :albumId");
+
+        auto result = prepareQuery(d->mRemoveAlbumStatsQuery, removeAlbumStatsQueryText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveAlbumStatsQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveAlbumStatsQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    if (d->mSearchIndexAvailable) {
+        {
+            auto indexTrackSearchQueryText = indexTracksSearchQueryText() +
+                    QStringLiteral("WHERE "
+                                   "tracks.`ID` = :trackId");
+
+            auto result = prepareQuery(d->mIndexTrackSearchQuery, indexTrackSearchQueryText);
+
+            if (!result) {
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mIndexTrackSearchQuery.lastQuery();
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mIndexTrackSearchQuery.lastError();
+
+                Q_EMIT databaseError();
+            }
+        }
+
+        {
+            auto removeTrackSearchQueryText = QStringLiteral("DELETE FROM `TracksSearch` "
+                                                             "WHERE "
+                                                             "`rowid` = :trackId");
+
+            auto result = prepareQuery(d->mRemoveTrackSearchQuery, removeTrackSearchQueryText);
+
+            if (!result) {
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveTrackSearchQuery.lastQuery();
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRemoveTrackSearchQuery.lastError();
+
+                Q_EMIT databaseError();
+            }
+        }
+
+        {
+            auto clearTracksSearchTableText = QStringLiteral("DELETE FROM `TracksSearch`");
+
+            auto result = prepareQuery(d->mClearTracksSearchTable, clearTracksSearchTableText);
+
+            if (!result) {
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearTracksSearchTable.lastQuery();
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mClearTracksSearchTable.lastError();
+
+                Q_EMIT databaseError();
+            }
+        }
+
+        {
+            auto searchAlbumsText = QStringLiteral("SELECT "
+                                                   "album.`ID`, "
+                                                   "album.`Title`, "
+                                                   "album.`ArtistName` as SecondaryText, "
+                                                   "album.`CoverFileName`, "
+                                                   "album.`ArtistName`, "
+                                                   "stats.`ArtistsCount`, "
+                                                   "stats.`AllArtists`, "
+                                                   "stats.`HighestRating`, "
+                                                   "stats.`AllGenres`, "
+                                                   "stats.`IsSingleDiscAlbum`, "
+                                                   "stats.`EmbeddedCover` "
+                                                   "FROM "
+                                                   "`Albums` album, "
+                                                   "`AlbumStats` stats "
+                                                   "WHERE "
+                                                   "stats.`AlbumId` = album.`ID` AND "
+                                                   "stats.`TracksCount` > 0 AND "
+                                                   "album.`ID` IN ("
+                                                   "     SELECT "
+                                                   "     album2.`ID` "
+                                                   "     FROM "
+                                                   "     `TracksSearch`, "
+                                                   "     `Tracks` tracks, "
+                                                   "     `Albums` album2 "
+                                                   "     WHERE "
+                                                   "     `TracksSearch` MATCH :searchQuery AND "
+                                                   "     tracks.`ID` = `TracksSearch`.`rowid` AND "
+                                                   "     tracks.`AlbumTitle` = album2.`Title` AND "
+                                                   "     (tracks.`AlbumArtistName` = album2.`ArtistName` OR "
+                                                   "     (tracks.`AlbumArtistName` IS NULL AND album2.`ArtistName` IS NULL)) AND "
+                                                   "     tracks.`AlbumPath` = album2.`AlbumPath` "
+                                                   ") "
+                                                   "ORDER BY album.`Title` COLLATE NOCASE "
+                                                   "LIMIT :limit OFFSET :offset");
+
+            auto result = prepareQuery(d->mSearchAlbumsQuery, searchAlbumsText);
+
+            if (!result) {
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSearchAlbumsQuery.lastQuery();
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSearchAlbumsQuery.lastError();
+
+                Q_EMIT databaseError();
+            }
+        }
+
+        {
+            auto searchArtistsText = QStringLiteral("SELECT artists.`ID`, "
+                                                    "artists.`Name`, "
+                                                    "GROUP_CONCAT(genres.`Name`, ', ') as AllGenres "
+                                                    "FROM `Artists` artists  LEFT JOIN "
+                                                    "`Tracks` tracks ON artists.`Name` = tracks.`ArtistName` LEFT JOIN "
+                                                    "`Genre` genres ON tracks.`Genre` = genres.`Name` "
+                                                    "WHERE "
+                                                    "artists.`Name` IN ("
+                                                    "     SELECT "
+                                                    "     tracks2.`ArtistName` "
+                                                    "     FROM "
+                                                    "     `TracksSearch`, "
+                                                    "     `Tracks` tracks2 "
+                                                    "     WHERE "
+                                                    "     `TracksSearch` MATCH :searchQuery AND "
+                                                    "     tracks2.`ID` = `TracksSearch`.`rowid` "
+                                                    ") "
+                                                    "GROUP BY artists.`ID` "
+                                                    "ORDER BY artists.`Name` COLLATE NOCASE "
+                                                    "LIMIT :limit OFFSET :offset");
+
+            auto result = prepareQuery(d->mSearchArtistsQuery, searchArtistsText);
+
+            if (!result) {
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSearchArtistsQuery.lastQuery();
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSearchArtistsQuery.lastError();
+
+                Q_EMIT databaseError();
+            }
+        }
+
+        {
+            auto searchTrackIdsText = QStringLiteral("SELECT "
+                                                     "`rowid` "
+                                                     "FROM "
+                                                     "`TracksSearch` "
+                                                     "WHERE "
+                                                     "`TracksSearch` MATCH :searchQuery "
+                                                     "LIMIT :limit");
+
+            auto result = prepareQuery(d->mSearchTrackIdsQuery, searchTrackIdsText);
+
+            if (!result) {
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSearchTrackIdsQuery.lastQuery();
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSearchTrackIdsQuery.lastError();
+
+                Q_EMIT databaseError();
+            }
+        }
+
+        {
+            auto searchAlbumIdsText = QStringLiteral("SELECT DISTINCT "
+                                                     "album.`ID` "
+                                                     "FROM "
+                                                     "`TracksSearch`, "
+                                                     "`Tracks` tracks, "
+                                                     "`Albums` album "
+                                                     "WHERE "
+                                                     "`TracksSearch` MATCH :searchQuery AND "
+                                                     "tracks.`ID` = `TracksSearch`.`rowid` AND "
+                                                     "tracks.`AlbumTitle` = album.`Title` AND "
+                                                     "(tracks.`AlbumArtistName` = album.`ArtistName` OR "
+                                                     "(tracks.`AlbumArtistName` IS NULL AND album.`ArtistName` IS NULL)) AND "
+                                                     "tracks.`AlbumPath` = album.`AlbumPath` "
+                                                     "LIMIT :limit");
+
+            auto result = prepareQuery(d->mSearchAlbumIdsQuery, searchAlbumIdsText);
+
+            if (!result) {
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSearchAlbumIdsQuery.lastQuery();
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSearchAlbumIdsQuery.lastError();
+
+                Q_EMIT databaseError();
+            }
+        }
+
+        {
+            auto searchArtistIdsText = QStringLiteral("SELECT DISTINCT "
+                                                      "artists.`ID` "
+                                                      "FROM "
+                                                      "`TracksSearch`, "
+                                                      "`Tracks` tracks, "
+                                                      "`Artists` artists "
+                                                      "WHERE "
+                                                      "`TracksSearch` MATCH :searchQuery AND "
+                                                      "tracks.`ID` = `TracksSearch`.`rowid` AND "
+                                                      "artists.`Name` = tracks.`ArtistName` "
+                                                      "LIMIT :limit");
+
+            auto result = prepareQuery(d->mSearchArtistIdsQuery, searchArtistIdsText);
+
+            if (!result) {
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSearchArtistIdsQuery.lastQuery();
+                qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mSearchArtistIdsQuery.lastError();
+
+                Q_EMIT databaseError();
+            }
+        }
+    }
+
     {
         auto selectAllTracksShortText = QStringLiteral("SELECT "
                                                        "tracks.`ID`, "
@@ -4641,6 +6381,10 @@ void DatabaseInterface::initRequest()
 
             Q_EMIT databaseError();
         }
+
+        // same request for a list of tracks, the placeholders depend on the number of ids
+        d->mSelectTracksFromIdsQueryText = selectTrackFromIdQueryText;
+        d->mSelectTracksFromIdsQueryText.replace(QStringLiteral("tracks.`ID` = :trackId AND "), QStringLiteral("tracks.`ID` IN (%1) AND "));
     }
 
     {
@@ -4990,16 +6734,33 @@ void DatabaseInterface::initRequest()
     }
 
     {
-        auto initialUpdateTracksValidityQueryText = QStringLiteral("UPDATE `TracksData` "
-                                                                   "SET "
-                                                                   "`FileModifiedTime` = :mtime "
-                                                                   "WHERE `FileName` = :fileName");
+        auto initialUpdateTracksValidityQueryText = QStringLiteral("UPDATE `TracksData` "
+                                                                   "SET "
+                                                                   "`FileModifiedTime` = :mtime "
+                                                                   "WHERE `FileName` = :fileName");
+
+        auto result = prepareQuery(d->mUpdateTrackFileModifiedTime, initialUpdateTracksValidityQueryText);
+
+        if (!result) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackFileModifiedTime.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackFileModifiedTime.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto renameTrackOriginQueryText = QStringLiteral("UPDATE `TracksData` "
+                                                         "SET "
+                                                         "`FileName` = :newFileName, "
+                                                         "`FileModifiedTime` = :mtime "
+                                                         "WHERE `FileName` = :oldFileName");
 
-        auto result = prepareQuery(d->mUpdateTrackFileModifiedTime, initialUpdateTracksValidityQueryText);
+        auto result = prepareQuery(d->mRenameTrackOriginQuery, renameTrackOriginQueryText);
 
         if (!result) {
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackFileModifiedTime.lastQuery();
-            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mUpdateTrackFileModifiedTime.lastError();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRenameTrackOriginQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initRequest" << d->mRenameTrackOriginQuery.lastError();
 
             Q_EMIT databaseError();
         }
@@ -5333,52 +7094,7 @@ void DatabaseInterface::initRequest()
     }
 
     {
-        auto insertTrackQueryText = QStringLiteral("INSERT INTO `Tracks` "
-                                                   "("
-                                                   "`ID`, "
-                                                   "`FileName`, "
-                                                   "`Priority`, "
-                                                   "`Title`, "
-                                                   "`ArtistName`, "
-                                                   "`AlbumTitle`, "
-                                                   "`AlbumArtistName`, "
-                                                   "`AlbumPath`, "
-                                                   "`Genre`, "
-                                                   "`Composer`, "
-                                                   "`Lyricist`, "
-                                                   "`Comment`, "
-                                                   "`TrackNumber`, "
-                                                   "`DiscNumber`, "
-                                                   "`Channels`, "
-                                                   "`BitRate`, "
-                                                   "`SampleRate`, "
-                                                   "`Year`,  "
-                                                   "`Duration`, "
-                                                   "`Rating`, "
-                                                   "`HasEmbeddedCover`) "
-                                                   "VALUES "
-                                                   "("
-                                                   ":trackId, "
-                                                   ":fileName, "
-                                                   ":priority, "
-                                                   ":title, "
-                                                   ":artistName, "
-                                                   ":albumTitle, "
-                                                   ":albumArtistName, "
-                                                   ":albumPath, "
-                                                   ":genre, "
-                                                   ":composer, "
-                                                   ":lyricist, "
-                                                   ":comment, "
-                                                   ":trackNumber, "
-                                                   ":discNumber, "
-                                                   ":channels, "
-                                                   ":bitRate, "
-                                                   ":sampleRate, "
-                                                   ":year, "
-                                                   ":trackDuration, "
-                                                   ":trackRating, "
-                                                   ":hasEmbeddedCover)");
+        auto insertTrackQueryText = insertTracksQueryText(DatabaseInterfacePrivate::mInsertTracksBatchSize);
 
         auto result = prepareQuery(d->mInsertTrackQuery, insertTrackQueryText);
 
@@ -5999,6 +7715,14 @@ qulonglong DatabaseInterface::insertAlbum(const QString &title, const QString &a
         return result;
     }
 
+    const auto albumCacheKey = qMakePair(title, trackPath);
+    const auto cachedAlbum = d->mAlbumIdsCache.constFind(albumCacheKey);
+    if (cachedAlbum != d->mAlbumIdsCache.constEnd() && cachedAlbum->first == albumArtist) {
+        ++d->mAlbumsCacheHits;
+        return cachedAlbum->second;
+    }
+    ++d->mAlbumsCacheMisses;
+
     d->mSelectAlbumIdFromTitleAndArtistQuery.bindValue(QStringLiteral(":title"), title);
     d->mSelectAlbumIdFromTitleAndArtistQuery.bindValue(QStringLiteral(":albumPath"), trackPath);
     d->mSelectAlbumIdFromTitleAndArtistQuery.bindValue(QStringLiteral(":artistName"), albumArtist);
@@ -6023,10 +7747,11 @@ qulonglong DatabaseInterface::insertAlbum(const QString &title, const QString &a
         d->mSelectAlbumIdFromTitleAndArtistQuery.finish();
 
         if (!albumArtist.isEmpty()) {
-            const auto similarAlbum = internalOneAlbumPartialData(result);
             updateAlbumArtist(result, title, trackPath, albumArtist);
         }
 
+        d->mAlbumIdsCache[albumCacheKey] = qMakePair(albumArtist, result);
+
         return result;
     }
 
@@ -6065,6 +7790,8 @@ qulonglong DatabaseInterface::insertAlbum(const QString &title, const QString &a
 
     d->mInsertedAlbums.insert(result);
 
+    d->mAlbumIdsCache[albumCacheKey] = qMakePair(albumArtist, result);
+
     return result;
 }
 
@@ -6120,6 +7847,13 @@ qulonglong DatabaseInterface::insertArtist(const QString &name)
         return result;
     }
 
+    const auto cachedArtist = d->mArtistIdsCache.constFind(name);
+    if (cachedArtist != d->mArtistIdsCache.constEnd()) {
+        ++d->mNamesCacheHits;
+        return *cachedArtist;
+    }
+    ++d->mNamesCacheMisses;
+
     d->mSelectArtistByNameQuery.bindValue(QStringLiteral(":name"), name);
 
     auto queryResult = execQuery(d->mSelectArtistByNameQuery);
@@ -6141,6 +7875,8 @@ qulonglong DatabaseInterface::insertArtist(const QString &name)
 
         d->mSelectArtistByNameQuery.finish();
 
+        d->mArtistIdsCache[name] = result;
+
         return result;
     }
 
@@ -6167,6 +7903,8 @@ qulonglong DatabaseInterface::insertArtist(const QString &name)
 
     ++d->mArtistId;
 
+    d->mArtistIdsCache[name] = result;
+
     d->mInsertedArtists.insert(result);
 
     d->mInsertArtistsQuery.finish();
@@ -6182,6 +7920,13 @@ qulonglong DatabaseInterface::insertComposer(const QString &name)
         return result;
     }
 
+    const auto cachedComposer = d->mComposerIdsCache.constFind(name);
+    if (cachedComposer != d->mComposerIdsCache.constEnd()) {
+        ++d->mNamesCacheHits;
+        return *cachedComposer;
+    }
+    ++d->mNamesCacheMisses;
+
     d->mSelectComposerByNameQuery.bindValue(QStringLiteral(":name"), name);
 
     auto queryResult = execQuery(d->mSelectComposerByNameQuery);
@@ -6204,6 +7949,8 @@ qulonglong DatabaseInterface::insertComposer(const QString &name)
 
         d->mSelectComposerByNameQuery.finish();
 
+        d->mComposerIdsCache[name] = result;
+
         return result;
     }
 
@@ -6230,9 +7977,11 @@ qulonglong DatabaseInterface::insertComposer(const QString &name)
 
     ++d->mComposerId;
 
+    d->mComposerIdsCache[name] = result;
+
     d->mInsertComposerQuery.finish();
 
-    Q_EMIT composersAdded(internalAllComposersPartialData());
+    d->mHasInsertedComposers = true;
 
     return result;
 }
@@ -6245,6 +7994,13 @@ qulonglong DatabaseInterface::insertGenre(const QString &name)
         return result;
     }
 
+    const auto cachedGenre = d->mGenreIdsCache.constFind(name);
+    if (cachedGenre != d->mGenreIdsCache.constEnd()) {
+        ++d->mNamesCacheHits;
+        return *cachedGenre;
+    }
+    ++d->mNamesCacheMisses;
+
     d->mSelectGenreByNameQuery.bindValue(QStringLiteral(":name"), name);
 
     auto queryResult = execQuery(d->mSelectGenreByNameQuery);
@@ -6266,6 +8022,8 @@ qulonglong DatabaseInterface::insertGenre(const QString &name)
 
         d->mSelectGenreByNameQuery.finish();
 
+        d->mGenreIdsCache[name] = result;
+
         return result;
     }
 
@@ -6292,9 +8050,11 @@ qulonglong DatabaseInterface::insertGenre(const QString &name)
 
     ++d->mGenreId;
 
+    d->mGenreIdsCache[name] = result;
+
     d->mInsertGenreQuery.finish();
 
-    Q_EMIT genresAdded({{{DataTypes::DatabaseIdRole, result}}});
+    d->mInsertedGenres.insert(result);
 
     return result;
 }
@@ -6346,6 +8106,31 @@ void DatabaseInterface::updateTrackOrigin(const QUrl &fileName, const QDateTime
     d->mUpdateTrackFileModifiedTime.finish();
 }
 
+bool DatabaseInterface::renameTrackOrigin(const QUrl &oldFileName, const QUrl &newFileName, const QDateTime &fileModifiedTime)
+{
+    d->mRenameTrackOriginQuery.bindValue(QStringLiteral(":oldFileName"), oldFileName);
+    d->mRenameTrackOriginQuery.bindValue(QStringLiteral(":newFileName"), newFileName);
+    d->mRenameTrackOriginQuery.bindValue(QStringLiteral(":mtime"), fileModifiedTime);
+
+    auto queryResult = execQuery(d->mRenameTrackOriginQuery);
+
+    if (!queryResult || !d->mRenameTrackOriginQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::renameTrackOrigin" << d->mRenameTrackOriginQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::renameTrackOrigin" << d->mRenameTrackOriginQuery.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::renameTrackOrigin" << d->mRenameTrackOriginQuery.lastError();
+
+        d->mRenameTrackOriginQuery.finish();
+
+        return false;
+    }
+
+    d->mRenameTrackOriginQuery.finish();
+
+    return true;
+}
+
 qulonglong DatabaseInterface::internalInsertTrack(const DataTypes::TrackDataType &oneTrack,
                                                   const QHash<QString, QUrl> &covers, bool &isInserted)
 {
@@ -6375,10 +8160,12 @@ qulonglong DatabaseInterface::internalInsertTrack(const DataTypes::TrackDataType
 
     auto oldAlbumId = albumId;
 
-    auto existingTrackId = internalTrackIdFromFileName(oneTrack.resourceURI());
+    auto existingTrackId = d->mBatchTracksMapping.value(oneTrack.resourceURI().toString());
     bool isModifiedTrack = (existingTrackId != 0);
 
     if (isModifiedTrack) {
+        flushPendingTracks();
+
         resultId = existingTrackId;
 
         auto oldTrack = internalTrackFromDatabaseId(existingTrackId);
@@ -6386,9 +8173,9 @@ qulonglong DatabaseInterface::internalInsertTrack(const DataTypes::TrackDataType
 
         auto isSameTrack = true;
         isSameTrack = isSameTrack && (oldTrack.title() == oneTrack.title());
-        isSameTrack = isSameTrack && (oldTrack.album() == oneTrack.album());
-        isSameTrack = isSameTrack && (oldTrack.artist() == oneTrack.artist());
-        isSameTrack = isSameTrack && (oldTrack.albumArtist() == oneTrack.albumArtist());
+        isSameTrack = isSameTrack && StringPool::isSame(oldTrack.album(), oneTrack.album());
+        isSameTrack = isSameTrack && StringPool::isSame(oldTrack.artist(), oneTrack.artist());
+        isSameTrack = isSameTrack && StringPool::isSame(oldTrack.albumArtist(), oneTrack.albumArtist());
         isSameTrack = isSameTrack && (oldTrack.hasTrackNumber() == oneTrack.hasTrackNumber());
         if (isSameTrack && oldTrack.hasTrackNumber()) {
             isSameTrack = isSameTrack && (oldTrack.trackNumber() == oneTrack.trackNumber());
@@ -6400,9 +8187,9 @@ qulonglong DatabaseInterface::internalInsertTrack(const DataTypes::TrackDataType
         isSameTrack = isSameTrack && (oldTrack.duration() == oneTrack.duration());
         isSameTrack = isSameTrack && (oldTrack.rating() == oneTrack.rating());
         isSameTrack = isSameTrack && (oldTrack.resourceURI() == oneTrack.resourceURI());
-        isSameTrack = isSameTrack && (oldTrack.genre() == oneTrack.genre());
-        isSameTrack = isSameTrack && (oldTrack.composer() == oneTrack.composer());
-        isSameTrack = isSameTrack && (oldTrack.lyricist() == oneTrack.lyricist());
+        isSameTrack = isSameTrack && StringPool::isSame(oldTrack.genre(), oneTrack.genre());
+        isSameTrack = isSameTrack && StringPool::isSame(oldTrack.composer(), oneTrack.composer());
+        isSameTrack = isSameTrack && StringPool::isSame(oldTrack.lyricist(), oneTrack.lyricist());
         isSameTrack = isSameTrack && (oldTrack.comment() == oneTrack.comment());
         isSameTrack = isSameTrack && (oldTrack.year() == oneTrack.year());
         isSameTrack = isSameTrack && (oldTrack.hasChannels() == oneTrack.hasChannels());
@@ -6417,161 +8204,537 @@ qulonglong DatabaseInterface::internalInsertTrack(const DataTypes::TrackDataType
         if (isSameTrack && oldTrack.hasSampleRate()) {
             isSameTrack = isSameTrack && (oldTrack.sampleRate() == oneTrack.sampleRate());
         }
+        isSameTrack = isSameTrack && (oldTrack.hasEmbeddedCover() == oneTrack.hasEmbeddedCover());
+
+        if (isSameTrack) {
+            return resultId;
+        }
+
+        auto newTrack = oneTrack;
+        newTrack[DataTypes::ColumnsRoles::DatabaseIdRole] = resultId;
+        updateTrackInDatabase(newTrack, trackPath, oldAlbumId, albumId);
+        updateTrackOrigin(oneTrack.resourceURI(), oneTrack.fileModificationTime());
+        updateAlbumFromId(albumId, oneTrack.albumCover(), oneTrack, trackPath);
+
+        // a track modified twice in the same batch is sent in full
+        const auto wasAlreadyModified = d->mModifiedTrackIds.contains(existingTrackId);
+
+        recordModifiedTrack(existingTrackId);
+
+        // album related roles of the track are unchanged: listeners only need the modified roles
+        const auto isSameAlbumData = !wasAlreadyModified && albumId == oldAlbumId &&
+                (!oneTrack.albumCover().isValid() || oneTrack.albumCover() == oldTrack.albumCover()) &&
+                oldTrack.hasDiscNumber() == oneTrack.hasDiscNumber() &&
+                oldTrack.discNumber() == oneTrack.discNumber();
+        if (isSameAlbumData) {
+            d->mTracksChanges[existingTrackId] = trackChanges(oldTrack, newTrack);
+        }
+        if (albumId != 0) {
+            recordModifiedAlbum(albumId);
+        }
+        if (oldAlbumId != 0) {
+            auto tracksCount = fetchTrackIds(oldAlbumId).count();
+
+            if (tracksCount) {
+                recordModifiedAlbum(oldAlbumId);
+            } else {
+                d->mModifiedAlbumIds.remove(oldAlbumId);
+                removeAlbumInDatabase(oldAlbumId);
+                d->mRemovedAlbumIds.push_back(oldAlbumId);
+            }
+        }
+
+        isInserted = false;
+
+        return resultId;
+    } else {
+        oldAlbumId = 0;
+        existingTrackId = d->mTrackId;
+
+        isInserted = true;
+    }
+
+    int priority = 1;
+    while(true) {
+        auto otherTrackId = getDuplicateTrackIdFromTitleAlbumTrackDiscNumber(oneTrack.title(), oneTrack.artist(), oneTrack.album(),
+                                                                             oneTrack.albumArtist(), trackPath, oneTrack.trackNumber(),
+                                                                             oneTrack.discNumber(), priority);
+
+        if (otherTrackId || hasPendingDuplicateTrack(oneTrack, trackPath, priority)) {
+            ++priority;
+        } else {
+            break;
+        }
+    }
+
+    resultId = existingTrackId;
+
+    auto pendingTrack = QVariantList{};
+    pendingTrack.reserve(DatabaseInterfacePrivate::PendingTrackColumnsCount);
+
+    pendingTrack.push_back(existingTrackId);
+    pendingTrack.push_back(oneTrack.resourceURI());
+    pendingTrack.push_back(priority);
+    pendingTrack.push_back(oneTrack.title());
+    insertArtist(oneTrack.artist());
+    pendingTrack.push_back(oneTrack.artist());
+    pendingTrack.push_back(oneTrack.album());
+    if (oneTrack.hasAlbumArtist()) {
+        pendingTrack.push_back(oneTrack.albumArtist());
+    } else {
+        pendingTrack.push_back({});
+    }
+    pendingTrack.push_back(trackPath);
+    if (insertGenre(oneTrack.genre()) != 0) {
+        pendingTrack.push_back(oneTrack.genre());
+    } else {
+        pendingTrack.push_back({});
+    }
+    if (insertComposer(oneTrack.composer()) != 0) {
+        pendingTrack.push_back(oneTrack.composer());
+    } else {
+        pendingTrack.push_back({});
+    }
+    if (insertLyricist(oneTrack.lyricist()) != 0) {
+        pendingTrack.push_back(oneTrack.lyricist());
+    } else {
+        pendingTrack.push_back({});
+    }
+    pendingTrack.push_back(oneTrack.comment());
+    if (oneTrack.hasTrackNumber()) {
+        pendingTrack.push_back(oneTrack.trackNumber());
+    } else {
+        pendingTrack.push_back({});
+    }
+    if (oneTrack.hasDiscNumber()) {
+        pendingTrack.push_back(oneTrack.discNumber());
+    } else {
+        pendingTrack.push_back({});
+    }
+    if (oneTrack.hasChannels()) {
+        pendingTrack.push_back(oneTrack.channels());
+    } else {
+        pendingTrack.push_back({});
+    }
+    if (oneTrack.hasBitRate()) {
+        pendingTrack.push_back(oneTrack.bitRate());
+    } else {
+        pendingTrack.push_back({});
+    }
+    if (oneTrack.hasSampleRate()) {
+        pendingTrack.push_back(oneTrack.sampleRate());
+    } else {
+        pendingTrack.push_back({});
+    }
+    pendingTrack.push_back(oneTrack.year());
+    pendingTrack.push_back(QVariant::fromValue<qlonglong>(oneTrack.duration().msecsSinceStartOfDay()));
+    pendingTrack.push_back(oneTrack.rating());
+    pendingTrack.push_back(oneTrack.hasEmbeddedCover());
+
+    d->mPendingTracks.push_back(pendingTrack);
+    d->mBatchTracksMapping[oneTrack.resourceURI().toString()] = existingTrackId;
+    d->mTracksSearchToRefresh.insert(existingTrackId);
+
+    ++d->mTrackId;
+
+    qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalInsertTrack" << oneTrack << "is queued for insertion";
+
+    if (albumId != 0) {
+        d->mAlbumsStatsToRefresh.insert(albumId);
+        d->mPendingAlbumUpdates.push_back({albumId, covers[oneTrack.resourceURI().toString()], oneTrack, trackPath});
+
+        recordModifiedAlbum(albumId);
+    }
+
+    if (d->mPendingTracks.size() >= DatabaseInterfacePrivate::mInsertTracksBatchSize) {
+        flushPendingTracks();
+    }
+
+    return resultId;
+}
+
+bool DatabaseInterface::hasPendingDuplicateTrack(const DataTypes::TrackDataType &oneTrack, const QString &trackPath, int priority) const
+{
+    auto matchPendingValue = [](const QVariant &pendingValue, const QVariant &value) {
+        return pendingValue.isNull() || pendingValue == value;
+    };
+
+    for (const auto &pendingTrack : qAsConst(d->mPendingTracks)) {
+        if (pendingTrack[DatabaseInterfacePrivate::PendingTrackTitle].toString() != oneTrack.title() ||
+                pendingTrack[DatabaseInterfacePrivate::PendingTrackPriority].toInt() != priority) {
+            continue;
+        }
+
+        if (matchPendingValue(pendingTrack[DatabaseInterfacePrivate::PendingTrackArtistName], oneTrack.artist()) &&
+                matchPendingValue(pendingTrack[DatabaseInterfacePrivate::PendingTrackAlbumTitle], oneTrack.album()) &&
+                matchPendingValue(pendingTrack[DatabaseInterfacePrivate::PendingTrackAlbumArtistName], oneTrack.albumArtist()) &&
+                matchPendingValue(pendingTrack[DatabaseInterfacePrivate::PendingTrackAlbumPath], trackPath) &&
+                matchPendingValue(pendingTrack[DatabaseInterfacePrivate::PendingTrackNumber], oneTrack.trackNumber()) &&
+                matchPendingValue(pendingTrack[DatabaseInterfacePrivate::PendingTrackDiscNumber], oneTrack.discNumber())) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool DatabaseInterface::flushPendingTracks()
+{
+    auto result = true;
+
+    while (!d->mPendingTracks.isEmpty()) {
+        const auto tracksCount = std::min(d->mPendingTracks.size(), DatabaseInterfacePrivate::mInsertTracksBatchSize);
+        const auto isFullBatch = (tracksCount == DatabaseInterfacePrivate::mInsertTracksBatchSize);
+
+        auto partialBatchQuery = QSqlQuery{d->mTracksDatabase};
+        if (!isFullBatch) {
+            prepareQuery(partialBatchQuery, insertTracksQueryText(tracksCount));
+        }
+
+        auto &insertTracksQuery = (isFullBatch ? d->mInsertTrackQuery : partialBatchQuery);
+
+        for (int trackIndex = 0; trackIndex < tracksCount; ++trackIndex) {
+            for (const auto &oneValue : d->mPendingTracks.at(trackIndex)) {
+                insertTracksQuery.addBindValue(oneValue);
+            }
+        }
+
+        auto queryResult = execQuery(insertTracksQuery);
+
+        if (!queryResult || !insertTracksQuery.isActive()) {
+            Q_EMIT databaseError();
+
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::flushPendingTracks" << insertTracksQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::flushPendingTracks" << insertTracksQuery.boundValues();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::flushPendingTracks" << insertTracksQuery.lastError();
+
+            for (int trackIndex = 0; trackIndex < tracksCount; ++trackIndex) {
+                const auto &pendingTrack = d->mPendingTracks.at(trackIndex);
+
+                d->mInsertedTracks.remove(pendingTrack[DatabaseInterfacePrivate::PendingTrackId].toULongLong());
+                d->mBatchTracksMapping[pendingTrack[DatabaseInterfacePrivate::PendingTrackFileName].toUrl().toString()] = 0;
+            }
+
+            result = false;
+        }
+
+        insertTracksQuery.finish();
+
+        d->mPendingTracks.erase(d->mPendingTracks.begin(), d->mPendingTracks.begin() + tracksCount);
+    }
+
+    flushPendingAlbumUpdates();
+
+    return result;
+}
+
+void DatabaseInterface::flushPendingAlbumUpdates()
+{
+    if (d->mPendingAlbumUpdates.isEmpty()) {
+        return;
+    }
+
+    const auto pendingAlbumUpdates = std::exchange(d->mPendingAlbumUpdates, {});
+
+    auto modifiedAlbumIds = QSet<qulonglong>{};
+    auto updatingTrackIds = QSet<qulonglong>{};
+    for (const auto &oneUpdate : pendingAlbumUpdates) {
+        if (updateAlbumFromId(oneUpdate.mAlbumId, oneUpdate.mAlbumCover, oneUpdate.mTrack, oneUpdate.mTrackPath)) {
+            modifiedAlbumIds.insert(oneUpdate.mAlbumId);
+        }
+        updatingTrackIds.insert(d->mBatchTracksMapping.value(oneUpdate.mTrack.resourceURI().toString()));
+    }
+
+    // the other tracks of the modified albums, read once per album with all the new rows inserted
+    for (auto oneAlbumId : qAsConst(modifiedAlbumIds)) {
+        const auto albumTrackIds = fetchTrackIds(oneAlbumId);
+        for (auto oneTrackId : albumTrackIds) {
+            if (!updatingTrackIds.contains(oneTrackId)) {
+                recordModifiedTrack(oneTrackId);
+            }
+        }
+    }
+}
+
+bool DatabaseInterface::internalPrefetchTracksMapping(const DataTypes::ListTrackDataType &tracks)
+{
+    auto fileNames = QStringList{};
+    fileNames.reserve(tracks.size());
+
+    for (const auto &oneTrack : tracks) {
+        fileNames.push_back(oneTrack.resourceURI().toString());
+    }
+    fileNames.removeDuplicates();
+
+    for (int chunkBegin = 0; chunkBegin < fileNames.size(); chunkBegin += DatabaseInterfacePrivate::mSelectBatchSize) {
+        const auto &chunk = fileNames.mid(chunkBegin, DatabaseInterfacePrivate::mSelectBatchSize);
+
+        auto selectTracksMappingQuery = QSqlQuery{d->mTracksDatabase};
+
+        auto selectTracksMappingQueryText = QStringLiteral("SELECT "
+                                                           "trackData.`FileName`, "
+                                                           "track.`ID` "
+                                                           "FROM "
+                                                           "`TracksData` trackData "
+                                                           "LEFT JOIN "
+                                                           "`Tracks` track "
+                                                           "ON "
+                                                           "track.`FileName` = trackData.`FileName` "
+                                                           "WHERE "
+                                                           "trackData.`FileName` IN (%1)").arg(queryPlaceholders(chunk.size()));
+
+        prepareQuery(selectTracksMappingQuery, selectTracksMappingQueryText);
+
+        for (const auto &oneFileName : chunk) {
+            selectTracksMappingQuery.addBindValue(oneFileName);
+        }
+
+        auto queryResult = execQuery(selectTracksMappingQuery);
+
+        if (!queryResult || !selectTracksMappingQuery.isSelect() || !selectTracksMappingQuery.isActive()) {
+            Q_EMIT databaseError();
+
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalPrefetchTracksMapping" << selectTracksMappingQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalPrefetchTracksMapping" << selectTracksMappingQuery.boundValues();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalPrefetchTracksMapping" << selectTracksMappingQuery.lastError();
+
+            selectTracksMappingQuery.finish();
+
+            return false;
+        }
+
+        while (selectTracksMappingQuery.next()) {
+            const auto &currentRecord = selectTracksMappingQuery.record();
+
+            d->mBatchTracksMapping[currentRecord.value(0).toString()] = (currentRecord.value(1).isNull() ? 0 : currentRecord.value(1).toULongLong());
+        }
+
+        selectTracksMappingQuery.finish();
+    }
+
+    return true;
+}
+
+bool DatabaseInterface::internalInsertTracksOriginList(const QList<QUrl> &fileNames, const QList<QDateTime> &fileModifiedTimes,
+                                                       const QDateTime &importDate)
+{
+    const auto importDateValue = importDate.toMSecsSinceEpoch();
+
+    for (int chunkBegin = 0; chunkBegin < fileNames.size(); chunkBegin += DatabaseInterfacePrivate::mInsertNamesBatchSize / 2) {
+        const auto chunkSize = std::min(fileNames.size() - chunkBegin, DatabaseInterfacePrivate::mInsertNamesBatchSize / 2);
+
+        auto insertTracksMappingQuery = QSqlQuery{d->mTracksDatabase};
+
+        auto insertTracksMappingQueryText = QStringLiteral("INSERT INTO "
+                                                           "`TracksData` "
+                                                           "(`FileName`, "
+                                                           "`FileModifiedTime`, "
+                                                           "`ImportDate`, "
+                                                           "`PlayCounter`) "
+                                                           "VALUES %1").arg(multiRowQueryPlaceholders(chunkSize, 4));
+
+        prepareQuery(insertTracksMappingQuery, insertTracksMappingQueryText);
+
+        for (int fileIndex = chunkBegin; fileIndex < chunkBegin + chunkSize; ++fileIndex) {
+            insertTracksMappingQuery.addBindValue(fileNames[fileIndex]);
+            insertTracksMappingQuery.addBindValue(fileModifiedTimes[fileIndex]);
+            insertTracksMappingQuery.addBindValue(importDateValue);
+            insertTracksMappingQuery.addBindValue(0);
+        }
+
+        auto queryResult = execQuery(insertTracksMappingQuery);
+
+        if (!queryResult || !insertTracksMappingQuery.isActive()) {
+            Q_EMIT databaseError();
+
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalInsertTracksOriginList" << insertTracksMappingQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalInsertTracksOriginList" << insertTracksMappingQuery.boundValues();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalInsertTracksOriginList" << insertTracksMappingQuery.lastError();
+
+            insertTracksMappingQuery.finish();
+
+            return false;
+        }
+
+        insertTracksMappingQuery.finish();
+    }
+
+    return true;
+}
+
+bool DatabaseInterface::internalInsertNamesList(const QString &tableName, const QStringList &names, qulonglong &nextId,
+                                                QHash<QString, qulonglong> &namesIds, QList<qulonglong> &newIds)
+{
+    auto uncachedNames = QStringList{};
+    for (const auto &oneName : names) {
+        if (!namesIds.contains(oneName)) {
+            uncachedNames.push_back(oneName);
+        }
+    }
+
+    d->mNamesCacheHits += names.size() - uncachedNames.size();
+    d->mNamesCacheMisses += uncachedNames.size();
+
+    for (int chunkBegin = 0; chunkBegin < uncachedNames.size(); chunkBegin += DatabaseInterfacePrivate::mSelectBatchSize) {
+        const auto &chunk = uncachedNames.mid(chunkBegin, DatabaseInterfacePrivate::mSelectBatchSize);
+
+        auto selectNamesQuery = QSqlQuery{d->mTracksDatabase};
+
+        auto selectNamesQueryText = QStringLiteral("SELECT "
+                                                   "`ID`, "
+                                                   "`Name` "
+                                                   "FROM `%1` "
+                                                   "WHERE "
+                                                   "`Name` IN (%2)").arg(tableName, queryPlaceholders(chunk.size()));
+
+        prepareQuery(selectNamesQuery, selectNamesQueryText);
+
+        for (const auto &oneName : chunk) {
+            selectNamesQuery.addBindValue(oneName);
+        }
 
-        if (isSameTrack) {
-            return resultId;
+        auto queryResult = execQuery(selectNamesQuery);
+
+        if (!queryResult || !selectNamesQuery.isSelect() || !selectNamesQuery.isActive()) {
+            Q_EMIT databaseError();
+
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalInsertNamesList" << selectNamesQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalInsertNamesList" << selectNamesQuery.boundValues();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalInsertNamesList" << selectNamesQuery.lastError();
+
+            selectNamesQuery.finish();
+
+            return false;
         }
 
-        auto newTrack = oneTrack;
-        newTrack[DataTypes::ColumnsRoles::DatabaseIdRole] = resultId;
-        updateTrackInDatabase(newTrack, trackPath);
-        updateTrackOrigin(oneTrack.resourceURI(), oneTrack.fileModificationTime());
-        updateAlbumFromId(albumId, oneTrack.albumCover(), oneTrack, trackPath);
+        while (selectNamesQuery.next()) {
+            const auto &currentRecord = selectNamesQuery.record();
 
-        recordModifiedTrack(existingTrackId);
-        if (albumId != 0) {
-            recordModifiedAlbum(albumId);
+            namesIds[currentRecord.value(1).toString()] = currentRecord.value(0).toULongLong();
         }
-        if (oldAlbumId != 0) {
-            auto tracksCount = fetchTrackIds(oldAlbumId).count();
 
-            if (tracksCount) {
-                recordModifiedAlbum(oldAlbumId);
-            } else {
-                removeAlbumInDatabase(oldAlbumId);
-                Q_EMIT albumRemoved(oldAlbumId);
-            }
+        selectNamesQuery.finish();
+    }
+
+    auto missingNames = QStringList{};
+    for (const auto &oneName : uncachedNames) {
+        if (!namesIds.contains(oneName)) {
+            missingNames.push_back(oneName);
         }
+    }
 
-        isInserted = false;
+    for (int chunkBegin = 0; chunkBegin < missingNames.size(); chunkBegin += DatabaseInterfacePrivate::mInsertNamesBatchSize) {
+        const auto &chunk = missingNames.mid(chunkBegin, DatabaseInterfacePrivate::mInsertNamesBatchSize);
 
-        return resultId;
-    } else {
-        oldAlbumId = 0;
-        existingTrackId = d->mTrackId;
+        auto insertNamesQuery = QSqlQuery{d->mTracksDatabase};
 
-        isInserted = true;
-    }
+        auto insertNamesQueryText = QStringLiteral("INSERT INTO `%1` (`ID`, `Name`) "
+                                                   "VALUES %2").arg(tableName, multiRowQueryPlaceholders(chunk.size(), 2));
 
-    int priority = 1;
-    while(true) {
-        auto otherTrackId = getDuplicateTrackIdFromTitleAlbumTrackDiscNumber(oneTrack.title(), oneTrack.artist(), oneTrack.album(),
-                                                                             oneTrack.albumArtist(), trackPath, oneTrack.trackNumber(),
-                                                                             oneTrack.discNumber(), priority);
+        prepareQuery(insertNamesQuery, insertNamesQueryText);
 
-        if (otherTrackId) {
-            ++priority;
-        } else {
-            break;
+        auto chunkFirstId = nextId;
+        for (const auto &oneName : chunk) {
+            insertNamesQuery.addBindValue(chunkFirstId);
+            insertNamesQuery.addBindValue(oneName);
+            ++chunkFirstId;
         }
-    }
 
-    resultId = existingTrackId;
+        auto queryResult = execQuery(insertNamesQuery);
 
-    d->mInsertTrackQuery.bindValue(QStringLiteral(":trackId"), existingTrackId);
-    d->mInsertTrackQuery.bindValue(QStringLiteral(":fileName"), oneTrack.resourceURI());
-    d->mInsertTrackQuery.bindValue(QStringLiteral(":priority"), priority);
-    d->mInsertTrackQuery.bindValue(QStringLiteral(":title"), oneTrack.title());
-    insertArtist(oneTrack.artist());
-    d->mInsertTrackQuery.bindValue(QStringLiteral(":artistName"), oneTrack.artist());
-    d->mInsertTrackQuery.bindValue(QStringLiteral(":albumTitle"), oneTrack.album());
-    if (oneTrack.hasAlbumArtist()) {
-        d->mInsertTrackQuery.bindValue(QStringLiteral(":albumArtistName"), oneTrack.albumArtist());
-    } else {
-        d->mInsertTrackQuery.bindValue(QStringLiteral(":albumArtistName"), {});
-    }
-    d->mInsertTrackQuery.bindValue(QStringLiteral(":albumPath"), trackPath);
-    if (oneTrack.hasTrackNumber()) {
-        d->mInsertTrackQuery.bindValue(QStringLiteral(":trackNumber"), oneTrack.trackNumber());
-    } else {
-        d->mInsertTrackQuery.bindValue(QStringLiteral(":trackNumber"), {});
-    }
-    if (oneTrack.hasDiscNumber()) {
-        d->mInsertTrackQuery.bindValue(QStringLiteral(":discNumber"), oneTrack.discNumber());
-    } else {
-        d->mInsertTrackQuery.bindValue(QStringLiteral(":discNumber"), {});
-    }
-    d->mInsertTrackQuery.bindValue(QStringLiteral(":trackDuration"), QVariant::fromValue<qlonglong>(oneTrack.duration().msecsSinceStartOfDay()));
-    d->mInsertTrackQuery.bindValue(QStringLiteral(":trackRating"), oneTrack.rating());
-    if (insertGenre(oneTrack.genre()) != 0) {
-        d->mInsertTrackQuery.bindValue(QStringLiteral(":genre"), oneTrack.genre());
-    } else {
-        d->mInsertTrackQuery.bindValue(QStringLiteral(":genre"), {});
-    }
-    if (insertComposer(oneTrack.composer()) != 0) {
-        d->mInsertTrackQuery.bindValue(QStringLiteral(":composer"), oneTrack.composer());
-    } else {
-        d->mInsertTrackQuery.bindValue(QStringLiteral(":composer"), {});
-    }
-    if (insertLyricist(oneTrack.lyricist()) != 0) {
-        d->mInsertTrackQuery.bindValue(QStringLiteral(":lyricist"), oneTrack.lyricist());
-    } else {
-        d->mInsertTrackQuery.bindValue(QStringLiteral(":lyricist"), {});
-    }
-    d->mInsertTrackQuery.bindValue(QStringLiteral(":comment"), oneTrack.comment());
-    d->mInsertTrackQuery.bindValue(QStringLiteral(":year"), oneTrack.year());
-    if (oneTrack.hasChannels()) {
-        d->mInsertTrackQuery.bindValue(QStringLiteral(":channels"), oneTrack.channels());
-    } else {
-        d->mInsertTrackQuery.bindValue(QStringLiteral(":channels"), {});
-    }
-    if (oneTrack.hasBitRate()) {
-        d->mInsertTrackQuery.bindValue(QStringLiteral(":bitRate"), oneTrack.bitRate());
-    } else {
-        d->mInsertTrackQuery.bindValue(QStringLiteral(":bitRate"), {});
-    }
-    if (oneTrack.hasSampleRate()) {
-        d->mInsertTrackQuery.bindValue(QStringLiteral(":sampleRate"), oneTrack.sampleRate());
-    } else {
-        d->mInsertTrackQuery.bindValue(QStringLiteral(":sampleRate"), {});
-    }
-    d->mInsertTrackQuery.bindValue(QStringLiteral(":hasEmbeddedCover"), oneTrack.hasEmbeddedCover());
+        if (!queryResult || !insertNamesQuery.isActive()) {
+            Q_EMIT databaseError();
 
-    auto result = execQuery(d->mInsertTrackQuery);
-    qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalInsertTrack" << oneTrack << "is inserted";
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalInsertNamesList" << insertNamesQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalInsertNamesList" << insertNamesQuery.boundValues();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalInsertNamesList" << insertNamesQuery.lastError();
 
-    if (result && d->mInsertTrackQuery.isActive()) {
-        d->mInsertTrackQuery.finish();
+            insertNamesQuery.finish();
 
-        if (!isModifiedTrack) {
-            ++d->mTrackId;
+            return false;
         }
 
-        updateTrackOrigin(oneTrack.resourceURI(), oneTrack.fileModificationTime());
+        insertNamesQuery.finish();
 
-        if (isModifiedTrack) {
-            recordModifiedTrack(existingTrackId);
-            if (albumId != 0) {
-                recordModifiedAlbum(albumId);
-            }
-            if (oldAlbumId != 0) {
-                recordModifiedAlbum(oldAlbumId);
-            }
+        for (const auto &oneName : chunk) {
+            namesIds[oneName] = nextId;
+            newIds.push_back(nextId);
+            ++nextId;
         }
+    }
 
-        if (albumId != 0) {
-            if (updateAlbumFromId(albumId, covers[oneTrack.resourceURI().toString()], oneTrack, trackPath)) {
-                auto modifiedTracks = fetchTrackIds(albumId);
-                for (auto oneModifiedTrack : modifiedTracks) {
-                    if (oneModifiedTrack != resultId) {
-                        recordModifiedTrack(oneModifiedTrack);
-                    }
-                }
-            }
-            recordModifiedAlbum(albumId);
+    return true;
+}
+
+bool DatabaseInterface::internalResolveTracksListNames(const DataTypes::ListTrackDataType &tracks)
+{
+    auto artistNames = QSet<QString>{};
+    auto genreNames = QSet<QString>{};
+    auto composerNames = QSet<QString>{};
+    auto lyricistNames = QSet<QString>{};
+
+    for (const auto &oneTrack : tracks) {
+        if (oneTrack.title().isEmpty() || d->mBatchTracksMapping.value(oneTrack.resourceURI().toString()) != 0) {
+            continue;
         }
-    } else {
-        d->mInsertTrackQuery.finish();
 
-        Q_EMIT databaseError();
+        if (!oneTrack.artist().isEmpty()) {
+            artistNames.insert(oneTrack.artist());
+        }
+        if (!oneTrack.album().isEmpty() && oneTrack.hasAlbumArtist() && !oneTrack.albumArtist().isEmpty()) {
+            artistNames.insert(oneTrack.albumArtist());
+        }
+        if (!oneTrack.genre().isEmpty()) {
+            genreNames.insert(oneTrack.genre());
+        }
+        if (!oneTrack.composer().isEmpty()) {
+            composerNames.insert(oneTrack.composer());
+        }
+        if (!oneTrack.lyricist().isEmpty()) {
+            lyricistNames.insert(oneTrack.lyricist());
+        }
+    }
 
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalInsertTrack" << oneTrack << oneTrack.resourceURI();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalInsertTrack" << d->mInsertTrackQuery.lastQuery();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalInsertTrack" << d->mInsertTrackQuery.boundValues();
-        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalInsertTrack" << d->mInsertTrackQuery.lastError();
+    auto newArtistIds = QList<qulonglong>{};
+    if (!internalInsertNamesList(QStringLiteral("Artists"), artistNames.values(), d->mArtistId, d->mArtistIdsCache, newArtistIds)) {
+        return false;
+    }
+    for (auto oneArtistId : newArtistIds) {
+        d->mInsertedArtists.insert(oneArtistId);
     }
 
-    return resultId;
+    auto newGenreIds = QList<qulonglong>{};
+    if (!internalInsertNamesList(QStringLiteral("Genre"), genreNames.values(), d->mGenreId, d->mGenreIdsCache, newGenreIds)) {
+        return false;
+    }
+    for (auto oneGenreId : newGenreIds) {
+        d->mInsertedGenres.insert(oneGenreId);
+    }
+
+    auto newComposerIds = QList<qulonglong>{};
+    if (!internalInsertNamesList(QStringLiteral("Composer"), composerNames.values(), d->mComposerId, d->mComposerIdsCache, newComposerIds)) {
+        return false;
+    }
+    if (!newComposerIds.isEmpty()) {
+        d->mHasInsertedComposers = true;
+    }
+
+    auto newLyricistIds = QList<qulonglong>{};
+    if (!internalInsertNamesList(QStringLiteral("Lyricist"), lyricistNames.values(), d->mLyricistId, d->mLyricistIdsCache, newLyricistIds)) {
+        return false;
+    }
+    if (!newLyricistIds.isEmpty()) {
+        d->mHasInsertedLyricists = true;
+    }
+
+    return true;
+}
+
+void DatabaseInterface::clearTracksListBatch()
+{
+    d->mBatchTracksMapping.clear();
+    d->mPendingTracks.clear();
+    d->mPendingAlbumUpdates.clear();
 }
 
 DataTypes::TrackDataType DatabaseInterface::buildTrackFromDatabaseRecord(const QSqlRecord &trackRecord) const
@@ -6756,11 +8919,13 @@ void DatabaseInterface::internalRemoveTracksList(const QList<QUrl> &removedTrack
     for (const auto &removedTrackFileName : removedTracks) {
         auto removedTrackId = internalTrackIdFromFileName(removedTrackFileName);
 
-        Q_EMIT trackRemoved(removedTrackId);
+        if (removedTrackId != 0) {
+            d->mRemovedTrackIds.push_back(removedTrackId);
+        }
 
         auto oneRemovedTrack = internalTrackFromDatabaseId(removedTrackId);
 
-        removeTrackInDatabase(removedTrackId);
+        removeTrackInDatabase(removedTrackId, oneRemovedTrack.albumId());
 
         const auto &trackPath = oneRemovedTrack.resourceURI().toString(currentOptions);
         const auto &modifiedAlbumId = internalAlbumIdFromTitleAndArtist(oneRemovedTrack.album(), oneRemovedTrack.albumArtist(), trackPath);
@@ -6776,7 +8941,7 @@ void DatabaseInterface::internalRemoveTracksList(const QList<QUrl> &removedTrack
 
         if (removedArtistId != 0 && allTracksFromArtist.isEmpty() && allAlbumsFromArtist.isEmpty()) {
             removeArtistInDatabase(removedArtistId);
-            Q_EMIT artistRemoved(removedArtistId);
+            d->mRemovedArtistIds.push_back(removedArtistId);
         }
 
         d->mRemoveTracksMapping.bindValue(QStringLiteral(":fileName"), removedTrackFileName.toString());
@@ -6801,11 +8966,10 @@ void DatabaseInterface::internalRemoveTracksList(const QList<QUrl> &removedTrack
 
         auto tracksCount = fetchTrackIds(modifiedAlbumId).count();
 
-        if (!modifiedAlbumData.isEmpty() && tracksCount) {
-            Q_EMIT albumModified({{DataTypes::DatabaseIdRole, modifiedAlbumId}}, modifiedAlbumId);
-        } else {
+        if (modifiedAlbumData.isEmpty() || !tracksCount) {
+            d->mModifiedAlbumIds.remove(modifiedAlbumId);
             removeAlbumInDatabase(modifiedAlbumId);
-            Q_EMIT albumRemoved(modifiedAlbumId);
+            d->mRemovedAlbumIds.push_back(modifiedAlbumId);
 
             const auto &allTracksFromArtist = internalTracksFromAuthor(modifiedAlbumData[DataTypes::AlbumDataType::key_type::ArtistRole].toString());
             const auto &allAlbumsFromArtist = internalAlbumIdsFromAuthor(modifiedAlbumData[DataTypes::AlbumDataType::key_type::ArtistRole].toString());
@@ -6813,7 +8977,81 @@ void DatabaseInterface::internalRemoveTracksList(const QList<QUrl> &removedTrack
 
             if (removedArtistId != 0 && allTracksFromArtist.isEmpty() && allAlbumsFromArtist.isEmpty()) {
                 removeArtistInDatabase(removedArtistId);
-                Q_EMIT artistRemoved(removedArtistId);
+                d->mRemovedArtistIds.push_back(removedArtistId);
+            }
+        }
+    }
+}
+
+void DatabaseInterface::internalRenameTracksList(const DataTypes::ListRenamedFileData &renamedFiles)
+{
+    QUrl::FormattingOptions currentOptions = QUrl::PreferLocalFile |
+            QUrl::RemoveAuthority | QUrl::RemoveFilename | QUrl::RemoveFragment |
+            QUrl::RemovePassword | QUrl::RemovePort | QUrl::RemoveQuery |
+            QUrl::RemoveScheme | QUrl::RemoveUserInfo;
+
+    // the file name is the key between TracksData and Tracks: they are only consistent again once both are updated
+    QSqlQuery deferForeignKeysQuery(d->mTracksDatabase);
+    if (!deferForeignKeysQuery.exec(QStringLiteral("PRAGMA defer_foreign_keys = ON"))) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalRenameTracksList" << deferForeignKeysQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalRenameTracksList" << deferForeignKeysQuery.lastError();
+
+        return;
+    }
+
+    for (const auto &oneRenamedFile : renamedFiles) {
+        const auto trackId = internalTrackIdFromFileName(oneRenamedFile.mOldFileName);
+        if (trackId == 0) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalRenameTracksList" << oneRenamedFile.mOldFileName << "is not a known track";
+            continue;
+        }
+
+        const auto oldTrack = internalTrackFromDatabaseId(trackId);
+        const auto oldAlbumId = oldTrack.albumId();
+
+        if (!renameTrackOrigin(oneRenamedFile.mOldFileName, oneRenamedFile.mNewFileName, oneRenamedFile.mFileModificationTime)) {
+            continue;
+        }
+
+        auto newTrack = oldTrack;
+        newTrack[DataTypes::ResourceRole] = oneRenamedFile.mNewFileName;
+
+        const auto &oldTrackPath = oneRenamedFile.mOldFileName.toString(currentOptions);
+        const auto &trackPath = oneRenamedFile.mNewFileName.toString(currentOptions);
+
+        auto albumCover = oneRenamedFile.mAlbumCover;
+        if (albumCover.isEmpty() && trackPath == oldTrackPath) {
+            albumCover = oldTrack.albumCover();
+        }
+
+        const auto albumId = insertAlbum(oldTrack.album(), (oldTrack.hasAlbumArtist() ? oldTrack.albumArtist() : QString()),
+                                         trackPath, albumCover);
+
+        updateTrackInDatabase(newTrack, trackPath, oldAlbumId, albumId);
+
+        if (albumId != 0) {
+            updateAlbumFromId(albumId, albumCover, newTrack, trackPath);
+            recordModifiedAlbum(albumId);
+        }
+
+        recordModifiedTrack(trackId);
+
+        // the track stays in the same album: listeners only need its new file name
+        if (albumId == oldAlbumId) {
+            d->mTracksChanges[trackId] = {{DataTypes::DatabaseIdRole, trackId}, {DataTypes::ResourceRole, oneRenamedFile.mNewFileName}};
+        }
+
+        if (oldAlbumId != 0 && oldAlbumId != albumId) {
+            auto tracksCount = fetchTrackIds(oldAlbumId).count();
+
+            if (tracksCount) {
+                recordModifiedAlbum(oldAlbumId);
+            } else {
+                d->mModifiedAlbumIds.remove(oldAlbumId);
+                removeAlbumInDatabase(oldAlbumId);
+                d->mRemovedAlbumIds.push_back(oldAlbumId);
             }
         }
     }
@@ -6921,6 +9159,13 @@ qulonglong DatabaseInterface::insertLyricist(const QString &name)
         return result;
     }
 
+    const auto cachedLyricist = d->mLyricistIdsCache.constFind(name);
+    if (cachedLyricist != d->mLyricistIdsCache.constEnd()) {
+        ++d->mNamesCacheHits;
+        return *cachedLyricist;
+    }
+    ++d->mNamesCacheMisses;
+
     d->mSelectLyricistByNameQuery.bindValue(QStringLiteral(":name"), name);
 
     auto queryResult = execQuery(d->mSelectLyricistByNameQuery);
@@ -6942,6 +9187,8 @@ qulonglong DatabaseInterface::insertLyricist(const QString &name)
 
         d->mSelectLyricistByNameQuery.finish();
 
+        d->mLyricistIdsCache[name] = result;
+
         return result;
     }
 
@@ -6968,9 +9215,11 @@ qulonglong DatabaseInterface::insertLyricist(const QString &name)
 
     ++d->mLyricistId;
 
+    d->mLyricistIdsCache[name] = result;
+
     d->mInsertLyricistQuery.finish();
 
-    Q_EMIT lyricistsAdded(internalAllLyricistsPartialData());
+    d->mHasInsertedLyricists = true;
 
     return result;
 }
@@ -7005,6 +9254,37 @@ QHash<QUrl, QDateTime> DatabaseInterface::internalAllFileName()
     return allFileNames;
 }
 
+DataTypes::ListDirectoryScanData DatabaseInterface::internalAllScannedDirectories()
+{
+    auto allDirectories = DataTypes::ListDirectoryScanData{};
+
+    auto queryResult = execQuery(d->mSelectAllScannedDirectoriesQuery);
+
+    if (!queryResult || !d->mSelectAllScannedDirectoriesQuery.isSelect() || !d->mSelectAllScannedDirectoriesQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalAllScannedDirectories" << d->mSelectAllScannedDirectoriesQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalAllScannedDirectories" << d->mSelectAllScannedDirectoriesQuery.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalAllScannedDirectories" << d->mSelectAllScannedDirectoriesQuery.lastError();
+
+        d->mSelectAllScannedDirectoriesQuery.finish();
+
+        return allDirectories;
+    }
+
+    while(d->mSelectAllScannedDirectoriesQuery.next()) {
+        const auto &currentRecord = d->mSelectAllScannedDirectoriesQuery.record();
+
+        allDirectories.push_back({currentRecord.value(0).toUrl(), currentRecord.value(1).toDateTime(),
+                                  currentRecord.value(2).toInt(), currentRecord.value(3).toByteArray(),
+                                  currentRecord.value(4).toByteArray()});
+    }
+
+    d->mSelectAllScannedDirectoriesQuery.finish();
+
+    return allDirectories;
+}
+
 qulonglong DatabaseInterface::internalArtistIdFromName(const QString &name)
 {
     auto result = qulonglong(0);
@@ -7042,8 +9322,13 @@ qulonglong DatabaseInterface::internalArtistIdFromName(const QString &name)
     return result;
 }
 
-void DatabaseInterface::removeTrackInDatabase(qulonglong trackId)
+void DatabaseInterface::removeTrackInDatabase(qulonglong trackId, qulonglong albumId)
 {
+    if (albumId != 0) {
+        d->mAlbumsStatsToRefresh.insert(albumId);
+    }
+    d->mTracksSearchToRefresh.insert(trackId);
+
     d->mRemoveTrackQuery.bindValue(QStringLiteral(":trackId"), trackId);
 
     auto result = execQuery(d->mRemoveTrackQuery);
@@ -7059,8 +9344,17 @@ void DatabaseInterface::removeTrackInDatabase(qulonglong trackId)
     d->mRemoveTrackQuery.finish();
 }
 
-void DatabaseInterface::updateTrackInDatabase(const DataTypes::TrackDataType &oneTrack, const QString &albumPath)
+void DatabaseInterface::updateTrackInDatabase(const DataTypes::TrackDataType &oneTrack, const QString &albumPath,
+                                              qulonglong oldAlbumId, qulonglong newAlbumId)
 {
+    if (oldAlbumId != 0) {
+        d->mAlbumsStatsToRefresh.insert(oldAlbumId);
+    }
+    if (newAlbumId != 0) {
+        d->mAlbumsStatsToRefresh.insert(newAlbumId);
+    }
+    d->mTracksSearchToRefresh.insert(oneTrack.databaseId());
+
     d->mUpdateTrackQuery.bindValue(QStringLiteral(":fileName"), oneTrack.resourceURI());
     d->mUpdateTrackQuery.bindValue(QStringLiteral(":trackId"), oneTrack.databaseId());
     d->mUpdateTrackQuery.bindValue(QStringLiteral(":title"), oneTrack.title());
@@ -7191,6 +9485,8 @@ void DatabaseInterface::removeRadio(qulonglong radioId)
 
 void DatabaseInterface::removeAlbumInDatabase(qulonglong albumId)
 {
+    d->removeCachedAlbumId(albumId);
+
     d->mRemoveAlbumQuery.bindValue(QStringLiteral(":albumId"), albumId);
 
     auto result = execQuery(d->mRemoveAlbumQuery);
@@ -7204,10 +9500,28 @@ void DatabaseInterface::removeAlbumInDatabase(qulonglong albumId)
     }
 
     d->mRemoveAlbumQuery.finish();
+
+    d->mAlbumsStatsToRefresh.remove(albumId);
+
+    d->mRemoveAlbumStatsQuery.bindValue(QStringLiteral(":albumId"), albumId);
+
+    result = execQuery(d->mRemoveAlbumStatsQuery);
+
+    if (!result || !d->mRemoveAlbumStatsQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::removeAlbumInDatabase" << d->mRemoveAlbumStatsQuery.lastQuery();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::removeAlbumInDatabase" << d->mRemoveAlbumStatsQuery.boundValues();
+        qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::removeAlbumInDatabase" << d->mRemoveAlbumStatsQuery.lastError();
+    }
+
+    d->mRemoveAlbumStatsQuery.finish();
 }
 
 void DatabaseInterface::removeArtistInDatabase(qulonglong artistId)
 {
+    DatabaseInterfacePrivate::removeCachedId(d->mArtistIdsCache, artistId);
+
     d->mRemoveArtistQuery.bindValue(QStringLiteral(":artistId"), artistId);
 
     auto result = execQuery(d->mRemoveArtistQuery);
@@ -7308,6 +9622,14 @@ qulonglong DatabaseInterface::internalAlbumIdFromTitleAndArtist(const QString &t
 {
     auto result = qulonglong(0);
 
+    const auto albumCacheKey = DatabaseInterfacePrivate::AlbumCacheKey{title, artist, albumPath};
+    const auto cachedAlbum = d->mAlbumIdsFromTitleAndArtistCache.constFind(albumCacheKey);
+    if (cachedAlbum != d->mAlbumIdsFromTitleAndArtistCache.constEnd()) {
+        ++d->mAlbumsCacheHits;
+        return *cachedAlbum;
+    }
+    ++d->mAlbumsCacheMisses;
+
     d->mSelectAlbumIdFromTitleQuery.bindValue(QStringLiteral(":title"), title);
     d->mSelectAlbumIdFromTitleQuery.bindValue(QStringLiteral(":artistName"), artist);
 
@@ -7356,6 +9678,10 @@ qulonglong DatabaseInterface::internalAlbumIdFromTitleAndArtist(const QString &t
         d->mSelectAlbumIdFromTitleWithoutArtistQuery.finish();
     }
 
+    if (result != 0) {
+        d->mAlbumIdsFromTitleAndArtistCache[albumCacheKey] = result;
+    }
+
     return result;
 }
 
@@ -7633,14 +9959,16 @@ DataTypes::ListArtistDataType DatabaseInterface::internalAllArtistsPartialData(Q
         return result;
     }
 
+    auto &stringPool = StringPool::instance();
+
     while(artistsQuery.next()) {
         auto newData = DataTypes::ArtistDataType{};
 
         const auto &currentRecord = artistsQuery.record();
 
         newData[DataTypes::DatabaseIdRole] = currentRecord.value(0);
-        newData[DataTypes::TitleRole] = currentRecord.value(1);
-        newData[DataTypes::GenreRole] = QVariant::fromValue(currentRecord.value(2).toString().split(QStringLiteral(", ")));
+        newData[DataTypes::TitleRole] = stringPool.intern(currentRecord.value(1));
+        newData[DataTypes::GenreRole] = QVariant::fromValue(stringPool.intern(currentRecord.value(2).toString().split(QStringLiteral(", "))));
         newData[DataTypes::ElementTypeRole] = ElisaUtils::Artist;
 
         result.push_back(newData);
@@ -7655,28 +9983,32 @@ DataTypes::ListAlbumDataType DatabaseInterface::internalAllAlbumsPartialData(QSq
 {
     auto result = DataTypes::ListAlbumDataType{};
 
+    internalRefreshAlbumsStats();
+
     if (!internalGenericPartialData(query)) {
         return result;
     }
 
+    auto &stringPool = StringPool::instance();
+
     while(query.next()) {
         auto newData = DataTypes::AlbumDataType{};
 
         const auto &currentRecord = query.record();
 
         newData[DataTypes::DatabaseIdRole] = currentRecord.value(0);
-        newData[DataTypes::TitleRole] = currentRecord.value(1);
+        newData[DataTypes::TitleRole] = stringPool.intern(currentRecord.value(1));
         if (!currentRecord.value(3).toString().isEmpty()) {
             newData[DataTypes::ImageUrlRole] = currentRecord.value(3);
         } else if (!currentRecord.value(10).toString().isEmpty()) {
             newData[DataTypes::ImageUrlRole] = QVariant{QLatin1String("image://cover/") + currentRecord.value(10).toUrl().toLocalFile()};
         }
-        auto allArtists = currentRecord.value(6).toString().split(QStringLiteral(", "));
+        auto allArtists = stringPool.intern(currentRecord.value(6).toString().split(QStringLiteral(", ")));
         allArtists.removeDuplicates();
         newData[DataTypes::AllArtistsRole] = QVariant::fromValue(allArtists);
         if (!currentRecord.value(4).isNull()) {
             newData[DataTypes::IsValidAlbumArtistRole] = true;
-            newData[DataTypes::SecondaryTextRole] = currentRecord.value(4);
+            newData[DataTypes::SecondaryTextRole] = stringPool.intern(currentRecord.value(4));
         } else {
             newData[DataTypes::IsValidAlbumArtistRole] = false;
             if (currentRecord.value(5).toInt() == 1) {
@@ -7688,7 +10020,7 @@ DataTypes::ListAlbumDataType DatabaseInterface::internalAllAlbumsPartialData(QSq
         newData[DataTypes::ArtistRole] = newData[DataTypes::SecondaryTextRole];
         newData[DataTypes::HighestTrackRating] = currentRecord.value(7);
         newData[DataTypes::IsSingleDiscAlbumRole] = currentRecord.value(9);
-        newData[DataTypes::GenreRole] = QVariant::fromValue(currentRecord.value(8).toString().split(QStringLiteral(", ")));
+        newData[DataTypes::GenreRole] = QVariant::fromValue(stringPool.intern(currentRecord.value(8).toString().split(QStringLiteral(", "))));
         newData[DataTypes::ElementTypeRole] = ElisaUtils::Album;
 
         result.push_back(newData);
@@ -7703,6 +10035,10 @@ DataTypes::AlbumDataType DatabaseInterface::internalOneAlbumPartialData(qulonglo
 {
     auto result = DataTypes::AlbumDataType{};
 
+    if (d->mAlbumsStatsToRefresh.contains(databaseId)) {
+        internalRefreshAlbumsStats();
+    }
+
     d->mSelectAlbumQuery.bindValue(QStringLiteral(":albumId"), databaseId);
 
     if (!internalGenericPartialData(d->mSelectAlbumQuery)) {
@@ -7710,23 +10046,25 @@ DataTypes::AlbumDataType DatabaseInterface::internalOneAlbumPartialData(qulonglo
     }
 
     if (d->mSelectAlbumQuery.next()) {
+        auto &stringPool = StringPool::instance();
+
         const auto &currentRecord = d->mSelectAlbumQuery.record();
 
         result[DataTypes::DatabaseIdRole] = currentRecord.value(0);
-        result[DataTypes::TitleRole] = currentRecord.value(1);
+        result[DataTypes::TitleRole] = stringPool.intern(currentRecord.value(1));
         if (!currentRecord.value(4).toString().isEmpty()) {
             result[DataTypes::ImageUrlRole] = currentRecord.value(4);
         } else if (!currentRecord.value(11).toString().isEmpty()) {
             result[DataTypes::ImageUrlRole] = QVariant{QLatin1String("image://cover/") + currentRecord.value(11).toUrl().toLocalFile()};
         }
 
-        auto allArtists = currentRecord.value(8).toString().split(QStringLiteral(", "));
+        auto allArtists = stringPool.intern(currentRecord.value(8).toString().split(QStringLiteral(", ")));
         allArtists.removeDuplicates();
         result[DataTypes::AllArtistsRole] = QVariant::fromValue(allArtists);
 
         if (!currentRecord.value(2).isNull()) {
             result[DataTypes::IsValidAlbumArtistRole] = true;
-            result[DataTypes::SecondaryTextRole] = currentRecord.value(2);
+            result[DataTypes::SecondaryTextRole] = stringPool.intern(currentRecord.value(2));
         } else {
             result[DataTypes::IsValidAlbumArtistRole] = false;
             if (currentRecord.value(7).toInt() == 1) {
@@ -7738,7 +10076,7 @@ DataTypes::AlbumDataType DatabaseInterface::internalOneAlbumPartialData(qulonglo
         result[DataTypes::ArtistRole] = result[DataTypes::SecondaryTextRole];
         result[DataTypes::HighestTrackRating] = currentRecord.value(9);
         result[DataTypes::IsSingleDiscAlbumRole] = currentRecord.value(6);
-        result[DataTypes::GenreRole] = QVariant::fromValue(currentRecord.value(10).toString().split(QStringLiteral(", ")));
+        result[DataTypes::GenreRole] = QVariant::fromValue(stringPool.intern(currentRecord.value(10).toString().split(QStringLiteral(", "))));
         result[DataTypes::ElementTypeRole] = ElisaUtils::Album;
 
     }
@@ -7748,27 +10086,84 @@ DataTypes::AlbumDataType DatabaseInterface::internalOneAlbumPartialData(qulonglo
     return result;
 }
 
-DataTypes::ListTrackDataType DatabaseInterface::internalAllTracksPartialData()
+DataTypes::ListTrackDataType DatabaseInterface::internalAllTracksPartialData(QSqlQuery &query)
 {
     auto result = DataTypes::ListTrackDataType{};
 
-    if (!internalGenericPartialData(d->mSelectAllTracksQuery)) {
+    if (!internalGenericPartialData(query)) {
         return result;
     }
 
-    while(d->mSelectAllTracksQuery.next()) {
-        const auto &currentRecord = d->mSelectAllTracksQuery.record();
+    while(query.next()) {
+        const auto &currentRecord = query.record();
 
         auto newData = buildTrackDataFromDatabaseRecord(currentRecord);
 
         result.push_back(newData);
     }
 
-    d->mSelectAllTracksQuery.finish();
+    query.finish();
 
     return result;
 }
 
+QSqlQuery *DatabaseInterface::internalPageQuery(ElisaUtils::PlayListEntryType dataType, const DataTypes::PageRequest &request)
+{
+    auto searchColumns = QString{};
+    switch (dataType)
+    {
+    case ElisaUtils::Album:
+        searchColumns = QStringLiteral("AlbumTitle ArtistName");
+        break;
+    case ElisaUtils::Artist:
+        searchColumns = QStringLiteral("ArtistName");
+        break;
+    case ElisaUtils::Track:
+        break;
+    case ElisaUtils::Composer:
+    case ElisaUtils::Genre:
+    case ElisaUtils::Lyricist:
+    case ElisaUtils::FileName:
+    case ElisaUtils::Unknown:
+    case ElisaUtils::Radio:
+        return nullptr;
+    }
+
+    const auto matchExpression = searchMatchExpression(request.mSearchText, searchColumns);
+    const auto withSearch = !matchExpression.isEmpty();
+
+    if (withSearch) {
+        if (!d->mSearchIndexAvailable) {
+            return nullptr;
+        }
+
+        internalRefreshTracksSearch();
+    }
+
+    auto itQuery = d->mPageQueries.find(pageQueryKey(dataType, request.mSortOrder, withSearch));
+    if (itQuery == d->mPageQueries.end()) {
+        return nullptr;
+    }
+
+    auto &pageQuery = itQuery.value();
+
+    pageQuery.bindValue(QStringLiteral(":isFirstPage"), request.mIsFirstPage);
+    pageQuery.bindValue(QStringLiteral(":afterSortKey"), request.mAfterSortKey);
+    pageQuery.bindValue(QStringLiteral(":afterKey"), request.mAfterKey);
+    pageQuery.bindValue(QStringLiteral(":pageSize"), request.mPageSize);
+
+    // artists have no rating
+    if (dataType != ElisaUtils::Artist) {
+        pageQuery.bindValue(QStringLiteral(":minimumRating"), request.mMinimumRating);
+    }
+
+    if (withSearch) {
+        pageQuery.bindValue(QStringLiteral(":searchQuery"), matchExpression);
+    }
+
+    return &pageQuery;
+}
+
 DataTypes::ListRadioDataType DatabaseInterface::internalAllRadiosPartialData()
 {
     auto result = DataTypes::ListRadioDataType{};
@@ -7857,6 +10252,62 @@ DataTypes::TrackDataType DatabaseInterface::internalOneTrackPartialData(qulonglo
     return result;
 }
 
+DataTypes::ListTrackDataType DatabaseInterface::internalTracksPartialData(const QVector<qulonglong> &ids)
+{
+    auto result = DataTypes::ListTrackDataType{};
+
+    auto uniqueIds = ids;
+    std::sort(uniqueIds.begin(), uniqueIds.end());
+    uniqueIds.erase(std::unique(uniqueIds.begin(), uniqueIds.end()), uniqueIds.end());
+
+    auto tracksById = QHash<qulonglong, DataTypes::TrackDataType>{};
+    tracksById.reserve(uniqueIds.size());
+
+    for (int chunkBegin = 0; chunkBegin < uniqueIds.size(); chunkBegin += DatabaseInterfacePrivate::mSelectBatchSize) {
+        const auto &chunk = uniqueIds.mid(chunkBegin, DatabaseInterfacePrivate::mSelectBatchSize);
+
+        auto selectTracksQuery = QSqlQuery{d->mTracksDatabase};
+
+        prepareQuery(selectTracksQuery, d->mSelectTracksFromIdsQueryText.arg(queryPlaceholders(chunk.size())));
+
+        for (auto oneId : chunk) {
+            selectTracksQuery.addBindValue(oneId);
+        }
+
+        auto queryResult = execQuery(selectTracksQuery);
+
+        if (!queryResult || !selectTracksQuery.isSelect() || !selectTracksQuery.isActive()) {
+            Q_EMIT databaseError();
+
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalTracksPartialData" << selectTracksQuery.lastQuery();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalTracksPartialData" << selectTracksQuery.boundValues();
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::internalTracksPartialData" << selectTracksQuery.lastError();
+
+            selectTracksQuery.finish();
+
+            return result;
+        }
+
+        while (selectTracksQuery.next()) {
+            auto oneTrack = buildTrackDataFromDatabaseRecord(selectTracksQuery.record());
+            tracksById[oneTrack.databaseId()] = oneTrack;
+        }
+
+        selectTracksQuery.finish();
+    }
+
+    // in the order of the requested ids, missing tracks are skipped
+    result.reserve(ids.size());
+    for (auto oneId : ids) {
+        const auto itTrack = tracksById.constFind(oneId);
+        if (itTrack != tracksById.constEnd()) {
+            result.push_back(*itTrack);
+        }
+    }
+
+    return result;
+}
+
 DataTypes::TrackDataType DatabaseInterface::internalOneTrackPartialDataByIdAndUrl(qulonglong databaseId, const QUrl &trackUrl)
 {
     auto result = DataTypes::TrackDataType{};
@@ -8003,6 +10454,11 @@ void DatabaseInterface::updateAlbumArtist(qulonglong albumId, const QString &tit
                                           const QString &albumPath,
                                           const QString &artistName)
 {
+    d->mAlbumIdsCache.remove(qMakePair(title, albumPath));
+    DatabaseInterfacePrivate::removeCachedId(d->mAlbumIdsFromTitleAndArtistCache, albumId);
+
+    d->mAlbumsStatsToRefresh.insert(albumId);
+
     d->mUpdateAlbumArtistQuery.bindValue(QStringLiteral(":albumId"), albumId);
     insertArtist(artistName);
     d->mUpdateAlbumArtistQuery.bindValue(QStringLiteral(":artistName"), artistName);
@@ -8042,6 +10498,14 @@ void DatabaseInterface::updateAlbumArtist(qulonglong albumId, const QString &tit
     }
 
     d->mUpdateAlbumArtistInTracksQuery.finish();
+
+    for (auto &pendingTrack : d->mPendingTracks) {
+        if (pendingTrack[DatabaseInterfacePrivate::PendingTrackAlbumTitle].toString() == title &&
+                pendingTrack[DatabaseInterfacePrivate::PendingTrackAlbumPath].toString() == albumPath &&
+                pendingTrack[DatabaseInterfacePrivate::PendingTrackAlbumArtistName].isNull()) {
+            pendingTrack[DatabaseInterfacePrivate::PendingTrackAlbumArtistName] = artistName;
+        }
+    }
 }
 
 void DatabaseInterface::updateTrackStatistics(const QUrl &fileName, const QDateTime &time)
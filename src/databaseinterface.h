@@ -25,6 +25,7 @@
 
 #include <QObject>
 #include <QString>
+#include <QStringList>
 #include <QHash>
 #include <QList>
 #include <QVariant>
@@ -53,14 +54,27 @@ public:
         V13 = 13,
         V14 = 14,
         V15 = 15,
-        V16 = 16, //Does not exist yet, for testing purpose only.
+        V16 = 16,
+        V17 = 17,
+        V18 = 18,
+        V19 = 19,
+        V20 = 20, //Does not exist yet, for testing purpose only.
     };
 
     explicit DatabaseInterface(QObject *parent = nullptr);
 
     ~DatabaseInterface() override;
 
-    Q_INVOKABLE void init(const QString &dbName, const QString &databaseFileName = {});
+    Q_INVOKABLE void init(const QString &dbName, const QString &databaseFileName = {},
+                          bool useWriteAheadLog = false);
+
+    /**
+     * Open an additional connection to an existing database file that can only
+     * read. It is meant to be used from its own thread together with a writer
+     * connection initialized with useWriteAheadLog set to true so that reads
+     * are not blocked while tracks are being imported.
+     */
+    Q_INVOKABLE void initReadOnly(const QString &dbName, const QString &databaseFileName);
 
     qulonglong albumIdFromTitleAndArtist(const QString &title, const QString &artist, const QString &albumPath);
 
@@ -94,6 +108,12 @@ public:
 
     DataTypes::TrackDataType trackDataFromDatabaseId(qulonglong id);
 
+    /**
+     * Data of many tracks read in one transaction, in the order of ids.
+     * Unknown ids are skipped.
+     */
+    DataTypes::ListTrackDataType tracksDataFromDatabaseIds(const QVector<qulonglong> &ids);
+
     DataTypes::TrackDataType trackDataFromDatabaseIdAndUrl(qulonglong id, const QUrl &trackUrl);
 
     DataTypes::TrackDataType radioDataFromDatabaseId(qulonglong id);
@@ -104,6 +124,46 @@ public:
 
     qulonglong radioIdFromFileName(const QUrl &fileName);
 
+    /**
+     * Keyset pagination of all tracks, sorted by title then by database id.
+     * Returns at most request.mPageSize tracks after the track given by request:
+     * the title and the id of the last track of a page start the next one.
+     */
+    DataTypes::ListTrackDataType allTracksDataPage(const DataTypes::PageRequest &request);
+
+    DataTypes::ListAlbumDataType allAlbumsDataPage(const DataTypes::PageRequest &request);
+
+    DataTypes::ListArtistDataType allArtistsDataPage(const DataTypes::PageRequest &request);
+
+    /**
+     * Database ids and titles of the entries of the pages given by request, in the same order.
+     * This is all what is needed to enqueue them without loading their complete data.
+     */
+    ElisaUtils::EntryDataList allEntriesOfPages(ElisaUtils::PlayListEntryType dataType, const DataTypes::PageRequest &request);
+
+    /**
+     * Full text search of tracks by title, artist, album, composer, genre or comment.
+     * Each word of searchText is matched as a prefix of a word of the indexed text.
+     * A negative limit returns all matching tracks.
+     */
+    DataTypes::ListTrackDataType searchTracks(const QString &searchText, int limit, int offset);
+
+    DataTypes::ListAlbumDataType searchAlbums(const QString &searchText, int limit, int offset);
+
+    DataTypes::ListArtistDataType searchArtists(const QString &searchText, int limit, int offset);
+
+    /**
+     * Same search as searchTracks, searchAlbums or searchArtists without reading the matching data.
+     * At most limit ids are returned, in no specific order.
+     */
+    QVector<qulonglong> searchIds(ElisaUtils::PlayListEntryType dataType, const QString &searchText, int limit);
+
+    /**
+     * The full text index needs the FTS5 extension of SQLite.
+     * When it is missing, all search methods return no result.
+     */
+    bool isSearchIndexAvailable() const;
+
     void applicationAboutToQuit();
 
 Q_SIGNALS:
@@ -130,15 +190,30 @@ Q_SIGNALS:
 
     void trackModified(const DataTypes::TrackDataType &modifiedTrack);
 
+    /**
+     * Emitted once per database operation with all the tracks it inserted, modified or removed.
+     * Only the changed roles of tracks whose album is unchanged are re-sent.
+     */
+    void tracksChanged(const DataTypes::TracksChangeSet &changes);
+
     void requestsInitDone();
 
     void databaseError();
 
+    /**
+     * Emitted by askRestoredTracks just before restoredTracks with the directories
+     * recorded by insertScannedDirectoriesList.
+     */
+    void restoredScannedDirectories(const DataTypes::ListDirectoryScanData &scannedDirectories);
+
     void restoredTracks(const QHash<QUrl, QDateTime> &allFiles);
 
     void cleanedDatabase();
 
-    void finishInsertingTracksList();
+    /**
+     * batchId is the one given to insertTracksAndScannedDirectoriesList, 0 for insertTracksList.
+     */
+    void finishInsertingTracksList(qulonglong batchId);
 
     void finishRemovingTracksList();
 
@@ -152,10 +227,34 @@ public Q_SLOTS:
 
     void insertTracksList(const DataTypes::ListTrackDataType &tracks, const QHash<QString, QUrl> &covers);
 
+    /**
+     * Insert tracks and, in the same transaction, the directories whose tracks
+     * have now all been sent: a scan interrupted before its end resumes from the
+     * directories not yet recorded.
+     * batchId is given back by finishInsertingTracksList to let the sender
+     * recognize its own batches.
+     */
+    void insertTracksAndScannedDirectoriesList(const DataTypes::ListTrackDataType &tracks, const QHash<QString, QUrl> &covers,
+                                               const DataTypes::ListDirectoryScanData &scannedDirectories,
+                                               qulonglong batchId);
+
     void removeTracksList(const QList<QUrl> &removedTracks);
 
+    /**
+     * Move tracks to their new file name. Their database ids, statistics and
+     * metadata are kept: only the file name and the album path are updated.
+     */
+    void renameTracksList(const DataTypes::ListRenamedFileData &renamedFiles);
+
     void askRestoredTracks();
 
+    /**
+     * Record the state of directories whose tracks have all been sent with insertTracksList.
+     * Each removed directory is forgotten together with all its sub-directories.
+     */
+    void insertScannedDirectoriesList(const DataTypes::ListDirectoryScanData &scannedDirectories,
+                                      const QList<QUrl> &removedDirectories);
+
     void trackHasStartedPlaying(const QUrl &fileName, const QDateTime &time);
 
     void clearData();
@@ -177,9 +276,13 @@ private:
 
     void recordModifiedAlbum(qulonglong albumId);
 
+    bool internalRefreshAlbumsStats();
+
+    bool internalRefreshTracksSearch();
+
     bool startTransaction() const;
 
-    bool finishTransaction() const;
+    bool finishTransaction();
 
     bool rollBackTransaction() const;
 
@@ -220,9 +323,10 @@ private:
 
     qulonglong insertGenre(const QString &name);
 
-    void removeTrackInDatabase(qulonglong trackId);
+    void removeTrackInDatabase(qulonglong trackId, qulonglong albumId);
 
-    void updateTrackInDatabase(const DataTypes::TrackDataType &oneTrack, const QString &albumPath);
+    void updateTrackInDatabase(const DataTypes::TrackDataType &oneTrack, const QString &albumPath,
+                               qulonglong oldAlbumId, qulonglong newAlbumId);
 
     void removeAlbumInDatabase(qulonglong albumId);
 
@@ -236,9 +340,29 @@ private:
 
     void updateTrackOrigin(const QUrl &fileName, const QDateTime &fileModifiedTime);
 
+    bool renameTrackOrigin(const QUrl &oldFileName, const QUrl &newFileName, const QDateTime &fileModifiedTime);
+
     qulonglong internalInsertTrack(const DataTypes::TrackDataType &oneModifiedTrack,
                                    const QHash<QString, QUrl> &covers, bool &isInserted);
 
+    bool hasPendingDuplicateTrack(const DataTypes::TrackDataType &oneTrack, const QString &trackPath, int priority) const;
+
+    bool flushPendingTracks();
+
+    void flushPendingAlbumUpdates();
+
+    bool internalPrefetchTracksMapping(const DataTypes::ListTrackDataType &tracks);
+
+    bool internalInsertTracksOriginList(const QList<QUrl> &fileNames, const QList<QDateTime> &fileModifiedTimes,
+                                        const QDateTime &importDate);
+
+    bool internalInsertNamesList(const QString &tableName, const QStringList &names, qulonglong &nextId,
+                                 QHash<QString, qulonglong> &namesIds, QList<qulonglong> &newIds);
+
+    bool internalResolveTracksListNames(const DataTypes::ListTrackDataType &tracks);
+
+    void clearTracksListBatch();
+
     DataTypes::TrackDataType buildTrackFromDatabaseRecord(const QSqlRecord &trackRecord) const;
 
     DataTypes::TrackDataType buildTrackDataFromDatabaseRecord(const QSqlRecord &trackRecord) const;
@@ -247,6 +371,11 @@ private:
 
     void internalRemoveTracksList(const QList<QUrl> &removedTracks);
 
+    void internalRenameTracksList(const DataTypes::ListRenamedFileData &renamedFiles);
+
+    void internalInsertScannedDirectoriesList(const DataTypes::ListDirectoryScanData &scannedDirectories,
+                                              const QList<QUrl> &removedDirectories);
+
     void internalRemoveTracksList(const QHash<QUrl, QDateTime> &removedTracks, qulonglong sourceId);
 
     QUrl internalAlbumArtUriFromAlbumId(qulonglong albumId);
@@ -259,6 +388,8 @@ private:
 
     QHash<QUrl, QDateTime> internalAllFileName();
 
+    DataTypes::ListDirectoryScanData internalAllScannedDirectories();
+
     bool internalGenericPartialData(QSqlQuery &query);
 
     DataTypes::ListArtistDataType internalAllArtistsPartialData(QSqlQuery &artistsQuery);
@@ -267,7 +398,9 @@ private:
 
     DataTypes::AlbumDataType internalOneAlbumPartialData(qulonglong databaseId);
 
-    DataTypes::ListTrackDataType internalAllTracksPartialData();
+    DataTypes::ListTrackDataType internalAllTracksPartialData(QSqlQuery &query);
+
+    QSqlQuery *internalPageQuery(ElisaUtils::PlayListEntryType dataType, const DataTypes::PageRequest &request);
 
     DataTypes::ListRadioDataType internalAllRadiosPartialData();
 
@@ -277,6 +410,8 @@ private:
 
     DataTypes::TrackDataType internalOneTrackPartialData(qulonglong databaseId);
 
+    DataTypes::ListTrackDataType internalTracksPartialData(const QVector<qulonglong> &ids);
+
     DataTypes::TrackDataType internalOneTrackPartialDataByIdAndUrl(qulonglong databaseId, const QUrl &trackUrl);
 
     DataTypes::TrackDataType internalOneRadioPartialData(qulonglong databaseId);
@@ -312,10 +447,22 @@ private:
 
     void upgradeDatabaseV16();
 
+    void upgradeDatabaseV17();
+
+    void upgradeDatabaseV18();
+
+    void upgradeDatabaseV19();
+
+    void upgradeDatabaseV20();
+
     void checkDatabaseSchema();
 
     void checkAlbumsTableSchema();
 
+    void checkAlbumStatsTableSchema();
+
+    void checkScannedDirectoriesTableSchema();
+
     void checkArtistsTableSchema();
 
     void checkComposerTableSchema();
@@ -18,5 +18,108 @@
 
 #include "datatypes.h"
 
+#include "stringpool.h"
+
+#include <QDebug>
+
+static constexpr int rolesCount(quint64 roles)
+{
+    return roles ? static_cast<int>(roles & 1) + rolesCount(roles >> 1) : 0;
+}
+
+static bool packTrackValue(const QVariant &value, quint8 &type, qint64 &packedValue)
+{
+    if (value.isNull()) {
+        return false;
+    }
+
+    switch (value.userType())
+    {
+    case QMetaType::Bool:
+        packedValue = value.toBool() ? 1 : 0;
+        break;
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::LongLong:
+        packedValue = value.toLongLong();
+        break;
+    case QMetaType::ULongLong:
+        packedValue = static_cast<qint64>(value.toULongLong());
+        break;
+    case QMetaType::QTime:
+        packedValue = value.toTime().msecsSinceStartOfDay();
+        break;
+    default:
+        return false;
+    }
+
+    type = static_cast<quint8>(value.userType());
+
+    return true;
+}
+
+void DataTypes::TrackDataType::setRoleValue(key_type role, const mapped_type &value)
+{
+    const auto index = roleIndex(role);
+
+    if (index < 0) {
+        return;
+    }
+
+    if (InternedTrackRoles & roleBit(index)) {
+        storeRoleValue(role, StringPool::instance().intern(value));
+    } else {
+        storeRoleValue(role, value);
+    }
+}
+
+void DataTypes::TrackDataType::storeRoleValue(key_type role, mapped_type value)
+{
+    static_assert(rolesCount(PackedTrackRoles) == PackedTrackRolesCount, "PackedTrackRolesCount must match PackedTrackRoles");
+
+    const auto index = roleIndex(role);
+
+    if (index < 0) {
+        return;
+    }
+
+    auto *data = writableData();
+    const auto bit = roleBit(index);
+
+    data->mPresentRoles |= bit;
+
+    if (PackedTrackRoles & bit) {
+        const auto packedSlot = packedIndex(index);
+
+        if (packTrackValue(value, data->mPackedTypes[packedSlot], data->mPackedValues[packedSlot])) {
+            if (data->mVariantRoles & bit) {
+                data->mValues.remove(variantIndex(data, index));
+                data->mVariantRoles &= ~bit;
+            }
+
+            return;
+        }
+    }
+
+    if (data->mVariantRoles & bit) {
+        data->mValues[variantIndex(data, index)] = std::move(value);
+    } else {
+        data->mValues.insert(variantIndex(data, index), value);
+        data->mVariantRoles |= bit;
+    }
+}
+
+QDebug operator<<(QDebug stream, const DataTypes::TrackDataType &trackData)
+{
+    QDebugStateSaver saver(stream);
+
+    stream.nospace() << "TrackDataType(";
+    for (auto itData = trackData.begin(); itData != trackData.end(); ++itData) {
+        stream << '(' << itData.key() << ", " << itData.value() << ')';
+    }
+    stream << ')';
+
+    return stream;
+}
 
 #include "moc_datatypes.cpp"
@@ -24,10 +24,21 @@
 #include <QObject>
 #include <QString>
 #include <QList>
+#include <QVector>
 #include <QVariant>
 #include <QUrl>
 #include <QDateTime>
+#include <QByteArray>
 #include <QMap>
+#include <QSharedData>
+#include <QSharedDataPointer>
+#include <QtAlgorithms>
+
+#include <array>
+#include <initializer_list>
+#include <utility>
+
+class QDebug;
 
 class ELISALIB_EXPORT DataTypes : public QObject
 {
@@ -84,31 +95,556 @@ private:
 
     using DataType = QMap<ColumnsRoles, QVariant>;
 
+    static constexpr int FirstTrackRole = TitleRole;
+
+    static constexpr int TrackRolesCount = LyricsRole - TitleRole + 1;
+
+    static_assert(TrackRolesCount <= 64, "track roles presence must fit in a 64 bits mask");
+
+    /**
+     * Roles stored as a packed 64 bits integer when they hold a boolean, an integer or a valid time.
+     */
+    static constexpr quint64 PackedTrackRoles =
+            (quint64(1) << (DurationRole - FirstTrackRole)) | (quint64(1) << (HighestTrackRating - FirstTrackRole)) |
+            (quint64(1) << (IsValidAlbumArtistRole - FirstTrackRole)) | (quint64(1) << (TrackNumberRole - FirstTrackRole)) |
+            (quint64(1) << (DiscNumberRole - FirstTrackRole)) | (quint64(1) << (RatingRole - FirstTrackRole)) |
+            (quint64(1) << (YearRole - FirstTrackRole)) | (quint64(1) << (ChannelsRole - FirstTrackRole)) |
+            (quint64(1) << (BitRateRole - FirstTrackRole)) | (quint64(1) << (SampleRateRole - FirstTrackRole)) |
+            (quint64(1) << (DatabaseIdRole - FirstTrackRole)) | (quint64(1) << (IsSingleDiscAlbumRole - FirstTrackRole)) |
+            (quint64(1) << (IsPartialDataRole - FirstTrackRole)) | (quint64(1) << (AlbumIdRole - FirstTrackRole)) |
+            (quint64(1) << (HasEmbeddedCover - FirstTrackRole)) | (quint64(1) << (PlayCounter - FirstTrackRole)) |
+            (quint64(1) << (ElementTypeRole - FirstTrackRole));
+
+    static constexpr int PackedTrackRolesCount = 17;
+
+    /**
+     * Roles whose string values are shared through StringPool when they are set.
+     * This is the only place where the strings of a track are interned.
+     */
+    static constexpr quint64 InternedTrackRoles =
+            (quint64(1) << (ArtistRole - FirstTrackRole)) | (quint64(1) << (AlbumRole - FirstTrackRole)) |
+            (quint64(1) << (AlbumArtistRole - FirstTrackRole)) | (quint64(1) << (GenreRole - FirstTrackRole)) |
+            (quint64(1) << (ComposerRole - FirstTrackRole)) | (quint64(1) << (LyricistRole - FirstTrackRole));
+
+    class TrackDataTypePrivate : public QSharedData
+    {
+    public:
+
+        /**
+         * Values of mVariantRoles, ordered by role.
+         */
+        QVector<QVariant> mValues;
+
+        /**
+         * One slot per PackedTrackRoles role holding the value and its QMetaType::Type.
+         */
+        std::array<qint64, PackedTrackRolesCount> mPackedValues = {};
+
+        std::array<quint8, PackedTrackRolesCount> mPackedTypes = {};
+
+        quint64 mPresentRoles = 0;
+
+        quint64 mVariantRoles = 0;
+
+    };
+
 public:
 
-    class TrackDataType : public DataType
+    /**
+     * Compact track record: a fixed array of packed integers for the numeric roles, a vector
+     * holding only the other roles that are set and a bitmask of the roles that have been set.
+     * Strings of the roles shared by many tracks (artists, albums, genres, ...) are interned
+     * through StringPool.
+     *
+     * Copies are implicitly shared. The API mirrors the subset of QMap used by Elisa so that
+     * it can be used as a drop-in replacement of the previous QMap based storage, except that
+     * values are returned by value and written through a RoleReference.
+     */
+    class ELISALIB_EXPORT TrackDataType
     {
     public:
 
-        using DataType::DataType;
+        using key_type = ColumnsRoles;
+
+        using mapped_type = QVariant;
+
+        /**
+         * Writable access to one role given by the non const operator[]. It converts to the
+         * QVariant value of the role and forwards its read only API. Reading a role does not
+         * insert it.
+         */
+        class RoleReference
+        {
+        public:
+
+            RoleReference(const RoleReference &other) = default;
+
+            RoleReference &operator=(const mapped_type &value)
+            {
+                mTrack->setRoleValue(mRole, value);
+                return *this;
+            }
+
+            RoleReference &operator=(const RoleReference &other)
+            {
+                return operator=(other.toVariant());
+            }
+
+            operator mapped_type() const
+            {
+                return toVariant();
+            }
+
+            mapped_type toVariant() const
+            {
+                return mTrack->roleValue(mRole);
+            }
+
+            bool isValid() const
+            {
+                return toVariant().isValid();
+            }
+
+            bool isNull() const
+            {
+                return toVariant().isNull();
+            }
+
+            int userType() const
+            {
+                return toVariant().userType();
+            }
+
+            bool toBool() const
+            {
+                return toVariant().toBool();
+            }
+
+            int toInt(bool *ok = nullptr) const
+            {
+                return toVariant().toInt(ok);
+            }
+
+            uint toUInt(bool *ok = nullptr) const
+            {
+                return toVariant().toUInt(ok);
+            }
+
+            qlonglong toLongLong(bool *ok = nullptr) const
+            {
+                return toVariant().toLongLong(ok);
+            }
+
+            qulonglong toULongLong(bool *ok = nullptr) const
+            {
+                return toVariant().toULongLong(ok);
+            }
+
+            double toDouble(bool *ok = nullptr) const
+            {
+                return toVariant().toDouble(ok);
+            }
+
+            QString toString() const
+            {
+                return toVariant().toString();
+            }
+
+            QStringList toStringList() const
+            {
+                return toVariant().toStringList();
+            }
+
+            QByteArray toByteArray() const
+            {
+                return toVariant().toByteArray();
+            }
+
+            QUrl toUrl() const
+            {
+                return toVariant().toUrl();
+            }
+
+            QTime toTime() const
+            {
+                return toVariant().toTime();
+            }
+
+            QDateTime toDateTime() const
+            {
+                return toVariant().toDateTime();
+            }
+
+            template <typename T>
+            T value() const
+            {
+                return toVariant().template value<T>();
+            }
+
+            template <typename T>
+            bool canConvert() const
+            {
+                return toVariant().template canConvert<T>();
+            }
+
+            friend bool operator==(const RoleReference &first, const RoleReference &second)
+            {
+                return first.toVariant() == second.toVariant();
+            }
+
+            friend bool operator==(const RoleReference &first, const mapped_type &second)
+            {
+                return first.toVariant() == second;
+            }
+
+            friend bool operator==(const mapped_type &first, const RoleReference &second)
+            {
+                return first == second.toVariant();
+            }
+
+            friend bool operator!=(const RoleReference &first, const RoleReference &second)
+            {
+                return !(first == second);
+            }
+
+            friend bool operator!=(const RoleReference &first, const mapped_type &second)
+            {
+                return !(first == second);
+            }
+
+            friend bool operator!=(const mapped_type &first, const RoleReference &second)
+            {
+                return !(first == second);
+            }
+
+        private:
+
+            friend class TrackDataType;
+
+            RoleReference(TrackDataType *track, key_type role) : mTrack(track), mRole(role)
+            {
+            }
+
+            TrackDataType *mTrack;
+
+            key_type mRole;
+
+        };
+
+        class const_iterator
+        {
+        public:
+
+            const_iterator() = default;
+
+            key_type key() const
+            {
+                return static_cast<key_type>(FirstTrackRole + mIndex);
+            }
+
+            mapped_type value() const
+            {
+                return valueAt(mData, mIndex);
+            }
+
+            mapped_type operator*() const
+            {
+                return value();
+            }
+
+            const_iterator &operator++()
+            {
+                mIndex = nextIndex(mData, mIndex + 1);
+                return *this;
+            }
+
+            const_iterator operator++(int)
+            {
+                auto previous = *this;
+                operator++();
+                return previous;
+            }
+
+            bool operator==(const const_iterator &other) const
+            {
+                return mIndex == other.mIndex;
+            }
+
+            bool operator!=(const const_iterator &other) const
+            {
+                return mIndex != other.mIndex;
+            }
+
+        private:
+
+            friend class TrackDataType;
+
+            const_iterator(const TrackDataTypePrivate *data, int index) : mData(data), mIndex(index)
+            {
+            }
+
+            const TrackDataTypePrivate *mData = nullptr;
+
+            int mIndex = TrackRolesCount;
+
+        };
+
+        using iterator = const_iterator;
+
+        class const_key_value_iterator
+        {
+        public:
+
+            const_key_value_iterator() = default;
+
+            explicit const_key_value_iterator(const_iterator iterator) : mIterator(iterator)
+            {
+            }
+
+            std::pair<key_type, mapped_type> operator*() const
+            {
+                return {mIterator.key(), mIterator.value()};
+            }
+
+            const_key_value_iterator &operator++()
+            {
+                ++mIterator;
+                return *this;
+            }
+
+            const_key_value_iterator operator++(int)
+            {
+                auto previous = *this;
+                ++mIterator;
+                return previous;
+            }
+
+            bool operator==(const const_key_value_iterator &other) const
+            {
+                return mIterator == other.mIterator;
+            }
+
+            bool operator!=(const const_key_value_iterator &other) const
+            {
+                return mIterator != other.mIterator;
+            }
+
+        private:
+
+            const_iterator mIterator;
+
+        };
+
+        TrackDataType() = default;
+
+        TrackDataType(std::initializer_list<std::pair<key_type, mapped_type>> list)
+        {
+            for (const auto &oneData : list) {
+                setRoleValue(oneData.first, oneData.second);
+            }
+        }
 
         TrackDataType(bool aValid, QString aId, QString aParentId, QString aTitle, QString aArtist, QString aAlbumName,
                       QString aAlbumArtist, int aTrackNumber, int aDiscNumber, QTime aDuration, QUrl aResourceURI,
                       const QDateTime &fileModificationTime, QUrl aAlbumCover, int rating, bool aIsSingleDiscAlbum,
                       QString aGenre, QString aComposer, QString aLyricist, bool aHasEmbeddedCover)
-            : DataType({{key_type::TitleRole, std::move(aTitle)}, {key_type::AlbumRole, std::move(aAlbumName)},
-                        {key_type::ArtistRole, std::move(aArtist)}, {key_type::AlbumArtistRole, std::move(aAlbumArtist)},
-                        {key_type::IdRole, std::move(aId)}, {key_type::ParentIdRole, std::move(aParentId)},
-                        {key_type::TrackNumberRole, aTrackNumber}, {key_type::DiscNumberRole, aDiscNumber},
-                        {key_type::DurationRole, aDuration}, {key_type::ResourceRole, std::move(aResourceURI)},
-                        {key_type::FileModificationTime, fileModificationTime}, {key_type::ImageUrlRole, std::move(aAlbumCover)},
-                        {key_type::RatingRole, rating}, {key_type::IsSingleDiscAlbumRole, aIsSingleDiscAlbum},
-                        {key_type::GenreRole, std::move(aGenre)}, {key_type::ComposerRole, std::move(aComposer)},
-                        {key_type::LyricistRole, std::move(aLyricist)}, {key_type::HasEmbeddedCover, aHasEmbeddedCover},})
+            : TrackDataType({{key_type::TitleRole, std::move(aTitle)}, {key_type::AlbumRole, std::move(aAlbumName)},
+                             {key_type::ArtistRole, std::move(aArtist)}, {key_type::AlbumArtistRole, std::move(aAlbumArtist)},
+                             {key_type::IdRole, std::move(aId)}, {key_type::ParentIdRole, std::move(aParentId)},
+                             {key_type::TrackNumberRole, aTrackNumber}, {key_type::DiscNumberRole, aDiscNumber},
+                             {key_type::DurationRole, aDuration}, {key_type::ResourceRole, std::move(aResourceURI)},
+                             {key_type::FileModificationTime, fileModificationTime}, {key_type::ImageUrlRole, std::move(aAlbumCover)},
+                             {key_type::RatingRole, rating}, {key_type::IsSingleDiscAlbumRole, aIsSingleDiscAlbum},
+                             {key_type::GenreRole, std::move(aGenre)}, {key_type::ComposerRole, std::move(aComposer)},
+                             {key_type::LyricistRole, std::move(aLyricist)}, {key_type::HasEmbeddedCover, aHasEmbeddedCover},})
         {
             Q_UNUSED(aValid)
         }
 
+        mapped_type operator[](key_type role) const
+        {
+            return roleValue(role);
+        }
+
+        /**
+         * Returns a writable reference to role. Values written to roles that are not
+         * DataTypes::ColumnsRoles values are discarded.
+         */
+        RoleReference operator[](key_type role)
+        {
+            return {this, role};
+        }
+
+        /**
+         * Value of a model role without going through a map lookup nor detaching the record.
+         * Roles outside of DataTypes::ColumnsRoles give an invalid QVariant.
+         */
+        QVariant roleData(int role) const
+        {
+            return roleValue(static_cast<key_type>(role));
+        }
+
+        mapped_type value(key_type role, const mapped_type &defaultValue = {}) const
+        {
+            return contains(role) ? roleValue(role) : defaultValue;
+        }
+
+        bool contains(key_type role) const
+        {
+            const auto index = roleIndex(role);
+            return index >= 0 && (presentRoles() & roleBit(index));
+        }
+
+        const_iterator insert(key_type role, const mapped_type &value)
+        {
+            setRoleValue(role, value);
+            return find(role);
+        }
+
+        int remove(key_type role)
+        {
+            if (!contains(role)) {
+                return 0;
+            }
+
+            auto *data = writableData();
+            const auto index = roleIndex(role);
+
+            if (data->mVariantRoles & roleBit(index)) {
+                data->mValues.remove(variantIndex(data, index));
+                data->mVariantRoles &= ~roleBit(index);
+            }
+            data->mPresentRoles &= ~roleBit(index);
+
+            return 1;
+        }
+
+        void clear()
+        {
+            d = QSharedDataPointer<TrackDataTypePrivate>{};
+        }
+
+        int count() const
+        {
+            return static_cast<int>(qPopulationCount(presentRoles()));
+        }
+
+        int size() const
+        {
+            return count();
+        }
+
+        bool isEmpty() const
+        {
+            return presentRoles() == 0;
+        }
+
+        bool empty() const
+        {
+            return isEmpty();
+        }
+
+        QList<key_type> keys() const
+        {
+            auto result = QList<key_type>{};
+
+            for (auto itData = begin(); itData != end(); ++itData) {
+                result.push_back(itData.key());
+            }
+
+            return result;
+        }
+
+        const_iterator find(key_type role) const
+        {
+            return contains(role) ? const_iterator{d.constData(), roleIndex(role)} : end();
+        }
+
+        const_iterator constFind(key_type role) const
+        {
+            return find(role);
+        }
+
+        const_iterator begin() const
+        {
+            return {d.constData(), nextIndex(d.constData(), 0)};
+        }
+
+        const_iterator end() const
+        {
+            return {d.constData(), TrackRolesCount};
+        }
+
+        const_iterator cbegin() const
+        {
+            return begin();
+        }
+
+        const_iterator cend() const
+        {
+            return end();
+        }
+
+        const_iterator constBegin() const
+        {
+            return begin();
+        }
+
+        const_iterator constEnd() const
+        {
+            return end();
+        }
+
+        const_key_value_iterator constKeyValueBegin() const
+        {
+            return const_key_value_iterator{begin()};
+        }
+
+        const_key_value_iterator constKeyValueEnd() const
+        {
+            return const_key_value_iterator{end()};
+        }
+
+        bool operator==(const TrackDataType &other) const
+        {
+            if (d == other.d) {
+                return true;
+            }
+
+            if (presentRoles() != other.presentRoles()) {
+                return false;
+            }
+
+            for (auto itData = begin(); itData != end(); ++itData) {
+                if (itData.value() != valueAt(other.d.constData(), itData.mIndex)) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        bool operator!=(const TrackDataType &other) const
+        {
+            return !operator==(other);
+        }
+
+        /**
+         * Copy the roles set in changes into this record. A role with an invalid value in
+         * changes is removed.
+         */
+        void applyChanges(const TrackDataType &changes)
+        {
+            for (auto itChange = changes.begin(); itChange != changes.end(); ++itChange) {
+                auto changedValue = itChange.value();
+                if (changedValue.isValid()) {
+                    storeRoleValue(itChange.key(), std::move(changedValue));
+                } else {
+                    remove(itChange.key());
+                }
+            }
+        }
+
         bool isValid() const
         {
             return !isEmpty() && duration().isValid();
@@ -116,165 +652,334 @@ public:
 
         qulonglong databaseId() const
         {
-            return operator[](key_type::DatabaseIdRole).toULongLong();
+            return roleValue(key_type::DatabaseIdRole).toULongLong();
         }
 
         QString title() const
         {
-            return operator[](key_type::TitleRole).toString();
+            return roleValue(key_type::TitleRole).toString();
         }
 
         QString artist() const
         {
-            return operator[](key_type::ArtistRole).toString();
+            return roleValue(key_type::ArtistRole).toString();
         }
 
         qulonglong albumId() const
         {
-            return operator[](key_type::AlbumIdRole).toULongLong();
+            return roleValue(key_type::AlbumIdRole).toULongLong();
         }
 
         bool hasAlbum() const
         {
-            return find(key_type::AlbumRole) != end();
+            return contains(key_type::AlbumRole);
         }
 
         QString album() const
         {
-            return operator[](key_type::AlbumRole).toString();
+            return roleValue(key_type::AlbumRole).toString();
         }
 
         QString albumArtist() const
         {
-            return operator[](key_type::AlbumArtistRole).toString();
+            return roleValue(key_type::AlbumArtistRole).toString();
         }
 
         bool hasAlbumArtist() const
         {
-            return find(key_type::AlbumArtistRole) != end();
+            return contains(key_type::AlbumArtistRole);
         }
 
         bool hasTrackNumber() const
         {
-            return find(key_type::TrackNumberRole) != end();
+            return contains(key_type::TrackNumberRole);
         }
 
         int trackNumber() const
         {
-            return operator[](key_type::TrackNumberRole).toInt();
+            return roleValue(key_type::TrackNumberRole).toInt();
         }
 
         bool hasDiscNumber() const
         {
-            return find(key_type::DiscNumberRole) != end();
+            return contains(key_type::DiscNumberRole);
         }
 
         int discNumber() const
         {
-            return operator[](key_type::DiscNumberRole).toInt();
+            return roleValue(key_type::DiscNumberRole).toInt();
         }
 
         QTime duration() const
         {
-            return operator[](key_type::DurationRole).toTime();
+            return roleValue(key_type::DurationRole).toTime();
         }
 
         QUrl resourceURI() const
         {
-            return operator[](key_type::ResourceRole).toUrl();
+            return roleValue(key_type::ResourceRole).toUrl();
         }
 
         QUrl albumCover() const
         {
-            return operator[](key_type::ImageUrlRole).toUrl();
+            return roleValue(key_type::ImageUrlRole).toUrl();
         }
 
         bool isSingleDiscAlbum() const
         {
-            return operator[](key_type::IsSingleDiscAlbumRole).toBool();
+            return roleValue(key_type::IsSingleDiscAlbumRole).toBool();
         }
 
         int rating() const
         {
-            return operator[](key_type::RatingRole).toInt();
+            return roleValue(key_type::RatingRole).toInt();
         }
 
         QString genre() const
         {
-            return operator[](key_type::GenreRole).toString();
+            return roleValue(key_type::GenreRole).toString();
         }
 
         QString composer() const
         {
-            return operator[](key_type::ComposerRole).toString();
+            return roleValue(key_type::ComposerRole).toString();
         }
 
         QString lyricist() const
         {
-            return operator[](key_type::LyricistRole).toString();
+            return roleValue(key_type::LyricistRole).toString();
         }
 
         QString lyrics() const
         {
-            return operator[](key_type::LyricsRole).toString();
+            return roleValue(key_type::LyricsRole).toString();
         }
 
         QString comment() const
         {
-            return operator[](key_type::CommentRole).toString();
+            return roleValue(key_type::CommentRole).toString();
         }
 
         int year() const
         {
-            return operator[](key_type::YearRole).toInt();
+            return roleValue(key_type::YearRole).toInt();
         }
 
         int channels() const
         {
-            return operator[](key_type::ChannelsRole).toInt();
+            return roleValue(key_type::ChannelsRole).toInt();
         }
 
         bool hasChannels() const
         {
-            return find(key_type::ChannelsRole) != end();
+            return contains(key_type::ChannelsRole);
         }
 
         int bitRate() const
         {
-            return operator[](key_type::BitRateRole).toInt();
+            return roleValue(key_type::BitRateRole).toInt();
         }
 
         bool hasBitRate() const
         {
-            return find(key_type::BitRateRole) != end();
+            return contains(key_type::BitRateRole);
         }
 
         int sampleRate() const
         {
-            return operator[](key_type::SampleRateRole).toInt();
+            return roleValue(key_type::SampleRateRole).toInt();
         }
 
         bool hasSampleRate() const
         {
-            return find(key_type::SampleRateRole) != end();
+            return contains(key_type::SampleRateRole);
         }
 
 
         bool hasEmbeddedCover() const
         {
-            return operator[](key_type::HasEmbeddedCover).toBool();
+            return roleValue(key_type::HasEmbeddedCover).toBool();
         }
 
         QDateTime fileModificationTime() const
         {
-            return operator[](key_type::FileModificationTime).toDateTime();
+            return roleValue(key_type::FileModificationTime).toDateTime();
         }
+
+    private:
+
+        static int roleIndex(key_type role)
+        {
+            const auto index = static_cast<int>(role) - FirstTrackRole;
+            return (index >= 0 && index < TrackRolesCount) ? index : -1;
+        }
+
+        static quint64 roleBit(int index)
+        {
+            return quint64(1) << index;
+        }
+
+        static int nextIndex(const TrackDataTypePrivate *data, int index)
+        {
+            if (!data) {
+                return TrackRolesCount;
+            }
+
+            while (index < TrackRolesCount && !(data->mPresentRoles & roleBit(index))) {
+                ++index;
+            }
+
+            return index;
+        }
+
+        static int packedIndex(int index)
+        {
+            return static_cast<int>(qPopulationCount(PackedTrackRoles & (roleBit(index) - 1)));
+        }
+
+        static int variantIndex(const TrackDataTypePrivate *data, int index)
+        {
+            return static_cast<int>(qPopulationCount(data->mVariantRoles & (roleBit(index) - 1)));
+        }
+
+        static mapped_type unpackValue(int type, qint64 packedValue)
+        {
+            switch (type)
+            {
+            case QMetaType::Bool:
+                return mapped_type{packedValue != 0};
+            case QMetaType::Int:
+                return mapped_type{static_cast<int>(packedValue)};
+            case QMetaType::UInt:
+                return mapped_type{static_cast<uint>(packedValue)};
+            case QMetaType::LongLong:
+                return mapped_type{static_cast<qlonglong>(packedValue)};
+            case QMetaType::ULongLong:
+                return mapped_type{static_cast<qulonglong>(packedValue)};
+            case QMetaType::QTime:
+                return mapped_type{QTime::fromMSecsSinceStartOfDay(static_cast<int>(packedValue))};
+            default:
+                return {};
+            }
+        }
+
+        static mapped_type valueAt(const TrackDataTypePrivate *data, int index)
+        {
+            if (!data || !(data->mPresentRoles & roleBit(index))) {
+                return {};
+            }
+
+            if (data->mVariantRoles & roleBit(index)) {
+                return data->mValues[variantIndex(data, index)];
+            }
+
+            const auto packedSlot = packedIndex(index);
+            return unpackValue(data->mPackedTypes[packedSlot], data->mPackedValues[packedSlot]);
+        }
+
+        mapped_type roleValue(key_type role) const
+        {
+            const auto index = roleIndex(role);
+
+            if (index < 0) {
+                return {};
+            }
+
+            return valueAt(d.constData(), index);
+        }
+
+        /**
+         * Store value for role, interning the strings of InternedTrackRoles.
+         */
+        void setRoleValue(key_type role, const mapped_type &value);
+
+        /**
+         * Store value for role as is, for values already held by another record.
+         */
+        void storeRoleValue(key_type role, mapped_type value);
+
+        quint64 presentRoles() const
+        {
+            return d ? d->mPresentRoles : 0;
+        }
+
+        TrackDataTypePrivate *writableData()
+        {
+            if (!d) {
+                d = new TrackDataTypePrivate;
+            }
+
+            return d.data();
+        }
+
+        QSharedDataPointer<TrackDataTypePrivate> d;
+
     };
 
     using ListTrackDataType = QList<TrackDataType>;
 
     using ListRadioDataType = QList<TrackDataType>;
 
+    /**
+     * Batch of tracks modifications done by one database operation.
+     *
+     * mModifiedTracks holds complete records replacing the known ones. mTracksChanges holds
+     * records with the DatabaseIdRole and only the roles that changed, to be merged with
+     * TrackDataType::applyChanges.
+     */
+    class TracksChangeSet
+    {
+    public:
+
+        bool isEmpty() const
+        {
+            return mInsertedTrackIds.isEmpty() && mModifiedTracks.isEmpty() && mTracksChanges.isEmpty() &&
+                    mRemovedTrackIds.isEmpty() && mModifiedAlbumIds.isEmpty();
+        }
+
+        /**
+         * Union of the roles changed by mTracksChanges, empty when complete records are part
+         * of the change set since any role may then have changed.
+         */
+        QVector<int> changedRoles() const
+        {
+            auto result = QVector<int>{};
+
+            if (!mModifiedTracks.isEmpty()) {
+                return result;
+            }
+
+            for (const auto &oneChange : mTracksChanges) {
+                for (auto itChange = oneChange.begin(); itChange != oneChange.end(); ++itChange) {
+                    if (itChange.key() != DatabaseIdRole && !result.contains(itChange.key())) {
+                        result.push_back(itChange.key());
+                    }
+                }
+            }
+
+            // roles computed by the models from the modified ones
+            if (result.contains(TitleRole) && !result.contains(Qt::DisplayRole)) {
+                result.push_back(Qt::DisplayRole);
+            }
+            if (result.contains(DurationRole) && !result.contains(StringDurationRole)) {
+                result.push_back(StringDurationRole);
+            }
+
+            return result;
+        }
+
+        QVector<qulonglong> mInsertedTrackIds;
+
+        ListTrackDataType mModifiedTracks;
+
+        ListTrackDataType mTracksChanges;
+
+        QVector<qulonglong> mRemovedTrackIds;
+
+        QVector<qulonglong> mModifiedAlbumIds;
+
+    };
+
     class AlbumDataType : public DataType
     {
     public:
@@ -361,6 +1066,87 @@ public:
 
     using ListGenreDataType = QList<GenreDataType>;
 
+    /**
+     * Page of all the tracks, albums or artists of the collection.
+     *
+     * Pages are sorted by title without case, then by database id. A page starts after the
+     * entry with mAfterSortKey and mAfterKey, or at the start of the collection when
+     * mIsFirstPage is true. Only entries matching mSearchText in the full text index and
+     * rated at least mMinimumRating are part of the pages.
+     */
+    class PageRequest
+    {
+    public:
+
+        QString mAfterSortKey;
+
+        qulonglong mAfterKey = 0;
+
+        bool mIsFirstPage = true;
+
+        // a negative size gives all the entries until the end of the collection
+        int mPageSize = -1;
+
+        Qt::SortOrder mSortOrder = Qt::AscendingOrder;
+
+        QString mSearchText;
+
+        int mMinimumRating = 0;
+
+        // not used by the database, they let the model match the page with its request
+        int mGeneration = 0;
+
+        int mPageIndex = 0;
+
+    };
+
+    /**
+     * State of a directory at the time its content was last imported.
+     * A directory whose modification time, number of entries and hash of the
+     * entry names did not change since then does not need to be listed again.
+     */
+    class DirectoryScanData
+    {
+    public:
+
+        QUrl mDirectory;
+
+        QDateTime mModificationTime;
+
+        int mEntriesCount = 0;
+
+        QByteArray mContentHash;
+
+        /**
+         * Identity of the files of the directory, used to recognize a file
+         * moved elsewhere while Elisa was not running.
+         */
+        QByteArray mFilesIdentity;
+
+    };
+
+    using ListDirectoryScanData = QList<DirectoryScanData>;
+
+    /**
+     * A track file moved to another place: the database keeps its statistics
+     * and its metadata instead of removing it and importing it again.
+     */
+    class RenamedFileData
+    {
+    public:
+
+        QUrl mOldFileName;
+
+        QUrl mNewFileName;
+
+        QDateTime mFileModificationTime;
+
+        QUrl mAlbumCover;
+
+    };
+
+    using ListRenamedFileData = QList<RenamedFileData>;
+
 };
 
 Q_DECLARE_METATYPE(DataTypes::TrackDataType)
@@ -373,4 +1159,13 @@ Q_DECLARE_METATYPE(DataTypes::ListAlbumDataType)
 Q_DECLARE_METATYPE(DataTypes::ListArtistDataType)
 Q_DECLARE_METATYPE(DataTypes::ListGenreDataType)
 
+Q_DECLARE_METATYPE(DataTypes::TracksChangeSet)
+Q_DECLARE_METATYPE(DataTypes::PageRequest)
+Q_DECLARE_METATYPE(DataTypes::DirectoryScanData)
+Q_DECLARE_METATYPE(DataTypes::ListDirectoryScanData)
+Q_DECLARE_METATYPE(DataTypes::RenamedFileData)
+Q_DECLARE_METATYPE(DataTypes::ListRenamedFileData)
+
+ELISALIB_EXPORT QDebug operator<<(QDebug stream, const DataTypes::TrackDataType &trackData);
+
 #endif // DATATYPES_H
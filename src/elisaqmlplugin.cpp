@@ -160,6 +160,12 @@ void ElisaQmlTestPlugin::registerTypes(const char *uri)
     qRegisterMetaType<ModelDataLoader::ListGenreDataType>("ModelDataLoader::ListGenreDataType");
     qRegisterMetaType<ModelDataLoader::AlbumDataType>("ModelDataLoader::AlbumDataType");
     qRegisterMetaType<TracksListener::ListTrackDataType>("TracksListener::ListTrackDataType");
+    qRegisterMetaType<DataTypes::TracksChangeSet>("DataTypes::TracksChangeSet");
+    qRegisterMetaType<ModelDataLoader::TracksChangeSet>("ModelDataLoader::TracksChangeSet");
+    qRegisterMetaType<TracksListener::TracksChangeSet>("TracksListener::TracksChangeSet");
+    qRegisterMetaType<DataTypes::PageRequest>("DataTypes::PageRequest");
+    qRegisterMetaType<DataTypes::ListDirectoryScanData>("DataTypes::ListDirectoryScanData");
+    qRegisterMetaType<DataTypes::ListRenamedFileData>("DataTypes::ListRenamedFileData");
     qRegisterMetaType<QMap<QString, int>>();
     qRegisterMetaType<QAction*>();
     qRegisterMetaType<QMap<QString,int>>("QMap<QString,int>");
@@ -74,6 +74,11 @@ void LocalFileListing::triggerRefreshOfContent()
         scanDirectoryTree(onePath);
     }
 
+    // files not seen by an interrupted scan are not removed: the next scan resumes it
+    if (isStopRequested()) {
+        return;
+    }
+
     setWaitEndTrackRemoval(false);
 
     checkFilesToRemove();
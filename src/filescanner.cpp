@@ -29,6 +29,7 @@
 #include <KFileMetaData/UserMetaData>
 #include <KFileMetaData/Properties>
 #include <KFileMetaData/EmbeddedImageData>
+#include <kfilemetadata_version.h>
 
 #if defined KF5Baloo_FOUND && KF5Baloo_FOUND
 
@@ -45,9 +46,121 @@
 #include <QHash>
 #include <QMimeDatabase>
 
+#include <algorithm>
+
+namespace {
+
+/**
+ * What the mime database says about the files with one extension,
+ * without reading their content.
+ */
+class ExtensionMimeTypes
+{
+public:
+
+    enum class Kind {
+        Audio,
+        NotAudio,
+        Ambiguous,
+    };
+
+    Kind mKind = Kind::Ambiguous;
+
+    // only set when the extension matches a single mime type
+    QString mMimeTypeName;
+
+};
+
+class AudioExtensions
+{
+public:
+
+    static const AudioExtensions &instance()
+    {
+        static const AudioExtensions extensions;
+        return extensions;
+    }
+
+    ExtensionMimeTypes mimeTypes(const QString &fileName) const
+    {
+        const auto lastDot = fileName.lastIndexOf(QLatin1Char('.'));
+        if (lastDot == -1 || lastDot < fileName.lastIndexOf(QLatin1Char('/'))) {
+            return {};
+        }
+
+        // a pattern other than an extension may match an audio file whatever its extension
+        const auto baseName = fileName.mid(fileName.lastIndexOf(QLatin1Char('/')) + 1);
+        if (!mOtherAudioPatterns.isEmpty() && QDir::match(mOtherAudioPatterns, baseName)) {
+            return {};
+        }
+
+        return mExtensions.value(fileName.mid(lastDot + 1).toLower());
+    }
+
+private:
+
+    AudioExtensions()
+    {
+        QMimeDatabase mimeDatabase;
+        QHash<QString, QStringList> mimeTypesByExtension;
+
+        const auto allMimeTypes = mimeDatabase.allMimeTypes();
+        for (const auto &oneMimeType : allMimeTypes) {
+            const auto isAudio = oneMimeType.name().startsWith(QLatin1String("audio/"));
+
+            const auto globPatterns = oneMimeType.globPatterns();
+            for (const auto &onePattern : globPatterns) {
+                const auto extension = onePattern.mid(2).toLower();
+                const auto isExtension = onePattern.startsWith(QLatin1String("*.")) && !extension.isEmpty() &&
+                        !extension.contains(QLatin1Char('.')) && !extension.contains(QLatin1Char('*')) &&
+                        !extension.contains(QLatin1Char('?')) && !extension.contains(QLatin1Char('['));
+
+                if (isExtension) {
+                    auto &extensionMimeTypes = mimeTypesByExtension[extension];
+                    if (!extensionMimeTypes.contains(oneMimeType.name())) {
+                        extensionMimeTypes.push_back(oneMimeType.name());
+                    }
+                } else if (isAudio) {
+                    mOtherAudioPatterns.push_back(onePattern);
+                }
+            }
+        }
+
+        for (auto itExtension = mimeTypesByExtension.cbegin(); itExtension != mimeTypesByExtension.cend(); ++itExtension) {
+            const auto &mimeTypeNames = itExtension.value();
+            const auto audioCount = std::count_if(mimeTypeNames.cbegin(), mimeTypeNames.cend(), [](const QString &oneName) {
+                return oneName.startsWith(QLatin1String("audio/"));
+            });
+
+            auto &extensionMimeTypes = mExtensions[itExtension.key()];
+
+            if (audioCount == mimeTypeNames.size()) {
+                extensionMimeTypes.mKind = ExtensionMimeTypes::Kind::Audio;
+            } else if (audioCount == 0) {
+                extensionMimeTypes.mKind = ExtensionMimeTypes::Kind::NotAudio;
+            }
+
+            if (mimeTypeNames.size() == 1) {
+                extensionMimeTypes.mMimeTypeName = mimeTypeNames.first();
+            }
+        }
+
+        qCDebug(orgKdeElisaIndexer()) << "AudioExtensions::AudioExtensions" << mExtensions.size() << "extensions"
+                                      << mOtherAudioPatterns.size() << "other audio patterns";
+    }
+
+    QHash<QString, ExtensionMimeTypes> mExtensions;
+
+    QStringList mOtherAudioPatterns;
+
+};
+
+}
+
 class FileScannerPrivate
 {
 public:
+
 #if defined KF5FileMetaData_FOUND && KF5FileMetaData_FOUND
     KFileMetaData::ExtractorCollection mAllExtractors;
 
@@ -58,6 +171,35 @@ public:
 
     QMimeDatabase mMimeDb;
 
+    qulonglong mSniffedFilesCount = 0;
+
+    qulonglong mSkippedSniffingFilesCount = 0;
+
+    QString audioMimeTypeName(const QString &localFileName)
+    {
+        const auto extensionMimeTypes = AudioExtensions::instance().mimeTypes(localFileName);
+
+        if (extensionMimeTypes.mKind == ExtensionMimeTypes::Kind::NotAudio) {
+            ++mSkippedSniffingFilesCount;
+            return {};
+        }
+
+        // the mime database would not read the content either
+        if (!extensionMimeTypes.mMimeTypeName.isEmpty()) {
+            ++mSkippedSniffingFilesCount;
+            return extensionMimeTypes.mMimeTypeName;
+        }
+
+        ++mSniffedFilesCount;
+
+        const auto fileMimeTypeName = mMimeDb.mimeTypeForFile(localFileName).name();
+        if (!fileMimeTypeName.startsWith(QLatin1String("audio/"))) {
+            return {};
+        }
+
+        return fileMimeTypeName;
+    }
+
 #if defined KF5FileMetaData_FOUND && KF5FileMetaData_FOUND
     const QHash<KFileMetaData::Property::Property, DataTypes::ColumnsRoles> propertyTranslation = {
         {KFileMetaData::Property::Artist, DataTypes::ColumnsRoles::ArtistRole},
@@ -88,6 +230,40 @@ public:
         QStringLiteral("*[Ff]ront*.jpg"),
         QStringLiteral("*[Ff]ront*.png")
     };
+
+    QUrl coverFromEntries(const QString &directoryName, const QStringList &fileNames) const
+    {
+        const QDir directory(directoryName);
+
+        // same patterns and order as a QDir listing filtered by name
+        auto firstMatch = [&directory, &fileNames](const QStringList &nameFilters) {
+            for (const auto &oneFileName : fileNames) {
+                if (QDir::match(nameFilters, oneFileName)) {
+                    return QUrl::fromLocalFile(directory.absoluteFilePath(oneFileName));
+                }
+            }
+
+            return QUrl();
+        };
+
+        auto coverFile = firstMatch(constSearchStrings);
+        if (coverFile.isEmpty()) {
+            QString dirNamePattern = QLatin1String("*") + directory.dirName() + QLatin1String("*");
+            QString dirNameNoSpaces = dirNamePattern.remove(QLatin1Char(' '));
+            const QStringList filters = {
+                dirNamePattern + QStringLiteral(".jpg"),
+                dirNamePattern + QStringLiteral(".png"),
+
+                dirNameNoSpaces + QStringLiteral(".jpg"),
+                dirNameNoSpaces + QStringLiteral(".png")
+            };
+            coverFile = firstMatch(filters);
+        }
+
+        return coverFile;
+    }
+
+    QHash<QString, QUrl> mCoverByDirectory;
 };
 
 FileScanner::FileScanner() : d(std::make_unique<FileScannerPrivate>())
@@ -96,8 +272,23 @@ FileScanner::FileScanner() : d(std::make_unique<FileScannerPrivate>())
 
 bool FileScanner::shouldScanFile(const QString &scanFile)
 {
-    const auto &fileMimeType = d->mMimeDb.mimeTypeForFile(scanFile);
-    return fileMimeType.name().startsWith(QLatin1String("audio/"));
+    // the extractor needs the exact mime type but any audio mime type will do here
+    if (AudioExtensions::instance().mimeTypes(scanFile).mKind == ExtensionMimeTypes::Kind::Audio) {
+        ++d->mSkippedSniffingFilesCount;
+        return true;
+    }
+
+    return !d->audioMimeTypeName(scanFile).isEmpty();
+}
+
+qulonglong FileScanner::sniffedFilesCount() const
+{
+    return d->mSniffedFilesCount;
+}
+
+qulonglong FileScanner::skippedSniffingFilesCount() const
+{
+    return d->mSkippedSniffingFilesCount;
 }
 
 FileScanner::~FileScanner() = default;
@@ -119,22 +310,24 @@ DataTypes::TrackDataType FileScanner::scanOneFile(const QUrl &scanFile)
     newTrack[DataTypes::RatingRole] = 0;
 
 #if defined KF5FileMetaData_FOUND && KF5FileMetaData_FOUND
-    const auto &fileMimeType = d->mMimeDb.mimeTypeForFile(localFileName);
-    if (!fileMimeType.name().startsWith(QLatin1String("audio/"))) {
+    const auto mimetype = d->audioMimeTypeName(localFileName);
+    if (mimetype.isEmpty()) {
         return newTrack;
     }
 
-    QString mimetype = fileMimeType.name();
-
     QList<KFileMetaData::Extractor*> exList = d->mAllExtractors.fetchExtractors(mimetype);
 
     if (exList.isEmpty()) {
         return newTrack;
     }
 
+    auto extractionFlags = KFileMetaData::ExtractionResult::Flags{KFileMetaData::ExtractionResult::ExtractMetaData};
+#if KFILEMETADATA_VERSION >= QT_VERSION_CHECK(5, 76, 0)
+    extractionFlags |= KFileMetaData::ExtractionResult::ExtractImageData;
+#endif
+
     KFileMetaData::Extractor* ex = exList.first();
-    KFileMetaData::SimpleExtractionResult result(localFileName, mimetype,
-                                                 KFileMetaData::ExtractionResult::ExtractMetaData);
+    KFileMetaData::SimpleExtractionResult result(localFileName, mimetype, extractionFlags);
 
     ex->extract(&result);
 
@@ -142,6 +335,13 @@ DataTypes::TrackDataType FileScanner::scanOneFile(const QUrl &scanFile)
 
     scanProperties(localFileName, newTrack);
 
+#if KFILEMETADATA_VERSION >= QT_VERSION_CHECK(5, 76, 0)
+    // the extractor copies the raw data of every embedded picture, whatever its type:
+    // nothing is decoded, only whether a front cover exists is kept and the
+    // image itself is loaded again by the cover image provider when displayed
+    newTrack[DataTypes::HasEmbeddedCover] = !result.imageData().value(KFileMetaData::EmbeddedImageData::FrontCover).isEmpty();
+#endif
+
     qCDebug(orgKdeElisaIndexer()) << "scanOneFile" << scanFile << "using KFileMetaData" << newTrack;
 #else
     Q_UNUSED(scanFile)
@@ -226,28 +426,31 @@ void FileScanner::scanProperties(const QString &localFileName, DataTypes::TrackD
 
 QUrl FileScanner::searchForCoverFile(const QString &localFileName)
 {
-    QFileInfo trackFilePath(localFileName);
-    QDir trackFileDir = trackFilePath.absoluteDir();
-    trackFileDir.setFilter(QDir::Files);
-    trackFileDir.setNameFilters(d->constSearchStrings);
-    QFileInfoList coverFiles = trackFileDir.entryInfoList();
-    if (coverFiles.isEmpty()) {
-        QString dirNamePattern = QLatin1String("*") + trackFileDir.dirName() + QLatin1String("*");
-        QString dirNameNoSpaces = dirNamePattern.remove(QLatin1Char(' '));
-        QStringList filters = {
-            dirNamePattern + QStringLiteral(".jpg"),
-            dirNamePattern + QStringLiteral(".png"),
-
-            dirNameNoSpaces + QStringLiteral(".jpg"),
-            dirNameNoSpaces + QStringLiteral(".png")
-        };
-        trackFileDir.setNameFilters(filters);
-        coverFiles = trackFileDir.entryInfoList();
-    }
-    if (coverFiles.isEmpty()) {
-        return QUrl();
+    const auto directoryName = QFileInfo(localFileName).absolutePath();
+
+    const auto itCover = d->mCoverByDirectory.constFind(directoryName);
+    if (itCover != d->mCoverByDirectory.constEnd()) {
+        return *itCover;
     }
-    return QUrl::fromLocalFile(coverFiles.first().absoluteFilePath());
+
+    QDir trackFileDir(directoryName);
+    trackFileDir.setFilter(QDir::Files);
+
+    const auto coverFile = d->coverFromEntries(directoryName, trackFileDir.entryList());
+    d->mCoverByDirectory[directoryName] = coverFile;
+
+    return coverFile;
+}
+
+void FileScanner::addDirectoryEntries(const QString &directoryName, const QStringList &fileNames)
+{
+    const auto cleanDirectoryName = QDir::cleanPath(directoryName);
+    d->mCoverByDirectory[cleanDirectoryName] = d->coverFromEntries(cleanDirectoryName, fileNames);
+}
+
+void FileScanner::invalidateDirectoryCover(const QString &directoryName)
+{
+    d->mCoverByDirectory.remove(QDir::cleanPath(directoryName));
 }
 
 bool FileScanner::checkEmbeddedCoverImage(const QString &localFileName)
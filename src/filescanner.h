@@ -23,6 +23,7 @@
 #include "datatypes.h"
 
 #include <QUrl>
+#include <QStringList>
 
 #include <memory>
 
@@ -42,16 +43,54 @@ public:
 
     virtual ~FileScanner();
 
+    /**
+     * Check if a file is an audio file.
+     * The file extension is enough for most files: the content is only read
+     * for files without extension or with an extension shared by audio and
+     * other mime types.
+     */
     bool shouldScanFile(const QString &scanFile);
 
+    /**
+     * Number of files whose content was read to find their mime type.
+     */
+    qulonglong sniffedFilesCount() const;
+
+    /**
+     * Number of files whose mime type was decided from their extension alone.
+     */
+    qulonglong skippedSniffingFilesCount() const;
+
+    /**
+     * Read the metadata of one file.
+     * When the metadata extractor can report embedded images in the same pass,
+     * HasEmbeddedCover is also set and checkEmbeddedCoverImage is not needed.
+     * The extractor cannot be limited to the front cover: the raw data of all
+     * embedded pictures is read, none of them is decoded.
+     */
     DataTypes::TrackDataType scanOneFile(const QUrl &scanFile);
 
     void scanProperties(const Baloo::File &match, DataTypes::TrackDataType &trackData);
 
     void scanProperties(const QString &localFileName, DataTypes::TrackDataType &trackData);
 
+    /**
+     * Find the cover image of the directory of localFileName.
+     * The result is cached per directory: the directory is only listed the first time.
+     */
     QUrl searchForCoverFile(const QString &localFileName);
 
+    /**
+     * Resolve the cover of a directory from a listing already done by the caller.
+     * fileNames are the names of the files of the directory sorted like QDir does.
+     */
+    void addDirectoryEntries(const QString &directoryName, const QStringList &fileNames);
+
+    /**
+     * Forget the cover of a directory after its content changed.
+     */
+    void invalidateDirectoryCover(const QString &directoryName);
+
     bool checkEmbeddedCoverImage(const QString &localFileName);
 
 private:
@@ -0,0 +1,205 @@
+/*
+ * Copyright 2026 The Elisa developers
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "filescannerpool.h"
+
+#include "abstractfile/indexercommon.h"
+
+#include "filescanner.h"
+
+#include <QThread>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+#include <QQueue>
+#include <QHash>
+
+#include <vector>
+#include <algorithm>
+
+class FileScannerPoolPrivate
+{
+public:
+
+    struct ScanJob
+    {
+        quint64 mSequence = 0;
+
+        QUrl mFileName;
+
+        QUrl mDirectory;
+
+        QDateTime mMetadataChangeTime;
+    };
+
+    void runWorker();
+
+    static FileScannerPool::ScanResult scanFile(FileScanner &scanner, const ScanJob &job);
+
+    std::vector<std::unique_ptr<QThread>> mWorkers;
+
+    QMutex mLock;
+
+    QWaitCondition mJobAvailable;
+
+    QWaitCondition mResultAvailable;
+
+    QQueue<ScanJob> mJobs;
+
+    QHash<quint64, FileScannerPool::ScanResult> mResults;
+
+    quint64 mNextScheduledSequence = 0;
+
+    quint64 mNextTakenSequence = 0;
+
+    int mCapacity = 1;
+
+    bool mStopWorkers = false;
+
+};
+
+void FileScannerPoolPrivate::runWorker()
+{
+    FileScanner scanner;
+
+    QMutexLocker locker(&mLock);
+
+    while (true) {
+        while (!mStopWorkers && mJobs.isEmpty()) {
+            mJobAvailable.wait(&mLock);
+        }
+
+        if (mStopWorkers) {
+            return;
+        }
+
+        const auto currentJob = mJobs.dequeue();
+
+        locker.unlock();
+        auto result = scanFile(scanner, currentJob);
+        locker.relock();
+
+        // results of files scheduled before a cancel are dropped
+        if (currentJob.mSequence >= mNextTakenSequence) {
+            mResults.insert(currentJob.mSequence, std::move(result));
+            mResultAvailable.wakeAll();
+        }
+    }
+}
+
+FileScannerPool::ScanResult FileScannerPoolPrivate::scanFile(FileScanner &scanner, const ScanJob &job)
+{
+    auto result = FileScannerPool::ScanResult{job.mFileName, job.mDirectory, scanner.scanOneFile(job.mFileName)};
+
+    if (result.mTrack.isValid()) {
+        if (!result.mTrack.contains(DataTypes::HasEmbeddedCover)) {
+            result.mTrack[DataTypes::HasEmbeddedCover] = scanner.checkEmbeddedCoverImage(job.mFileName.toLocalFile());
+        }
+        result.mTrack[DataTypes::FileModificationTime] = job.mMetadataChangeTime;
+    }
+
+    return result;
+}
+
+FileScannerPool::FileScannerPool(int workersCount) : d(std::make_unique<FileScannerPoolPrivate>())
+{
+    workersCount = std::max(1, workersCount);
+
+    // keep a few files ahead of each worker so that none of them waits for the directory listing
+    d->mCapacity = 4 * workersCount;
+
+    d->mWorkers.reserve(workersCount);
+    for (int i = 0; i < workersCount; ++i) {
+        d->mWorkers.emplace_back(QThread::create([this] () {d->runWorker();}));
+        d->mWorkers.back()->setObjectName(QStringLiteral("Elisa metadata extraction %1").arg(i));
+        d->mWorkers.back()->start(QThread::LowPriority);
+    }
+
+    qCDebug(orgKdeElisaIndexer()) << "FileScannerPool::FileScannerPool" << workersCount << "workers";
+}
+
+FileScannerPool::~FileScannerPool()
+{
+    {
+        QMutexLocker locker(&d->mLock);
+        d->mStopWorkers = true;
+        d->mJobs.clear();
+        d->mJobAvailable.wakeAll();
+    }
+
+    for (auto &oneWorker : d->mWorkers) {
+        oneWorker->wait();
+    }
+}
+
+int FileScannerPool::workersCount() const
+{
+    return static_cast<int>(d->mWorkers.size());
+}
+
+int FileScannerPool::capacity() const
+{
+    return d->mCapacity;
+}
+
+bool FileScannerPool::isFull() const
+{
+    return d->mNextScheduledSequence - d->mNextTakenSequence >= static_cast<quint64>(d->mCapacity);
+}
+
+bool FileScannerPool::hasPendingResults() const
+{
+    return d->mNextScheduledSequence != d->mNextTakenSequence;
+}
+
+void FileScannerPool::scheduleFile(const QUrl &fileName, const QUrl &directory, const QDateTime &metadataChangeTime)
+{
+    QMutexLocker locker(&d->mLock);
+
+    d->mJobs.enqueue({d->mNextScheduledSequence, fileName, directory, metadataChangeTime});
+    ++d->mNextScheduledSequence;
+
+    d->mJobAvailable.wakeOne();
+}
+
+FileScannerPool::ScanResult FileScannerPool::takeNextResult()
+{
+    Q_ASSERT(hasPendingResults());
+
+    QMutexLocker locker(&d->mLock);
+
+    auto itResult = d->mResults.find(d->mNextTakenSequence);
+    while (itResult == d->mResults.end()) {
+        d->mResultAvailable.wait(&d->mLock);
+        itResult = d->mResults.find(d->mNextTakenSequence);
+    }
+
+    auto result = std::move(*itResult);
+    d->mResults.erase(itResult);
+    ++d->mNextTakenSequence;
+
+    return result;
+}
+
+void FileScannerPool::cancel()
+{
+    QMutexLocker locker(&d->mLock);
+
+    d->mJobs.clear();
+    d->mResults.clear();
+    d->mNextTakenSequence = d->mNextScheduledSequence;
+}
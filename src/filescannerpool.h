@@ -0,0 +1,89 @@
+/*
+ * Copyright 2026 The Elisa developers
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef FILESCANNERPOOL_H
+#define FILESCANNERPOOL_H
+
+#include "elisaLib_export.h"
+
+#include "datatypes.h"
+
+#include <QUrl>
+#include <QDateTime>
+
+#include <memory>
+
+class FileScannerPoolPrivate;
+
+/**
+ * Extract metadata of audio files with several worker threads.
+ *
+ * Each worker owns its own FileScanner. Files are queued with scheduleFile()
+ * and results are handed back by takeNextResult() in the order the files were
+ * scheduled, whatever the order the workers finish them.
+ *
+ * The number of files scheduled and not yet taken is bounded by capacity():
+ * the caller is expected to take results before scheduling more once isFull().
+ *
+ * All methods must be called from the same thread.
+ */
+class ELISALIB_EXPORT FileScannerPool
+{
+public:
+
+    struct ScanResult
+    {
+        QUrl mFileName;
+
+        QUrl mDirectory;
+
+        DataTypes::TrackDataType mTrack;
+    };
+
+    explicit FileScannerPool(int workersCount);
+
+    ~FileScannerPool();
+
+    int workersCount() const;
+
+    int capacity() const;
+
+    bool isFull() const;
+
+    bool hasPendingResults() const;
+
+    void scheduleFile(const QUrl &fileName, const QUrl &directory, const QDateTime &metadataChangeTime);
+
+    /**
+     * Wait for the oldest scheduled file to be scanned and return its result.
+     * Must only be called when hasPendingResults() is true.
+     */
+    ScanResult takeNextResult();
+
+    /**
+     * Drop all files not yet scanned and all results not yet taken.
+     * Files being scanned by a worker are finished and then discarded.
+     */
+    void cancel();
+
+private:
+
+    std::unique_ptr<FileScannerPoolPrivate> d;
+
+};
+
+#endif // FILESCANNERPOOL_H
@@ -22,6 +22,8 @@
 #include <QTimer>
 #include <QDateTime>
 
+#include <utility>
+
 ManageAudioPlayer::ManageAudioPlayer(QObject *parent) : QObject(parent)
 {
 
@@ -137,6 +139,27 @@ int ManageAudioPlayer::albumNameRole() const
 
 void ManageAudioPlayer::setCurrentTrack(const QPersistentModelIndex &currentTrack)
 {
+    const auto startedPreparedSource = std::exchange(mStartedPreparedSource, {});
+    if (!startedPreparedSource.isEmpty() && currentTrack.isValid() &&
+            currentTrack.data(mUrlRole).toUrl() == startedPreparedSource) {
+        mOldCurrentTrack = mCurrentTrack;
+        mCurrentTrack = currentTrack;
+        mOldPlayerSource = mCurrentTrack.data(mUrlRole);
+        mPlayerError = QMediaPlayer::NoError;
+
+        Q_EMIT currentTrackChanged();
+
+        if (mPlayListModel) {
+            if (mOldCurrentTrack.isValid()) {
+                mPlayListModel->setData(mOldCurrentTrack, MediaPlayList::NotPlaying, mIsPlayingRole);
+            }
+            mPlayListModel->setData(mCurrentTrack, MediaPlayList::IsPlaying, mIsPlayingRole);
+        }
+        Q_EMIT startedPlayingTrack(startedPreparedSource, QDateTime::currentDateTime());
+
+        return;
+    }
+
     mOldCurrentTrack = mCurrentTrack;
 
     mCurrentTrack = currentTrack;
@@ -166,6 +189,20 @@ void ManageAudioPlayer::setCurrentTrack(const QPersistentModelIndex &currentTrac
     }
 }
 
+void ManageAudioPlayer::setNextTrack(const QPersistentModelIndex &nextTrack)
+{
+    mNextTrack = nextTrack;
+
+    notifyPlayerNextSourceProperty();
+}
+
+void ManageAudioPlayer::preparedSourceStarted(const QUrl &source)
+{
+    mStartedPreparedSource = source;
+
+    Q_EMIT skipNextTrack();
+}
+
 void ManageAudioPlayer::saveForUndoClearPlaylist(){
     mUndoPlayingState = mPlayingState;
 
@@ -453,6 +490,8 @@ void ManageAudioPlayer::playListFinished()
 
 void ManageAudioPlayer::tracksDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles)
 {
+    notifyPlayerNextSourceProperty();
+
     if (!mCurrentTrack.isValid()) {
         return;
     }
@@ -530,6 +569,20 @@ void ManageAudioPlayer::notifyPlayerSourceProperty()
     }
 }
 
+void ManageAudioPlayer::notifyPlayerNextSourceProperty()
+{
+    auto newNextUrl = QUrl();
+    if (mNextTrack.isValid()) {
+        newNextUrl = mNextTrack.data(mUrlRole).toUrl();
+    }
+
+    if (mNextPlayerSource != newNextUrl) {
+        mNextPlayerSource = newNextUrl;
+
+        Q_EMIT playerNextSourceChanged(mNextPlayerSource);
+    }
+}
+
 void ManageAudioPlayer::triggerPlay()
 {
     QTimer::singleShot(0, this, [this]() {Q_EMIT playerPlay();});
@@ -157,6 +157,8 @@ Q_SIGNALS:
 
     void playerSourceChanged(const QUrl &url);
 
+    void playerNextSourceChanged(const QUrl &url);
+
     void urlRoleChanged();
 
     void isPlayingRoleChanged();
@@ -209,6 +211,14 @@ public Q_SLOTS:
 
     void setCurrentTrack(const QPersistentModelIndex &currentTrack);
 
+    void setNextTrack(const QPersistentModelIndex &nextTrack);
+
+    /**
+     * The player went on with the next track by itself: the play list follows
+     * without stopping it.
+     */
+    void preparedSourceStarted(const QUrl &source);
+
     void saveForUndoClearPlaylist();
 
     void restoreForUndoClearPlaylist();
@@ -261,6 +271,8 @@ private:
 
     void notifyPlayerSourceProperty();
 
+    void notifyPlayerNextSourceProperty();
+
     void triggerPlay();
 
     void triggerPause();
@@ -275,6 +287,12 @@ private:
 
     QPersistentModelIndex mOldCurrentTrack;
 
+    QPersistentModelIndex mNextTrack;
+
+    QUrl mNextPlayerSource;
+
+    QUrl mStartedPreparedSource;
+
     QAbstractItemModel *mPlayListModel = nullptr;
 
     int mTitleRole = Qt::DisplayRole;
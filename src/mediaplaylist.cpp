@@ -20,16 +20,19 @@
 #include "playListLogging.h"
 #include "datatypes.h"
 #include "musiclistenersmanager.h"
+#include "shufflelist.h"
 
 #include <QUrl>
 #include <QPersistentModelIndex>
 #include <QList>
+#include <QHash>
+#include <QVector>
 #include <QMediaPlaylist>
 #include <QFileInfo>
+#include <QDataStream>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QDebug>
-#include <QRandomGenerator>
 
 #include <algorithm>
 
@@ -57,11 +60,110 @@ public:
 
     bool mRandomPlay = false;
 
+    bool mRandomPlayByAlbum = false;
+
     bool mRepeatPlay = false;
 
     bool mForceUndo = false;
 
-    QList<int> mRandomPositions = {0, 0, 0};
+    // order of the rows in random play, only kept up to date while random play is enabled
+    ShuffleList mRandomOrder;
+
+    // header of the playlist saved in the persistent state as a list of entry types, database ids and urls
+    static constexpr quint32 mPlayListDataMagic = 0x454c504c;
+
+    static constexpr quint32 mPlayListDataVersion = 1;
+
+    // rows of the entries from their database id and from their url
+    QMultiHash<qulonglong, int> mRowsFromIds;
+
+    QMultiHash<QUrl, int> mRowsFromUrls;
+
+    // rows of the entries not yet found in the database that are only known by their metadata
+    QVector<int> mUnresolvedRows;
+
+    // the rows index is built again on first use after rows are inserted, moved or removed
+    bool mIsRowsIndexValid = false;
+
+    // the random order follows a current track chosen outside of it
+    void followCurrentTrack()
+    {
+        if (mRandomPlay && mCurrentTrack.isValid()) {
+            mRandomOrder.setCurrentRow(mCurrentTrack.row());
+        }
+    }
+
+    void invalidateRowsIndex()
+    {
+        mIsRowsIndexValid = false;
+    }
+
+    void indexRows()
+    {
+        if (mIsRowsIndexValid) {
+            return;
+        }
+
+        mRowsFromIds.clear();
+        mRowsFromUrls.clear();
+        mUnresolvedRows.clear();
+
+        for (int row = 0; row < mData.size(); ++row) {
+            const auto &oneEntry = mData.at(row);
+
+            if (oneEntry.mEntryType == ElisaUtils::Artist) {
+                continue;
+            }
+
+            if (oneEntry.mId != 0) {
+                mRowsFromIds.insert(oneEntry.mId, row);
+            }
+
+            if (oneEntry.mTrackUrl.isValid()) {
+                mRowsFromUrls.insert(oneEntry.mTrackUrl.toUrl(), row);
+            } else if (!oneEntry.mIsValid) {
+                mUnresolvedRows.push_back(row);
+            }
+        }
+
+        mIsRowsIndexValid = true;
+    }
+
+    QVector<int> rowsFromId(qulonglong databaseId)
+    {
+        indexRows();
+
+        auto result = mRowsFromIds.values(databaseId).toVector();
+        std::sort(result.begin(), result.end());
+
+        return result;
+    }
+
+    bool isSameAlbum(int firstRow, int secondRow) const
+    {
+        const auto &firstTrack = mTrackData.at(firstRow);
+        const auto &secondTrack = mTrackData.at(secondRow);
+
+        return firstTrack.hasAlbum() && secondTrack.hasAlbum() &&
+                firstTrack.album() == secondTrack.album() && firstTrack.albumArtist() == secondTrack.albumArtist();
+    }
+
+    // all the rows that may be updated by new data about a track, in playlist order
+    QVector<int> candidateRows(qulonglong databaseId, const QUrl &fileName)
+    {
+        indexRows();
+
+        auto result = mUnresolvedRows;
+        if (databaseId != 0) {
+            result.append(mRowsFromIds.values(databaseId).toVector());
+        }
+        result.append(mRowsFromUrls.values(fileName).toVector());
+
+        std::sort(result.begin(), result.end());
+        result.erase(std::unique(result.begin(), result.end()), result.end());
+
+        return result;
+    }
 
 };
 
@@ -69,6 +171,32 @@ MediaPlayList::MediaPlayList(QObject *parent) : QAbstractListModel(parent), d(ne
 {
     connect(&d->mLoadPlaylist, &QMediaPlaylist::loaded, this, &MediaPlayList::loadPlayListLoaded);
     connect(&d->mLoadPlaylist, &QMediaPlaylist::loadFailed, this, &MediaPlayList::loadPlayListLoadFailed);
+
+    connect(this, &MediaPlayList::rowsInserted, this, [this]() {d->invalidateRowsIndex();});
+    connect(this, &MediaPlayList::rowsRemoved, this, [this]() {d->invalidateRowsIndex();});
+    connect(this, &MediaPlayList::rowsMoved, this, [this]() {d->invalidateRowsIndex();});
+    connect(this, &MediaPlayList::modelReset, this, [this]() {d->invalidateRowsIndex();});
+
+    connect(this, &MediaPlayList::rowsInserted, this, [this](const QModelIndex &, int first, int last) {
+        if (d->mRandomPlay) {
+            d->mRandomOrder.insertRows(first, last - first + 1);
+        }
+    });
+    connect(this, &MediaPlayList::rowsRemoved, this, [this](const QModelIndex &, int first, int last) {
+        if (d->mRandomPlay) {
+            d->mRandomOrder.removeRows(first, last - first + 1);
+        }
+    });
+    connect(this, &MediaPlayList::rowsMoved, this, [this](const QModelIndex &, int first, int last, const QModelIndex &, int destination) {
+        if (d->mRandomPlay) {
+            d->mRandomOrder.moveRows(first, last - first + 1, destination);
+        }
+    });
+    connect(this, &MediaPlayList::modelReset, this, [this]() {
+        if (d->mRandomPlay) {
+            createRandomList();
+        }
+    });
 }
 
 MediaPlayList::~MediaPlayList()
@@ -164,14 +292,7 @@ QVariant MediaPlayList::data(const QModelIndex &index, int role) const
             break;
         }
         default:
-            const auto &trackData = d->mTrackData[index.row()];
-            auto roleEnum = static_cast<TrackDataType::key_type>(role);
-            auto itData = trackData.find(roleEnum);
-            if (itData != trackData.end()) {
-                result = itData.value();
-            } else {
-                result = {};
-            }
+            result = d->mTrackData.at(index.row()).roleData(role);
         }
     } else {
         switch(role)
@@ -299,9 +420,14 @@ bool MediaPlayList::removeRows(int row, int count, const QModelIndex &parent)
     endRemoveRows();
 
     if (!d->mCurrentTrack.isValid()) {
-        d->mCurrentTrack = index(d->mCurrentPlayListPosition, 0);
+        if (d->mRandomPlay) {
+            d->mCurrentTrack = index(d->mRandomOrder.currentRow(), 0);
+        } else {
+            d->mCurrentTrack = index(d->mCurrentPlayListPosition, 0);
+        }
 
         if (d->mCurrentTrack.isValid()) {
+            d->followCurrentTrack();
             notifyCurrentTrackChanged();
         }
 
@@ -321,10 +447,6 @@ bool MediaPlayList::removeRows(int row, int count, const QModelIndex &parent)
         resetCurrentTrack();
     }
 
-    if (d->mRandomPlay) {
-        createRandomList();
-    }
-
     Q_EMIT tracksCountChanged();
     Q_EMIT remainingTracksChanged();
     Q_EMIT persistentStateChanged();
@@ -396,6 +518,7 @@ void MediaPlayList::enqueueRestoredEntry(const MediaPlayListEntry &newEntry)
                 QFileInfo newTrackFile(entryString);
                 if (newTrackFile.exists()) {
                     d->mData.last().mIsValid = true;
+                    d->invalidateRowsIndex();
                 }
                 Q_EMIT newEntryInList(0, entryString, ElisaUtils::FileName);
             }
@@ -419,6 +542,101 @@ void MediaPlayList::enqueueRestoredEntry(const MediaPlayListEntry &newEntry)
     }
 }
 
+void MediaPlayList::enqueueRestoredPlayList(const QByteArray &playListData)
+{
+    QDataStream playListStream(playListData);
+    playListStream.setVersion(QDataStream::Qt_5_11);
+
+    auto magic = quint32{};
+    auto version = quint32{};
+    playListStream >> magic >> version;
+
+    if (playListStream.status() != QDataStream::Ok || magic != MediaPlayListPrivate::mPlayListDataMagic ||
+            version != MediaPlayListPrivate::mPlayListDataVersion) {
+        qCDebug(orgKdeElisaPlayList()) << "MediaPlayList::enqueueRestoredPlayList" << "unknown format" << magic << version;
+        return;
+    }
+
+    auto newEntries = QList<MediaPlayListEntry>{};
+
+    while (!playListStream.atEnd()) {
+        auto entryType = qint32{};
+        auto databaseId = quint64{};
+        auto trackUrl = QUrl{};
+
+        playListStream >> entryType >> databaseId >> trackUrl;
+
+        if (playListStream.status() != QDataStream::Ok) {
+            break;
+        }
+
+        const auto type = static_cast<ElisaUtils::PlayListEntryType>(entryType);
+
+        if (type == ElisaUtils::Radio) {
+            newEntries.push_back(MediaPlayListEntry{databaseId, {}, ElisaUtils::Radio});
+        } else if (databaseId != 0) {
+            // the url is kept to find the track again if its id is no longer valid
+            auto newEntry = MediaPlayListEntry{databaseId};
+            newEntry.mEntryType = type;
+            newEntry.mTrackUrl = trackUrl;
+            newEntries.push_back(newEntry);
+        } else if (trackUrl.isValid()) {
+            auto newEntry = MediaPlayListEntry{trackUrl};
+            newEntry.mEntryType = type;
+            newEntries.push_back(newEntry);
+        }
+    }
+
+    qCDebug(orgKdeElisaPlayList()) << "MediaPlayList::enqueueRestoredPlayList" << newEntries.size();
+
+    if (newEntries.isEmpty()) {
+        return;
+    }
+
+    enqueueCommon();
+
+    auto newTrackIds = QVector<qulonglong>{};
+
+    beginInsertRows(QModelIndex(), d->mData.size(), d->mData.size() + newEntries.size() - 1);
+    for (const auto &newEntry : newEntries) {
+        d->mData.push_back(newEntry);
+
+        if (newEntry.mEntryType == ElisaUtils::Radio) {
+            d->mTrackData.push_back({});
+            Q_EMIT newEntryInList(newEntry.mId, {}, ElisaUtils::Radio);
+        } else if (newEntry.mId != 0) {
+            d->mTrackData.push_back({});
+            newTrackIds.push_back(newEntry.mId);
+        } else {
+            const auto trackUrl = newEntry.mTrackUrl.toUrl();
+            if (trackUrl.isLocalFile()) {
+                d->mTrackData.push_back({{DataTypes::ColumnsRoles::ResourceRole, trackUrl}});
+                d->mData.last().mIsValid = QFileInfo::exists(trackUrl.toLocalFile());
+            } else {
+                d->mTrackData.push_back({{DataTypes::ColumnsRoles::ResourceRole, trackUrl},
+                                         {DataTypes::ColumnsRoles::TitleRole, trackUrl.fileName()}});
+                d->mData.last().mIsValid = true;
+            }
+            Q_EMIT newUrlInList(trackUrl, newEntry.mEntryType);
+        }
+    }
+    endInsertRows();
+
+    // all the tracks of the restored playlist are read with one request to the database
+    if (!newTrackIds.isEmpty()) {
+        Q_EMIT newTracksByIdInList(newTrackIds);
+    }
+
+    restorePlayListPosition();
+    if (!d->mCurrentTrack.isValid()) {
+        resetCurrentTrack();
+    }
+
+    Q_EMIT tracksCountChanged();
+    Q_EMIT remainingTracksChanged();
+    Q_EMIT persistentStateChanged();
+}
+
 void MediaPlayList::enqueueArtist(const QString &artistName)
 {
     qCDebug(orgKdeElisaPlayList()) << "MediaPlayList::enqueueArtist" << artistName;
@@ -507,15 +725,25 @@ void MediaPlayList::enqueueTracksListById(const ElisaUtils::EntryDataList &newEn
     qCDebug(orgKdeElisaPlayList()) << "MediaPlayList::enqueueTracksListById" << newEntries.size() << type;
     enqueueCommon();
 
+    auto newTrackIds = QVector<qulonglong>{};
+
     beginInsertRows(QModelIndex(), d->mData.size(), d->mData.size() + newEntries.size() - 1);
     for (const auto &newTrack : newEntries) {
         auto newMediaPlayListEntry = MediaPlayListEntry{std::get<0>(newTrack), std::get<1>(newTrack), type};
         d->mData.push_back(newMediaPlayListEntry);
         d->mTrackData.push_back({});
-        Q_EMIT newEntryInList(newMediaPlayListEntry.mId, newMediaPlayListEntry.mTitle.toString(), newMediaPlayListEntry.mEntryType);
+        if (type == ElisaUtils::Track) {
+            newTrackIds.push_back(newMediaPlayListEntry.mId);
+        } else {
+            Q_EMIT newEntryInList(newMediaPlayListEntry.mId, newMediaPlayListEntry.mTitle.toString(), newMediaPlayListEntry.mEntryType);
+        }
     }
     endInsertRows();
 
+    if (!newTrackIds.isEmpty()) {
+        Q_EMIT newTracksByIdInList(newTrackIds);
+    }
+
     restorePlayListPosition();
     if (!d->mCurrentTrack.isValid()) {
         resetCurrentTrack();
@@ -549,6 +777,8 @@ void MediaPlayList::enqueueMultipleEntries(const ElisaUtils::EntryDataList &entr
     qCDebug(orgKdeElisaPlayList()) << "MediaPlayList::enqueueMultipleEntries" << entriesData.size() << type;
     enqueueCommon();
 
+    auto newTrackIds = QVector<qulonglong>{};
+
     beginInsertRows(QModelIndex(), d->mData.size(), d->mData.size() + entriesData.size() - 1);
     for (const auto &entryData : entriesData) {
         if (std::get<2>(entryData).isValid()) {
@@ -559,12 +789,19 @@ void MediaPlayList::enqueueMultipleEntries(const ElisaUtils::EntryDataList &entr
         d->mTrackData.push_back({});
         if (std::get<2>(entryData).isValid()) {
             Q_EMIT newUrlInList(std::get<2>(entryData), type);
+        } else if (type == ElisaUtils::Track) {
+            newTrackIds.push_back(std::get<0>(entryData));
         } else {
             Q_EMIT newEntryInList(std::get<0>(entryData), std::get<1>(entryData), type);
         }
     }
     endInsertRows();
 
+    // tracks known by their id are resolved together, with one request to the database
+    if (!newTrackIds.isEmpty()) {
+        Q_EMIT newTracksByIdInList(newTrackIds);
+    }
+
     Q_EMIT tracksCountChanged();
     Q_EMIT remainingTracksChanged();
     Q_EMIT persistentStateChanged();
@@ -647,6 +884,13 @@ void MediaPlayList::undoClearPlayList()
 
     if (candidateTrack.isValid() && candidateTrack.data(ColumnsRoles::IsValidRole).toBool()) {
         d->mCurrentTrack = candidateTrack;
+    }
+
+    if (d->mRandomPlay) {
+        createRandomList();
+    }
+
+    if (d->mCurrentTrack.isValid()) {
         notifyCurrentTrackChanged();
     }
 
@@ -834,41 +1078,39 @@ bool MediaPlayList::savePlaylist(const QUrl &fileName)
 QVariantMap MediaPlayList::persistentState() const
 {
     auto currentState = QVariantMap();
-    auto result = QList<QVariant>();
+
+    QByteArray playListData;
+    QDataStream playListStream(&playListData, QIODevice::WriteOnly);
+    playListStream.setVersion(QDataStream::Qt_5_11);
+
+    playListStream << MediaPlayListPrivate::mPlayListDataMagic << MediaPlayListPrivate::mPlayListDataVersion;
+
+    auto skippedRows = QVector<int>{};
 
     for (int trackIndex = 0; trackIndex < d->mData.size(); ++trackIndex) {
-        auto oneData = QList<QString>();
         const auto &oneEntry = d->mData[trackIndex];
-        if (oneEntry.mIsValid) {
-            const auto &oneTrack = d->mTrackData[trackIndex];
+        if (!oneEntry.mIsValid) {
+            skippedRows.push_back(trackIndex);
+            continue;
+        }
 
-            oneData.push_back(QString::number(oneTrack.databaseId()));
-            oneData.push_back(oneTrack.title());
-            oneData.push_back(oneTrack.artist());
-            if (oneTrack.hasAlbum()) {
-                oneData.push_back(oneTrack.album());
-            } else {
-                oneData.push_back({});
-            }
-            if (oneTrack.hasTrackNumber()) {
-                oneData.push_back(QString::number(oneTrack.trackNumber()));
-            } else {
-                oneData.push_back({});
-            }
-            if (oneTrack.hasDiscNumber()) {
-                oneData.push_back(QString::number(oneTrack.discNumber()));
-            } else {
-                oneData.push_back({});
-            }
-            oneData.push_back(QString::number(oneEntry.mEntryType));
+        const auto &oneTrack = d->mTrackData[trackIndex];
 
-            result.push_back(QVariant(oneData));
-        }
+        // a restored entry not yet found in the database is saved as it was restored
+        const auto databaseId = oneTrack.isEmpty() ? oneEntry.mId : oneTrack.databaseId();
+        const auto trackUrl = oneTrack.isEmpty() ? oneEntry.mTrackUrl.toUrl() : oneTrack.resourceURI();
+
+        playListStream << static_cast<qint32>(oneEntry.mEntryType) << quint64(databaseId) << trackUrl;
     }
 
-    currentState[QStringLiteral("playList")] = result;
+    currentState[QStringLiteral("playListData")] = playListData;
     currentState[QStringLiteral("currentTrack")] = d->mCurrentPlayListPosition;
     currentState[QStringLiteral("randomPlay")] = d->mRandomPlay;
+    currentState[QStringLiteral("randomPlayByAlbum")] = d->mRandomPlayByAlbum;
+    if (d->mRandomPlay) {
+        // the order is restored with the saved entries only
+        currentState[QStringLiteral("randomOrder")] = d->mRandomOrder.state(skippedRows);
+    }
     currentState[QStringLiteral("repeatPlay")] = d->mRepeatPlay;
 
     return currentState;
@@ -909,6 +1151,11 @@ bool MediaPlayList::randomPlay() const
     return d->mRandomPlay;
 }
 
+bool MediaPlayList::randomPlayByAlbum() const
+{
+    return d->mRandomPlayByAlbum;
+}
+
 bool MediaPlayList::repeatPlay() const
 {
     return d->mRepeatPlay;
@@ -924,6 +1171,12 @@ void MediaPlayList::setPersistentState(const QVariantMap &persistentStateValue)
 
     d->mPersistentState = persistentStateValue;
 
+    auto playListData = d->mPersistentState.find(QStringLiteral("playListData"));
+    if (playListData != d->mPersistentState.end()) {
+        enqueueRestoredPlayList(playListData->toByteArray());
+    }
+
+    // playlist saved by older versions as the metadata of each track
     auto persistentState = d->mPersistentState[QStringLiteral("playList")].toList();
 
     for (auto &oneData : persistentState) {
@@ -958,9 +1211,6 @@ void MediaPlayList::removeSelection(QList<int> selection)
     for (auto oneItem : selection) {
         removeRow(oneItem);
     }
-    if (d->mRandomPlay) {
-        createRandomList();
-    }
 }
 
 void MediaPlayList::tracksListAdded(qulonglong newDatabaseId,
@@ -986,6 +1236,7 @@ void MediaPlayList::tracksListAdded(qulonglong newDatabaseId,
         oneEntry.mId = tracks.first().databaseId();
         oneEntry.mIsValid = true;
         oneEntry.mEntryType = ElisaUtils::Track;
+        d->invalidateRowsIndex();
 
         Q_EMIT dataChanged(index(playListIndex, 0), index(playListIndex, 0), {});
 
@@ -1017,7 +1268,9 @@ void MediaPlayList::tracksListAdded(qulonglong newDatabaseId,
 
 void MediaPlayList::trackChanged(const TrackDataType &track)
 {
-    for (int i = 0; i < d->mData.size(); ++i) {
+    const auto candidateRows = d->candidateRows(track.databaseId(), track.resourceURI());
+
+    for (auto i : candidateRows) {
         auto &oneEntry = d->mData[i];
 
         if (oneEntry.mEntryType != ElisaUtils::Artist && oneEntry.mIsValid) {
@@ -1062,6 +1315,7 @@ void MediaPlayList::trackChanged(const TrackDataType &track)
             d->mTrackData[i] = track;
             oneEntry.mId = track.databaseId();
             oneEntry.mIsValid = true;
+            d->invalidateRowsIndex();
 
             Q_EMIT dataChanged(index(i, 0), index(i, 0), {});
 
@@ -1096,6 +1350,7 @@ void MediaPlayList::trackChanged(const TrackDataType &track)
             d->mTrackData[i] = track;
             oneEntry.mId = track.databaseId();
             oneEntry.mIsValid = true;
+            d->invalidateRowsIndex();
 
             Q_EMIT dataChanged(index(i, 0), index(i, 0), {});
 
@@ -1118,6 +1373,7 @@ void MediaPlayList::trackChanged(const TrackDataType &track)
             d->mTrackData[i] = track;
             oneEntry.mId = track.databaseId();
             oneEntry.mIsValid = true;
+            d->invalidateRowsIndex();
 
             Q_EMIT dataChanged(index(i, 0), index(i, 0), {});
 
@@ -1138,12 +1394,15 @@ void MediaPlayList::trackChanged(const TrackDataType &track)
 
 void MediaPlayList::trackRemoved(qulonglong trackId)
 {
-    for (int i = 0; i < d->mData.size(); ++i) {
+    const auto removedRows = d->rowsFromId(trackId);
+
+    for (auto i : removedRows) {
         auto &oneEntry = d->mData[i];
 
         if (oneEntry.mIsValid) {
             if (oneEntry.mId == trackId) {
                 oneEntry.mIsValid = false;
+                d->invalidateRowsIndex();
                 oneEntry.mTitle = d->mTrackData[i].title();
                 oneEntry.mArtist = d->mTrackData[i].artist();
                 oneEntry.mAlbum = d->mTrackData[i].album();
@@ -1160,6 +1419,124 @@ void MediaPlayList::trackRemoved(qulonglong trackId)
     }
 }
 
+void MediaPlayList::tracksChanged(const TracksChangeSet &changes)
+{
+    const auto validTrackRows = [this](qulonglong databaseId) {
+        auto result = d->rowsFromId(databaseId);
+
+        auto newEnd = std::remove_if(result.begin(), result.end(), [this](int row) {
+            const auto &oneEntry = d->mData.at(row);
+            return oneEntry.mEntryType == ElisaUtils::Artist || oneEntry.mEntryType == ElisaUtils::Radio || !oneEntry.mIsValid;
+        });
+        result.erase(newEnd, result.end());
+
+        return result;
+    };
+
+    // a restored entry is found again by its url when its saved id is unknown or names another track
+    const auto isRestoredTrackRow = [this](int row) {
+        return d->mData.at(row).mTrackUrl.isValid() && d->mTrackData.at(row).isEmpty();
+    };
+
+    auto modifiedRows = QVector<int>{};
+    auto restoredRowsFromUrl = QVector<int>{};
+
+    for (const auto &oneModifiedTrack : changes.mModifiedTracks) {
+        for (auto i : validTrackRows(oneModifiedTrack.databaseId())) {
+            auto &trackData = d->mTrackData[i];
+
+            if (isRestoredTrackRow(i) && d->mData.at(i).mTrackUrl.toUrl() != oneModifiedTrack.resourceURI()) {
+                restoredRowsFromUrl.push_back(i);
+                continue;
+            }
+
+            if (trackData != oneModifiedTrack) {
+                trackData = oneModifiedTrack;
+                modifiedRows.push_back(i);
+            }
+        }
+    }
+
+    for (const auto &oneChange : changes.mTracksChanges) {
+        for (auto i : validTrackRows(oneChange.databaseId())) {
+            d->mTrackData[i].applyChanges(oneChange);
+            modifiedRows.push_back(i);
+        }
+    }
+
+    for (auto oneRemovedTrackId : changes.mRemovedTrackIds) {
+        for (auto i : validTrackRows(oneRemovedTrackId)) {
+            // an entry never found in the database has no track data to keep
+            if (d->mTrackData.at(i).isEmpty()) {
+                if (isRestoredTrackRow(i)) {
+                    restoredRowsFromUrl.push_back(i);
+                }
+                continue;
+            }
+
+            auto &oneEntry = d->mData[i];
+            const auto &trackData = d->mTrackData.at(i);
+
+            oneEntry.mIsValid = false;
+            oneEntry.mTitle = trackData.title();
+            oneEntry.mArtist = trackData.artist();
+            oneEntry.mAlbum = trackData.album();
+            oneEntry.mTrackNumber = trackData.trackNumber();
+            oneEntry.mDiscNumber = trackData.discNumber();
+
+            modifiedRows.push_back(i);
+        }
+    }
+
+    for (auto i : restoredRowsFromUrl) {
+        auto &oneEntry = d->mData[i];
+
+        oneEntry.mId = 0;
+        oneEntry.mIsValid = false;
+
+        modifiedRows.push_back(i);
+    }
+
+    if (!changes.mRemovedTrackIds.isEmpty() || !restoredRowsFromUrl.isEmpty()) {
+        d->invalidateRowsIndex();
+    }
+
+    for (auto i : restoredRowsFromUrl) {
+        Q_EMIT newUrlInList(d->mData.at(i).mTrackUrl.toUrl(), d->mData.at(i).mEntryType);
+    }
+
+    std::sort(modifiedRows.begin(), modifiedRows.end());
+    modifiedRows.erase(std::unique(modifiedRows.begin(), modifiedRows.end()), modifiedRows.end());
+
+    if (modifiedRows.isEmpty()) {
+        return;
+    }
+
+    const auto changedRoles = changes.mRemovedTrackIds.isEmpty() && restoredRowsFromUrl.isEmpty() ?
+                changes.changedRoles() : QVector<int>{};
+
+    for (auto firstRow = 0; firstRow < modifiedRows.size();) {
+        auto lastRow = firstRow;
+        while (lastRow + 1 < modifiedRows.size() && modifiedRows[lastRow + 1] == modifiedRows[lastRow] + 1) {
+            ++lastRow;
+        }
+
+        Q_EMIT dataChanged(index(modifiedRows[firstRow], 0), index(modifiedRows[lastRow], 0), changedRoles);
+
+        firstRow = lastRow + 1;
+    }
+
+    restorePlayListPosition();
+
+    if (!d->mCurrentTrack.isValid()) {
+        resetCurrentTrack();
+    } else if (modifiedRows.contains(d->mCurrentTrack.row())) {
+        notifyCurrentTrackChanged();
+    } else if (modifiedRows.contains(d->mNextTrack.row()) || modifiedRows.contains(d->mPreviousTrack.row())) {
+        notifyPreviousAndNextTracks();
+    }
+}
+
 void MediaPlayList::setMusicListenersManager(MusicListenersManager *musicListenersManager)
 {
     if (d->mMusicListenersManager == musicListenersManager) {
@@ -1179,13 +1556,30 @@ void MediaPlayList::setRandomPlay(bool value)
 {
     if (d->mRandomPlay != value) {
         d->mRandomPlay = value;
-        createRandomList();
+        if (d->mRandomPlay) {
+            createRandomList();
+        } else {
+            d->mRandomOrder.reset(0);
+        }
         Q_EMIT randomPlayChanged();
         Q_EMIT remainingTracksChanged();
         notifyPreviousAndNextTracks();
     }
 }
 
+void MediaPlayList::setRandomPlayByAlbum(bool value)
+{
+    if (d->mRandomPlayByAlbum != value) {
+        d->mRandomPlayByAlbum = value;
+        if (d->mRandomPlay) {
+            createRandomList();
+            notifyPreviousAndNextTracks();
+        }
+        Q_EMIT randomPlayByAlbumChanged();
+        Q_EMIT persistentStateChanged();
+    }
+}
+
 void MediaPlayList::setRepeatPlay(bool value)
 {
     if (d->mRepeatPlay != value) {
@@ -1214,11 +1608,14 @@ void MediaPlayList::skipNextTrack()
     }
 
     if (d->mRandomPlay) {
-        d->mRandomPositions.removeFirst();
-        d->mCurrentTrack = index(d->mRandomPositions.at(1), 0);
-        if (rowCount()) {
-            d->mRandomPositions.append(QRandomGenerator::global()->bounded(rowCount()));
+        auto nextRow = d->mRandomOrder.moveToNext(d->mRepeatPlay);
+        if (nextRow == -1) {
+            // every track has been played: start again with a new order
+            d->mRandomOrder.reset(rowCount());
+            nextRow = d->mRandomOrder.moveToNext(false);
+            Q_EMIT playListFinished();
         }
+        d->mCurrentTrack = index(nextRow, 0);
     } else {
         if (d->mCurrentTrack.row() >= rowCount() - 1) {
             d->mCurrentTrack = index(0, 0);
@@ -1240,11 +1637,11 @@ void MediaPlayList::skipPreviousTrack()
     }
 
     if (d->mRandomPlay) {
-        d->mRandomPositions.removeLast();
-        d->mCurrentTrack = index(d->mRandomPositions.at(0), 0);
-        if (rowCount()) {
-            d->mRandomPositions.prepend(QRandomGenerator::global()->bounded(rowCount()));
+        const auto previousRow = d->mRandomOrder.moveToPrevious(d->mRepeatPlay);
+        if (previousRow == -1) {
+            return;
         }
+        d->mCurrentTrack = index(previousRow, 0);
     } else {
         if (d->mCurrentTrack.row() == 0) {
             if (d->mRepeatPlay) {
@@ -1266,12 +1663,8 @@ void MediaPlayList::switchTo(int row)
         return;
     }
 
-    if (d->mRandomPlay) {
-        d->mCurrentTrack = index(row, 0);
-        d->mRandomPositions.replace(1, row);
-    } else {
-        d->mCurrentTrack = index(row, 0);
-    }
+    d->mCurrentTrack = index(row, 0);
+    d->followCurrentTrack();
 
     notifyCurrentTrackChanged();
 }
@@ -1287,6 +1680,7 @@ void MediaPlayList::trackInError(const QUrl &sourceInError, QMediaPlayer::Error
 
             if (oneTrackData.resourceURI() == sourceInError) {
                 oneTrack.mIsValid = false;
+                d->invalidateRowsIndex();
                 Q_EMIT dataChanged(index(i, 0), index(i, 0), {ColumnsRoles::IsValidRole});
             }
         }
@@ -1328,6 +1722,7 @@ void MediaPlayList::resetCurrentTrack()
 
         if (candidateTrack.isValid() && candidateTrack.data(ColumnsRoles::IsValidRole).toBool()) {
             d->mCurrentTrack = candidateTrack;
+            d->followCurrentTrack();
             notifyCurrentTrackChanged();
             break;
         }
@@ -1342,10 +1737,12 @@ void MediaPlayList::notifyPreviousAndNextTracks()
     }
     auto mOldPreviousTrack = d->mPreviousTrack;
     auto mOldNextTrack = d->mNextTrack;
-    // use random list for previous and next types
+    // use random order for previous and next types
     if (d->mRandomPlay) {
-        d->mPreviousTrack = index(d->mRandomPositions.first(), 0);
-        d->mNextTrack = index(d->mRandomPositions.last(), 0);
+        if (d->mCurrentTrack.isValid()) {
+            d->mPreviousTrack = index(d->mRandomOrder.previousRow(d->mRepeatPlay), 0);
+            d->mNextTrack = index(d->mRandomOrder.nextRow(d->mRepeatPlay), 0);
+        }
     } else if (d->mRepeatPlay) {
         // forward to end or begin when repeating
         if (d->mCurrentTrack.row() == 0) {
@@ -1400,6 +1797,7 @@ void MediaPlayList::restorePlayListPosition()
         auto newIndex = index(playerCurrentTrack->toInt(), 0);
         if (newIndex.isValid() && (newIndex != d->mCurrentTrack)) {
             d->mCurrentTrack = newIndex;
+            d->followCurrentTrack();
             notifyCurrentTrackChanged();
 
             if (d->mCurrentTrack.isValid()) {
@@ -1411,10 +1809,23 @@ void MediaPlayList::restorePlayListPosition()
 
 void MediaPlayList::restoreRandomPlay()
 {
+    auto randomPlayByAlbumStoredValue = d->mPersistentState.find(QStringLiteral("randomPlayByAlbum"));
+    if (randomPlayByAlbumStoredValue != d->mPersistentState.end()) {
+        setRandomPlayByAlbum(randomPlayByAlbumStoredValue->toBool());
+    }
+
     auto randomPlayStoredValue = d->mPersistentState.find(QStringLiteral("randomPlay"));
     if (randomPlayStoredValue != d->mPersistentState.end()) {
         setRandomPlay(randomPlayStoredValue->toBool());
     }
+
+    auto randomOrderStoredValue = d->mPersistentState.find(QStringLiteral("randomOrder"));
+    if (d->mRandomPlay && randomOrderStoredValue != d->mPersistentState.end()) {
+        if (d->mRandomOrder.restoreState(randomOrderStoredValue->toByteArray())) {
+            notifyPreviousAndNextTracks();
+            Q_EMIT remainingTracksChanged();
+        }
+    }
 }
 
 void MediaPlayList::restoreRepeatPlay()
@@ -1437,8 +1848,10 @@ int MediaPlayList::remainingTracks() const
         return -1;
     }
 
-    if (d->mRandomPlay || d->mRepeatPlay) {
+    if (d->mRepeatPlay) {
         return -1;
+    } else if (d->mRandomPlay) {
+        return d->mRandomOrder.remainingRowsCount();
     } else {
         return rowCount() - d->mCurrentTrack.row() - 1;
     }
@@ -1446,13 +1859,18 @@ int MediaPlayList::remainingTracks() const
 
 void MediaPlayList::createRandomList()
 {
-    if (rowCount()) {
-        for (auto& position : d->mRandomPositions) {
-            position = QRandomGenerator::global()->bounded(rowCount());
-        }
+    d->mRandomOrder.reset(rowCount());
+
+    if (d->mRandomPlayByAlbum) {
+        d->mRandomOrder.setSameGroupFunction([this](int firstRow, int secondRow) {
+            return d->isSameAlbum(firstRow, secondRow);
+        });
+    } else {
+        d->mRandomOrder.setSameGroupFunction({});
     }
+
     if (d->mCurrentTrack.isValid()) {
-        d->mRandomPositions.replace(1, d->mCurrentTrack.row());
+        d->mRandomOrder.setCurrentRow(d->mCurrentTrack.row());
     }
 }
 
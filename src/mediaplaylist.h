@@ -22,6 +22,7 @@
 
 #include "elisautils.h"
 #include "datatypes.h"
+#include "stringpool.h"
 
 #include <QAbstractListModel>
 #include <QVector>
@@ -75,6 +76,11 @@ class ELISALIB_EXPORT MediaPlayList : public QAbstractListModel
                WRITE setRandomPlay
                NOTIFY randomPlayChanged)
 
+    Q_PROPERTY(bool randomPlayByAlbum
+               READ randomPlayByAlbum
+               WRITE setRandomPlayByAlbum
+               NOTIFY randomPlayByAlbumChanged)
+
     Q_PROPERTY(bool repeatPlay
                READ repeatPlay
                WRITE setRepeatPlay
@@ -148,6 +154,8 @@ public:
 
     using TrackDataType = DataTypes::TrackDataType;
 
+    using TracksChangeSet = DataTypes::TracksChangeSet;
+
     explicit MediaPlayList(QObject *parent = nullptr);
 
     ~MediaPlayList() override;
@@ -186,6 +194,8 @@ public:
 
     bool randomPlay() const;
 
+    bool randomPlayByAlbum() const;
+
     bool repeatPlay() const;
 
     int remainingTracks() const;
@@ -201,6 +211,8 @@ Q_SIGNALS:
                         const QString &entryTitle,
                         ElisaUtils::PlayListEntryType databaseIdType);
 
+    void newTracksByIdInList(const QVector<qulonglong> &newDatabaseIds);
+
     void newUrlInList(const QUrl &entryUrl,
                       ElisaUtils::PlayListEntryType databaseIdType);
 
@@ -224,6 +236,8 @@ Q_SIGNALS:
 
     void randomPlayChanged();
 
+    void randomPlayByAlbumChanged();
+
     void repeatPlayChanged();
 
     void playListFinished();
@@ -251,10 +265,14 @@ public Q_SLOTS:
 
     void trackRemoved(qulonglong trackId);
 
+    void tracksChanged(const MediaPlayList::TracksChangeSet &changes);
+
     void setMusicListenersManager(MusicListenersManager* musicListenersManager);
 
     void setRandomPlay(bool value);
 
+    void setRandomPlayByAlbum(bool value);
+
     void setRepeatPlay(bool value);
 
     void skipNextTrack();
@@ -310,6 +328,8 @@ private Q_SLOTS:
 private:
     void displayOrHideUndoInline(bool value);
 
+    void enqueueRestoredPlayList(const QByteArray &playListData);
+
     void clearPlayList(bool prepareUndo);
 
     void resetCurrentTrack();
@@ -357,7 +377,7 @@ public:
     MediaPlayListEntry(QString title, QString artist,
                        QString album, int trackNumber,
                        int discNumber, ElisaUtils::PlayListEntryType entryType = ElisaUtils::Unknown)
-        : mTitle(std::move(title)), mAlbum(std::move(album)), mArtist(std::move(artist)),
+        : mTitle(std::move(title)), mAlbum(StringPool::instance().intern(album)), mArtist(StringPool::instance().intern(artist)),
           mTrackNumber(trackNumber), mDiscNumber(discNumber), mEntryType(entryType) {
     }
 
@@ -377,7 +397,7 @@ public:
           mIsValid(true) {
     }
 
-    explicit MediaPlayListEntry(QString artist) : mArtist(std::move(artist)), mEntryType(ElisaUtils::Artist) {
+    explicit MediaPlayListEntry(QString artist) : mArtist(StringPool::instance().intern(artist)), mEntryType(ElisaUtils::Artist) {
     }
 
     explicit MediaPlayListEntry(QUrl fileName) : mTrackUrl(std::move(fileName)) {
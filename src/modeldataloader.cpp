@@ -25,6 +25,8 @@ public:
 
     DatabaseInterface *mDatabase = nullptr;
 
+    DatabaseInterface *mReadDatabase = nullptr;
+
     ElisaUtils::PlayListEntryType mModelType = ElisaUtils::Unknown;
 
     ModelDataLoader::FilterType mFilterType = ModelDataLoader::FilterType::UnknownFilter;
@@ -41,6 +43,8 @@ public:
 
     FileScanner mFileScanner;
 
+    int mMaximumSearchResults = 2000;
+
 };
 
 ModelDataLoader::ModelDataLoader(QObject *parent) : QObject(parent), d(std::make_unique<ModelDataLoaderPrivate>())
@@ -57,16 +61,12 @@ void ModelDataLoader::setDatabase(DatabaseInterface *database)
             this, &ModelDataLoader::genresAdded);
     connect(database, &DatabaseInterface::albumsAdded,
             this, &ModelDataLoader::databaseAlbumsAdded);
-    connect(database, &DatabaseInterface::albumModified,
-            this, &ModelDataLoader::albumModified);
     connect(database, &DatabaseInterface::albumRemoved,
             this, &ModelDataLoader::albumRemoved);
     connect(database, &DatabaseInterface::tracksAdded,
             this, &ModelDataLoader::databaseTracksAdded);
-    connect(database, &DatabaseInterface::trackModified,
-            this, &ModelDataLoader::trackModified);
-    connect(database, &DatabaseInterface::trackRemoved,
-            this, &ModelDataLoader::trackRemoved);
+    connect(database, &DatabaseInterface::tracksChanged,
+            this, &ModelDataLoader::tracksChanged);
     connect(database, &DatabaseInterface::artistsAdded,
             this, &ModelDataLoader::databaseArtistsAdded);
     connect(database, &DatabaseInterface::artistRemoved,
@@ -85,6 +85,11 @@ void ModelDataLoader::setDatabase(DatabaseInterface *database)
             this, &ModelDataLoader::clearedDatabase);
 }
 
+void ModelDataLoader::setReadDatabase(DatabaseInterface *database)
+{
+    d->mReadDatabase = database;
+}
+
 void ModelDataLoader::loadData(ElisaUtils::PlayListEntryType dataType)
 {
     if (!d->mDatabase) {
@@ -96,30 +101,70 @@ void ModelDataLoader::loadData(ElisaUtils::PlayListEntryType dataType)
     switch (dataType)
     {
     case ElisaUtils::Album:
-        Q_EMIT allAlbumsData(d->mDatabase->allAlbumsData());
+        Q_EMIT allAlbumsData(readDatabase()->allAlbumsData());
         break;
     case ElisaUtils::Artist:
-        Q_EMIT allArtistsData(d->mDatabase->allArtistsData());
+        Q_EMIT allArtistsData(readDatabase()->allArtistsData());
         break;
     case ElisaUtils::Composer:
         break;
     case ElisaUtils::Genre:
-        Q_EMIT allGenresData(d->mDatabase->allGenresData());
+        Q_EMIT allGenresData(readDatabase()->allGenresData());
         break;
     case ElisaUtils::Lyricist:
         break;
     case ElisaUtils::Track:
-        Q_EMIT allTracksData(d->mDatabase->allTracksData());
+        Q_EMIT allTracksData(readDatabase()->allTracksData());
         break;
     case ElisaUtils::FileName:
     case ElisaUtils::Unknown:
         break;
     case ElisaUtils::Radio:
-        Q_EMIT allRadiosData(d->mDatabase->allRadiosData());
+        Q_EMIT allRadiosData(readDatabase()->allRadiosData());
         break;
     }
 }
 
+void ModelDataLoader::loadDataPage(ElisaUtils::PlayListEntryType dataType, const DataTypes::PageRequest &request)
+{
+    if (!d->mDatabase) {
+        return;
+    }
+
+    d->mFilterType = ModelDataLoader::FilterType::NoFilter;
+
+    switch (dataType)
+    {
+    case ElisaUtils::Album:
+        Q_EMIT albumsDataPage(readDatabase()->allAlbumsDataPage(request), request);
+        break;
+    case ElisaUtils::Artist:
+        Q_EMIT artistsDataPage(readDatabase()->allArtistsDataPage(request), request);
+        break;
+    case ElisaUtils::Track:
+        Q_EMIT tracksDataPage(readDatabase()->allTracksDataPage(request), request);
+        break;
+    case ElisaUtils::Composer:
+    case ElisaUtils::Genre:
+    case ElisaUtils::Lyricist:
+    case ElisaUtils::FileName:
+    case ElisaUtils::Unknown:
+    case ElisaUtils::Radio:
+        break;
+    }
+}
+
+void ModelDataLoader::loadAllEntriesOfPages(ElisaUtils::PlayListEntryType dataType, const DataTypes::PageRequest &request,
+                                            ElisaUtils::PlayListEnqueueMode enqueueMode,
+                                            ElisaUtils::PlayListEnqueueTriggerPlay triggerPlay)
+{
+    if (!d->mDatabase) {
+        return;
+    }
+
+    Q_EMIT entriesToEnqueue(readDatabase()->allEntriesOfPages(dataType, request), dataType, enqueueMode, triggerPlay);
+}
+
 void ModelDataLoader::loadDataByAlbumId(ElisaUtils::PlayListEntryType dataType, qulonglong databaseId)
 {
     if (!d->mDatabase) {
@@ -142,7 +187,7 @@ void ModelDataLoader::loadDataByAlbumId(ElisaUtils::PlayListEntryType dataType,
     case ElisaUtils::Lyricist:
         break;
     case ElisaUtils::Track:
-        Q_EMIT allTracksData(d->mDatabase->albumData(databaseId));
+        Q_EMIT allTracksData(readDatabase()->albumData(databaseId));
         break;
     case ElisaUtils::FileName:
     case ElisaUtils::Unknown:
@@ -163,7 +208,7 @@ void ModelDataLoader::loadDataByGenre(ElisaUtils::PlayListEntryType dataType, co
     switch (dataType)
     {
     case ElisaUtils::Artist:
-        Q_EMIT allArtistsData(d->mDatabase->allArtistsDataByGenre(genre));
+        Q_EMIT allArtistsData(readDatabase()->allArtistsDataByGenre(genre));
         break;
     case ElisaUtils::Album:
     case ElisaUtils::Composer:
@@ -189,7 +234,7 @@ void ModelDataLoader::loadDataByArtist(ElisaUtils::PlayListEntryType dataType, c
     switch (dataType)
     {
     case ElisaUtils::Album:
-        Q_EMIT allAlbumsData(d->mDatabase->allAlbumsDataByArtist(artist));
+        Q_EMIT allAlbumsData(readDatabase()->allAlbumsDataByArtist(artist));
         break;
     case ElisaUtils::Artist:
     case ElisaUtils::Composer:
@@ -216,7 +261,7 @@ void ModelDataLoader::loadDataByGenreAndArtist(ElisaUtils::PlayListEntryType dat
     switch (dataType)
     {
     case ElisaUtils::Album:
-        Q_EMIT allAlbumsData(d->mDatabase->allAlbumsDataByGenreAndArtist(genre, artist));
+        Q_EMIT allAlbumsData(readDatabase()->allAlbumsDataByGenreAndArtist(genre, artist));
         break;
     case ElisaUtils::Artist:
     case ElisaUtils::Composer:
@@ -243,10 +288,10 @@ void ModelDataLoader::loadDataByDatabaseIdAndUrl(ElisaUtils::PlayListEntryType d
     switch (dataType)
     {
     case ElisaUtils::Track:
-        Q_EMIT allTrackData(d->mDatabase->trackDataFromDatabaseIdAndUrl(databaseId, url));
+        Q_EMIT allTrackData(readDatabase()->trackDataFromDatabaseIdAndUrl(databaseId, url));
         break;
     case ElisaUtils::Radio:
-        Q_EMIT allRadioData(d->mDatabase->radioDataFromDatabaseId(databaseId));
+        Q_EMIT allRadioData(readDatabase()->radioDataFromDatabaseId(databaseId));
         break;
     case ElisaUtils::Album:
     case ElisaUtils::Artist:
@@ -271,9 +316,9 @@ void ModelDataLoader::loadDataByUrl(ElisaUtils::PlayListEntryType dataType, cons
     {
     case ElisaUtils::FileName:
     {
-        auto databaseId = d->mDatabase->trackIdFromFileName(url);
+        auto databaseId = readDatabase()->trackIdFromFileName(url);
         if (databaseId != 0) {
-            Q_EMIT allTrackData(d->mDatabase->trackDataFromDatabaseIdAndUrl(databaseId, url));
+            Q_EMIT allTrackData(readDatabase()->trackDataFromDatabaseIdAndUrl(databaseId, url));
         } else {
             auto result = d->mFileScanner.scanOneFile(url);
             Q_EMIT allTrackData(result);
@@ -303,7 +348,7 @@ void ModelDataLoader::loadRecentlyPlayedData(ElisaUtils::PlayListEntryType dataT
     switch (dataType)
     {
     case ElisaUtils::Track:
-        Q_EMIT allTracksData(d->mDatabase->recentlyPlayedTracksData(50));
+        Q_EMIT allTracksData(readDatabase()->recentlyPlayedTracksData(50));
         break;
     case ElisaUtils::Album:
     case ElisaUtils::Artist:
@@ -328,7 +373,7 @@ void ModelDataLoader::loadFrequentlyPlayedData(ElisaUtils::PlayListEntryType dat
     switch (dataType)
     {
     case ElisaUtils::Track:
-        Q_EMIT allTracksData(d->mDatabase->frequentlyPlayedTracksData(50));
+        Q_EMIT allTracksData(readDatabase()->frequentlyPlayedTracksData(50));
         break;
     case ElisaUtils::Album:
     case ElisaUtils::Artist:
@@ -342,6 +387,26 @@ void ModelDataLoader::loadFrequentlyPlayedData(ElisaUtils::PlayListEntryType dat
     }
 }
 
+void ModelDataLoader::searchData(ElisaUtils::PlayListEntryType dataType, const QString &searchText)
+{
+    if (!d->mDatabase || !readDatabase()->isSearchIndexAvailable()) {
+        return;
+    }
+
+    if (dataType != ElisaUtils::Track && dataType != ElisaUtils::Album && dataType != ElisaUtils::Artist) {
+        return;
+    }
+
+    const auto matchingIds = readDatabase()->searchIds(dataType, searchText, d->mMaximumSearchResults + 1);
+
+    // too many matches to be worth it: the proxy models keep filtering on the displayed text
+    if (matchingIds.size() > d->mMaximumSearchResults) {
+        return;
+    }
+
+    Q_EMIT searchResults(searchText, matchingIds);
+}
+
 void ModelDataLoader::databaseTracksAdded(const ListTrackDataType &newData)
 {
     switch(d->mFilterType) {
@@ -376,7 +441,7 @@ void ModelDataLoader::databaseArtistsAdded(const ListArtistDataType &newData)
     {
         auto filteredData = newData;
         auto new_end = std::remove_if(filteredData.begin(), filteredData.end(),
-                                      [&](const auto &oneArtist){return !d->mDatabase->internalArtistMatchGenre(oneArtist.databaseId(), d->mGenre);});
+                                      [&](const auto &oneArtist){return !readDatabase()->internalArtistMatchGenre(oneArtist.databaseId(), d->mGenre);});
         filteredData.erase(new_end, filteredData.end());
 
         Q_EMIT artistsAdded(filteredData);
@@ -436,4 +501,13 @@ void ModelDataLoader::databaseAlbumsAdded(const ListAlbumDataType &newData)
     }
 }
 
+DatabaseInterface *ModelDataLoader::readDatabase() const
+{
+    if (d->mReadDatabase) {
+        return d->mReadDatabase;
+    }
+
+    return d->mDatabase;
+}
+
 #include "moc_modeldataloader.cpp"
@@ -45,6 +45,7 @@ public:
     using ListRadioDataType = DataTypes::ListRadioDataType;
     using TrackDataType = DataTypes::TrackDataType;
     using AlbumDataType = DataTypes::AlbumDataType;
+    using TracksChangeSet = DataTypes::TracksChangeSet;
 
     using FilterType = ElisaUtils::FilterType;
 
@@ -54,6 +55,8 @@ public:
 
     void setDatabase(DatabaseInterface *database);
 
+    void setReadDatabase(DatabaseInterface *database);
+
 Q_SIGNALS:
 
     void allAlbumsData(const ModelDataLoader::ListAlbumDataType &allData);
@@ -76,9 +79,7 @@ Q_SIGNALS:
 
     void tracksAdded(const ModelDataLoader::ListTrackDataType &newData);
 
-    void trackModified(const ModelDataLoader::TrackDataType &modifiedTrack);
-
-    void trackRemoved(qulonglong removedTrackId);
+    void tracksChanged(const ModelDataLoader::TracksChangeSet &changes);
 
     void genresAdded(const ModelDataLoader::ListGenreDataType &newData);
 
@@ -90,8 +91,6 @@ Q_SIGNALS:
 
     void albumRemoved(qulonglong removedDatabaseId);
 
-    void albumModified(const ModelDataLoader::AlbumDataType &modifiedAlbum);
-
     void saveRadioModified(const ModelDataLoader::TrackDataType &trackDataType);
 
     void removeRadio(qulonglong radioId);
@@ -100,10 +99,29 @@ Q_SIGNALS:
 
     void clearedDatabase();
 
+    void searchResults(const QString &searchText, const QVector<qulonglong> &matchingIds);
+
+    void tracksDataPage(const ModelDataLoader::ListTrackDataType &pageData, const DataTypes::PageRequest &request);
+
+    void albumsDataPage(const ModelDataLoader::ListAlbumDataType &pageData, const DataTypes::PageRequest &request);
+
+    void artistsDataPage(const ModelDataLoader::ListArtistDataType &pageData, const DataTypes::PageRequest &request);
+
+    void entriesToEnqueue(const ElisaUtils::EntryDataList &newEntries,
+                          ElisaUtils::PlayListEntryType databaseIdType,
+                          ElisaUtils::PlayListEnqueueMode enqueueMode,
+                          ElisaUtils::PlayListEnqueueTriggerPlay triggerPlay);
+
 public Q_SLOTS:
 
     void loadData(ElisaUtils::PlayListEntryType dataType);
 
+    void loadDataPage(ElisaUtils::PlayListEntryType dataType, const DataTypes::PageRequest &request);
+
+    void loadAllEntriesOfPages(ElisaUtils::PlayListEntryType dataType, const DataTypes::PageRequest &request,
+                               ElisaUtils::PlayListEnqueueMode enqueueMode,
+                               ElisaUtils::PlayListEnqueueTriggerPlay triggerPlay);
+
     void loadDataByAlbumId(ElisaUtils::PlayListEntryType dataType, qulonglong databaseId);
 
     void loadDataByGenre(ElisaUtils::PlayListEntryType dataType,
@@ -125,6 +143,8 @@ public Q_SLOTS:
 
     void loadFrequentlyPlayedData(ElisaUtils::PlayListEntryType dataType);
 
+    void searchData(ElisaUtils::PlayListEntryType dataType, const QString &searchText);
+
 private Q_SLOTS:
 
     void databaseTracksAdded(const ModelDataLoader::ListTrackDataType &newData);
@@ -135,6 +155,8 @@ private Q_SLOTS:
 
 private:
 
+    DatabaseInterface *readDatabase() const;
+
     std::unique_ptr<ModelDataLoaderPrivate> d;
 
 };
@@ -18,6 +18,8 @@
 
 #include "abstractmediaproxymodel.h"
 
+#include "datamodel.h"
+
 #include <QWriteLocker>
 
 AbstractMediaProxyModel::AbstractMediaProxyModel(QObject *parent) : QSortFilterProxyModel(parent)
@@ -41,35 +43,125 @@ int AbstractMediaProxyModel::filterRating() const
 
 void AbstractMediaProxyModel::setFilterText(const QString &filterText)
 {
-    QWriteLocker writeLocker(&mDataLock);
+    {
+        QWriteLocker writeLocker(&mDataLock);
 
-    if (mFilterText == filterText)
-        return;
+        if (mFilterText == filterText)
+            return;
 
-    mFilterText = filterText;
+        mFilterText = filterText;
 
-    mFilterExpression.setPattern(mFilterText);
-    mFilterExpression.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
-    mFilterExpression.optimize();
+        mFilterExpression.setPattern(mFilterText);
+        mFilterExpression.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
+        mFilterExpression.optimize();
 
-    invalidate();
+        mSearchResults.clear();
+        mHasSearchResults = false;
 
-    Q_EMIT filterTextChanged(mFilterText);
+        invalidate();
+    }
+
+    if (mSearchModel) {
+        mSearchModel->filterData(mFilterText, mFilterRating);
+    }
+
+    // the results may be delivered synchronously when the data loader lives in this thread
+    if (mSearchModel && !mSearchModel->isPaged() && !filterText.isEmpty()) {
+        mSearchModel->searchData(filterText);
+    }
+
+    Q_EMIT filterTextChanged(filterText);
 }
 
 void AbstractMediaProxyModel::setFilterRating(int filterRating)
+{
+    {
+        QWriteLocker writeLocker(&mDataLock);
+
+        if (mFilterRating == filterRating) {
+            return;
+        }
+
+        mFilterRating = filterRating;
+
+        invalidate();
+    }
+
+    if (mSearchModel) {
+        mSearchModel->filterData(mFilterText, mFilterRating);
+    }
+
+    Q_EMIT filterRatingChanged(filterRating);
+}
+
+void AbstractMediaProxyModel::setSourceModel(QAbstractItemModel *sourceModel)
+{
+    if (mSearchModel) {
+        disconnect(mSearchModel, &DataModel::searchResults,
+                   this, &AbstractMediaProxyModel::searchResultsReceived);
+        disconnect(mSearchModel, &DataModel::rowsAboutToBeInserted,
+                   this, &AbstractMediaProxyModel::sourceRowsAboutToBeInserted);
+        disconnect(mSearchModel, &DataModel::entriesToEnqueue,
+                   this, &AbstractMediaProxyModel::entriesToEnqueue);
+    }
+
+    mSearchModel = qobject_cast<DataModel*>(sourceModel);
+
+    if (mSearchModel) {
+        connect(mSearchModel, &DataModel::searchResults,
+                this, &AbstractMediaProxyModel::searchResultsReceived);
+        // connected before the source model is set to be called before the new rows are filtered
+        connect(mSearchModel, &DataModel::rowsAboutToBeInserted,
+                this, &AbstractMediaProxyModel::sourceRowsAboutToBeInserted);
+        connect(mSearchModel, &DataModel::entriesToEnqueue,
+                this, &AbstractMediaProxyModel::entriesToEnqueue);
+
+        // a paged model may not be initialized yet, it will be loaded with them
+        mSearchModel->sortData(sortOrder());
+        mSearchModel->filterData(mFilterText, mFilterRating);
+    }
+
+    QSortFilterProxyModel::setSourceModel(sourceModel);
+}
+
+void AbstractMediaProxyModel::searchResultsReceived(const QString &searchText, const QVector<qulonglong> &matchingIds)
 {
     QWriteLocker writeLocker(&mDataLock);
 
-    if (mFilterRating == filterRating) {
+    // results of an older search arriving late
+    if (searchText != mFilterText) {
         return;
     }
 
-    mFilterRating = filterRating;
+    mSearchResults.clear();
+    mSearchResults.reserve(matchingIds.size());
+    for (auto oneId : matchingIds) {
+        mSearchResults.insert(oneId);
+    }
+    mHasSearchResults = true;
 
     invalidate();
+}
 
-    Q_EMIT filterRatingChanged(filterRating);
+void AbstractMediaProxyModel::sourceRowsAboutToBeInserted()
+{
+    {
+        QWriteLocker writeLocker(&mDataLock);
+
+        if (!mHasSearchResults) {
+            return;
+        }
+
+        // the new rows are not part of the search results: filter them on their text until the search is done again
+        mSearchResults.clear();
+        mHasSearchResults = false;
+    }
+
+    QMetaObject::invokeMethod(this, [this]() {
+        if (mSearchModel && !mSearchModel->isPaged() && !mFilterText.isEmpty()) {
+            mSearchModel->searchData(mFilterText);
+        }
+    }, Qt::QueuedConnection);
 }
 
 bool AbstractMediaProxyModel::sortedAscending() const
@@ -79,8 +171,31 @@ bool AbstractMediaProxyModel::sortedAscending() const
 
 void AbstractMediaProxyModel::sortModel(Qt::SortOrder order)
 {
+    if (mSearchModel) {
+        mSearchModel->sortData(order);
+    }
+
     this->sort(0, order);
     Q_EMIT sortedAscendingChanged();
 }
 
+bool AbstractMediaProxyModel::lessThan(const QModelIndex &source_left, const QModelIndex &source_right) const
+{
+    if (!isSourcePaged()) {
+        return QSortFilterProxyModel::lessThan(source_left, source_right);
+    }
+
+    // the proxy swaps the arguments when sorting in descending order
+    if (sortOrder() == Qt::AscendingOrder) {
+        return source_left.row() < source_right.row();
+    }
+
+    return source_left.row() > source_right.row();
+}
+
+bool AbstractMediaProxyModel::isSourcePaged() const
+{
+    return mSearchModel && mSearchModel->isPaged();
+}
+
 #include "moc_abstractmediaproxymodel.cpp"
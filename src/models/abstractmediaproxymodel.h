@@ -27,6 +27,11 @@
 #include <QRegularExpression>
 #include <QReadWriteLock>
 #include <QThreadPool>
+#include <QPointer>
+#include <QSet>
+#include <QVector>
+
+class DataModel;
 
 class ELISALIB_EXPORT AbstractMediaProxyModel : public QSortFilterProxyModel
 {
@@ -59,6 +64,8 @@ public:
 
     bool sortedAscending() const;
 
+    void setSourceModel(QAbstractItemModel *sourceModel) override;
+
 public Q_SLOTS:
 
     void setFilterText(const QString &filterText);
@@ -75,16 +82,43 @@ Q_SIGNALS:
 
     void sortedAscendingChanged();
 
+    void entriesToEnqueue(const ElisaUtils::EntryDataList &newEntries,
+                          ElisaUtils::PlayListEntryType databaseIdType,
+                          ElisaUtils::PlayListEnqueueMode enqueueMode,
+                          ElisaUtils::PlayListEnqueueTriggerPlay triggerPlay);
+
+private Q_SLOTS:
+
+    void searchResultsReceived(const QString &searchText, const QVector<qulonglong> &matchingIds);
+
+    void sourceRowsAboutToBeInserted();
+
 protected:
 
     bool filterAcceptsRow(int source_row, const QModelIndex &source_parent) const override = 0;
 
+    bool lessThan(const QModelIndex &source_left, const QModelIndex &source_right) const override;
+
+    /**
+     * The database sorts and filters the data of a paged source model: all its rows are
+     * accepted and kept in their order.
+     */
+    bool isSourcePaged() const;
+
     QString mFilterText;
 
     int mFilterRating = 0;
 
     QRegularExpression mFilterExpression;
 
+    // database ids matching mFilterText in the full text index of the database
+    // only valid when mHasSearchResults is true, else mFilterExpression is used
+    QSet<qulonglong> mSearchResults;
+
+    bool mHasSearchResults = false;
+
+    QPointer<DataModel> mSearchModel;
+
     QReadWriteLock mDataLock;
 
     QThreadPool mThreadPool;
@@ -17,6 +17,7 @@
 
 #include "alltracksproxymodel.h"
 
+#include "datamodel.h"
 #include "datatypes.h"
 
 #include <QReadLocker>
@@ -33,6 +34,11 @@ bool AllTracksProxyModel::filterAcceptsRow(int source_row, const QModelIndex &so
 {
     bool result = false;
 
+    if (isSourcePaged()) {
+        result = true;
+        return result;
+    }
+
     auto currentIndex = sourceModel()->index(source_row, 0, source_parent);
 
     const auto &titleValue = sourceModel()->data(currentIndex, Qt::DisplayRole).toString();
@@ -43,6 +49,11 @@ bool AllTracksProxyModel::filterAcceptsRow(int source_row, const QModelIndex &so
         return result;
     }
 
+    if (mHasSearchResults) {
+        result = mSearchResults.contains(sourceModel()->data(currentIndex, DataTypes::ColumnsRoles::DatabaseIdRole).toULongLong());
+        return result;
+    }
+
     if (mFilterExpression.match(titleValue).hasMatch()) {
         result = true;
     }
@@ -57,6 +68,12 @@ bool AllTracksProxyModel::filterAcceptsRow(int source_row, const QModelIndex &so
 void AllTracksProxyModel::genericEnqueueToPlayList(ElisaUtils::PlayListEnqueueMode enqueueMode,
                                                    ElisaUtils::PlayListEnqueueTriggerPlay triggerPlay)
 {
+    // most of the tracks of a paged model are not loaded
+    if (isSourcePaged()) {
+        mSearchModel->enqueueAllData(enqueueMode, triggerPlay);
+        return;
+    }
+
     QtConcurrent::run(&mThreadPool, [=] () {
         QReadLocker locker(&mDataLock);
         auto allTracks = ElisaUtils::EntryDataList{};
@@ -24,9 +24,11 @@
 #include <QTimer>
 #include <QPointer>
 #include <QVector>
+#include <QHash>
 #include <QDebug>
 
 #include <algorithm>
+#include <iterator>
 
 class DataModelPrivate
 {
@@ -60,6 +62,295 @@ public:
 
     bool mIsBusy = false;
 
+    // models showing a whole collection are loaded by pages sorted by title, see DataTypes::PageRequest
+    // the data of the pages not used since a while is dropped and loaded again when displayed
+    class DataPage
+    {
+    public:
+
+        QString mAfterSortKey;
+
+        qulonglong mAfterKey = 0;
+
+        bool mIsFirstPage = true;
+
+        int mFirstRow = 0;
+
+        int mRowsCount = 0;
+
+        bool mIsLoaded = true;
+
+        bool mIsLoading = false;
+
+    };
+
+    QVector<DataPage> mPages;
+
+    // indexes of the pages whose data is loaded, the most recently used last
+    QVector<int> mLoadedPages;
+
+    // answers of the database to the requests of a previous generation of pages are ignored
+    int mPagesGeneration = 0;
+
+    Qt::SortOrder mSortOrder = Qt::AscendingOrder;
+
+    QString mSearchText;
+
+    int mMinimumRating = 0;
+
+    bool mIsPaged = false;
+
+    bool mHasMoreData = false;
+
+    bool mIsFetchingPage = false;
+
+    // new entries received while a page is loaded may be missing from it
+    DataModel::ListTrackDataType mNewTracksWhileFetching;
+
+    DataModel::ListAlbumDataType mNewAlbumsWhileFetching;
+
+    DataModel::ListArtistDataType mNewArtistsWhileFetching;
+
+    // row of each displayed entry from its database id
+    QHash<qulonglong, int> mRowsFromIds;
+
+    static constexpr int mPageSize = 200;
+
+    static constexpr int mMaximumLoadedPages = 5;
+
+    DataModel::ListTrackDataType &newDataWhileFetching(const DataModel::ListTrackDataType &)
+    {
+        return mNewTracksWhileFetching;
+    }
+
+    DataModel::ListAlbumDataType &newDataWhileFetching(const DataModel::ListAlbumDataType &)
+    {
+        return mNewAlbumsWhileFetching;
+    }
+
+    DataModel::ListArtistDataType &newDataWhileFetching(const DataModel::ListArtistDataType &)
+    {
+        return mNewArtistsWhileFetching;
+    }
+
+    DataTypes::PageRequest pageRequest() const
+    {
+        auto result = DataTypes::PageRequest{};
+
+        result.mSortOrder = mSortOrder;
+        result.mSearchText = mSearchText;
+        result.mMinimumRating = mMinimumRating;
+        result.mGeneration = mPagesGeneration;
+
+        return result;
+    }
+
+    DataTypes::PageRequest pageRequest(int pageIndex) const
+    {
+        auto result = pageRequest();
+
+        const auto &onePage = mPages.at(pageIndex);
+        result.mAfterSortKey = onePage.mAfterSortKey;
+        result.mAfterKey = onePage.mAfterKey;
+        result.mIsFirstPage = onePage.mIsFirstPage;
+        result.mPageSize = onePage.mRowsCount;
+        result.mPageIndex = pageIndex;
+
+        return result;
+    }
+
+    // same comparison as the COLLATE NOCASE of SQLite: only ASCII letters are compared without case
+    static int compareSortKeys(const QString &first, const QString &second)
+    {
+        const auto foldCase = [](QChar oneChar) {
+            const auto code = oneChar.unicode();
+            return (code >= 'A' && code <= 'Z') ? static_cast<ushort>(code + ('a' - 'A')) : code;
+        };
+
+        const auto commonSize = std::min(first.size(), second.size());
+        for (int i = 0; i < commonSize; ++i) {
+            const auto firstCode = foldCase(first.at(i));
+            const auto secondCode = foldCase(second.at(i));
+            if (firstCode != secondCode) {
+                return firstCode < secondCode ? -1 : 1;
+            }
+        }
+
+        return first.size() == second.size() ? 0 : (first.size() < second.size() ? -1 : 1);
+    }
+
+    // order of the pages: by title then by database id
+    template <typename DataType>
+    bool isBefore(const DataType &first, const DataType &second) const
+    {
+        auto comparison = compareSortKeys(first.value(DataTypes::TitleRole).toString(), second.value(DataTypes::TitleRole).toString());
+        if (comparison == 0 && first.databaseId() != second.databaseId()) {
+            comparison = first.databaseId() < second.databaseId() ? -1 : 1;
+        }
+
+        return mSortOrder == Qt::AscendingOrder ? comparison < 0 : comparison > 0;
+    }
+
+    int pageFromRow(int row) const
+    {
+        auto itPage = std::upper_bound(mPages.begin(), mPages.end(), row,
+                                       [](int oneRow, const DataPage &onePage) {return oneRow < onePage.mFirstRow;});
+
+        return static_cast<int>(itPage - mPages.begin()) - 1;
+    }
+
+    void updateFirstRows(int firstPage)
+    {
+        for (int pageIndex = std::max(firstPage, 1); pageIndex < mPages.size(); ++pageIndex) {
+            mPages[pageIndex].mFirstRow = mPages[pageIndex - 1].mFirstRow + mPages[pageIndex - 1].mRowsCount;
+        }
+    }
+
+    void pagesRowsInserted(int firstRow, int count, int rowsCount)
+    {
+        if (!mIsPaged) {
+            return;
+        }
+
+        // the database has been cleared, new entries are not part of a loaded page
+        if (mPages.isEmpty()) {
+            mPages.push_back({});
+            mLoadedPages.push_back(0);
+        }
+
+        const auto pageIndex = (firstRow < rowsCount ? pageFromRow(firstRow) : mPages.size() - 1);
+        mPages[pageIndex].mRowsCount += count;
+        updateFirstRows(pageIndex + 1);
+    }
+
+    void pagesRowsRemoved(int firstRow, int lastRow)
+    {
+        if (!mIsPaged || mPages.isEmpty()) {
+            return;
+        }
+
+        const auto firstPage = pageFromRow(firstRow);
+        for (int pageIndex = firstPage; pageIndex < mPages.size() && mPages[pageIndex].mFirstRow <= lastRow; ++pageIndex) {
+            auto &onePage = mPages[pageIndex];
+            const auto removedCount = std::min(lastRow, onePage.mFirstRow + onePage.mRowsCount - 1) -
+                    std::max(firstRow, onePage.mFirstRow) + 1;
+            onePage.mRowsCount -= std::max(removedCount, 0);
+        }
+
+        updateFirstRows(firstPage + 1);
+    }
+
+    void touchPage(int pageIndex)
+    {
+        if (!mLoadedPages.isEmpty() && mLoadedPages.constLast() == pageIndex) {
+            return;
+        }
+
+        mLoadedPages.removeOne(pageIndex);
+        mLoadedPages.push_back(pageIndex);
+    }
+
+    // only the id and the title used to sort them are kept for the entries of the pages not used since a while
+    template <typename DataListType>
+    void evictPages(DataListType &allData)
+    {
+        while (mLoadedPages.size() > mMaximumLoadedPages) {
+            auto &onePage = mPages[mLoadedPages.takeFirst()];
+
+            for (int row = onePage.mFirstRow; row < onePage.mFirstRow + onePage.mRowsCount; ++row) {
+                auto &oneData = allData[row];
+
+                auto evictedData = typename DataListType::value_type{};
+                evictedData[DataTypes::DatabaseIdRole] = oneData.databaseId();
+                evictedData[DataTypes::TitleRole] = oneData.value(DataTypes::TitleRole);
+
+                oneData = evictedData;
+            }
+
+            onePage.mIsLoaded = false;
+        }
+    }
+
+    void clearPages()
+    {
+        mPages.clear();
+        mLoadedPages.clear();
+        mNewTracksWhileFetching.clear();
+        mNewAlbumsWhileFetching.clear();
+        mNewArtistsWhileFetching.clear();
+        mHasMoreData = false;
+        mIsFetchingPage = false;
+        ++mPagesGeneration;
+    }
+
+    // the database filters the pages, new entries are filtered here the same way with the data they hold
+    template <typename DataListType>
+    void filterNewData(DataListType &newData) const
+    {
+        const auto searchTerms = mSearchText.simplified().split(QLatin1Char(' '));
+        const auto hasSearchTerms = !searchTerms.constFirst().isEmpty();
+
+        if (!hasSearchTerms && mMinimumRating == 0) {
+            return;
+        }
+
+        const auto ratingRole = (mModelType == ElisaUtils::Album ? DataTypes::HighestTrackRating : DataTypes::RatingRole);
+
+        auto newEnd = std::remove_if(newData.begin(), newData.end(), [&](const auto &oneData) {
+            // artists have no rating
+            if (mModelType != ElisaUtils::Artist && oneData.value(ratingRole).toInt() < mMinimumRating) {
+                return true;
+            }
+
+            if (!hasSearchTerms) {
+                return false;
+            }
+
+            auto searchedText = QStringList{oneData.value(DataTypes::TitleRole).toString(),
+                    oneData.value(DataTypes::ArtistRole).toString(), oneData.value(DataTypes::AlbumRole).toString()};
+            searchedText.append(oneData.value(DataTypes::AllArtistsRole).toStringList());
+
+            const auto allSearchedText = searchedText.join(QLatin1Char(' '));
+            for (const auto &oneTerm : searchTerms) {
+                if (!allSearchedText.contains(oneTerm, Qt::CaseInsensitive)) {
+                    return true;
+                }
+            }
+
+            return false;
+        });
+        newData.erase(newEnd, newData.end());
+    }
+
+    // rows from firstRow have been inserted or have moved
+    template <typename DataListType>
+    void indexRows(const DataListType &allData, int firstRow)
+    {
+        for (int row = firstRow; row < allData.size(); ++row) {
+            mRowsFromIds[allData.at(row).databaseId()] = row;
+        }
+    }
+
+    // to be called before removing rows from firstRow to lastRow, rows after them need to be indexed again once removed
+    template <typename DataListType>
+    void unindexRows(const DataListType &allData, int firstRow, int lastRow)
+    {
+        for (int row = firstRow; row <= lastRow; ++row) {
+            mRowsFromIds.remove(allData.at(row).databaseId());
+        }
+
+        pagesRowsRemoved(firstRow, lastRow);
+    }
+
+    // an entry already displayed is not inserted a second time
+    template <typename DataListType>
+    void filterKnownData(DataListType &newData) const
+    {
+        auto newEnd = std::remove_if(newData.begin(), newData.end(),
+                                     [this](const auto &oneData) {return mRowsFromIds.contains(oneData.databaseId());});
+        newData.erase(newEnd, newData.end());
+    }
+
 };
 
 DataModel::DataModel(QObject *parent) : QAbstractListModel(parent), d(std::make_unique<DataModelPrivate>())
@@ -137,13 +428,30 @@ QVariant DataModel::data(const QModelIndex &index, int role) const
     Q_ASSERT(index.internalId() == 0);
     Q_ASSERT(index.row() >= 0 && index.row() < dataCount);
 
+    if (d->mIsPaged && !d->mPages.isEmpty()) {
+        const auto pageIndex = d->pageFromRow(index.row());
+        auto &onePage = d->mPages[pageIndex];
+
+        if (onePage.mIsLoaded) {
+            d->touchPage(pageIndex);
+        } else if (!onePage.mIsLoading) {
+            // the view is not notified while it is reading the model
+            onePage.mIsLoading = true;
+
+            auto model = const_cast<DataModel*>(this);
+            const auto pagesGeneration = d->mPagesGeneration;
+            QMetaObject::invokeMethod(model, [model, pageIndex, pagesGeneration]() {model->requestPage(pageIndex, pagesGeneration);},
+                                      Qt::QueuedConnection);
+        }
+    }
+
     switch(role)
     {
     case Qt::DisplayRole:
         switch(d->mModelType)
         {
         case ElisaUtils::Track:
-            result = d->mAllTrackData[index.row()][TrackDataType::key_type::TitleRole];
+            result = d->mAllTrackData.at(index.row()).roleData(TrackDataType::key_type::TitleRole);
             break;
         case ElisaUtils::Album:
             result = d->mAllAlbumData[index.row()][AlbumDataType::key_type::TitleRole];
@@ -155,7 +463,7 @@ QVariant DataModel::data(const QModelIndex &index, int role) const
             result = d->mAllGenreData[index.row()][GenreDataType::key_type::TitleRole];
             break;
         case ElisaUtils::Radio:
-            result = d->mAllRadiosData[index.row()][GenreDataType::key_type::TitleRole];
+            result = d->mAllRadiosData.at(index.row()).roleData(TrackDataType::key_type::TitleRole);
             break;
         case ElisaUtils::Lyricist:
         case ElisaUtils::Composer:
@@ -170,7 +478,7 @@ QVariant DataModel::data(const QModelIndex &index, int role) const
         {
         case ElisaUtils::Track:
         {
-            auto trackDuration = d->mAllTrackData[index.row()][TrackDataType::key_type::DurationRole].toTime();
+            auto trackDuration = d->mAllTrackData.at(index.row()).duration();
             if (trackDuration.hour() == 0) {
                 result = trackDuration.toString(QStringLiteral("mm:ss"));
             } else {
@@ -195,7 +503,7 @@ QVariant DataModel::data(const QModelIndex &index, int role) const
         switch (d->mModelType)
         {
         case ElisaUtils::Track:
-            result = d->mAllTrackData[index.row()][TrackDataType::key_type::IsSingleDiscAlbumRole];
+            result = d->mAllTrackData.at(index.row()).roleData(TrackDataType::key_type::IsSingleDiscAlbumRole);
             break;
         case ElisaUtils::Radio:
             result = false;
@@ -217,7 +525,7 @@ QVariant DataModel::data(const QModelIndex &index, int role) const
         switch(d->mModelType)
         {
         case ElisaUtils::Track:
-            result = d->mAllTrackData[index.row()][static_cast<TrackDataType::key_type>(role)];
+            result = d->mAllTrackData.at(index.row()).roleData(role);
             break;
         case ElisaUtils::Album:
             result = d->mAllAlbumData[index.row()][static_cast<AlbumDataType::key_type>(role)];
@@ -229,7 +537,7 @@ QVariant DataModel::data(const QModelIndex &index, int role) const
             result = d->mAllGenreData[index.row()][static_cast<GenreDataType::key_type>(role)];
             break;
         case ElisaUtils::Radio:
-            result = d->mAllRadiosData[index.row()][static_cast<TrackDataType::key_type>(role)];
+            result = d->mAllRadiosData.at(index.row()).roleData(role);
             break;
         case ElisaUtils::Lyricist:
         case ElisaUtils::Composer:
@@ -268,6 +576,64 @@ QModelIndex DataModel::parent(const QModelIndex &child) const
     return result;
 }
 
+bool DataModel::canFetchMore(const QModelIndex &parent) const
+{
+    if (parent.isValid()) {
+        return false;
+    }
+
+    return d->mIsPaged && d->mHasMoreData && !d->mIsFetchingPage;
+}
+
+void DataModel::fetchMore(const QModelIndex &parent)
+{
+    if (!canFetchMore(parent)) {
+        return;
+    }
+
+    d->mIsFetchingPage = true;
+
+    auto request = d->pageRequest();
+    request.mPageSize = DataModelPrivate::mPageSize;
+    request.mPageIndex = d->mPages.size();
+
+    // the next page starts after the last entry, its data may have been dropped but not its title
+    auto lastEntry = QVariantList{};
+    switch (d->mModelType)
+    {
+    case ElisaUtils::Track:
+        if (!d->mAllTrackData.isEmpty()) {
+            lastEntry = {d->mAllTrackData.constLast().title(), d->mAllTrackData.constLast().databaseId()};
+        }
+        break;
+    case ElisaUtils::Album:
+        if (!d->mAllAlbumData.isEmpty()) {
+            lastEntry = {d->mAllAlbumData.constLast().title(), d->mAllAlbumData.constLast().databaseId()};
+        }
+        break;
+    case ElisaUtils::Artist:
+        if (!d->mAllArtistData.isEmpty()) {
+            lastEntry = {d->mAllArtistData.constLast().value(DataTypes::TitleRole), d->mAllArtistData.constLast().databaseId()};
+        }
+        break;
+    case ElisaUtils::Genre:
+    case ElisaUtils::Lyricist:
+    case ElisaUtils::Composer:
+    case ElisaUtils::FileName:
+    case ElisaUtils::Radio:
+    case ElisaUtils::Unknown:
+        break;
+    }
+
+    if (!lastEntry.isEmpty()) {
+        request.mIsFirstPage = false;
+        request.mAfterSortKey = lastEntry.at(0).toString();
+        request.mAfterKey = lastEntry.at(1).toULongLong();
+    }
+
+    Q_EMIT needDataPage(d->mModelType, request);
+}
+
 QString DataModel::title() const
 {
     return d->mAlbumTitle;
@@ -283,6 +649,11 @@ bool DataModel::isBusy() const
     return d->mIsBusy;
 }
 
+bool DataModel::isPaged() const
+{
+    return d->mIsPaged;
+}
+
 void DataModel::initialize(MusicListenersManager *manager, DatabaseInterface *database,
                            ElisaUtils::PlayListEntryType modelType, ElisaUtils::FilterType filter,
                            const QString &genre, const QString &artist, qulonglong databaseId)
@@ -294,6 +665,73 @@ void DataModel::initialize(MusicListenersManager *manager, DatabaseInterface *da
     initializeModel(manager, database, modelType, filter);
 }
 
+void DataModel::searchData(const QString &searchText)
+{
+    Q_EMIT needSearchData(d->mModelType, searchText);
+}
+
+void DataModel::sortData(Qt::SortOrder sortOrder)
+{
+    if (d->mSortOrder == sortOrder) {
+        return;
+    }
+
+    d->mSortOrder = sortOrder;
+
+    reloadPages();
+}
+
+void DataModel::filterData(const QString &searchText, int minimumRating)
+{
+    if (d->mSearchText == searchText && d->mMinimumRating == minimumRating) {
+        return;
+    }
+
+    d->mSearchText = searchText;
+    d->mMinimumRating = minimumRating;
+
+    reloadPages();
+}
+
+void DataModel::enqueueAllData(ElisaUtils::PlayListEnqueueMode enqueueMode,
+                               ElisaUtils::PlayListEnqueueTriggerPlay triggerPlay)
+{
+    if (!d->mIsPaged) {
+        return;
+    }
+
+    Q_EMIT needAllEntriesOfPages(d->mModelType, d->pageRequest(), enqueueMode, triggerPlay);
+}
+
+void DataModel::reloadPages()
+{
+    if (!d->mIsPaged) {
+        return;
+    }
+
+    beginResetModel();
+    d->mAllTrackData.clear();
+    d->mAllAlbumData.clear();
+    d->mAllArtistData.clear();
+    d->mRowsFromIds.clear();
+    d->clearPages();
+    endResetModel();
+
+    setBusy(true);
+
+    d->mHasMoreData = true;
+    fetchMore({});
+}
+
+void DataModel::requestPage(int pageIndex, int pagesGeneration)
+{
+    if (pagesGeneration != d->mPagesGeneration || pageIndex >= d->mPages.size()) {
+        return;
+    }
+
+    Q_EMIT needDataPage(d->mModelType, d->pageRequest(pageIndex));
+}
+
 void DataModel::setBusy(bool value)
 {
     if (d->mIsBusy == value) {
@@ -322,11 +760,21 @@ void DataModel::initializeModel(MusicListenersManager *manager, DatabaseInterfac
         return;
     }
 
+    d->mIsPaged = (d->mFilterType == ElisaUtils::NoFilter &&
+                   (d->mModelType == ElisaUtils::Track || d->mModelType == ElisaUtils::Album || d->mModelType == ElisaUtils::Artist));
+
     switch(d->mFilterType)
     {
     case ElisaUtils::NoFilter:
-        connect(this, &DataModel::needData,
-                d->mDataLoader, &ModelDataLoader::loadData);
+        if (d->mIsPaged) {
+            connect(this, &DataModel::needDataPage,
+                    d->mDataLoader, &ModelDataLoader::loadDataPage);
+            connect(this, &DataModel::needAllEntriesOfPages,
+                    d->mDataLoader, &ModelDataLoader::loadAllEntriesOfPages);
+        } else {
+            connect(this, &DataModel::needData,
+                    d->mDataLoader, &ModelDataLoader::loadData);
+        }
         break;
     case ElisaUtils::FilterById:
         connect(this, &DataModel::needDataById,
@@ -356,6 +804,9 @@ void DataModel::initializeModel(MusicListenersManager *manager, DatabaseInterfac
         break;
     }
 
+    connect(this, &DataModel::needSearchData,
+            d->mDataLoader, &ModelDataLoader::searchData);
+
     setBusy(true);
 
     askModelData();
@@ -366,7 +817,13 @@ void DataModel::askModelData()
     switch(d->mFilterType)
     {
     case ElisaUtils::NoFilter:
-        Q_EMIT needData(d->mModelType);
+        if (d->mIsPaged) {
+            d->clearPages();
+            d->mHasMoreData = true;
+            fetchMore({});
+        } else {
+            Q_EMIT needData(d->mModelType);
+        }
         break;
     case ElisaUtils::FilterById:
         Q_EMIT needDataById(d->mModelType, d->mDatabaseId);
@@ -393,18 +850,7 @@ void DataModel::askModelData()
 
 int DataModel::indexFromId(qulonglong id) const
 {
-    int result;
-    DataModel::ListTrackDataType mAllData = d->mModelType == ElisaUtils::Radio ? d->mAllRadiosData: d->mAllTrackData;
-
-    for (result = 0; result < mAllData.size(); ++result) {
-        if (mAllData[result].databaseId() == id) {
-            return result;
-        }
-    }
-
-    result = -1;
-
-    return result;
+    return d->mRowsFromIds.value(id, -1);
 }
 
 void DataModel::connectModel(DatabaseInterface *database)
@@ -425,16 +871,12 @@ void DataModel::connectModel(DatabaseInterface *database)
             this, &DataModel::genresAdded);
     connect(d->mDataLoader, &ModelDataLoader::albumsAdded,
             this, &DataModel::albumsAdded);
-    connect(d->mDataLoader, &ModelDataLoader::albumModified,
-            this, &DataModel::albumModified);
     connect(d->mDataLoader, &ModelDataLoader::albumRemoved,
             this, &DataModel::albumRemoved);
     connect(d->mDataLoader, &ModelDataLoader::tracksAdded,
             this, &DataModel::tracksAdded);
-    connect(d->mDataLoader, &ModelDataLoader::trackModified,
-            this, &DataModel::trackModified);
-    connect(d->mDataLoader, &ModelDataLoader::trackRemoved,
-            this, &DataModel::trackRemoved);
+    connect(d->mDataLoader, &ModelDataLoader::tracksChanged,
+            this, &DataModel::tracksChanged);
     connect(d->mDataLoader, &ModelDataLoader::artistsAdded,
             this, &DataModel::artistsAdded);
     connect(d->mDataLoader, &ModelDataLoader::artistRemoved,
@@ -447,9 +889,38 @@ void DataModel::connectModel(DatabaseInterface *database)
             this, &DataModel::radioRemoved);
     connect(d->mDataLoader, &ModelDataLoader::clearedDatabase,
             this, &DataModel::cleanedDatabase);
+    connect(d->mDataLoader, &ModelDataLoader::searchResults,
+            this, &DataModel::searchResults);
+    connect(d->mDataLoader, &ModelDataLoader::tracksDataPage,
+            this, &DataModel::tracksPageAdded);
+    connect(d->mDataLoader, &ModelDataLoader::albumsDataPage,
+            this, &DataModel::albumsPageAdded);
+    connect(d->mDataLoader, &ModelDataLoader::artistsDataPage,
+            this, &DataModel::artistsPageAdded);
+    connect(d->mDataLoader, &ModelDataLoader::entriesToEnqueue,
+            this, &DataModel::entriesToEnqueue);
 }
 
 void DataModel::tracksAdded(ListTrackDataType newData)
+{
+    if (d->mIsPaged && d->mModelType == ElisaUtils::Track) {
+        insertSortedData(d->mAllTrackData, newData);
+        return;
+    }
+
+    addTracks(newData);
+}
+
+void DataModel::tracksPageAdded(const ListTrackDataType &pageData, const DataTypes::PageRequest &request)
+{
+    if (d->mModelType != ElisaUtils::Track) {
+        return;
+    }
+
+    pageLoaded(d->mAllTrackData, pageData, request);
+}
+
+void DataModel::addTracks(ListTrackDataType newData)
 {
     if (newData.isEmpty() && d->mModelType == ElisaUtils::Track) {
         setBusy(false);
@@ -474,6 +945,7 @@ void DataModel::tracksAdded(ListTrackDataType newData)
                 if (oneTrack.discNumber() >= newTrack.discNumber() && oneTrack.trackNumber() > newTrack.trackNumber()) {
                     beginInsertRows({}, trackIndex, trackIndex);
                     d->mAllTrackData.insert(trackIndex, newTrack);
+                    d->indexRows(d->mAllTrackData, trackIndex);
                     endInsertRows();
 
                     if (d->mAllTrackData.size() == 1) {
@@ -488,6 +960,7 @@ void DataModel::tracksAdded(ListTrackDataType newData)
             if (!trackInserted) {
                 beginInsertRows({}, d->mAllTrackData.count(), d->mAllTrackData.count());
                 d->mAllTrackData.insert(d->mAllTrackData.count(), newTrack);
+                d->indexRows(d->mAllTrackData, d->mAllTrackData.count() - 1);
                 endInsertRows();
 
                 if (d->mAllTrackData.size() == 1) {
@@ -496,15 +969,24 @@ void DataModel::tracksAdded(ListTrackDataType newData)
             }
         }
     } else {
+        d->filterKnownData(newData);
+
+        if (newData.isEmpty()) {
+            return;
+        }
+
         if (d->mAllTrackData.isEmpty()) {
             beginInsertRows({}, 0, newData.size() - 1);
             d->mAllTrackData.swap(newData);
+            d->indexRows(d->mAllTrackData, 0);
             endInsertRows();
 
             setBusy(false);
         } else {
-            beginInsertRows({}, d->mAllTrackData.size(), d->mAllTrackData.size() + newData.size() - 1);
+            const auto firstNewRow = d->mAllTrackData.size();
+            beginInsertRows({}, firstNewRow, firstNewRow + newData.size() - 1);
             d->mAllTrackData.append(newData);
+            d->indexRows(d->mAllTrackData, firstNewRow);
             endInsertRows();
         }
     }
@@ -535,6 +1017,7 @@ void DataModel::radiosAdded(ListRadioDataType newData)
                 if (oneTrack.trackNumber() > newTrack.trackNumber()) {
                     beginInsertRows({}, trackIndex, trackIndex);
                     d->mAllRadiosData.insert(trackIndex, newTrack);
+                    d->indexRows(d->mAllRadiosData, trackIndex);
                     endInsertRows();
 
                     if (d->mAllRadiosData.size() == 1) {
@@ -549,6 +1032,7 @@ void DataModel::radiosAdded(ListRadioDataType newData)
             if (!trackInserted) {
                 beginInsertRows({}, d->mAllRadiosData.count(), d->mAllRadiosData.count());
                 d->mAllRadiosData.insert(d->mAllRadiosData.count(), newTrack);
+                d->indexRows(d->mAllRadiosData, d->mAllRadiosData.count() - 1);
                 endInsertRows();
 
                 if (d->mAllRadiosData.size() == 1) {
@@ -557,15 +1041,24 @@ void DataModel::radiosAdded(ListRadioDataType newData)
             }
         }
     } else {
+        d->filterKnownData(newData);
+
+        if (newData.isEmpty()) {
+            return;
+        }
+
         if (d->mAllRadiosData.isEmpty()) {
             beginInsertRows({}, 0, newData.size() - 1);
             d->mAllRadiosData.swap(newData);
+            d->indexRows(d->mAllRadiosData, 0);
             endInsertRows();
 
             setBusy(false);
         } else {
-            beginInsertRows({}, d->mAllRadiosData.size(), d->mAllRadiosData.size() + newData.size() - 1);
+            const auto firstNewRow = d->mAllRadiosData.size();
+            beginInsertRows({}, firstNewRow, firstNewRow + newData.size() - 1);
             d->mAllRadiosData.append(newData);
+            d->indexRows(d->mAllRadiosData, firstNewRow);
             endInsertRows();
         }
     }
@@ -581,31 +1074,16 @@ void DataModel::trackModified(const TrackDataType &modifiedTrack)
         if (modifiedTrack.album() != d->mAlbumTitle) {
             return;
         }
+    }
 
-        auto trackIndex = indexFromId(modifiedTrack.databaseId());
-
-        if (trackIndex == -1) {
-            return;
-        }
-
-        d->mAllTrackData[trackIndex] = modifiedTrack;
-        Q_EMIT dataChanged(index(trackIndex, 0), index(trackIndex, 0));
-    } else {
-        auto itTrack = std::find_if(d->mAllTrackData.begin(), d->mAllTrackData.end(),
-                                    [modifiedTrack](auto track) {
-            return track.databaseId() == modifiedTrack.databaseId();
-        });
-
-        if (itTrack == d->mAllTrackData.end()) {
-            return;
-        }
-
-        auto position = itTrack - d->mAllTrackData.begin();
-
-        d->mAllTrackData[position] = modifiedTrack;
+    auto trackIndex = indexFromId(modifiedTrack.databaseId());
 
-        Q_EMIT dataChanged(index(position, 0), index(position, 0));
+    if (trackIndex == -1) {
+        return;
     }
+
+    d->mAllTrackData[trackIndex] = modifiedTrack;
+    Q_EMIT dataChanged(index(trackIndex, 0), index(trackIndex, 0));
 }
 
 void DataModel::radioModified(const TrackDataType &modifiedRadio)
@@ -630,29 +1108,124 @@ void DataModel::trackRemoved(qulonglong removedTrackId)
         return;
     }
 
-    if (!d->mAlbumTitle.isEmpty() && !d->mAlbumArtist.isEmpty()) {
-        auto trackIndex = indexFromId(removedTrackId);
+    auto trackIndex = indexFromId(removedTrackId);
+
+    if (trackIndex == -1) {
+        return;
+    }
 
+    beginRemoveRows({}, trackIndex, trackIndex);
+    d->unindexRows(d->mAllTrackData, trackIndex, trackIndex);
+    d->mAllTrackData.removeAt(trackIndex);
+    d->indexRows(d->mAllTrackData, trackIndex);
+    endRemoveRows();
+}
+
+void DataModel::tracksChanged(const TracksChangeSet &changes)
+{
+    if (d->mModelType == ElisaUtils::Album) {
+        auto modifiedRows = QVector<int>{};
+
+        for (auto oneAlbumId : changes.mModifiedAlbumIds) {
+            const auto albumIndex = indexFromId(oneAlbumId);
+            if (albumIndex != -1) {
+                modifiedRows.push_back(albumIndex);
+            }
+        }
+
+        notifyRowsChanged(modifiedRows, {});
+
+        return;
+    }
+
+    if (d->mModelType != ElisaUtils::Track) {
+        return;
+    }
+
+    // new tracks are received through tracksAdded, with their complete data
+    if (!changes.mRemovedTrackIds.isEmpty()) {
+        auto removedRows = QVector<int>{};
+
+        for (auto oneTrackId : changes.mRemovedTrackIds) {
+            const auto trackIndex = indexFromId(oneTrackId);
+            if (trackIndex != -1) {
+                removedRows.push_back(trackIndex);
+            }
+        }
+
+        std::sort(removedRows.begin(), removedRows.end());
+        removedRows.erase(std::unique(removedRows.begin(), removedRows.end()), removedRows.end());
+
+        // remove contiguous blocks from the end so that the remaining rows keep their position
+        for (auto lastRow = removedRows.size() - 1; lastRow >= 0;) {
+            auto firstRow = lastRow;
+            while (firstRow > 0 && removedRows[firstRow - 1] == removedRows[firstRow] - 1) {
+                --firstRow;
+            }
+
+            beginRemoveRows({}, removedRows[firstRow], removedRows[lastRow]);
+            d->unindexRows(d->mAllTrackData, removedRows[firstRow], removedRows[lastRow]);
+            d->mAllTrackData.erase(d->mAllTrackData.begin() + removedRows[firstRow],
+                                   d->mAllTrackData.begin() + removedRows[lastRow] + 1);
+            endRemoveRows();
+
+            lastRow = firstRow - 1;
+        }
+
+        // rows after the first removed one have moved, they are indexed once for all the blocks
+        if (!removedRows.isEmpty()) {
+            d->indexRows(d->mAllTrackData, removedRows.constFirst());
+        }
+    }
+
+    if (changes.mModifiedTracks.isEmpty() && changes.mTracksChanges.isEmpty()) {
+        return;
+    }
+
+    const auto isAlbumModel = !d->mAlbumTitle.isEmpty() && !d->mAlbumArtist.isEmpty();
+    auto modifiedRows = QVector<int>{};
+
+    for (const auto &oneModifiedTrack : changes.mModifiedTracks) {
+        if (isAlbumModel && oneModifiedTrack.album() != d->mAlbumTitle) {
+            continue;
+        }
+
+        const auto trackIndex = indexFromId(oneModifiedTrack.databaseId());
         if (trackIndex == -1) {
-            return;
+            continue;
         }
 
-        beginRemoveRows({}, trackIndex, trackIndex);
-        d->mAllTrackData.removeAt(trackIndex);
-        endRemoveRows();
-    } else {
-        auto itTrack = std::find_if(d->mAllTrackData.begin(), d->mAllTrackData.end(),
-                                    [removedTrackId](auto track) {return track.databaseId() == removedTrackId;});
+        d->mAllTrackData[trackIndex] = oneModifiedTrack;
+        modifiedRows.push_back(trackIndex);
+    }
 
-        if (itTrack == d->mAllTrackData.end()) {
-            return;
+    for (const auto &oneChange : changes.mTracksChanges) {
+        const auto trackIndex = indexFromId(oneChange.databaseId());
+        if (trackIndex == -1) {
+            continue;
         }
 
-        auto position = itTrack - d->mAllTrackData.begin();
+        d->mAllTrackData[trackIndex].applyChanges(oneChange);
+        modifiedRows.push_back(trackIndex);
+    }
+
+    notifyRowsChanged(modifiedRows, changes.changedRoles());
+}
+
+void DataModel::notifyRowsChanged(QVector<int> rows, const QVector<int> &roles)
+{
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
 
-        beginRemoveRows({}, position, position);
-        d->mAllTrackData.erase(itTrack);
-        endRemoveRows();
+    for (auto firstRow = 0; firstRow < rows.size();) {
+        auto lastRow = firstRow;
+        while (lastRow + 1 < rows.size() && rows[lastRow + 1] == rows[lastRow] + 1) {
+            ++lastRow;
+        }
+
+        Q_EMIT dataChanged(index(rows[firstRow], 0), index(rows[lastRow], 0), roles);
+
+        firstRow = lastRow + 1;
     }
 }
 
@@ -662,18 +1235,16 @@ void DataModel::radioRemoved(qulonglong removedRadioId)
         return;
     }
 
+    auto position = indexFromId(removedRadioId);
 
-    auto itRadio = std::find_if(d->mAllRadiosData.begin(), d->mAllRadiosData.end(),
-                                [removedRadioId](auto track) {return track.databaseId() == removedRadioId;});
-
-    if (itRadio == d->mAllRadiosData.end()) {
+    if (position == -1) {
         return;
     }
 
-    auto position = itRadio - d->mAllRadiosData.begin();
-
     beginRemoveRows({}, position, position);
-    d->mAllRadiosData.erase(itRadio);
+    d->unindexRows(d->mAllRadiosData, position, position);
+    d->mAllRadiosData.removeAt(position);
+    d->indexRows(d->mAllRadiosData, position);
     endRemoveRows();
 }
 
@@ -696,6 +1267,7 @@ void DataModel::removeRadios()
 
     beginRemoveRows({}, 0, d->mAllRadiosData.size());
     d->mAllRadiosData.clear();
+    d->mRowsFromIds.clear();
     endRemoveRows();
 }
 
@@ -709,20 +1281,48 @@ void DataModel::genresAdded(DataModel::ListGenreDataType newData)
         return;
     }
 
+    d->filterKnownData(newData);
+
+    if (newData.isEmpty()) {
+        return;
+    }
+
     if (d->mAllGenreData.isEmpty()) {
         beginInsertRows({}, d->mAllGenreData.size(), newData.size() - 1);
         d->mAllGenreData.swap(newData);
+        d->indexRows(d->mAllGenreData, 0);
         endInsertRows();
 
         setBusy(false);
     } else {
-        beginInsertRows({}, d->mAllGenreData.size(), d->mAllGenreData.size() + newData.size() - 1);
+        const auto firstNewRow = d->mAllGenreData.size();
+        beginInsertRows({}, firstNewRow, firstNewRow + newData.size() - 1);
         d->mAllGenreData.append(newData);
+        d->indexRows(d->mAllGenreData, firstNewRow);
         endInsertRows();
     }
 }
 
 void DataModel::artistsAdded(DataModel::ListArtistDataType newData)
+{
+    if (d->mIsPaged && d->mModelType == ElisaUtils::Artist) {
+        insertSortedData(d->mAllArtistData, newData);
+        return;
+    }
+
+    addArtists(newData);
+}
+
+void DataModel::artistsPageAdded(const DataModel::ListArtistDataType &pageData, const DataTypes::PageRequest &request)
+{
+    if (d->mModelType != ElisaUtils::Artist) {
+        return;
+    }
+
+    pageLoaded(d->mAllArtistData, pageData, request);
+}
+
+void DataModel::addArtists(DataModel::ListArtistDataType newData)
 {
     if (newData.isEmpty() && d->mModelType == ElisaUtils::Artist) {
         setBusy(false);
@@ -732,15 +1332,24 @@ void DataModel::artistsAdded(DataModel::ListArtistDataType newData)
         return;
     }
 
+    d->filterKnownData(newData);
+
+    if (newData.isEmpty()) {
+        return;
+    }
+
     if (d->mAllArtistData.isEmpty()) {
         beginInsertRows({}, d->mAllArtistData.size(), newData.size() - 1);
         d->mAllArtistData.swap(newData);
+        d->indexRows(d->mAllArtistData, 0);
         endInsertRows();
 
         setBusy(false);
     } else {
-        beginInsertRows({}, d->mAllArtistData.size(), d->mAllArtistData.size() + newData.size() - 1);
+        const auto firstNewRow = d->mAllArtistData.size();
+        beginInsertRows({}, firstNewRow, firstNewRow + newData.size() - 1);
         d->mAllArtistData.append(newData);
+        d->indexRows(d->mAllArtistData, firstNewRow);
         endInsertRows();
     }
 }
@@ -751,25 +1360,41 @@ void DataModel::artistRemoved(qulonglong removedDatabaseId)
         return;
     }
 
-    auto removedDataIterator = d->mAllArtistData.end();
+    auto dataIndex = indexFromId(removedDatabaseId);
 
-    removedDataIterator = std::find_if(d->mAllArtistData.begin(), d->mAllArtistData.end(),
-                                       [removedDatabaseId](auto album) {return album.databaseId() == removedDatabaseId;});
-
-    if (removedDataIterator == d->mAllArtistData.end()) {
+    if (dataIndex == -1) {
         return;
     }
 
-    int dataIndex = removedDataIterator - d->mAllArtistData.begin();
-
     beginRemoveRows({}, dataIndex, dataIndex);
 
-    d->mAllArtistData.erase(removedDataIterator);
+    d->unindexRows(d->mAllArtistData, dataIndex, dataIndex);
+    d->mAllArtistData.removeAt(dataIndex);
+    d->indexRows(d->mAllArtistData, dataIndex);
 
     endRemoveRows();
 }
 
 void DataModel::albumsAdded(DataModel::ListAlbumDataType newData)
+{
+    if (d->mIsPaged && d->mModelType == ElisaUtils::Album) {
+        insertSortedData(d->mAllAlbumData, newData);
+        return;
+    }
+
+    addAlbums(newData);
+}
+
+void DataModel::albumsPageAdded(const DataModel::ListAlbumDataType &pageData, const DataTypes::PageRequest &request)
+{
+    if (d->mModelType != ElisaUtils::Album) {
+        return;
+    }
+
+    pageLoaded(d->mAllAlbumData, pageData, request);
+}
+
+void DataModel::addAlbums(DataModel::ListAlbumDataType newData)
 {
     if (newData.isEmpty() && d->mModelType == ElisaUtils::Album) {
         setBusy(false);
@@ -779,15 +1404,24 @@ void DataModel::albumsAdded(DataModel::ListAlbumDataType newData)
         return;
     }
 
+    d->filterKnownData(newData);
+
+    if (newData.isEmpty()) {
+        return;
+    }
+
     if (d->mAllAlbumData.isEmpty()) {
         beginInsertRows({}, d->mAllAlbumData.size(), newData.size() - 1);
         d->mAllAlbumData.swap(newData);
+        d->indexRows(d->mAllAlbumData, 0);
         endInsertRows();
 
         setBusy(false);
     } else {
-        beginInsertRows({}, d->mAllAlbumData.size(), d->mAllAlbumData.size() + newData.size() - 1);
+        const auto firstNewRow = d->mAllAlbumData.size();
+        beginInsertRows({}, firstNewRow, firstNewRow + newData.size() - 1);
         d->mAllAlbumData.append(newData);
+        d->indexRows(d->mAllAlbumData, firstNewRow);
         endInsertRows();
     }
 }
@@ -798,20 +1432,17 @@ void DataModel::albumRemoved(qulonglong removedDatabaseId)
         return;
     }
 
-    auto removedDataIterator = d->mAllAlbumData.end();
+    auto dataIndex = indexFromId(removedDatabaseId);
 
-    removedDataIterator = std::find_if(d->mAllAlbumData.begin(), d->mAllAlbumData.end(),
-                                       [removedDatabaseId](auto album) {return album.databaseId() == removedDatabaseId;});
-
-    if (removedDataIterator == d->mAllAlbumData.end()) {
+    if (dataIndex == -1) {
         return;
     }
 
-    int dataIndex = removedDataIterator - d->mAllAlbumData.begin();
-
     beginRemoveRows({}, dataIndex, dataIndex);
 
-    d->mAllAlbumData.erase(removedDataIterator);
+    d->unindexRows(d->mAllAlbumData, dataIndex, dataIndex);
+    d->mAllAlbumData.removeAt(dataIndex);
+    d->indexRows(d->mAllAlbumData, dataIndex);
 
     endRemoveRows();
 }
@@ -822,17 +1453,12 @@ void DataModel::albumModified(const DataModel::AlbumDataType &modifiedAlbum)
         return;
     }
 
-    auto modifiedAlbumIterator = std::find_if(d->mAllAlbumData.begin(), d->mAllAlbumData.end(),
-                                              [modifiedAlbum](auto album) {
-        return album.databaseId() == modifiedAlbum.databaseId();
-    });
+    auto albumIndex = indexFromId(modifiedAlbum.databaseId());
 
-    if (modifiedAlbumIterator == d->mAllAlbumData.end()) {
+    if (albumIndex == -1) {
         return;
     }
 
-    auto albumIndex = modifiedAlbumIterator - d->mAllAlbumData.begin();
-
     Q_EMIT dataChanged(index(albumIndex, 0), index(albumIndex, 0));
 }
 
@@ -843,7 +1469,147 @@ void DataModel::cleanedDatabase()
     d->mAllGenreData.clear();
     d->mAllTrackData.clear();
     d->mAllArtistData.clear();
+    d->mRowsFromIds.clear();
+    d->clearPages();
     endResetModel();
 }
 
+template <typename DataListType>
+void DataModel::pageLoaded(DataListType &allData, DataListType pageData, const DataTypes::PageRequest &request)
+{
+    // a page asked before the model was cleared or loaded again
+    if (request.mGeneration != d->mPagesGeneration) {
+        return;
+    }
+
+    if (request.mPageIndex < d->mPages.size()) {
+        // data of a page that had been dropped, the page keeps its rows
+        auto &onePage = d->mPages[request.mPageIndex];
+        onePage.mIsLoading = false;
+
+        if (onePage.mIsLoaded) {
+            return;
+        }
+
+        onePage.mIsLoaded = true;
+
+        const auto firstRow = onePage.mFirstRow;
+        const auto lastRow = onePage.mFirstRow + onePage.mRowsCount - 1;
+
+        for (const auto &oneData : pageData) {
+            const auto row = indexFromId(oneData.databaseId());
+            if (row >= firstRow && row <= lastRow) {
+                allData[row] = oneData;
+            }
+        }
+
+        d->touchPage(request.mPageIndex);
+        d->evictPages(allData);
+
+        if (lastRow >= firstRow) {
+            Q_EMIT dataChanged(index(firstRow, 0), index(lastRow, 0));
+        }
+
+        return;
+    }
+
+    d->mIsFetchingPage = false;
+    d->mHasMoreData = pageData.size() >= request.mPageSize;
+
+    auto newPage = DataModelPrivate::DataPage{};
+    newPage.mAfterSortKey = request.mAfterSortKey;
+    newPage.mAfterKey = request.mAfterKey;
+    newPage.mIsFirstPage = request.mIsFirstPage;
+    newPage.mFirstRow = allData.size();
+    d->mPages.push_back(newPage);
+
+    d->filterKnownData(pageData);
+
+    if (!pageData.isEmpty()) {
+        const auto firstNewRow = allData.size();
+        beginInsertRows({}, firstNewRow, firstNewRow + pageData.size() - 1);
+        allData.append(pageData);
+        d->indexRows(allData, firstNewRow);
+        d->mPages.last().mRowsCount = pageData.size();
+        endInsertRows();
+    }
+
+    d->touchPage(d->mPages.size() - 1);
+    d->evictPages(allData);
+
+    setBusy(false);
+
+    auto newDataWhileFetching = DataListType{};
+    newDataWhileFetching.swap(d->newDataWhileFetching(allData));
+    insertSortedData(allData, newDataWhileFetching);
+}
+
+template <typename DataListType>
+void DataModel::insertSortedData(DataListType &allData, DataListType newData)
+{
+    d->filterNewData(newData);
+    d->filterKnownData(newData);
+
+    if (newData.isEmpty()) {
+        return;
+    }
+
+    const auto isBefore = [this](const auto &first, const auto &second) {return d->isBefore(first, second);};
+
+    std::sort(newData.begin(), newData.end(), isBefore);
+
+    // entries after the last loaded one will come with the next pages
+    if (d->mHasMoreData || d->mIsFetchingPage) {
+        auto firstNotLoaded = newData.begin();
+        if (!allData.isEmpty()) {
+            firstNotLoaded = std::upper_bound(newData.begin(), newData.end(), allData.constLast(), isBefore);
+        }
+
+        if (d->mIsFetchingPage) {
+            std::copy(firstNotLoaded, newData.end(), std::back_inserter(d->newDataWhileFetching(allData)));
+        }
+
+        newData.erase(firstNotLoaded, newData.end());
+
+        if (newData.isEmpty()) {
+            return;
+        }
+    }
+
+    const auto wasEmpty = allData.isEmpty();
+
+    auto newRows = QVector<int>{};
+    newRows.reserve(newData.size());
+    for (const auto &oneData : newData) {
+        newRows.push_back(static_cast<int>(std::upper_bound(allData.begin(), allData.end(), oneData, isBefore) - allData.begin()));
+    }
+
+    // entries inserted at the same place are a block, blocks are inserted from the end so that the
+    // places of the other ones do not change
+    for (auto lastEntry = newData.size() - 1; lastEntry >= 0;) {
+        auto firstEntry = lastEntry;
+        while (firstEntry > 0 && newRows[firstEntry - 1] == newRows[lastEntry]) {
+            --firstEntry;
+        }
+
+        const auto firstRow = newRows[firstEntry];
+        const auto rowsCount = lastEntry - firstEntry + 1;
+
+        beginInsertRows({}, firstRow, firstRow + rowsCount - 1);
+        d->pagesRowsInserted(firstRow, rowsCount, allData.size());
+        for (auto entry = lastEntry; entry >= firstEntry; --entry) {
+            allData.insert(firstRow, newData[entry]);
+        }
+        endInsertRows();
+
+        lastEntry = firstEntry - 1;
+    }
+
+    d->indexRows(allData, newRows.constFirst());
+
+    if (wasEmpty) {
+        setBusy(false);
+    }
+}
+
 #include "moc_datamodel.cpp"
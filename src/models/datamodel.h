@@ -58,6 +58,8 @@ public:
 
     using ListAlbumDataType = DataTypes::ListAlbumDataType;
 
+    using TracksChangeSet = DataTypes::TracksChangeSet;
+
     using AlbumDataType = DataTypes::AlbumDataType;
 
     using ListArtistDataType = DataTypes::ListArtistDataType;
@@ -86,12 +88,22 @@ public:
 
     QModelIndex parent(const QModelIndex &child) const override;
 
+    bool canFetchMore(const QModelIndex &parent) const override;
+
+    void fetchMore(const QModelIndex &parent) override;
+
     QString title() const;
 
     QString author() const;
 
     bool isBusy() const;
 
+    /**
+     * A paged model shows a whole collection loaded by pages from the database: the database
+     * sorts and filters it, see sortData and filterData.
+     */
+    bool isPaged() const;
+
 Q_SIGNALS:
 
     void titleChanged();
@@ -100,6 +112,12 @@ Q_SIGNALS:
 
     void needData(ElisaUtils::PlayListEntryType dataType);
 
+    void needDataPage(ElisaUtils::PlayListEntryType dataType, const DataTypes::PageRequest &request);
+
+    void needAllEntriesOfPages(ElisaUtils::PlayListEntryType dataType, const DataTypes::PageRequest &request,
+                               ElisaUtils::PlayListEnqueueMode enqueueMode,
+                               ElisaUtils::PlayListEnqueueTriggerPlay triggerPlay);
+
     void needDataById(ElisaUtils::PlayListEntryType dataType, qulonglong databaseId);
 
     void needDataByGenre(ElisaUtils::PlayListEntryType dataType, const QString &genre);
@@ -113,8 +131,17 @@ Q_SIGNALS:
 
     void needFrequentlyPlayedData(ElisaUtils::PlayListEntryType dataType);
 
+    void needSearchData(ElisaUtils::PlayListEntryType dataType, const QString &searchText);
+
+    void searchResults(const QString &searchText, const QVector<qulonglong> &matchingIds);
+
     void isBusyChanged();
 
+    void entriesToEnqueue(const ElisaUtils::EntryDataList &newEntries,
+                          ElisaUtils::PlayListEntryType databaseIdType,
+                          ElisaUtils::PlayListEnqueueMode enqueueMode,
+                          ElisaUtils::PlayListEnqueueTriggerPlay triggerPlay);
+
 public Q_SLOTS:
 
     void tracksAdded(DataModel::ListTrackDataType newData);
@@ -125,6 +152,8 @@ public Q_SLOTS:
 
     void trackRemoved(qulonglong removedTrackId);
 
+    void tracksChanged(const DataModel::TracksChangeSet &changes);
+
     void radioRemoved(qulonglong removedRadioId);
 
     void genresAdded(DataModel::ListGenreDataType newData);
@@ -143,18 +172,62 @@ public Q_SLOTS:
                     ElisaUtils::PlayListEntryType modelType, ElisaUtils::FilterType filter,
                     const QString &genre, const QString &artist, qulonglong databaseId);
 
+    void searchData(const QString &searchText);
+
+    /**
+     * Order of the entries of a paged model, the model is loaded again when it changes.
+     */
+    void sortData(Qt::SortOrder sortOrder);
+
+    /**
+     * Only entries of a paged model matching searchText and rated at least minimumRating are
+     * loaded, the model is loaded again when they change.
+     */
+    void filterData(const QString &searchText, int minimumRating);
+
+    /**
+     * Enqueue all the entries of a paged model, including the ones not loaded yet.
+     * They are given by entriesToEnqueue.
+     */
+    void enqueueAllData(ElisaUtils::PlayListEnqueueMode enqueueMode,
+                        ElisaUtils::PlayListEnqueueTriggerPlay triggerPlay);
+
 private Q_SLOTS:
 
     void cleanedDatabase();
 
+    void tracksPageAdded(const DataModel::ListTrackDataType &pageData, const DataTypes::PageRequest &request);
+
+    void albumsPageAdded(const DataModel::ListAlbumDataType &pageData, const DataTypes::PageRequest &request);
+
+    void artistsPageAdded(const DataModel::ListArtistDataType &pageData, const DataTypes::PageRequest &request);
+
 private:
 
     void radioAdded(const TrackDataType &radiosData);
 
     void radioModified(const DataModel::TrackDataType &modifiedRadio);
 
+    void addTracks(DataModel::ListTrackDataType newData);
+
+    void addArtists(DataModel::ListArtistDataType newData);
+
+    void addAlbums(DataModel::ListAlbumDataType newData);
+
+    template <typename DataListType>
+    void pageLoaded(DataListType &allData, DataListType pageData, const DataTypes::PageRequest &request);
+
+    template <typename DataListType>
+    void insertSortedData(DataListType &allData, DataListType newData);
+
+    void requestPage(int pageIndex, int pagesGeneration);
+
+    void reloadPages();
+
     int indexFromId(qulonglong id) const;
 
+    void notifyRowsChanged(QVector<int> rows, const QVector<int> &roles);
+
     void connectModel(DatabaseInterface *database);
 
     void setBusy(bool value);
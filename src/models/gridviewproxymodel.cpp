@@ -18,6 +18,7 @@
 
 #include "gridviewproxymodel.h"
 
+#include "datamodel.h"
 #include "datatypes.h"
 #include "elisautils.h"
 
@@ -43,6 +44,11 @@ bool GridViewProxyModel::filterAcceptsRow(int source_row, const QModelIndex &sou
 {
     bool result = false;
 
+    if (isSourcePaged()) {
+        result = true;
+        return result;
+    }
+
     auto currentIndex = sourceModel()->index(source_row, 0, source_parent);
 
     const auto &mainValue = sourceModel()->data(currentIndex, Qt::DisplayRole).toString();
@@ -55,6 +61,11 @@ bool GridViewProxyModel::filterAcceptsRow(int source_row, const QModelIndex &sou
         return result;
     }
 
+    if (mHasSearchResults) {
+        result = mSearchResults.contains(sourceModel()->data(currentIndex, DataTypes::DatabaseIdRole).toULongLong());
+        return result;
+    }
+
     if (mFilterExpression.match(mainValue).hasMatch()) {
         result = true;
         return result;
@@ -78,6 +89,12 @@ bool GridViewProxyModel::filterAcceptsRow(int source_row, const QModelIndex &sou
 void GridViewProxyModel::genericEnqueueToPlayList(ElisaUtils::PlayListEnqueueMode enqueueMode,
                                                    ElisaUtils::PlayListEnqueueTriggerPlay triggerPlay)
 {
+    // most of the entries of a paged model are not loaded
+    if (isSourcePaged()) {
+        mSearchModel->enqueueAllData(enqueueMode, triggerPlay);
+        return;
+    }
+
     QtConcurrent::run(&mThreadPool, [=] () {
         QReadLocker locker(&mDataLock);
         auto allData = ElisaUtils::EntryDataList{};
@@ -34,13 +34,6 @@ public:
 
     ~SingleAlbumProxyModel() override;
 
-Q_SIGNALS:
-
-    void entriesToEnqueue(const ElisaUtils::EntryDataList &newEntries,
-                          ElisaUtils::PlayListEntryType databaseIdType,
-                          ElisaUtils::PlayListEnqueueMode enqueueMode,
-                          ElisaUtils::PlayListEnqueueTriggerPlay triggerPlay);
-
 public Q_SLOTS:
 
     void enqueueToPlayList();
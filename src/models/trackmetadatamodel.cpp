@@ -418,6 +418,29 @@ void TrackMetadataModel::lyricsValueIsReady()
     }
 }
 
+void TrackMetadataModel::tracksChanged(const DataTypes::TracksChangeSet &changes)
+{
+    if (mFullData.isEmpty()) {
+        return;
+    }
+
+    for (const auto &oneModifiedTrack : changes.mModifiedTracks) {
+        if (oneModifiedTrack.databaseId() == mFullData.databaseId()) {
+            trackData(oneModifiedTrack);
+            return;
+        }
+    }
+
+    for (const auto &oneChange : changes.mTracksChanges) {
+        if (oneChange.databaseId() == mFullData.databaseId()) {
+            auto modifiedTrack = mFullData;
+            modifiedTrack.applyChanges(oneChange);
+            trackData(modifiedTrack);
+            return;
+        }
+    }
+}
+
 void TrackMetadataModel::initializeByIdAndUrl(ElisaUtils::PlayListEntryType type, qulonglong databaseId, const QUrl &url)
 {
     mFullData.clear();
@@ -457,8 +480,8 @@ void TrackMetadataModel::initialize(MusicListenersManager *newManager, DatabaseI
             &mDataLoader, &ModelDataLoader::saveRadioModified);
     connect(this, &TrackMetadataModel::deleteRadioData,
             &mDataLoader, &ModelDataLoader::removeRadio);
-    connect(&mDataLoader, &ModelDataLoader::trackModified,
-            this, &TrackMetadataModel::trackData);
+    connect(&mDataLoader, &ModelDataLoader::tracksChanged,
+            this, &TrackMetadataModel::tracksChanged);
     connect(&mDataLoader, &ModelDataLoader::allTrackData,
             this, &TrackMetadataModel::trackData);
     connect(&mDataLoader, &ModelDataLoader::allRadioData,
@@ -544,7 +567,7 @@ void TrackMetadataModel::saveData()
 
 void TrackMetadataModel::deleteRadio()
 {
-    if (mTrackData[DataTypes::DatabaseIdRole]>=0) {
+    if (mTrackData.value(DataTypes::DatabaseIdRole)>=0) {
         Q_EMIT deleteRadioData(mTrackData[DataTypes::DatabaseIdRole].toULongLong());
     }
 }
@@ -125,6 +125,8 @@ public Q_SLOTS:
 
     void trackData(const TrackMetadataModel::TrackDataType &trackData);
 
+    void tracksChanged(const DataTypes::TracksChangeSet &changes);
+
     void initializeByIdAndUrl(ElisaUtils::PlayListEntryType type, qulonglong databaseId, const QUrl &url);
 
     void initializeByUrl(ElisaUtils::PlayListEntryType type, const QUrl &url);
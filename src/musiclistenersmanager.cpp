@@ -59,6 +59,7 @@
 #include <QDebug>
 
 #include <list>
+#include <vector>
 
 class MusicListenersManagerPrivate
 {
@@ -86,6 +87,12 @@ public:
 
     DatabaseInterface mDatabaseInterface;
 
+    std::vector<std::unique_ptr<QThread>> mDatabaseReaderThreads;
+
+    std::vector<std::unique_ptr<DatabaseInterface>> mDatabaseReaders;
+
+    int mNextDatabaseReader = 0;
+
     std::unique_ptr<TracksListener> mTracksListener;
 
     QFileSystemWatcher mConfigFileWatcher;
@@ -145,8 +152,28 @@ MusicListenersManager::MusicListenersManager(QObject *parent)
         databaseFileName = localDataPaths.first() + QStringLiteral("/elisaDatabase.db");
     }
 
+    const auto useWriteAheadLog = Elisa::ElisaConfiguration::useWriteAheadLog() && !databaseFileName.isEmpty();
+
     QMetaObject::invokeMethod(&d->mDatabaseInterface, "init", Qt::QueuedConnection,
-                              Q_ARG(QString, QStringLiteral("listeners")), Q_ARG(QString, databaseFileName));
+                              Q_ARG(QString, QStringLiteral("listeners")), Q_ARG(QString, databaseFileName),
+                              Q_ARG(bool, useWriteAheadLog));
+
+    if (useWriteAheadLog) {
+        // reader threads are started once the writer has created or upgraded the database
+        for (int readerIndex = 0; readerIndex < Elisa::ElisaConfiguration::databaseReadersCount(); ++readerIndex) {
+            auto readerThread = std::make_unique<QThread>();
+            auto reader = std::make_unique<DatabaseInterface>();
+
+            reader->moveToThread(readerThread.get());
+
+            QMetaObject::invokeMethod(reader.get(), "initReadOnly", Qt::QueuedConnection,
+                                      Q_ARG(QString, QStringLiteral("listenersReader%1").arg(readerIndex)),
+                                      Q_ARG(QString, databaseFileName));
+
+            d->mDatabaseReaderThreads.push_back(std::move(readerThread));
+            d->mDatabaseReaders.push_back(std::move(reader));
+        }
+    }
 
     qCInfo(orgKdeElisaIndexersManager) << "Local file system indexer is inactive";
     qCInfo(orgKdeElisaIndexersManager) << "Baloo indexer is unavailable";
@@ -165,9 +192,10 @@ void MusicListenersManager::subscribeForTracks(MediaPlayList *client)
 {
     createTracksListener();
     connect(d->mTracksListener.get(), &TracksListener::trackHasChanged, client, &MediaPlayList::trackChanged);
-    connect(d->mTracksListener.get(), &TracksListener::trackHasBeenRemoved, client, &MediaPlayList::trackRemoved);
+    connect(d->mTracksListener.get(), &TracksListener::tracksHaveChanged, client, &MediaPlayList::tracksChanged);
     connect(d->mTracksListener.get(), &TracksListener::tracksListAdded, client, &MediaPlayList::tracksListAdded);
     connect(client, &MediaPlayList::newEntryInList, d->mTracksListener.get(), &TracksListener::newEntryInList);
+    connect(client, &MediaPlayList::newTracksByIdInList, d->mTracksListener.get(), &TracksListener::newTracksByIdInList);
     connect(client, &MediaPlayList::newUrlInList, d->mTracksListener.get(), &TracksListener::newUrlInList);
     connect(client, &MediaPlayList::newTrackByNameInList, d->mTracksListener.get(), &TracksListener::trackByNameInList);
 }
@@ -233,6 +261,12 @@ auto MusicListenersManager::initializeRootPath()
 
 void MusicListenersManager::databaseReady()
 {
+    for (const auto &oneReaderThread : d->mDatabaseReaderThreads) {
+        if (!oneReaderThread->isRunning()) {
+            oneReaderThread->start();
+        }
+    }
+
     auto initialRootPath = Elisa::ElisaConfiguration::rootPath();
     if (initialRootPath.isEmpty()) {
         initializeRootPath();
@@ -252,6 +286,11 @@ void MusicListenersManager::applicationAboutToQuit()
     d->mDatabaseThread.exit();
     d->mDatabaseThread.wait();
 
+    for (const auto &oneReaderThread : d->mDatabaseReaderThreads) {
+        oneReaderThread->exit();
+        oneReaderThread->wait();
+    }
+
     d->mListenerThread.exit();
     d->mListenerThread.wait();
 }
@@ -310,7 +349,16 @@ void MusicListenersManager::deleteElementById(ElisaUtils::PlayListEntryType entr
 
 void MusicListenersManager::connectModel(ModelDataLoader *dataLoader)
 {
-    dataLoader->moveToThread(&d->mDatabaseThread);
+    if (d->mDatabaseReaders.empty()) {
+        dataLoader->moveToThread(&d->mDatabaseThread);
+        return;
+    }
+
+    const auto readerIndex = d->mNextDatabaseReader;
+    d->mNextDatabaseReader = (d->mNextDatabaseReader + 1) % static_cast<int>(d->mDatabaseReaders.size());
+
+    dataLoader->setReadDatabase(d->mDatabaseReaders[readerIndex].get());
+    dataLoader->moveToThread(d->mDatabaseReaderThreads[readerIndex].get());
 }
 
 void MusicListenersManager::resetMusicData()
@@ -354,6 +402,13 @@ void MusicListenersManager::configChanged()
 
     d->mFileListener.setAllRootPaths(allRootPaths);
 
+    auto metadataExtractionWorkersCount = currentConfiguration->metadataExtractionWorkersCount();
+    if (metadataExtractionWorkersCount == 0) {
+        metadataExtractionWorkersCount = QThread::idealThreadCount();
+    }
+    QMetaObject::invokeMethod(d->mFileListener.fileListing(), "setMetadataExtractionWorkersCount", Qt::QueuedConnection,
+                              Q_ARG(int, metadataExtractionWorkersCount));
+
 #if defined KF5Baloo_FOUND && KF5Baloo_FOUND
     d->mBalooListener.setAllRootPaths(allRootPaths);
 #endif
@@ -538,9 +593,8 @@ void MusicListenersManager::createTracksListener()
         connect(this, &MusicListenersManager::removeTracksInError,
                 &d->mDatabaseInterface, &DatabaseInterface::removeTracksList);
 
-        connect(&d->mDatabaseInterface, &DatabaseInterface::trackRemoved, d->mTracksListener.get(), &TracksListener::trackRemoved);
         connect(&d->mDatabaseInterface, &DatabaseInterface::tracksAdded, d->mTracksListener.get(), &TracksListener::tracksAdded);
-        connect(&d->mDatabaseInterface, &DatabaseInterface::trackModified, d->mTracksListener.get(), &TracksListener::trackModified);
+        connect(&d->mDatabaseInterface, &DatabaseInterface::tracksChanged, d->mTracksListener.get(), &TracksListener::tracksChanged);
         Q_EMIT tracksListenerChanged();
     }
 }
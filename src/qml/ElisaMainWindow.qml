@@ -333,6 +333,9 @@ ApplicationWindow {
         elisa.mediaPlayList.repeatPlay = Qt.binding(function() { return headerBar.playerControl.repeat })
         elisa.audioPlayer.muted = Qt.binding(function() { return headerBar.playerControl.muted })
         elisa.audioPlayer.volume = Qt.binding(function() { return headerBar.playerControl.volume })
+        elisa.audioPlayer.positionUpdateInterval = Qt.binding(function() {
+            return (mainWindow.visible && mainWindow.visibility !== Window.Minimized) ? 100 : 250
+        })
 
         mprisloader.active = true
     }
@@ -0,0 +1,511 @@
+/*
+ * Copyright 2026 The Elisa developers
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "shufflelist.h"
+
+#include <QVector>
+#include <QDataStream>
+#include <QRandomGenerator>
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+
+class ShuffleListPrivate
+{
+public:
+
+    // the positions before poolBegin and from poolEnd have their row, the rows in between are not drawn yet
+    int poolBegin() const
+    {
+        return mDrawnAtBegin;
+    }
+
+    int poolEnd() const
+    {
+        return mOrder.size() - mDrawnAtEnd;
+    }
+
+    bool isInPool(int row) const
+    {
+        const auto position = mPositions[row];
+        return position >= poolBegin() && position < poolEnd();
+    }
+
+    void swapPositions(int firstPosition, int secondPosition)
+    {
+        std::swap(mOrder[firstPosition], mOrder[secondPosition]);
+        mPositions[mOrder[firstPosition]] = firstPosition;
+        mPositions[mOrder[secondPosition]] = secondPosition;
+    }
+
+    void rebuildPositions()
+    {
+        mPositions.resize(mOrder.size());
+        for (int position = 0; position < mOrder.size(); ++position) {
+            mPositions[mOrder[position]] = position;
+        }
+    }
+
+    int drawRow(bool atBegin) const
+    {
+        auto row = mOrder[QRandomGenerator::global()->bounded(poolBegin(), poolEnd())];
+
+        if (!mSameGroup) {
+            return row;
+        }
+
+        if (atBegin) {
+            // go on with the group of the row drawn last
+            if (poolBegin() > 0) {
+                const auto drawnRow = mOrder[poolBegin() - 1];
+                if (drawnRow + 1 < mOrder.size() && isInPool(drawnRow + 1) && mSameGroup(drawnRow, drawnRow + 1)) {
+                    return drawnRow + 1;
+                }
+            }
+
+            // or start a group from its first row not yet drawn
+            while (row > 0 && isInPool(row - 1) && mSameGroup(row - 1, row)) {
+                --row;
+            }
+        } else {
+            if (poolEnd() < mOrder.size()) {
+                const auto drawnRow = mOrder[poolEnd()];
+                if (drawnRow > 0 && isInPool(drawnRow - 1) && mSameGroup(drawnRow - 1, drawnRow)) {
+                    return drawnRow - 1;
+                }
+            }
+
+            while (row + 1 < mOrder.size() && isInPool(row + 1) && mSameGroup(row, row + 1)) {
+                ++row;
+            }
+        }
+
+        return row;
+    }
+
+    void ensureDrawn(int position)
+    {
+        while (position >= poolBegin() && position < poolEnd()) {
+            if (position - poolBegin() <= poolEnd() - 1 - position) {
+                swapPositions(mPositions[drawRow(true)], poolBegin());
+                ++mDrawnAtBegin;
+            } else {
+                swapPositions(mPositions[drawRow(false)], poolEnd() - 1);
+                ++mDrawnAtEnd;
+            }
+        }
+    }
+
+    int nextPosition(bool wrap) const
+    {
+        if (mOrder.isEmpty()) {
+            return -1;
+        }
+
+        if (mCurrentPosition + 1 < mOrder.size()) {
+            return mCurrentPosition + 1;
+        }
+
+        return wrap ? 0 : -1;
+    }
+
+    int previousPosition(bool wrap) const
+    {
+        if (mOrder.isEmpty() || mCurrentPosition < 0) {
+            return -1;
+        }
+
+        if (mCurrentPosition > 0) {
+            return mCurrentPosition - 1;
+        }
+
+        return wrap ? mOrder.size() - 1 : -1;
+    }
+
+    int drawnRow(int position)
+    {
+        if (position < 0) {
+            return -1;
+        }
+
+        ensureDrawn(position);
+
+        return mOrder[position];
+    }
+
+    // row at each position of the order
+    QVector<int> mOrder;
+
+    // position of each row in the order
+    QVector<int> mPositions;
+
+    int mDrawnAtBegin = 0;
+
+    int mDrawnAtEnd = 0;
+
+    int mCurrentPosition = -1;
+
+    ShuffleList::SameGroupFunction mSameGroup;
+
+    static constexpr quint32 mStateVersion = 1;
+
+};
+
+ShuffleList::ShuffleList() : d(std::make_unique<ShuffleListPrivate>())
+{
+}
+
+ShuffleList::~ShuffleList()
+= default;
+
+void ShuffleList::reset(int rowsCount)
+{
+    d->mOrder.resize(rowsCount);
+    std::iota(d->mOrder.begin(), d->mOrder.end(), 0);
+    d->rebuildPositions();
+
+    d->mDrawnAtBegin = 0;
+    d->mDrawnAtEnd = 0;
+    d->mCurrentPosition = -1;
+}
+
+void ShuffleList::setSameGroupFunction(SameGroupFunction sameGroup)
+{
+    d->mSameGroup = std::move(sameGroup);
+}
+
+int ShuffleList::rowsCount() const
+{
+    return d->mOrder.size();
+}
+
+int ShuffleList::currentRow() const
+{
+    if (d->mCurrentPosition < 0 || d->mCurrentPosition >= d->mOrder.size()) {
+        return -1;
+    }
+
+    return d->mOrder[d->mCurrentPosition];
+}
+
+void ShuffleList::setCurrentRow(int row)
+{
+    if (row < 0 || row >= d->mOrder.size()) {
+        return;
+    }
+
+    const auto position = d->mPositions[row];
+
+    if (position == d->mCurrentPosition) {
+        return;
+    }
+
+    if (position < d->mCurrentPosition) {
+        const auto isInSameDrawnPart = d->mCurrentPosition < d->poolBegin() || position >= d->poolEnd();
+
+        if (isInSameDrawnPart) {
+            for (auto onePosition = position; onePosition < d->mCurrentPosition; ++onePosition) {
+                d->swapPositions(onePosition, onePosition + 1);
+            }
+        } else {
+            d->mCurrentPosition = position;
+        }
+
+        return;
+    }
+
+    const auto nextPosition = d->mCurrentPosition + 1;
+    const auto isNextPositionInPool = nextPosition >= d->poolBegin() && nextPosition < d->poolEnd();
+
+    d->swapPositions(position, nextPosition);
+    if (isNextPositionInPool) {
+        ++d->mDrawnAtBegin;
+    }
+
+    d->mCurrentPosition = nextPosition;
+}
+
+int ShuffleList::nextRow(bool wrap)
+{
+    return d->drawnRow(d->nextPosition(wrap));
+}
+
+int ShuffleList::previousRow(bool wrap)
+{
+    return d->drawnRow(d->previousPosition(wrap));
+}
+
+int ShuffleList::moveToNext(bool wrap)
+{
+    const auto position = d->nextPosition(wrap);
+
+    if (position < 0) {
+        return -1;
+    }
+
+    // every row has been played: a new order starts with the row given by nextRow
+    if (position == 0 && d->mCurrentPosition >= 0) {
+        const auto firstRow = d->drawnRow(0);
+
+        reset(d->mOrder.size());
+
+        d->swapPositions(d->mPositions[firstRow], 0);
+        d->mDrawnAtBegin = 1;
+        d->mCurrentPosition = 0;
+
+        return firstRow;
+    }
+
+    d->mCurrentPosition = position;
+
+    return d->drawnRow(position);
+}
+
+int ShuffleList::moveToPrevious(bool wrap)
+{
+    const auto position = d->previousPosition(wrap);
+
+    if (position < 0) {
+        return -1;
+    }
+
+    d->mCurrentPosition = position;
+
+    return d->drawnRow(position);
+}
+
+int ShuffleList::remainingRowsCount() const
+{
+    return d->mOrder.size() - d->mCurrentPosition - 1;
+}
+
+void ShuffleList::insertRows(int first, int count)
+{
+    if (count <= 0) {
+        return;
+    }
+
+    for (auto &row : d->mOrder) {
+        if (row >= first) {
+            row += count;
+        }
+    }
+
+    // new rows are not drawn yet
+    const auto insertPosition = d->poolEnd();
+    d->mOrder.insert(insertPosition, count, 0);
+    std::iota(d->mOrder.begin() + insertPosition, d->mOrder.begin() + insertPosition + count, first);
+
+    if (d->mCurrentPosition >= insertPosition) {
+        d->mCurrentPosition += count;
+    }
+
+    d->rebuildPositions();
+}
+
+void ShuffleList::removeRows(int first, int count)
+{
+    if (count <= 0) {
+        return;
+    }
+
+    const auto last = first + count - 1;
+    const auto poolEnd = d->poolEnd();
+
+    auto newOrder = QVector<int>{};
+    newOrder.reserve(std::max(d->mOrder.size() - count, 0));
+
+    auto drawnAtBegin = d->mDrawnAtBegin;
+    auto drawnAtEnd = d->mDrawnAtEnd;
+    auto currentPosition = d->mCurrentPosition;
+    auto isCurrentRemoved = false;
+
+    for (int position = 0; position < d->mOrder.size(); ++position) {
+        const auto row = d->mOrder[position];
+
+        if (row >= first && row <= last) {
+            if (position < d->mDrawnAtBegin) {
+                --drawnAtBegin;
+            } else if (position >= poolEnd) {
+                --drawnAtEnd;
+            }
+
+            if (position < d->mCurrentPosition) {
+                --currentPosition;
+            } else if (position == d->mCurrentPosition) {
+                isCurrentRemoved = true;
+            }
+
+            continue;
+        }
+
+        newOrder.push_back(row > last ? row - count : row);
+    }
+
+    d->mOrder = std::move(newOrder);
+    d->mDrawnAtBegin = drawnAtBegin;
+    d->mDrawnAtEnd = drawnAtEnd;
+    d->mCurrentPosition = std::min(currentPosition, d->mOrder.size() - 1);
+    d->rebuildPositions();
+
+    // the row following the removed current row in the order becomes the current one
+    if (isCurrentRemoved && d->mCurrentPosition >= 0) {
+        d->ensureDrawn(d->mCurrentPosition);
+    }
+}
+
+void ShuffleList::moveRows(int first, int count, int destination)
+{
+    if (count <= 0 || (destination >= first && destination <= first + count)) {
+        return;
+    }
+
+    const auto movedRow = [first, count, destination](int row) {
+        if (destination > first) {
+            if (row >= first && row < first + count) {
+                return row + destination - first - count;
+            }
+            if (row >= first + count && row < destination) {
+                return row - count;
+            }
+        } else {
+            if (row >= first && row < first + count) {
+                return row - first + destination;
+            }
+            if (row >= destination && row < first) {
+                return row + count;
+            }
+        }
+
+        return row;
+    };
+
+    for (auto &row : d->mOrder) {
+        row = movedRow(row);
+    }
+
+    d->rebuildPositions();
+}
+
+QByteArray ShuffleList::state(const QVector<int> &skippedRows) const
+{
+    if (skippedRows.isEmpty()) {
+        return state();
+    }
+
+    ShuffleList savedOrder;
+    *savedOrder.d = *d;
+
+    // from the last one so that the other skipped rows keep their index
+    auto sortedRows = skippedRows;
+    std::sort(sortedRows.begin(), sortedRows.end(), std::greater<int>());
+    for (auto oneRow : qAsConst(sortedRows)) {
+        savedOrder.removeRows(oneRow, 1);
+    }
+
+    return savedOrder.state();
+}
+
+QByteArray ShuffleList::state() const
+{
+    auto drawnAtBegin = QVector<qint32>{};
+    drawnAtBegin.reserve(d->mDrawnAtBegin);
+    for (int position = 0; position < d->poolBegin(); ++position) {
+        drawnAtBegin.push_back(d->mOrder[position]);
+    }
+
+    auto drawnAtEnd = QVector<qint32>{};
+    drawnAtEnd.reserve(d->mDrawnAtEnd);
+    for (int position = d->poolEnd(); position < d->mOrder.size(); ++position) {
+        drawnAtEnd.push_back(d->mOrder[position]);
+    }
+
+    QByteArray result;
+    QDataStream stateStream(&result, QIODevice::WriteOnly);
+    stateStream.setVersion(QDataStream::Qt_5_11);
+
+    stateStream << ShuffleListPrivate::mStateVersion << qint32(d->mOrder.size()) << qint32(d->mCurrentPosition)
+                << drawnAtBegin << drawnAtEnd;
+
+    return result;
+}
+
+bool ShuffleList::restoreState(const QByteArray &savedState)
+{
+    QDataStream stateStream(savedState);
+    stateStream.setVersion(QDataStream::Qt_5_11);
+
+    auto version = quint32{};
+    auto rowsCount = qint32{-1};
+    auto currentPosition = qint32{-1};
+    auto drawnAtBegin = QVector<qint32>{};
+    auto drawnAtEnd = QVector<qint32>{};
+
+    stateStream >> version >> rowsCount >> currentPosition >> drawnAtBegin >> drawnAtEnd;
+
+    if (stateStream.status() != QDataStream::Ok || version != ShuffleListPrivate::mStateVersion) {
+        return false;
+    }
+
+    if (rowsCount != d->mOrder.size() || drawnAtBegin.size() + drawnAtEnd.size() > rowsCount) {
+        return false;
+    }
+
+    if (currentPosition < -1 || currentPosition >= rowsCount ||
+            (currentPosition >= drawnAtBegin.size() && currentPosition < rowsCount - drawnAtEnd.size())) {
+        return false;
+    }
+
+    auto newOrder = QVector<int>(rowsCount);
+    auto isDrawn = QVector<bool>(rowsCount, false);
+
+    const auto readRows = [&newOrder, &isDrawn, rowsCount](const QVector<qint32> &rows, int firstPosition) {
+        for (int i = 0; i < rows.size(); ++i) {
+            const auto row = rows[i];
+
+            if (row < 0 || row >= rowsCount || isDrawn[row]) {
+                return false;
+            }
+
+            isDrawn[row] = true;
+            newOrder[firstPosition + i] = row;
+        }
+
+        return true;
+    };
+
+    if (!readRows(drawnAtBegin, 0) || !readRows(drawnAtEnd, rowsCount - drawnAtEnd.size())) {
+        return false;
+    }
+
+    auto poolPosition = drawnAtBegin.size();
+    for (int row = 0; row < rowsCount; ++row) {
+        if (!isDrawn[row]) {
+            newOrder[poolPosition] = row;
+            ++poolPosition;
+        }
+    }
+
+    d->mOrder = std::move(newOrder);
+    d->mDrawnAtBegin = drawnAtBegin.size();
+    d->mDrawnAtEnd = drawnAtEnd.size();
+    d->mCurrentPosition = currentPosition;
+    d->rebuildPositions();
+
+    return true;
+}
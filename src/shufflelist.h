@@ -0,0 +1,136 @@
+/*
+ * Copyright 2026 The Elisa developers
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SHUFFLELIST_H
+#define SHUFFLELIST_H
+
+#include "elisaLib_export.h"
+
+#include <QByteArray>
+#include <QVector>
+
+#include <functional>
+#include <memory>
+
+class ShuffleListPrivate;
+
+/**
+ * Random play order of the rows of a playlist.
+ *
+ * The order is a permutation of the rows built lazily by a Fisher-Yates
+ * shuffle: a position gets its row only when it is reached, from either end
+ * of the permutation, so moving to the next or previous row is O(1) and every
+ * row is played once before the order wraps. Inserted rows join the part not
+ * yet drawn and removed or moved rows keep the order of the others.
+ *
+ * When rows are grouped, a group is drawn as a whole and its rows are played
+ * in playlist order.
+ */
+class ELISALIB_EXPORT ShuffleList
+{
+public:
+
+    /**
+     * Tells if two consecutive rows of the playlist belong to the same group.
+     */
+    using SameGroupFunction = std::function<bool(int firstRow, int secondRow)>;
+
+    ShuffleList();
+
+    ~ShuffleList();
+
+    /**
+     * Start a new order of rowsCount rows with no current row.
+     */
+    void reset(int rowsCount);
+
+    void setSameGroupFunction(SameGroupFunction sameGroup);
+
+    int rowsCount() const;
+
+    /**
+     * @return the current row or -1
+     */
+    int currentRow() const;
+
+    /**
+     * Make row the current one. A row not played yet is played right after the
+     * current one; a row already played becomes the last one played.
+     */
+    void setCurrentRow(int row);
+
+    /**
+     * @return the row after the current one or -1 at the end of the order when not wrapping
+     */
+    int nextRow(bool wrap);
+
+    /**
+     * @return the row before the current one or -1 at the start of the order when not wrapping
+     */
+    int previousRow(bool wrap);
+
+    /**
+     * Move to the next row. Wrapping at the end starts a new order with the
+     * row given by nextRow.
+     * @return the new current row or -1 at the end of the order when not wrapping
+     */
+    int moveToNext(bool wrap);
+
+    /**
+     * Move to the previous row.
+     * @return the new current row or -1 at the start of the order when not wrapping
+     */
+    int moveToPrevious(bool wrap);
+
+    /**
+     * @return the number of rows after the current one in the order
+     */
+    int remainingRowsCount() const;
+
+    void insertRows(int first, int count);
+
+    void removeRows(int first, int count);
+
+    /**
+     * Follow a move of count rows starting at first before the row destination,
+     * with the arguments of QAbstractItemModel::beginMoveRows.
+     */
+    void moveRows(int first, int count, int destination);
+
+    /**
+     * The drawn part of the order and the current position in a compact binary form.
+     */
+    QByteArray state() const;
+
+    /**
+     * The state of the order without skippedRows, as if they had been removed.
+     */
+    QByteArray state(const QVector<int> &skippedRows) const;
+
+    /**
+     * Restore an order saved by state for the same number of rows.
+     * @return false if the saved order does not match
+     */
+    bool restoreState(const QByteArray &savedState);
+
+private:
+
+    std::unique_ptr<ShuffleListPrivate> d;
+
+};
+
+#endif // SHUFFLELIST_H
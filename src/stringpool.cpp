@@ -0,0 +1,164 @@
+/*
+ * Copyright 2026 The Elisa developers
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "stringpool.h"
+
+#include <QSet>
+#include <QReadWriteLock>
+#include <QReadLocker>
+#include <QWriteLocker>
+#include <QAtomicInteger>
+
+class StringPoolPrivate
+{
+public:
+
+    static qint64 stringBytes(const QString &value)
+    {
+        return static_cast<qint64>(value.size()) * static_cast<qint64>(sizeof(QChar));
+    }
+
+    void countHit(const QString &pooledValue, const QString &value)
+    {
+        mHitsCount.fetchAndAddRelaxed(1);
+
+        if (pooledValue.constData() != value.constData()) {
+            mSavedBytes.fetchAndAddRelaxed(stringBytes(value));
+        }
+    }
+
+    mutable QReadWriteLock mLock;
+
+    QSet<QString> mStrings;
+
+    QAtomicInteger<qint64> mStoredBytes = 0;
+
+    QAtomicInteger<qint64> mSavedBytes = 0;
+
+    QAtomicInteger<qint64> mLookupsCount = 0;
+
+    QAtomicInteger<qint64> mHitsCount = 0;
+
+};
+
+StringPool &StringPool::instance()
+{
+    static StringPool pool;
+
+    return pool;
+}
+
+StringPool::StringPool() : d(std::make_unique<StringPoolPrivate>())
+{
+}
+
+StringPool::~StringPool() = default;
+
+QString StringPool::intern(const QString &value)
+{
+    if (value.isEmpty()) {
+        return value;
+    }
+
+    d->mLookupsCount.fetchAndAddRelaxed(1);
+
+    {
+        QReadLocker lockData(&d->mLock);
+
+        auto itString = d->mStrings.constFind(value);
+        if (itString != d->mStrings.constEnd()) {
+            d->countHit(*itString, value);
+            return *itString;
+        }
+    }
+
+    QWriteLocker lockData(&d->mLock);
+
+    auto itString = d->mStrings.constFind(value);
+    if (itString != d->mStrings.constEnd()) {
+        d->countHit(*itString, value);
+        return *itString;
+    }
+
+    d->mStrings.insert(value);
+    d->mStoredBytes.fetchAndAddRelaxed(StringPoolPrivate::stringBytes(value));
+
+    return value;
+}
+
+QStringList StringPool::intern(QStringList values)
+{
+    for (auto &oneValue : values) {
+        oneValue = intern(oneValue);
+    }
+
+    return values;
+}
+
+QVariant StringPool::intern(const QVariant &value)
+{
+    switch (value.userType())
+    {
+    case QMetaType::QString:
+        return intern(value.toString());
+    case QMetaType::QStringList:
+        return intern(value.toStringList());
+    default:
+        return value;
+    }
+}
+
+void StringPool::purgeUnusedStrings()
+{
+    QWriteLocker lockData(&d->mLock);
+
+    for (auto itString = d->mStrings.begin(); itString != d->mStrings.end(); ) {
+        if (itString->isDetached()) {
+            d->mStoredBytes.fetchAndSubRelaxed(StringPoolPrivate::stringBytes(*itString));
+            itString = d->mStrings.erase(itString);
+        } else {
+            ++itString;
+        }
+    }
+}
+
+int StringPool::stringsCount() const
+{
+    QReadLocker lockData(&d->mLock);
+
+    return d->mStrings.count();
+}
+
+qint64 StringPool::storedBytes() const
+{
+    return d->mStoredBytes;
+}
+
+qint64 StringPool::savedBytes() const
+{
+    return d->mSavedBytes;
+}
+
+qint64 StringPool::lookupsCount() const
+{
+    return d->mLookupsCount;
+}
+
+qint64 StringPool::hitsCount() const
+{
+    return d->mHitsCount;
+}
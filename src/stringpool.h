@@ -0,0 +1,86 @@
+/*
+ * Copyright 2026 The Elisa developers
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef STRINGPOOL_H
+#define STRINGPOOL_H
+
+#include "elisaLib_export.h"
+
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+
+#include <memory>
+
+class StringPoolPrivate;
+
+/**
+ * Process wide pool of strings shared by many tracks (artists, albums, genres, paths, ...).
+ *
+ * Interning a string gives back a copy sharing the buffer of the first equal string seen by
+ * the pool, so equal strings held by the models use one allocation and can be compared by
+ * pointer. All methods are thread safe.
+ */
+class ELISALIB_EXPORT StringPool
+{
+public:
+
+    static StringPool& instance();
+
+    ~StringPool();
+
+    QString intern(const QString &value);
+
+    QStringList intern(QStringList values);
+
+    /**
+     * Interns QString and QStringList values; any other value is returned unchanged.
+     */
+    QVariant intern(const QVariant &value);
+
+    /**
+     * Equality with a fast path for strings sharing the same buffer, as interned strings do.
+     */
+    static bool isSame(const QString &first, const QString &second)
+    {
+        return first.constData() == second.constData() || first == second;
+    }
+
+    /**
+     * Remove the strings only referenced by the pool.
+     */
+    void purgeUnusedStrings();
+
+    int stringsCount() const;
+
+    qint64 storedBytes() const;
+
+    qint64 savedBytes() const;
+
+    qint64 lookupsCount() const;
+
+    qint64 hitsCount() const;
+
+private:
+
+    StringPool();
+
+    std::unique_ptr<StringPoolPrivate> d;
+
+};
+
+#endif // STRINGPOOL_H
@@ -114,6 +114,33 @@ void TracksListener::trackModified(const TrackDataType &modifiedTrack)
     }
 }
 
+void TracksListener::tracksChanged(const TracksChangeSet &changes)
+{
+    TracksChangeSet listenedChanges;
+
+    for (const auto &oneModifiedTrack : changes.mModifiedTracks) {
+        if (d->mTracksByIdSet.contains(oneModifiedTrack.databaseId())) {
+            listenedChanges.mModifiedTracks.push_back(oneModifiedTrack);
+        }
+    }
+
+    for (const auto &oneChange : changes.mTracksChanges) {
+        if (d->mTracksByIdSet.contains(oneChange.databaseId())) {
+            listenedChanges.mTracksChanges.push_back(oneChange);
+        }
+    }
+
+    for (auto oneRemovedTrackId : changes.mRemovedTrackIds) {
+        if (d->mTracksByIdSet.contains(oneRemovedTrackId)) {
+            listenedChanges.mRemovedTrackIds.push_back(oneRemovedTrackId);
+        }
+    }
+
+    if (!listenedChanges.isEmpty()) {
+        Q_EMIT tracksHaveChanged(listenedChanges);
+    }
+}
+
 void TracksListener::trackByNameInList(const QVariant &title, const QVariant &artist, const QVariant &album,
                                        const QVariant &trackNumber, const QVariant &discNumber)
 {
@@ -237,6 +264,44 @@ void TracksListener::newEntryInList(qulonglong newDatabaseId,
     }
 }
 
+void TracksListener::newTracksByIdInList(const QVector<qulonglong> &newDatabaseIds)
+{
+    qCDebug(orgKdeElisaPlayList()) << "TracksListener::newTracksByIdInList" << newDatabaseIds.size();
+
+    auto uniqueIds = QVector<qulonglong>{};
+    uniqueIds.reserve(newDatabaseIds.size());
+    auto seenIds = QSet<qulonglong>{};
+    seenIds.reserve(newDatabaseIds.size());
+
+    for (auto oneId : newDatabaseIds) {
+        if (seenIds.contains(oneId)) {
+            continue;
+        }
+
+        seenIds.insert(oneId);
+        uniqueIds.push_back(oneId);
+    }
+
+    d->mTracksByIdSet.unite(seenIds);
+
+    TracksChangeSet newTracks;
+    newTracks.mModifiedTracks = d->mDatabase->tracksDataFromDatabaseIds(uniqueIds);
+
+    // ids unknown to the database are reported as removed tracks
+    for (const auto &oneTrack : qAsConst(newTracks.mModifiedTracks)) {
+        seenIds.remove(oneTrack.databaseId());
+    }
+    for (auto oneId : uniqueIds) {
+        if (seenIds.contains(oneId)) {
+            newTracks.mRemovedTrackIds.push_back(oneId);
+        }
+    }
+
+    if (!newTracks.isEmpty()) {
+        Q_EMIT tracksHaveChanged(newTracks);
+    }
+}
+
 void TracksListener::newUrlInList(const QUrl &entryUrl, ElisaUtils::PlayListEntryType databaseIdType)
 {
     switch (databaseIdType)
@@ -40,6 +40,8 @@ public:
 
     using TrackDataType = DataTypes::TrackDataType;
 
+    using TracksChangeSet = DataTypes::TracksChangeSet;
+
     explicit TracksListener(DatabaseInterface *database, QObject *parent = nullptr);
 
     ~TracksListener() override;
@@ -50,6 +52,8 @@ Q_SIGNALS:
 
     void trackHasBeenRemoved(qulonglong id);
 
+    void tracksHaveChanged(const TracksListener::TracksChangeSet &changes);
+
     void tracksListAdded(qulonglong newDatabaseId,
                          const QString &entryTitle,
                          ElisaUtils::PlayListEntryType databaseIdType,
@@ -63,12 +67,16 @@ public Q_SLOTS:
 
     void trackModified(const TracksListener::TrackDataType &modifiedTrack);
 
+    void tracksChanged(const TracksListener::TracksChangeSet &changes);
+
     void trackByNameInList(const QVariant &title, const QVariant &artist, const QVariant &album, const QVariant &trackNumber, const QVariant &discNumber);
 
     void newEntryInList(qulonglong newDatabaseId,
                         const QString &entryTitle,
                         ElisaUtils::PlayListEntryType databaseIdType);
 
+    void newTracksByIdInList(const QVector<qulonglong> &newDatabaseIds);
+
     void trackByFileNameInList(ElisaUtils::PlayListEntryType type, const QUrl &fileName);
 
     void newUrlInList(const QUrl &entryUrl,